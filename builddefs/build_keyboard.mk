@@ -599,6 +599,13 @@ check-size: build
 check-md5: build
 objs-size: build
 
+ifeq ($(strip $(BINLOG_ENABLE)), yes)
+# Dictionary of the binlog() format strings, for `qmk binlog-console`
+build: binlog-dictionary
+binlog-dictionary: elf
+	$(QMK_BIN) generate-binlog-dictionary --quiet --output $(BUILD_DIR)/$(TARGET).binlog.json $(DEPS)
+endif
+
 ifneq ($(strip $(TOP_SYMBOLS)),)
 ifeq ($(strip $(TOP_SYMBOLS)),yes)
 NUM_TOP_SYMBOLS := 10
@@ -45,6 +45,12 @@ else ifeq ($(strip $(DEBUG_MATRIX_SCAN_RATE_ENABLE)), api)
     OPT_DEFS += -DDEBUG_MATRIX_SCAN_RATE
 endif
 
+ifeq ($(strip $(BINLOG_ENABLE)), yes)
+    OPT_DEFS += -DBINLOG_ENABLE
+    QUANTUM_SRC += $(QUANTUM_DIR)/logging/binlog.c
+    CONSOLE_ENABLE = yes
+endif
+
 AUDIO_ENABLE ?= no
 ifeq ($(strip $(AUDIO_ENABLE)), yes)
     ifeq ($(PLATFORM),CHIBIOS)
@@ -131,6 +137,15 @@ ifeq ($(strip $(POINTING_DEVICE_ENABLE)), yes)
         VPATH += $(QUANTUM_DIR)/pointing_device
         SRC += $(QUANTUM_DIR)/pointing_device/pointing_device.c
         SRC += $(QUANTUM_DIR)/pointing_device/pointing_device_auto_mouse.c
+        SRC += $(QUANTUM_DIR)/pointing_device/pointing_device_accel.c
+        SRC += $(QUANTUM_DIR)/pointing_device/pointing_device_gestures.c
+        ifeq ($(strip $(POINTING_DEVICE_GESTURES_MOMENTUM_ENABLE)), yes)
+            OPT_DEFS += -DPOINTING_DEVICE_GESTURES_MOMENTUM_ENABLE
+            DEFERRED_EXEC_ENABLE := yes
+        endif
+        ifneq ("$(wildcard $(PLATFORM_PATH)/$(PLATFORM_KEY)/pointing_device_motion.c)","")
+            SRC += $(PLATFORM_PATH)/$(PLATFORM_KEY)/pointing_device_motion.c
+        endif
         ifneq ($(strip $(POINTING_DEVICE_DRIVER)), custom)
             SRC += drivers/sensors/$(strip $(POINTING_DEVICE_DRIVER)).c
             OPT_DEFS += -DPOINTING_DEVICE_DRIVER_$(strip $(shell echo $(POINTING_DEVICE_DRIVER) | tr '[:lower:]' '[:upper:]'))
@@ -147,12 +162,10 @@ ifeq ($(strip $(POINTING_DEVICE_ENABLE)), yes)
             I2C_DRIVER_REQUIRED = yes
             SRC += drivers/sensors/cirque_pinnacle.c
             SRC += drivers/sensors/cirque_pinnacle_gestures.c
-            SRC += $(QUANTUM_DIR)/pointing_device/pointing_device_gestures.c
         else ifeq ($(strip $(POINTING_DEVICE_DRIVER)), cirque_pinnacle_spi)
             SPI_DRIVER_REQUIRED = yes
             SRC += drivers/sensors/cirque_pinnacle.c
             SRC += drivers/sensors/cirque_pinnacle_gestures.c
-            SRC += $(QUANTUM_DIR)/pointing_device/pointing_device_gestures.c
         else ifeq ($(strip $(POINTING_DEVICE_DRIVER)), pimoroni_trackball)
             I2C_DRIVER_REQUIRED = yes
         else ifneq ($(filter $(strip $(POINTING_DEVICE_DRIVER)),pmw3360 pmw3389),)
@@ -639,6 +652,19 @@ ifeq ($(strip $(DYNAMIC_KEYMAP_ENABLE)), yes)
     SEND_STRING_ENABLE := yes
 endif
 
+ifeq ($(strip $(SEND_STRING_ASYNC_ENABLE)), yes)
+    SEND_STRING_ENABLE := yes
+    OPT_DEFS += -DSEND_STRING_ASYNC_ENABLE
+endif
+
+ifeq ($(strip $(MATRIX_IDLE_ENABLE)), yes)
+    OPT_DEFS += -DMATRIX_IDLE_ENABLE
+    SRC += $(QUANTUM_DIR)/matrix_idle.c
+    ifneq ("$(wildcard $(PLATFORM_PATH)/$(PLATFORM_KEY)/matrix_idle_wakeup.c)","")
+        SRC += $(PLATFORM_PATH)/$(PLATFORM_KEY)/matrix_idle_wakeup.c
+    endif
+endif
+
 VALID_CUSTOM_MATRIX_TYPES:= yes lite no
 
 CUSTOM_MATRIX ?= no
@@ -21,9 +21,9 @@ void eeprom_driver_erase(void) {
 }
 
 void eeprom_read_block(void *buf, const void *addr, size_t len) {
-    wear_leveling_read((uint32_t)addr, buf, len);
+    wear_leveling_read((uint32_t)(uintptr_t)addr, buf, len);
 }
 
 void eeprom_write_block(const void *buf, void *addr, size_t len) {
-    wear_leveling_write((uint32_t)addr, buf, len);
+    wear_leveling_write((uint32_t)(uintptr_t)addr, buf, len);
 }
@@ -4,6 +4,8 @@
 
 #include "azoteq_iqs5xx.h"
 #include "pointing_device_internal.h"
+#include "pointing_device_gestures.h"
+#include "gpio.h"
 #include "wait.h"
 
 #ifndef AZOTEQ_IQS5XX_ADDRESS
@@ -78,9 +80,20 @@
 #ifndef AZOTEQ_IQS5XX_ZOOM_CONSECUTIVE_DISTANCE
 #    define AZOTEQ_IQS5XX_ZOOM_CONSECUTIVE_DISTANCE 0x19
 #endif
+#ifndef AZOTEQ_IQS5XX_SCROLL_DISTANCE
+#    define AZOTEQ_IQS5XX_SCROLL_DISTANCE 64
+#endif
+#ifndef AZOTEQ_IQS5XX_SCROLL_MOMENTUM
+#    define AZOTEQ_IQS5XX_SCROLL_MOMENTUM 240
+#endif
 #ifndef AZOTEQ_IQS5XX_EVENT_MODE
-// Event mode can't be used until the pointing code has changed (stuck buttons)
-#    define AZOTEQ_IQS5XX_EVENT_MODE false
+// In event mode the trackpad only has a report ready when something changed, so it's
+// only read when the RDY pin says so. Polling it would wait on reports that never come.
+#    ifdef AZOTEQ_IQS5XX_RDY_PIN
+#        define AZOTEQ_IQS5XX_EVENT_MODE true
+#    else
+#        define AZOTEQ_IQS5XX_EVENT_MODE false
+#    endif
 #endif
 
 #if defined(AZOTEQ_IQS5XX_TPS43)
@@ -112,6 +125,31 @@ const pointing_device_driver_t azoteq_iqs5xx_pointing_device_driver = {
 
 static uint16_t azoteq_iqs5xx_product_number = AZOTEQ_IQS5XX_UNKNOWN;
 
+#ifdef AZOTEQ_IQS5XX_RDY_PIN
+// Press and hold is only reported when it starts and ends, so it's held in between
+static bool azoteq_iqs5xx_holding = false;
+#endif
+
+#ifdef POINTING_DEVICE_GESTURES_MULTI_TOUCH_ENABLE
+#    if AZOTEQ_IQS5XX_SCROLL_MOMENTUM < 1 || AZOTEQ_IQS5XX_SCROLL_MOMENTUM > 255
+#        error AZOTEQ_IQS5XX_SCROLL_MOMENTUM must be between 1 and 255.
+#    endif
+// The momentum counts in half pixels, steps once per report, and measures the speed over two reports
+static multi_touch_context_t multi_touch = {.config   = {
+                                                .scroll_trigger_px = AZOTEQ_IQS5XX_SCROLL_INITIAL_DISTANCE,
+                                                .pinch_trigger_px  = AZOTEQ_IQS5XX_ZOOM_INITIAL_DISTANCE,
+                                                .scroll_px         = AZOTEQ_IQS5XX_SCROLL_DISTANCE,
+                                                .pinch_px          = AZOTEQ_IQS5XX_ZOOM_CONSECUTIVE_DISTANCE,
+                                            },
+                                            .momentum = {.config = {
+                                                             .friction = MOMENTUM_FRICTION_VISCOUS,
+                                                             .coef     = (256 - AZOTEQ_IQS5XX_SCROLL_MOMENTUM) * 256,
+                                                             .trigger  = 2 * 256,
+                                                             .release  = 2 * AZOTEQ_IQS5XX_REPORT_RATE,
+                                                             .step     = AZOTEQ_IQS5XX_REPORT_RATE,
+                                                         }}};
+#endif
+
 static struct {
     uint16_t resolution_x;
     uint16_t resolution_y;
@@ -130,6 +168,14 @@ i2c_status_t azoteq_iqs5xx_get_base_data(azoteq_iqs5xx_base_data_t *base_data) {
     return status;
 }
 
+i2c_status_t azoteq_iqs5xx_get_touch_data(azoteq_iqs5xx_touch_data_t *touch_data) {
+    i2c_status_t status = i2c_read_register16(AZOTEQ_IQS5XX_ADDRESS, AZOTEQ_IQS5XX_REG_PREVIOUS_CYCLE_TIME, (uint8_t *)touch_data, sizeof(azoteq_iqs5xx_touch_data_t), AZOTEQ_IQS5XX_TIMEOUT_MS);
+    if (status == I2C_STATUS_SUCCESS) {
+        azoteq_iqs5xx_end_session();
+    }
+    return status;
+}
+
 i2c_status_t azoteq_iqs5xx_get_report_rate(azoteq_iqs5xx_report_rate_t *report_rate, azoteq_iqs5xx_charging_modes_t mode, bool end_session) {
     if (mode > AZOTEQ_IQS5XX_LP2) {
         pd_dprintf("IQS5XX - Invalid mode for get report rate.\n");
@@ -216,6 +262,11 @@ i2c_status_t azoteq_iqs5xx_set_gesture_config(bool end_session) {
         config.scroll_initial_distance               = AZOTEQ_IQS5XX_SWAP_H_L_BYTES(AZOTEQ_IQS5XX_SCROLL_INITIAL_DISTANCE);
         config.zoom_initial_distance                 = AZOTEQ_IQS5XX_SWAP_H_L_BYTES(AZOTEQ_IQS5XX_ZOOM_INITIAL_DISTANCE);
         config.zoom_consecutive_distance             = AZOTEQ_IQS5XX_SWAP_H_L_BYTES(AZOTEQ_IQS5XX_ZOOM_CONSECUTIVE_DISTANCE);
+#ifdef POINTING_DEVICE_GESTURES_MULTI_TOUCH_ENABLE
+        // Scroll and zoom come from the gesture engine, which follows the fingers itself
+        config.multi_finger_gestures.scroll = false;
+        config.multi_finger_gestures.zoom   = false;
+#endif
         status                                       = i2c_write_register16(AZOTEQ_IQS5XX_ADDRESS, AZOTEQ_IQS5XX_REG_SINGLE_FINGER_GESTURES, (uint8_t *)&config, sizeof(azoteq_iqs5xx_gesture_config_t), AZOTEQ_IQS5XX_TIMEOUT_MS);
     }
     if (end_session) {
@@ -323,6 +374,9 @@ static i2c_status_t azoteq_iqs5xx_init_status = 1;
 
 void azoteq_iqs5xx_init(void) {
     i2c_init();
+#ifdef AZOTEQ_IQS5XX_RDY_PIN
+    gpio_set_pin_input(AZOTEQ_IQS5XX_RDY_PIN);
+#endif
     i2c_ping_address(AZOTEQ_IQS5XX_ADDRESS, 1); // wake
     azoteq_iqs5xx_reset_suspend(true, false, true);
     wait_ms(100);
@@ -355,55 +409,95 @@ report_mouse_t azoteq_iqs5xx_get_report(report_mouse_t mouse_report) {
     report_mouse_t temp_report = {0};
 
     if (azoteq_iqs5xx_init_status == I2C_STATUS_SUCCESS) {
-        azoteq_iqs5xx_base_data_t base_data       = {0};
-        i2c_status_t              status          = azoteq_iqs5xx_get_base_data(&base_data);
-        bool                      ignore_movement = false;
+#ifdef AZOTEQ_IQS5XX_RDY_PIN
+        // RDY stays high from when a report is ready until the session ends, so
+        // there's nothing to read while it's low and the bus is left alone
+        if (!gpio_read_pin(AZOTEQ_IQS5XX_RDY_PIN)) {
+            if (azoteq_iqs5xx_holding) {
+                temp_report.buttons = pointing_device_handle_buttons(temp_report.buttons, true, POINTING_DEVICE_BUTTON1);
+            }
+#    ifdef POINTING_DEVICE_GESTURES_MULTI_TOUCH_ENABLE
+            multi_touch_t gesture = multi_touch_check(&multi_touch);
+            temp_report.h         = gesture.h;
+            temp_report.v         = gesture.v;
+#    endif
+            return temp_report;
+        }
+#endif
+        azoteq_iqs5xx_touch_data_t touch_data      = {0};
+        azoteq_iqs5xx_base_data_t *base_data       = &touch_data.base;
+        bool                       ignore_movement = false;
+#ifdef POINTING_DEVICE_GESTURES_MULTI_TOUCH_ENABLE
+        i2c_status_t status = azoteq_iqs5xx_get_touch_data(&touch_data);
+#else
+        i2c_status_t status = azoteq_iqs5xx_get_base_data(base_data);
+#endif
 
         if (status == I2C_STATUS_SUCCESS) {
 #ifdef POINTING_DEVICE_DEBUG
-            if (base_data.previous_cycle_time > AZOTEQ_IQS5XX_REPORT_RATE) {
-                pd_dprintf("IQS5XX - previous cycle time missed, took: %dms\n", base_data.previous_cycle_time);
+            if (base_data->previous_cycle_time > AZOTEQ_IQS5XX_REPORT_RATE) {
+                pd_dprintf("IQS5XX - previous cycle time missed, took: %dms\n", base_data->previous_cycle_time);
             }
 #endif
-            if (base_data.gesture_events_0.single_tap || base_data.gesture_events_0.press_and_hold) {
+            if (base_data->gesture_events_0.single_tap || base_data->gesture_events_0.press_and_hold) {
                 pd_dprintf("IQS5XX - Single tap/hold.\n");
                 temp_report.buttons = pointing_device_handle_buttons(temp_report.buttons, true, POINTING_DEVICE_BUTTON1);
-            } else if (base_data.gesture_events_1.two_finger_tap) {
+            } else if (base_data->gesture_events_1.two_finger_tap) {
                 pd_dprintf("IQS5XX - Two finger tap.\n");
                 temp_report.buttons = pointing_device_handle_buttons(temp_report.buttons, true, POINTING_DEVICE_BUTTON2);
-            } else if (base_data.gesture_events_0.swipe_x_neg) {
+            } else if (base_data->gesture_events_0.swipe_x_neg) {
                 pd_dprintf("IQS5XX - X-.\n");
                 temp_report.buttons = pointing_device_handle_buttons(temp_report.buttons, true, POINTING_DEVICE_BUTTON4);
                 ignore_movement     = true;
-            } else if (base_data.gesture_events_0.swipe_x_pos) {
+            } else if (base_data->gesture_events_0.swipe_x_pos) {
                 pd_dprintf("IQS5XX - X+.\n");
                 temp_report.buttons = pointing_device_handle_buttons(temp_report.buttons, true, POINTING_DEVICE_BUTTON5);
                 ignore_movement     = true;
-            } else if (base_data.gesture_events_0.swipe_y_neg) {
+            } else if (base_data->gesture_events_0.swipe_y_neg) {
                 pd_dprintf("IQS5XX - Y-.\n");
                 temp_report.buttons = pointing_device_handle_buttons(temp_report.buttons, true, POINTING_DEVICE_BUTTON6);
                 ignore_movement     = true;
-            } else if (base_data.gesture_events_0.swipe_y_pos) {
+            } else if (base_data->gesture_events_0.swipe_y_pos) {
                 pd_dprintf("IQS5XX - Y+.\n");
                 temp_report.buttons = pointing_device_handle_buttons(temp_report.buttons, true, POINTING_DEVICE_BUTTON3);
                 ignore_movement     = true;
-            } else if (base_data.gesture_events_1.zoom) {
-                if (AZOTEQ_IQS5XX_COMBINE_H_L_BYTES(base_data.x.h, base_data.x.l) < 0) {
+            } else if (base_data->gesture_events_1.zoom) {
+                if (AZOTEQ_IQS5XX_COMBINE_H_L_BYTES(base_data->x.h, base_data->x.l) < 0) {
                     pd_dprintf("IQS5XX - Zoom out.\n");
                     temp_report.buttons = pointing_device_handle_buttons(temp_report.buttons, true, POINTING_DEVICE_BUTTON7);
-                } else if (AZOTEQ_IQS5XX_COMBINE_H_L_BYTES(base_data.x.h, base_data.x.l) > 0) {
+                } else if (AZOTEQ_IQS5XX_COMBINE_H_L_BYTES(base_data->x.h, base_data->x.l) > 0) {
                     pd_dprintf("IQS5XX - Zoom in.\n");
                     temp_report.buttons = pointing_device_handle_buttons(temp_report.buttons, true, POINTING_DEVICE_BUTTON8);
                 }
-            } else if (base_data.gesture_events_1.scroll) {
+            } else if (base_data->gesture_events_1.scroll) {
                 pd_dprintf("IQS5XX - Scroll.\n");
-                temp_report.h = CONSTRAIN_HID(AZOTEQ_IQS5XX_COMBINE_H_L_BYTES(base_data.x.h, base_data.x.l));
-                temp_report.v = CONSTRAIN_HID(AZOTEQ_IQS5XX_COMBINE_H_L_BYTES(base_data.y.h, base_data.y.l));
+                temp_report.h = CONSTRAIN_HID(AZOTEQ_IQS5XX_COMBINE_H_L_BYTES(base_data->x.h, base_data->x.l));
+                temp_report.v = CONSTRAIN_HID(AZOTEQ_IQS5XX_COMBINE_H_L_BYTES(base_data->y.h, base_data->y.l));
+            }
+            if (base_data->number_of_fingers == 1 && !ignore_movement) {
+                temp_report.x = CONSTRAIN_HID_XY(AZOTEQ_IQS5XX_COMBINE_H_L_BYTES(base_data->x.h, base_data->x.l));
+                temp_report.y = CONSTRAIN_HID_XY(AZOTEQ_IQS5XX_COMBINE_H_L_BYTES(base_data->y.h, base_data->y.l));
             }
-            if (base_data.number_of_fingers == 1 && !ignore_movement) {
-                temp_report.x = CONSTRAIN_HID_XY(AZOTEQ_IQS5XX_COMBINE_H_L_BYTES(base_data.x.h, base_data.x.l));
-                temp_report.y = CONSTRAIN_HID_XY(AZOTEQ_IQS5XX_COMBINE_H_L_BYTES(base_data.y.h, base_data.y.l));
+#ifdef AZOTEQ_IQS5XX_RDY_PIN
+            azoteq_iqs5xx_holding = base_data->gesture_events_0.press_and_hold;
+#endif
+#ifdef POINTING_DEVICE_GESTURES_MULTI_TOUCH_ENABLE
+            multi_touch_point_t points[2];
+            for (uint8_t i = 0; i < 2; i++) {
+                points[i].x = (uint16_t)AZOTEQ_IQS5XX_COMBINE_H_L_BYTES(touch_data.fingers[i].x.h, touch_data.fingers[i].x.l);
+                points[i].y = (uint16_t)AZOTEQ_IQS5XX_COMBINE_H_L_BYTES(touch_data.fingers[i].y.h, touch_data.fingers[i].y.l);
+            }
+            multi_touch_t gesture = multi_touch_update(&multi_touch, points, base_data->number_of_fingers);
+            temp_report.h         = gesture.h;
+            temp_report.v         = gesture.v;
+            if (gesture.zoom < 0) {
+                pd_dprintf("IQS5XX - Pinch zoom out.\n");
+                temp_report.buttons = pointing_device_handle_buttons(temp_report.buttons, true, POINTING_DEVICE_BUTTON7);
+            } else if (gesture.zoom > 0) {
+                pd_dprintf("IQS5XX - Pinch zoom in.\n");
+                temp_report.buttons = pointing_device_handle_buttons(temp_report.buttons, true, POINTING_DEVICE_BUTTON8);
             }
+#endif
 
         } else {
             pd_dprintf("IQS5XX - get report failed, i2c status: %d \n", status);
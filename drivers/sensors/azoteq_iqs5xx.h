@@ -81,6 +81,29 @@ typedef struct {
 
 _Static_assert(sizeof(azoteq_iqs5xx_base_data_t) == 10, "azoteq_iqs5xx_basic_report_t should be 10 bytes");
 
+typedef struct {
+    uint8_t h : 8;
+    uint8_t l : 8;
+} azoteq_iqs5xx_absolute_xy_t;
+
+typedef struct {
+    azoteq_iqs5xx_absolute_xy_t x;
+    azoteq_iqs5xx_absolute_xy_t y;
+    uint8_t                     touch_strength_h;
+    uint8_t                     touch_strength_l;
+    uint8_t                     area;
+} azoteq_iqs5xx_finger_t;
+
+_Static_assert(sizeof(azoteq_iqs5xx_finger_t) == 7, "azoteq_iqs5xx_finger_t should be 7 bytes");
+
+// The base data followed by the first two fingers, which the registers hold straight after it
+typedef struct {
+    azoteq_iqs5xx_base_data_t base;
+    azoteq_iqs5xx_finger_t    fingers[2];
+} azoteq_iqs5xx_touch_data_t;
+
+_Static_assert(sizeof(azoteq_iqs5xx_touch_data_t) == 24, "azoteq_iqs5xx_touch_data_t should be 24 bytes");
+
 typedef struct {
     uint8_t                     number_of_fingers;
     azoteq_iqs5xx_relative_xy_t x;
@@ -172,7 +195,7 @@ typedef struct {
 #ifndef AZOTEQ_IQS5XX_REPORT_RATE
 #    define AZOTEQ_IQS5XX_REPORT_RATE 10
 #endif
-#if !defined(POINTING_DEVICE_TASK_THROTTLE_MS) && !defined(POINTING_DEVICE_MOTION_PIN)
+#if !defined(POINTING_DEVICE_TASK_THROTTLE_MS) && !defined(POINTING_DEVICE_MOTION_PIN) && !defined(AZOTEQ_IQS5XX_RDY_PIN)
 // Polling the Azoteq isn't recommended, ensuring we only poll after the report is ready stops any unexpected NACKs
 #    define POINTING_DEVICE_TASK_THROTTLE_MS AZOTEQ_IQS5XX_REPORT_RATE + 1
 #endif
@@ -190,6 +213,7 @@ i2c_status_t   azoteq_iqs5xx_set_gesture_config(bool end_session);
 i2c_status_t   azoteq_iqs5xx_set_xy_config(bool flip_x, bool flip_y, bool switch_xy, bool palm_reject, bool end_session);
 i2c_status_t   azoteq_iqs5xx_reset_suspend(bool reset, bool suspend, bool end_session);
 i2c_status_t   azoteq_iqs5xx_get_base_data(azoteq_iqs5xx_base_data_t *base_data);
+i2c_status_t   azoteq_iqs5xx_get_touch_data(azoteq_iqs5xx_touch_data_t *touch_data);
 void           azoteq_iqs5xx_set_cpi(uint16_t cpi);
 uint16_t       azoteq_iqs5xx_get_cpi(void);
 uint16_t       azoteq_iqs5xx_get_product(void);
@@ -21,6 +21,8 @@
 bool     touchpad_init;
 uint16_t scale_data = CIRQUE_PINNACLE_DEFAULT_SCALE;
 
+static uint16_t read_time_us;
+
 void cirque_pinnacle_clear_flags(void);
 void cirque_pinnacle_enable_feed(bool feedEnable);
 void RAP_ReadBytes(uint8_t address, uint8_t* data, uint8_t count);
@@ -66,21 +68,36 @@ void cirque_pinnacle_scale_data(pinnacle_data_t* coordinates, uint16_t xResoluti
     xTemp -= CIRQUE_PINNACLE_X_LOWER;
     yTemp -= CIRQUE_PINNACLE_Y_LOWER;
 
+    // The resolution only changes with the scale, so the division by the range is
+    // done then, leaving a multiply and a shift for each report. Rounding may put a
+    // position a count short, but each position maps to the same place every time,
+    // so the motion between them adds up the same.
+    static uint16_t xLastResolution, yLastResolution;
+    static uint32_t xFactor, yFactor;
+    if (xResolution != xLastResolution) {
+        xLastResolution = xResolution;
+        xFactor         = ((uint32_t)xResolution << 16) / CIRQUE_PINNACLE_X_RANGE;
+    }
+    if (yResolution != yLastResolution) {
+        yLastResolution = yResolution;
+        yFactor         = ((uint32_t)yResolution << 16) / CIRQUE_PINNACLE_Y_RANGE;
+    }
+
     // scale coordinates to (xResolution, yResolution) range
-    coordinates->xValue = (uint16_t)(xTemp * xResolution / CIRQUE_PINNACLE_X_RANGE);
-    coordinates->yValue = (uint16_t)(yTemp * yResolution / CIRQUE_PINNACLE_Y_RANGE);
+    coordinates->xValue = (uint16_t)((xTemp * xFactor) >> 16);
+    coordinates->yValue = (uint16_t)((yTemp * yFactor) >> 16);
 #else
     int32_t        xTemp = 0, yTemp = 0;
-    ldiv_t         temp;
     static int32_t xRemainder, yRemainder;
 
-    temp       = ldiv(((int32_t)coordinates->xDelta) * (int32_t)xResolution + xRemainder, (int32_t)CIRQUE_PINNACLE_X_RANGE);
-    xTemp      = temp.quot;
-    xRemainder = temp.rem;
+    // The range is 256 in relative mode, so these divisions are shifts
+    xTemp      = ((int32_t)coordinates->xDelta) * (int32_t)xResolution + xRemainder;
+    xRemainder = xTemp % CIRQUE_PINNACLE_X_RANGE;
+    xTemp      = xTemp / CIRQUE_PINNACLE_X_RANGE;
 
-    temp       = ldiv(((int32_t)coordinates->yDelta) * (int32_t)yResolution + yRemainder, (int32_t)CIRQUE_PINNACLE_Y_RANGE);
-    yTemp      = temp.quot;
-    yRemainder = temp.rem;
+    yTemp      = ((int32_t)coordinates->yDelta) * (int32_t)yResolution + yRemainder;
+    yRemainder = yTemp % CIRQUE_PINNACLE_Y_RANGE;
+    yTemp      = yTemp / CIRQUE_PINNACLE_Y_RANGE;
 
     coordinates->xDelta = (int16_t)xTemp;
     coordinates->yDelta = (int16_t)yTemp;
@@ -295,24 +312,40 @@ void cirque_pinnacle_init(void) {
 #endif
 }
 
+// Time spent on the bus by the last read, in microseconds
+uint16_t cirque_pinnacle_get_read_time_us(void) {
+    return read_time_us;
+}
+
 pinnacle_data_t cirque_pinnacle_read_data(void) {
-    uint8_t         data_ready = 0;
-    uint8_t         data[6]    = {0};
-    pinnacle_data_t result     = {0};
+    uint8_t         data[CIRQUE_PINNACLE_PACKET_LENGTH] = {0};
+    pinnacle_data_t result                              = {0};
+    uint32_t        read_timer                          = timer_read_us();
+
+    // With the DR pin as the motion pin, the sensor is only read once it has
+    // signalled data, so there is no need to poll the status register first
+#ifndef POINTING_DEVICE_MOTION_PIN
+    uint8_t data_ready = 0;
 
     // Check if there is valid data available
     RAP_ReadBytes(HOSTREG__STATUS1, &data_ready, 1);
     if ((data_ready & HOSTREG__STATUS1__DATA_READY) == 0) {
         // no data available yet
+        read_time_us = timer_elapsed_us(read_timer);
         result.valid = false; // be explicit
         return result;
     }
+#endif
 
     // Read all data bytes
-    RAP_ReadBytes(HOSTREG__PACKETBYTE_0, data, 6);
+    RAP_ReadBytes(HOSTREG__PACKETBYTE_0, data, CIRQUE_PINNACLE_PACKET_LENGTH);
 
-    // Get ready for the next data sample
-    cirque_pinnacle_clear_flags();
+    // Get ready for the next data sample. The next one is a sample period away, so
+    // unlike the command path this doesn't wait for the flags to settle
+    RAP_Write(HOSTREG__STATUS1, HOSTREG__STATUS1_DEFVAL & ~(HOSTREG__STATUS1__COMMAND_COMPLETE | HOSTREG__STATUS1__DATA_READY));
+
+    read_time_us = timer_elapsed_us(read_timer);
+    pd_dprintf("cirque_pinnacle read took %uus\n", read_time_us);
 
 #if CIRQUE_PINNACLE_POSITION_MODE
     // Decode data for absolute mode
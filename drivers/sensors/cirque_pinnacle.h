@@ -89,6 +89,9 @@
 #    endif
 #endif
 
+// Registers read for each report, from PACKETBYTE_0
+#define CIRQUE_PINNACLE_PACKET_LENGTH 6
+
 #define DIVIDE_UNSIGNED_ROUND(numerator, denominator) (((numerator) + ((denominator) / 2)) / (denominator))
 #define CIRQUE_PINNACLE_INCH_TO_PX(inch) (DIVIDE_UNSIGNED_ROUND((inch) * (uint32_t)CIRQUE_PINNACLE_DIAMETER_MM * 10, 254))
 #define CIRQUE_PINNACLE_PX_TO_INCH(px) (DIVIDE_UNSIGNED_ROUND((px) * (uint32_t)254, CIRQUE_PINNACLE_DIAMETER_MM * 10))
@@ -124,3 +127,4 @@ void            cirque_pinnacle_set_scale(uint16_t scale);
 uint16_t        cirque_pinnacle_get_cpi(void);
 void            cirque_pinnacle_set_cpi(uint16_t cpi);
 report_mouse_t  cirque_pinnacle_get_report(report_mouse_t mouse_report);
+uint16_t        cirque_pinnacle_get_read_time_us(void);
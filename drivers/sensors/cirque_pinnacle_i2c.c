@@ -14,7 +14,7 @@ extern bool touchpad_init;
 void RAP_ReadBytes(uint8_t address, uint8_t* data, uint8_t count) {
     uint8_t cmdByte = READ_MASK | address; // Form the READ command byte
     if (touchpad_init) {
-        i2c_write_register(CIRQUE_PINNACLE_ADDR << 1, cmdByte, NULL, 0, CIRQUE_PINNACLE_TIMEOUT);
+        // Sends the command and reads the registers back in one transaction, with a repeated start
         if (i2c_read_register(CIRQUE_PINNACLE_ADDR << 1, cmdByte, data, count, CIRQUE_PINNACLE_TIMEOUT) != I2C_STATUS_SUCCESS) {
             pd_dprintf("error cirque_pinnacle i2c_read_register\n");
             touchpad_init = false;
@@ -1,31 +1,46 @@
 // Copyright (c) 2018 Cirque Corp. Restrictions apply. See: www.cirque.com/sw-license
 #include "cirque_pinnacle.h"
 #include "spi_master.h"
+#include "util.h"
+#include <string.h>
 
 // Masks for Cirque Register Access Protocol (RAP)
 #define WRITE_MASK 0x80
 #define READ_MASK 0xA0
 #define FILLER_BYTE 0xFC
+// Command byte and the two fillers sent before the first register is clocked out
+#define RAP_HEADER_LENGTH 3
 
 extern bool touchpad_init;
 
 /*  RAP Functions */
 // Reads <count> Pinnacle registers starting at <address>
+// The command, the fillers and the data are clocked in a single transfer, which
+// ChibiOS hands to DMA, rather than a byte at a time
 void RAP_ReadBytes(uint8_t address, uint8_t* data, uint8_t count) {
-    uint8_t cmdByte = READ_MASK | address; // Form the READ command byte
-    if (touchpad_init) {
+    uint8_t tx[RAP_HEADER_LENGTH + CIRQUE_PINNACLE_PACKET_LENGTH];
+    uint8_t rx[sizeof(tx)];
+
+    memset(tx, FILLER_BYTE, sizeof(tx)); // write filler, receive data on the third filler send
+    while (count > 0 && touchpad_init) {
+        uint8_t length = MIN(count, CIRQUE_PINNACLE_PACKET_LENGTH);
+        tx[0]          = READ_MASK | address; // Form the READ command byte
         if (spi_start(CIRQUE_PINNACLE_SPI_CS_PIN, CIRQUE_PINNACLE_SPI_LSBFIRST, CIRQUE_PINNACLE_SPI_MODE, CIRQUE_PINNACLE_SPI_DIVISOR)) {
-            spi_write(cmdByte);     // write command byte, receive filler
-            spi_write(FILLER_BYTE); // write & receive filler
-            spi_write(FILLER_BYTE); // write & receive filler
-            for (uint8_t i = 0; i < count; i++) {
-                data[i] = spi_write(FILLER_BYTE); // write filler, receive data on the third filler send
+            if (spi_exchange(tx, rx, RAP_HEADER_LENGTH + length) == SPI_STATUS_SUCCESS) {
+                memcpy(data, rx + RAP_HEADER_LENGTH, length);
+            } else {
+                pd_dprintf("error cirque_pinnacle spi_exchange read\n");
+                touchpad_init = false;
             }
         } else {
             pd_dprintf("error cirque_pinnacle spi_start read\n");
             touchpad_init = false;
         }
         spi_stop();
+        // Registers auto-increment, so a longer read carries on where this one stopped
+        address += length;
+        data += length;
+        count -= length;
     }
 }
 
@@ -251,11 +251,42 @@ uint16_t pmw33xx_get_cpi_wrapper(void) {
 report_mouse_t pmw33xx_get_report(report_mouse_t mouse_report) {
     pmw33xx_report_t report    = pmw33xx_read_burst(0);
     static bool      in_motion = false;
+#ifdef POINTING_DEVICE_MOTION_INTERRUPT
+    // Counts that didn't fit in the last report, sent with the next one rather than dropped. The
+    // pointing device task reads again straight away after a clamped report, so none are left behind
+    static int32_t pending_x = 0;
+    static int32_t pending_y = 0;
+#endif
 
     if (report.motion.b.is_lifted) {
+#ifdef POINTING_DEVICE_MOTION_INTERRUPT
+        pending_x = 0;
+        pending_y = 0;
+#endif
         return mouse_report;
     }
 
+#ifdef POINTING_DEVICE_MOTION_INTERRUPT
+    if (!report.motion.b.is_motion) {
+        in_motion = false;
+    } else {
+        if (!in_motion) {
+            in_motion = true;
+            pd_dprintf("PWM3360 (0): starting motion\n");
+        }
+        pending_x += report.delta_x;
+        pending_y += report.delta_y;
+    }
+
+    if (pending_x == 0 && pending_y == 0) {
+        return mouse_report;
+    }
+
+    mouse_report.x = CONSTRAIN_HID_XY(pending_x);
+    mouse_report.y = CONSTRAIN_HID_XY(pending_y);
+    pending_x -= mouse_report.x;
+    pending_y -= mouse_report.y;
+#else
     if (!report.motion.b.is_motion) {
         in_motion = false;
         return mouse_report;
@@ -268,5 +299,6 @@ report_mouse_t pmw33xx_get_report(report_mouse_t mouse_report) {
 
     mouse_report.x = CONSTRAIN_HID_XY(report.delta_x);
     mouse_report.y = CONSTRAIN_HID_XY(report.delta_y);
+#endif
     return mouse_report;
 }
@@ -103,6 +103,17 @@ spi_status_t spi_transmit(const uint8_t *data, uint16_t length);
  */
 spi_status_t spi_receive(uint8_t *data, uint16_t length);
 
+/**
+ * \brief Send and receive multiple bytes at once with the selected SPI device.
+ *
+ * \param tx_data A pointer to the data to write from.
+ * \param rx_data A pointer to a buffer to read into. It must not overlap `tx_data`.
+ * \param length The number of bytes to write and read. Take care not to overrun the length of either buffer.
+ *
+ * \return `SPI_STATUS_TIMEOUT` if the timeout period elapses, `SPI_STATUS_ERROR` if some other error occurs, otherwise `SPI_STATUS_SUCCESS`.
+ */
+spi_status_t spi_exchange(const uint8_t *tx_data, uint8_t *rx_data, uint16_t length);
+
 /**
  * \brief End the current SPI transaction. This will deassert the slave select pin and reset the endianness, mode and divisor configured by `spi_start()`.
  *
@@ -0,0 +1,245 @@
+# Copyright 2025 QMK
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+# Host side of binary structured logging, see quantum/logging/binlog.h.
+# Builds the dictionary of format strings from the sources a firmware was built from, and decodes the messages
+# the keyboard sends over the console back into text.
+
+import codecs
+import json
+import re
+from pathlib import Path
+
+FRAME_MARKER = 0xF8
+MAX_ARGS = 7
+HASH_LENGTH = 64
+
+FNV_OFFSET = 2166136261
+FNV_PRIME = 16777619
+
+DICTIONARY_VERSION = 1
+
+# A binlog() or dbinlog() call, followed by one or more adjacent string literals
+CALL_PATTERN = re.compile(r'\bd?binlog\s*\(\s*((?:"(?:\\.|[^"\\\n])*"\s*)+)')
+LITERAL_PATTERN = re.compile(r'"((?:\\.|[^"\\\n])*)"')
+COMMENT_PATTERN = re.compile(r'//[^\n]*|/\*.*?\*/|\'(?:\\.|[^\\\'\n])*\'|"(?:\\.|[^\\"\n])*"', re.DOTALL)
+ESCAPE_PATTERN = re.compile(r'\\(x[0-9a-fA-F]+|[0-7]{1,3}|.)', re.DOTALL)
+CONVERSION_PATTERN = re.compile(r'%([-+ #0]*)(\d*)(?:\.(\d+))?(?:hh|h|ll|l|z)?([diuxXcbsp%])')
+
+SIMPLE_ESCAPES = {'n': 10, 't': 9, 'r': 13, 'a': 7, 'b': 8, 'f': 12, 'v': 11, 'e': 27, '\\': 92, '"': 34, "'": 39, '?': 63}
+
+
+class BinlogError(Exception):
+    """Raised when the dictionary can't be built, e.g. two format strings share an id.
+    """
+
+
+def format_id(fmt):
+    """The id of a format string, as calculated by `BINLOG_ID()` at compile time.
+    """
+    if isinstance(fmt, str):
+        fmt = fmt.encode('utf-8')
+
+    h = FNV_OFFSET
+    for c in fmt[:HASH_LENGTH]:
+        h = ((h ^ c) * FNV_PRIME) & 0xFFFFFFFF
+    return ((h ^ (len(fmt) & 0xFFFFFFFF)) * FNV_PRIME) & 0xFFFFFFFF
+
+
+def parse_c_string(literals):
+    """Returns the bytes of one or more adjacent C string literals, as the compiler would see them.
+    """
+    def _escape(match):
+        escape = match.group(1)
+        if escape[0] == 'x':
+            return bytes([int(escape[1:], 16) & 0xFF])
+        if escape[0] in '01234567':
+            return bytes([int(escape, 8) & 0xFF])
+        if escape in SIMPLE_ESCAPES:
+            return bytes([SIMPLE_ESCAPES[escape]])
+        return escape.encode('utf-8')
+
+    result = b''
+    for literal in LITERAL_PATTERN.findall(literals):
+        pos = 0
+        for match in ESCAPE_PATTERN.finditer(literal):
+            result += literal[pos:match.start()].encode('utf-8') + _escape(match)
+            pos = match.end()
+        result += literal[pos:].encode('utf-8')
+    return result
+
+
+def _strip_comments(text):
+    """Blanks out comments, keeping line numbers intact.
+    """
+    def _blank(match):
+        s = match.group(0)
+        return '\n' * s.count('\n') if s.startswith('/') else s
+
+    return COMMENT_PATTERN.sub(_blank, text)
+
+
+def find_formats(text):
+    """Returns the format string and line number of every binlog() call in C source text.
+    """
+    text = _strip_comments(text)
+    return [(parse_c_string(match.group(1)), text.count('\n', 0, match.start()) + 1) for match in CALL_PATTERN.finditer(text)]
+
+
+def dependency_sources(text):
+    """Returns the files listed in a make dependency file, as generated by `gcc -MMD -MP`.
+    """
+    sources = []
+    for line in text.replace('\\\n', ' ').splitlines():
+        if ':' not in line:
+            continue
+        _, deps = line.split(':', 1)
+        sources.extend(deps.split())
+    return sources
+
+
+def build_dictionary(paths):
+    """Builds the dictionary of format strings from C sources and headers, or dependency files listing them.
+    """
+    sources = []
+    for path in map(Path, paths):
+        if path.suffix == '.d':
+            sources.extend(Path(source) for source in dependency_sources(path.read_text(encoding='utf-8')))
+        else:
+            sources.append(path)
+
+    messages = {}
+    for source in sorted(set(sources)):
+        if not source.exists():
+            continue
+        for fmt, line in find_formats(source.read_text(encoding='utf-8', errors='replace')):
+            message_id = format_id(fmt)
+            text = fmt.decode('utf-8', errors='replace')
+            if message_id in messages:
+                if messages[message_id]['format'] != text:
+                    raise BinlogError(f'"{text}" ({source}:{line}) has the same id as "{messages[message_id]["format"]}" ({messages[message_id]["file"]}:{messages[message_id]["line"]}), reword one of them')
+                continue
+            messages[message_id] = {'format': text, 'file': str(source), 'line': line}
+
+    return messages
+
+
+def dump_dictionary(messages):
+    """Serialises a dictionary to JSON.
+    """
+    return json.dumps({'version': DICTIONARY_VERSION, 'messages': {f'0x{message_id:08X}': message for message_id, message in sorted(messages.items())}}, indent=4)
+
+
+def load_dictionary(text):
+    """Parses a dictionary serialised with `dump_dictionary()`.
+    """
+    data = json.loads(text)
+    if data.get('version') != DICTIONARY_VERSION:
+        raise BinlogError(f'Unsupported dictionary version {data.get("version")}')
+    return {int(message_id, 16): message for message_id, message in data['messages'].items()}
+
+
+def encode(message_id, args=()):
+    """Encodes a message the way `binlog_write()` sends it.
+    """
+    args = list(args)[:MAX_ARGS]
+    frame = bytearray([FRAME_MARKER | len(args)])
+    frame += message_id.to_bytes(4, 'little')
+    for arg in args:
+        value = arg & 0xFFFFFFFF
+        while value >= 0x80:
+            frame.append((value & 0x7F) | 0x80)
+            value >>= 7
+        frame.append(value)
+    return bytes(frame)
+
+
+def format_message(fmt, args):
+    """Renders a format string with the 32 bit arguments of a message.
+    """
+    args = list(args)
+
+    def _convert(match):
+        flags, width, precision, conversion = match.groups()
+        if conversion == '%':
+            return '%'
+        if not args:
+            return match.group(0)
+
+        value = args.pop(0) & 0xFFFFFFFF
+        if conversion in 'di':
+            value = value - (1 << 32) if value & 0x80000000 else value
+            conversion = 'd'
+        elif conversion == 'c':
+            return chr(value & 0xFF)
+        elif conversion == 'b':
+            digits = format(value, 'b')
+            if precision:
+                digits = digits.rjust(int(precision), '0')
+            fill = '0' if '0' in flags and '-' not in flags else ' '
+            return digits.ljust(int(width or 0)) if '-' in flags else digits.rjust(int(width or 0), fill)
+        elif conversion in 'sp':
+            return f'<0x{value:X}>'
+        spec = '%' + flags + width + (('.' + precision) if precision else '') + conversion
+        return spec % value
+
+    return CONVERSION_PATTERN.sub(_convert, fmt)
+
+
+class Decoder:
+    """Turns a console stream mixing text and binlog messages back into text.
+    """
+    def __init__(self, messages):
+        self.messages = messages
+        self.pending = bytearray()
+        self.text = codecs.getincrementaldecoder('utf-8')(errors='replace')
+
+    def _frame(self):
+        """Parses the frame at the start of `pending`, returning its length and text, or None if it is incomplete.
+        """
+        count = self.pending[0] - FRAME_MARKER
+        if len(self.pending) < 5:
+            return None
+
+        message_id = int.from_bytes(self.pending[1:5], 'little')
+        pos = 5
+        args = []
+        for _ in range(count):
+            value = 0
+            shift = 0
+            while True:
+                if pos >= len(self.pending):
+                    return None
+                byte = self.pending[pos]
+                pos += 1
+                value |= (byte & 0x7F) << shift
+                shift += 7
+                if not byte & 0x80 or shift >= 35:
+                    break
+            args.append(value & 0xFFFFFFFF)
+
+        if message_id in self.messages:
+            return pos, format_message(self.messages[message_id]['format'], args)
+        return pos, f'<binlog 0x{message_id:08X}{"".join(f" {arg}" for arg in args)}>\n'
+
+    def feed(self, data):
+        """Decodes the next chunk of the stream, returning the text it completes.
+        """
+        self.pending += data
+        output = ''
+        while self.pending:
+            byte = self.pending[0]
+            if byte >= FRAME_MARKER:
+                frame = self._frame()
+                if frame is None:
+                    break
+                length, text = frame
+                output += self.text.decode(b'', final=True) + text
+                del self.pending[:length]
+                continue
+
+            # Plain text, up to the next frame. Console packets are padded with zeros.
+            end = next((i for i, b in enumerate(self.pending) if b >= FRAME_MARKER), len(self.pending))
+            output += self.text.decode(bytes(b for b in self.pending[:end] if b != 0))
+            del self.pending[:end]
+        return output
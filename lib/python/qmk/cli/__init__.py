@@ -32,6 +32,7 @@ safe_commands = [
 
 subcommands = [
     'qmk.cli.ci.validate_aliases',
+    'qmk.cli.binlog_console',
     'qmk.cli.bux',
     'qmk.cli.c2json',
     'qmk.cli.cd',
@@ -48,6 +49,7 @@ subcommands = [
     'qmk.cli.format.text',
     'qmk.cli.generate.api',
     'qmk.cli.generate.autocorrect_data',
+    'qmk.cli.generate.binlog_dictionary',
     'qmk.cli.generate.compilation_database',
     'qmk.cli.generate.community_modules',
     'qmk.cli.generate.config_h',
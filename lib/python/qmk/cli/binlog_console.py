@@ -0,0 +1,58 @@
+"""Prints the console output of a keyboard using binary structured logging.
+"""
+import sys
+from pathlib import Path
+
+from milc import cli
+
+from qmk.binlog import BinlogError, Decoder, load_dictionary
+
+CONSOLE_USAGE_PAGE = 0xFF31
+CONSOLE_USAGE = 0x0074
+
+
+def _console_devices():
+    import hid
+
+    return [device for device in hid.enumerate() if device['usage_page'] == CONSOLE_USAGE_PAGE and device['usage'] == CONSOLE_USAGE]
+
+
+@cli.argument('-d', '--dictionary', arg_only=True, type=Path, required=True, help='The dictionary generated when the firmware was built, e.g. .build/<target>.binlog.json')
+@cli.argument('-i', '--input', arg_only=True, type=Path, help='Decode a captured console stream instead of reading from a keyboard, - for stdin')
+@cli.subcommand('Prints the console output of a keyboard built with BINLOG_ENABLE.')
+def binlog_console(cli):
+    """Reads the console of the first keyboard found, or a captured stream, and decodes binlog() messages using the dictionary.
+    """
+    try:
+        decoder = Decoder(load_dictionary(cli.args.dictionary.read_text(encoding='utf-8')))
+    except (OSError, ValueError, BinlogError) as e:
+        cli.log.error(f'Could not read {cli.args.dictionary}: {e}')
+        return False
+
+    if cli.args.input:
+        stream = sys.stdin.buffer if str(cli.args.input) == '-' else cli.args.input.open('rb')
+        with stream:
+            while True:
+                data = stream.read(4096)
+                if not data:
+                    break
+                sys.stdout.write(decoder.feed(data))
+        return True
+
+    devices = _console_devices()
+    if not devices:
+        cli.log.error('No keyboard with a console was found.')
+        return False
+
+    import hid
+
+    device = devices[0]
+    cli.log.info(f'Listening to {device["manufacturer_string"]} {device["product_string"]} ({device["vendor_id"]:04X}:{device["product_id"]:04X})')
+    with hid.Device(path=device['path']) as console:
+        try:
+            while True:
+                sys.stdout.write(decoder.feed(console.read(64, 1000)))
+                sys.stdout.flush()
+        except KeyboardInterrupt:
+            pass
+    return True
@@ -0,0 +1,23 @@
+"""Used by the make system to generate the dictionary of binlog() format strings.
+"""
+from milc import cli
+
+from qmk.binlog import BinlogError, build_dictionary, dump_dictionary
+from qmk.commands import dump_lines
+from qmk.path import normpath
+
+
+@cli.argument('-o', '--output', arg_only=True, type=normpath, help='File to write to')
+@cli.argument('-q', '--quiet', arg_only=True, action='store_true', help="Quiet mode, only output error messages")
+@cli.argument('sources', nargs='+', arg_only=True, type=normpath, help='C sources and headers, or the dependency files generated when compiling them')
+@cli.subcommand('Used by the make system to generate the dictionary of binlog() format strings', hidden=True)
+def generate_binlog_dictionary(cli):
+    """Generates the binlog dictionary for the sources a firmware was built from.
+    """
+    try:
+        messages = build_dictionary(cli.args.sources)
+    except BinlogError as e:
+        cli.log.error(str(e))
+        return False
+
+    dump_lines(cli.args.output, [dump_dictionary(messages)], cli.args.quiet)
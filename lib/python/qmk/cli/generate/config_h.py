@@ -9,6 +9,7 @@ from milc import cli
 from qmk.info import info_json
 from qmk.json_schema import json_load
 from qmk.keyboard import keyboard_completer, keyboard_folder
+from qmk.matrix_ports import group_pins
 from qmk.commands import dump_lines, parse_configurator_json
 from qmk.path import normpath, FileType
 from qmk.constants import GPL2_HEADER_C_LIKE, GENERATED_HEADER_C_LIKE
@@ -47,6 +48,37 @@ def pin_array(define, pins, postfix):
     return generate_define(f'{define}_PINS{postfix}', f'{{ {pin_array} }}')
 
 
+def col_port_reads(cols):
+    """Return the config.h lines that let quantum/matrix.c sample the column pins a port at a time.
+
+    They are only defined alongside the generated MATRIX_COL_PINS, as they would be wrong for any other pins.
+    quantum/matrix.c only uses them when the keyboard or keymap sets MATRIX_COL_PORT_READ_ENABLE.
+    """
+    grouped = group_pins(cols)
+    if not grouped:
+        return ''
+
+    ports, shifts = grouped
+    pin_array = ', '.join(map(str, [pin or 'NO_PIN' for pin in cols]))
+    port_list = ' '.join(f'X({index}, {pin})' for index, pin in enumerate(ports))
+    shift_list = ' '.join(f'X({port}, 0x{mask:X}, {left}, {right})' for port, mask, left, right in shifts)
+    defines = [
+        ('MATRIX_COL_PINS', f'{{ {pin_array} }}'),
+        ('MATRIX_COL_PORT_COUNT', len(ports)),
+        ('MATRIX_COL_PORTS(X)', port_list),
+        ('MATRIX_COL_PORT_SHIFTS(X)', shift_list),
+    ]
+
+    if cli.args.filename:
+        return '\n' + '\n'.join(f'#undef {define.split("(")[0]}\n#define {define} {value}' for define, value in defines)
+
+    lines = '\n'.join(f'#    define {define} {value}' for define, value in defines)
+    return f"""
+#ifndef MATRIX_COL_PINS
+{lines}
+#endif // MATRIX_COL_PINS"""
+
+
 def matrix_pins(matrix_pins, postfix=''):
     """Add the matrix config to the config.h.
     """
@@ -56,7 +88,13 @@ def matrix_pins(matrix_pins, postfix=''):
         pins.append(direct_pins(matrix_pins['direct'], postfix))
 
     if 'cols' in matrix_pins:
-        pins.append(pin_array('MATRIX_COL', matrix_pins['cols'], postfix))
+        col_pins = '' if postfix else col_port_reads(matrix_pins['cols'])
+        if not col_pins:
+            col_pins = pin_array('MATRIX_COL', matrix_pins['cols'], postfix)
+            if not postfix and cli.args.filename:
+                # Drop the keyboard's port grouping, as it was worked out for other pins
+                col_pins = ''.join(f'\n#undef {define}' for define in ('MATRIX_COL_PORT_COUNT', 'MATRIX_COL_PORTS', 'MATRIX_COL_PORT_SHIFTS')) + col_pins
+        pins.append(col_pins)
 
     if 'rows' in matrix_pins:
         pins.append(pin_array('MATRIX_ROW', matrix_pins['rows'], postfix))
@@ -0,0 +1,68 @@
+# Copyright 2025 QMK
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+# Groups matrix pins by GPIO port, so that quantum/matrix.c can sample each port once per row
+# instead of reading every pin on its own. See `MATRIX_COL_PORTS` in quantum/matrix.c.
+
+import re
+
+# AVR and most ChibiOS MCUs name pins by port letter and bit, e.g. B7 or A15
+PORT_PIN = re.compile(r'^([A-Z])(\d+)$')
+
+# RP2040 has a single bank of GPIOs
+RP_PIN = re.compile(r'^GP(\d+)$')
+
+PORT_BITS = 32
+
+
+def pin_port(pin):
+    """Returns the port and bit within it for a pin name, or None if the pin's port is unknown.
+    """
+    match = PORT_PIN.match(pin)
+    if match:
+        port, bit = match.group(1), int(match.group(2))
+    else:
+        match = RP_PIN.match(pin)
+        if not match:
+            return None
+        port, bit = 'GP', int(match.group(1))
+
+    if bit >= PORT_BITS:
+        return None
+
+    return port, bit
+
+
+def group_pins(pins):
+    """Works out how to read a row of pins a port at a time.
+
+    Returns a list of `(pin, ...)` tuples, one per port, holding a pin that identifies the port,
+    and a list of `(port_index, mask, left_shift, right_shift)` tuples that move the masked bits
+    of each port sample to the bits of the row they belong to. Pins that are kept in order within
+    a port share one mask. Returns None if any pin's port can't be worked out.
+    """
+    ports = []
+    port_index = {}
+    runs = {}
+
+    for index, pin in enumerate(pins):
+        if not pin:
+            continue
+
+        port_bit = pin_port(pin)
+        if port_bit is None:
+            return None
+
+        port, bit = port_bit
+        if port not in port_index:
+            port_index[port] = len(ports)
+            ports.append(pin)
+
+        key = (port_index[port], index - bit)
+        runs[key] = runs.get(key, 0) | (1 << bit)
+
+    shifts = []
+    for (port, shift), mask in sorted(runs.items()):
+        shifts.append((port, mask, max(shift, 0), max(-shift, 0)))
+
+    return ports, shifts
@@ -0,0 +1,104 @@
+from qmk.binlog import BinlogError, Decoder, build_dictionary, dependency_sources, dump_dictionary, encode, find_formats, format_id, format_message, load_dictionary, parse_c_string
+
+SOURCE = r'''
+#include "binlog.h"
+
+// binlog("not a call");
+void matrix_scan_user(void) {
+    binlog("scan rate: %d\n", rate);
+    /* binlog("also not a call"); */
+    dbinlog("key %02X "
+            "at %u\n", keycode, timer_read());
+    binlog("hello");
+}
+'''
+
+HEADER = r'''
+static inline void log_layer(uint8_t layer) {
+    binlog("layer \"%c\" %08b\t%%\n", 'A' + layer, layer_state);
+}
+'''
+
+
+def test_format_id():
+    # The same ids are checked by platforms/test/binlog_tests.cpp
+    assert format_id('hello') == 0x059355EA
+    assert format_id('scan rate: %d\n') == 0x5C1B1F8D
+    assert format_id('key %02X %s') == 0xA883ADE2
+    assert format_id('') == 0x050C5D1F
+    assert format_id('x' * 64) == 0x7C2ABF5F
+    assert format_id('x' * 65) == 0x7B2ABDCC
+
+
+def test_encode():
+    assert encode(format_id('scan rate: %d\n'), [-1, 300]) == bytes([0xFA, 0x8D, 0x1F, 0x1B, 0x5C, 0xFF, 0xFF, 0xFF, 0xFF, 0x0F, 0xAC, 0x02])
+    assert encode(format_id('hello')) == bytes([0xF8, 0xEA, 0x55, 0x93, 0x05])
+
+
+def test_parse_c_string():
+    assert parse_c_string(r'"a\n" "b\x41\101\\\""') == b'a\nbAA\\"'
+
+
+def test_find_formats():
+    assert find_formats(SOURCE) == [(b'scan rate: %d\n', 6), (b'key %02X at %u\n', 8), (b'hello', 10)]
+
+
+def test_format_message():
+    assert format_message('%d %u %x %04X', [0xFFFFFFFE, 0xFFFFFFFE, 255, 10]) == '-2 4294967294 ff 000A'
+    assert format_message('%c%c %5d|%-3u|', [ord('o'), ord('k'), 42, 7]) == 'ok    42|7  |'
+    assert format_message('%08b %ld%%', [5, 3]) == '00000101 3%'
+
+
+def test_dependency_sources():
+    deps = '.build/obj/quantum/keyboard.o: quantum/keyboard.c \\\n quantum/keyboard.h quantum/logging/binlog.h\nquantum/keyboard.h:\nquantum/logging/binlog.h:\n'
+    assert dependency_sources(deps) == ['quantum/keyboard.c', 'quantum/keyboard.h', 'quantum/logging/binlog.h']
+
+
+def test_dictionary_roundtrip(tmp_path):
+    (tmp_path / 'keymap.c').write_text(SOURCE)
+    (tmp_path / 'layers.h').write_text(HEADER)
+    (tmp_path / 'keymap.d').write_text(f'keymap.o: {tmp_path / "keymap.c"} \\\n {tmp_path / "layers.h"}\n{tmp_path / "layers.h"}:\n')
+
+    messages = load_dictionary(dump_dictionary(build_dictionary([tmp_path / 'keymap.d'])))
+    assert sorted(message['format'] for message in messages.values()) == ['hello', 'key %02X at %u\n', 'layer "%c" %08b\t%%\n', 'scan rate: %d\n']
+
+    # Text mixed with messages, sent in 32 byte console packets. A partial packet is only padded with zeros between messages.
+    chunks = [
+        b'boot\n',
+        encode(format_id('scan rate: %d\n'), [1234]),
+        encode(format_id('key %02X at %u\n'), [4, 70000]),
+        'caf\u00e9\n'.encode('utf-8'),
+        encode(format_id('layer "%c" %08b\t%%\n'), [ord('B'), 2]),
+        encode(0x12345678, [1, 2]),
+        encode(format_id('hello')),
+    ]
+    packets = []
+    buffer = b''
+    for i, chunk in enumerate(chunks * 3):
+        buffer += chunk
+        while len(buffer) >= 32:
+            packets.append(buffer[:32])
+            buffer = buffer[32:]
+        if i % 4 == 3 and buffer:
+            packets.append(buffer.ljust(32, b'\0'))
+            buffer = b''
+    packets.append(buffer.ljust(32, b'\0'))
+
+    decoder = Decoder(messages)
+    output = ''.join(decoder.feed(packet) for packet in packets)
+    assert output == 'boot\nscan rate: 1234\nkey 04 at 70000\ncaf\u00e9\nlayer "B" 00000010\t%\n<binlog 0x12345678 1 2>\nhello' * 3
+
+
+def test_dictionary_collision(tmp_path):
+    (tmp_path / 'a.c').write_text('void a(void) { binlog("same"); }')
+    (tmp_path / 'b.c').write_text('void b(void) { binlog("same"); }')
+    assert len(build_dictionary([tmp_path / 'a.c', tmp_path / 'b.c'])) == 1
+
+    # Hashing stops after 64 characters, so only the length tells these apart
+    (tmp_path / 'c.c').write_text('void c(void) { binlog("' + 'x' * 64 + 'a' + '"); binlog("' + 'x' * 64 + 'b' + '"); }')
+    try:
+        build_dictionary([tmp_path / 'c.c'])
+    except BinlogError:
+        pass
+    else:
+        assert False, 'Colliding format strings should have been rejected'
@@ -0,0 +1,65 @@
+import random
+
+from qmk.matrix_ports import group_pins, pin_port
+
+
+def _read_row(ports, shifts, levels):
+    """Reads a row the way quantum/matrix.c does with the generated port reads.
+    """
+    samples = []
+    for pin in ports:
+        port = pin_port(pin)[0]
+        samples.append(sum(1 << bit for (p, bit), level in levels.items() if p == port and level))
+
+    row = 0
+    for port, mask, left_shift, right_shift in shifts:
+        row |= ((samples[port] & mask) >> right_shift) << left_shift
+    return row
+
+
+def _check(pins, levels):
+    ports, shifts = group_pins(pins)
+    expected = sum(1 << index for index, pin in enumerate(pins) if pin and levels[pin_port(pin)])
+    assert _read_row(ports, shifts, levels) == expected
+
+
+def test_pin_port():
+    assert pin_port('B7') == ('B', 7)
+    assert pin_port('A15') == ('A', 15)
+    assert pin_port('GP29') == ('GP', 29)
+    assert pin_port('B32') is None
+    assert pin_port('PB7') is None
+
+
+def test_single_port_in_order():
+    ports, shifts = group_pins(['B0', 'B1', 'B2', 'B3', 'B4', 'B5', 'B6', 'B7'])
+    assert ports == ['B0']
+    assert shifts == [(0, 0xFF, 0, 0)]
+
+
+def test_runs_within_ports():
+    ports, shifts = group_pins(['F4', 'F5', 'F6', 'F7', 'B1', 'B3', 'B2', 'B6', 'D7', None, 'C6'])
+    assert ports == ['F4', 'B1', 'D7', 'C6']
+    assert shifts == [
+        (0, 0xF0, 0, 4),
+        (1, 0x40, 1, 0),
+        (1, 0x08, 2, 0),
+        (1, 0x02, 3, 0),
+        (1, 0x04, 4, 0),
+        (2, 0x80, 1, 0),
+        (3, 0x40, 4, 0),
+    ]
+
+
+def test_unknown_port():
+    assert group_pins(['B0', 'B1', 'TEENSY_PIN5']) is None
+
+
+def test_wide_matrix_reads_every_pin():
+    rng = random.Random(1)
+    pins = [f'{port}{bit}' for port in 'ABC' for bit in range(16)]
+    for _ in range(50):
+        row = rng.sample(pins, 21)
+        for _ in range(20):
+            levels = {pin_port(pin): rng.random() < 0.5 for pin in row}
+            _check(row, levels)
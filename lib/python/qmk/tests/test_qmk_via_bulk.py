@@ -0,0 +1,188 @@
+import random
+
+from qmk.via_bulk import BulkHost, BulkTransferError, LocalDevice, REGION_KEYMAP, REGION_MACRO, PAYLOAD_SIZE, content_hash, crc32, decode, encode, layer_hashes
+
+# 4 layers of a 6x16 matrix -- a populated base layer, a partially populated function layer, and two transparent layers
+LAYER_KEYS = 6 * 16
+LAYER_SIZE = LAYER_KEYS * 2
+
+
+def _keymap(layers=4):
+    keycodes = []
+    for i in range(layers * LAYER_KEYS):
+        if i < LAYER_KEYS:
+            keycodes.append(0x0004 + (i % 0x60))
+        elif i < 2 * LAYER_KEYS and i % 3 == 0:
+            keycodes.append(0x003A + (i % 12))
+        else:
+            keycodes.append(0x0001)
+    return b''.join(k.to_bytes(2, 'big') for k in keycodes)
+
+
+def test_encode_vector():
+    # Matches the token format documented in quantum/via.h
+    payload, consumed = encode(bytes([0x00, 0x04, 0x00, 0x05]) + bytes([0x00, 0x01]) * 10)
+    assert payload == bytes([0x03, 0x00, 0x04, 0x00, 0x05, 0x88, 0x00, 0x01])
+    assert consumed == 24
+
+
+def test_encode_roundtrip():
+    rng = random.Random(1)
+    for _ in range(200):
+        data = bytes(rng.choice([0, 1, rng.randrange(256)]) for _ in range(rng.randrange(1, 256)))
+        pos = 0
+        while pos < len(data):
+            payload, consumed = encode(data[pos:])
+            assert 0 < consumed
+            assert len(payload) <= PAYLOAD_SIZE
+            assert decode(payload) == data[pos:pos + consumed]
+            pos += consumed
+
+
+def test_get_info():
+    host = BulkHost(LocalDevice(_keymap(), bytes(512)))
+    info = host.get_info()
+    assert info['keymap_size'] == 4 * LAYER_KEYS * 2
+    assert info['macro_size'] == 512
+
+
+def test_read_keymap():
+    keymap = _keymap(32)
+    device = LocalDevice(keymap)
+    host = BulkHost(device)
+    assert host.read(REGION_KEYMAP, 0, len(keymap)) == keymap
+
+    # 28 bytes per round trip using id_dynamic_keymap_get_buffer
+    assert host.round_trips < len(keymap) // 28 // 10
+
+
+def test_read_clamped_to_region():
+    keymap = _keymap()
+    host = BulkHost(LocalDevice(keymap))
+    assert host.read(REGION_KEYMAP, 100, 0xFFFF) == keymap[100:]
+
+
+def test_write_keymap():
+    keymap = _keymap()
+    device = LocalDevice(bytes(len(keymap)))
+    host = BulkHost(device, window=4)
+    host.write(REGION_KEYMAP, 0, keymap)
+    assert bytes(device.regions[REGION_KEYMAP]) == keymap
+    assert device.reports_sent < len(keymap) // 28
+
+
+def test_write_macros():
+    macros = b'hello\x00world\x00' + bytes(500)
+    device = LocalDevice(_keymap(), bytes(len(macros)))
+    host = BulkHost(device)
+    host.write(REGION_MACRO, 0, macros)
+    assert bytes(device.regions[REGION_MACRO]) == macros
+
+
+def test_write_rejected_out_of_range():
+    keymap = _keymap()
+    host = BulkHost(LocalDevice(keymap))
+    try:
+        host.write(REGION_KEYMAP, len(keymap) - 4, bytes(range(16)))
+    except BulkTransferError:
+        pass
+    else:
+        assert False, 'Out of range write should have been rejected'
+
+
+def test_crc_matches_region():
+    keymap = _keymap()
+    host = BulkHost(LocalDevice(keymap))
+    assert host.get_crc(REGION_KEYMAP, 0, len(keymap)) == crc32(keymap)
+    assert host.get_crc(REGION_KEYMAP, 64, 32) == crc32(keymap[64:96])
+
+
+def test_fetch_changed_only():
+    keymap = _keymap(8)
+    device = LocalDevice(keymap)
+    host = BulkHost(device)
+
+    # Unchanged keymap needs a single CRC request
+    cached, changed = host.fetch_changed(REGION_KEYMAP, keymap)
+    assert cached == keymap
+    assert changed == []
+    assert host.round_trips == 1
+
+    # Only the block containing the modified key is read
+    device.regions[REGION_KEYMAP][700:702] = (0x0029).to_bytes(2, 'big')
+    cached, changed = host.fetch_changed(REGION_KEYMAP, keymap)
+    assert cached == bytes(device.regions[REGION_KEYMAP])
+    assert changed == [(512, 256)]
+
+
+def test_hashes_match_content():
+    keymap = _keymap(8)
+    macros = b'hello\x00' + bytes(250)
+    host = BulkHost(LocalDevice(keymap, macros, layer_size=LAYER_SIZE))
+    hashes = host.get_hashes()
+    assert hashes == layer_hashes(keymap, LAYER_SIZE, macros)
+    assert len(hashes) == 9
+
+    # Spans multiple reports, 7 hashes fit in each
+    assert host.round_trips == 2
+
+
+def test_layer_hash_vectors():
+    # Also checked against the firmware by tests/dynamic_keymap/test_dynamic_keymap_hash.cpp, using a 4x10 matrix
+    assert content_hash(bytes(40 * 2)) == 0xC5A56BFB
+    assert content_hash(b''.join((0x0004 + i).to_bytes(2, 'big') for i in range(40))) == 0xF967FC70
+
+
+def test_hashes_follow_edits():
+    rng = random.Random(2)
+    device = LocalDevice(_keymap(4), bytes(128), layer_size=LAYER_SIZE)
+    for _ in range(500):
+        if rng.randrange(4):
+            offset = rng.randrange(len(device.regions[REGION_KEYMAP]) // 2) * 2
+            device.update(REGION_KEYMAP, offset, rng.choice([0x0001, 0x0004, rng.randrange(0x10000)]).to_bytes(2, 'big'))
+        else:
+            offset = rng.randrange(len(device.regions[REGION_MACRO]))
+            device.update(REGION_MACRO, offset, bytes([rng.randrange(256)]))
+        assert device.hashes == layer_hashes(device.regions[REGION_KEYMAP], LAYER_SIZE, device.regions[REGION_MACRO])
+
+
+def test_hash_invalidated_by_single_key():
+    keymap = _keymap(4)
+    device = LocalDevice(keymap, layer_size=LAYER_SIZE)
+    before = list(device.hashes)
+
+    # Swapping two keys changes the layer's hash, even though the layer contains the same keycodes
+    layer = bytearray(keymap[:LAYER_SIZE])
+    layer[0:2], layer[2:4] = layer[2:4], layer[0:2]
+    device.update(REGION_KEYMAP, 0, layer[0:4])
+    assert device.hashes[0] != before[0]
+    assert device.hashes[1:] == before[1:]
+
+    # Restoring the key restores the hash
+    device.update(REGION_KEYMAP, 0, keymap[0:4])
+    assert device.hashes == before
+    assert content_hash(keymap[:LAYER_SIZE]) == before[0]
+
+
+def test_sync_layers_skips_unchanged():
+    keymap = _keymap(8)
+    device = LocalDevice(keymap, layer_size=LAYER_SIZE)
+    host = BulkHost(device)
+
+    # Nothing cached reads every layer
+    cached, hashes, changed = host.sync_layers(bytes(len(keymap)), [], LAYER_SIZE)
+    assert cached == keymap
+    assert changed == list(range(8))
+
+    # Unchanged keymap needs only the hash requests
+    host.round_trips = 0
+    cached, hashes, changed = host.sync_layers(cached, hashes, LAYER_SIZE)
+    assert changed == []
+    assert host.round_trips == 2
+
+    # Edits through a bulk write only cause the edited layers to be read
+    host.write(REGION_KEYMAP, 5 * LAYER_SIZE + 10, (0x0029).to_bytes(2, 'big'))
+    device.update(REGION_KEYMAP, 2 * LAYER_SIZE, (0x0029).to_bytes(2, 'big'))
+    cached, hashes, changed = host.sync_layers(cached, hashes, LAYER_SIZE)
+    assert cached == bytes(device.regions[REGION_KEYMAP])
+    assert changed == [2, 5]
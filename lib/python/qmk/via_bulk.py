@@ -0,0 +1,386 @@
+# Copyright 2025 QMK
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+# Host side of the VIA bulk keymap transfer protocol, see `id_dynamic_keymap_bulk` in quantum/via.h,
+# and of the per-layer content hashes, see `id_dynamic_keymap_get_hashes`.
+# `LocalDevice` is a stand-in for the firmware side, so that host code can be exercised without a keyboard attached.
+
+import zlib
+
+REPORT_SIZE = 32
+
+ID_DYNAMIC_KEYMAP_BULK = 0x16
+ID_DYNAMIC_KEYMAP_GET_HASHES = 0x17
+ID_UNHANDLED = 0xFF
+
+ID_BULK_GET_INFO = 0x01
+ID_BULK_GET_CRC = 0x02
+ID_BULK_READ = 0x03
+ID_BULK_WRITE = 0x04
+
+REGION_KEYMAP = 0x00
+REGION_MACRO = 0x01
+
+BULK_VERSION = 0x01
+SEQUENCE_LAST = 0x80
+HEADER_SIZE = 8
+PAYLOAD_SIZE = REPORT_SIZE - HEADER_SIZE
+MAX_RAW_LENGTH = 128
+MAX_WINDOW = 16
+HASHES_PER_REPORT = 7
+
+
+class BulkTransferError(Exception):
+    """Raised when the device rejects or mangles a bulk transfer.
+    """
+
+
+def crc32(data):
+    """CRC-32 as calculated by the firmware for `id_bulk_get_crc`.
+    """
+    return zlib.crc32(bytes(data)) & 0xFFFFFFFF
+
+
+def _hash_byte(index, value):
+    """MurmurHash3 finalizer of a byte's position and value, as in `dynamic_keymap_hash_byte()`.
+    """
+    h = (index << 8) | value
+    h ^= h >> 16
+    h = (h * 0x85EBCA6B) & 0xFFFFFFFF
+    h ^= h >> 13
+    h = (h * 0xC2B2AE35) & 0xFFFFFFFF
+    h ^= h >> 16
+    return h
+
+
+def content_hash(data):
+    """Content hash of a layer or the macro buffer, as calculated by `dynamic_keymap_get_hash()`.
+    """
+    return sum(_hash_byte(index, value) for index, value in enumerate(data)) & 0xFFFFFFFF
+
+
+def layer_hashes(keymap, layer_size, macros=b''):
+    """Content hashes of each layer of the keymap, followed by the macro buffer.
+    """
+    hashes = [content_hash(keymap[offset:offset + layer_size]) for offset in range(0, len(keymap), layer_size)]
+    hashes.append(content_hash(macros))
+    return hashes
+
+
+def _repeat_count(data, start):
+    """Number of times the 2-byte value at `start` repeats, limited to what fits in a single token.
+    """
+    if len(data) - start < 2:
+        return 0
+    count = 1
+    while count < 129 and start + (count + 1) * 2 <= len(data) and data[start + count * 2] == data[start] and data[start + count * 2 + 1] == data[start + 1]:
+        count += 1
+    return count
+
+
+def encode(data, payload_size=PAYLOAD_SIZE):
+    """Encodes as many leading bytes of `data` as fit in `payload_size` bytes.
+
+    Returns a tuple of the encoded payload and the number of raw bytes it covers.
+    """
+    data = bytes(data)
+    payload = bytearray()
+    pos = 0
+    while pos < len(data):
+        repeats = _repeat_count(data, pos)
+        if repeats >= 2:
+            if len(payload) + 3 > payload_size:
+                break
+            payload += bytes([0x80 | (repeats - 2), data[pos], data[pos + 1]])
+            pos += repeats * 2
+            continue
+
+        literal = 1
+        while pos + literal < len(data) and literal < 128 and _repeat_count(data, pos + literal) < 2:
+            literal += 1
+        if len(payload) + 1 + literal > payload_size:
+            if len(payload) + 2 > payload_size:
+                break
+            literal = payload_size - len(payload) - 1
+        payload.append(literal - 1)
+        payload += data[pos:pos + literal]
+        pos += literal
+
+    return bytes(payload), pos
+
+
+def decode(payload):
+    """Decodes a block payload back into the raw bytes.
+    """
+    data = bytearray()
+    pos = 0
+    while pos < len(payload):
+        token = payload[pos]
+        pos += 1
+        if token & 0x80:
+            if pos + 2 > len(payload):
+                raise BulkTransferError('Truncated repeat token')
+            data += bytes(payload[pos:pos + 2]) * ((token & 0x7F) + 2)
+            pos += 2
+        else:
+            count = (token & 0x7F) + 1
+            if pos + count > len(payload):
+                raise BulkTransferError('Truncated literal token')
+            data += payload[pos:pos + count]
+            pos += count
+    return bytes(data)
+
+
+def _report(*values):
+    report = bytearray(REPORT_SIZE)
+    report[0:len(values)] = bytes(values)
+    return report
+
+
+def _block_report(command, region, offset, sequence, raw_size, payload):
+    report = _report(ID_DYNAMIC_KEYMAP_BULK, command, region, offset >> 8, offset & 0xFF, sequence, raw_size, len(payload))
+    report[HEADER_SIZE:HEADER_SIZE + len(payload)] = payload
+    return report
+
+
+def _parse_block_report(report):
+    region = report[2]
+    offset = (report[3] << 8) | report[4]
+    sequence = report[5]
+    raw_size = report[6]
+    payload = bytes(report[HEADER_SIZE:HEADER_SIZE + report[7]])
+    return region, offset, sequence, raw_size, payload
+
+
+class BulkHost:
+    """Host side of the bulk transfer protocol.
+
+    `transport` is called with each 32-byte request report, and returns the list of reports sent back by the device.
+    """
+    def __init__(self, transport, window=MAX_WINDOW):
+        self.transport = transport
+        self.window = window
+        self.round_trips = 0
+
+    def _transact(self, report):
+        self.round_trips += 1
+        replies = self.transport(bytes(report))
+        if not replies or replies[-1][0] == ID_UNHANDLED:
+            raise BulkTransferError(f'Bulk command 0x{report[1]:02X} was not handled by the device')
+        return replies
+
+    def get_info(self):
+        """Returns the region sizes and maximum window supported by the device.
+        """
+        reply = self._transact(_report(ID_DYNAMIC_KEYMAP_BULK, ID_BULK_GET_INFO))[-1]
+        if reply[2] != BULK_VERSION:
+            raise BulkTransferError(f'Unsupported bulk transfer version {reply[2]}')
+        return {
+            'regions': reply[3],
+            'keymap_size': (reply[4] << 8) | reply[5],
+            'macro_size': (reply[6] << 8) | reply[7],
+            'max_window': reply[8],
+        }
+
+    def get_crc(self, region, offset, size):
+        """Returns the CRC-32 of a span of the region, calculated by the device.
+        """
+        reply = self._transact(_report(ID_DYNAMIC_KEYMAP_BULK, ID_BULK_GET_CRC, region, offset >> 8, offset & 0xFF, size >> 8, size & 0xFF))[-1]
+        return (reply[7] << 24) | (reply[8] << 16) | (reply[9] << 8) | reply[10]
+
+    def read(self, region, offset, size):
+        """Reads a span of the region, one window of block reports per round trip.
+        """
+        data = bytearray()
+        while len(data) < size:
+            position = offset + len(data)
+            remaining = size - len(data)
+            replies = self._transact(_report(ID_DYNAMIC_KEYMAP_BULK, ID_BULK_READ, region, position >> 8, position & 0xFF, remaining >> 8, remaining & 0xFF, self.window))
+            for expected_sequence, reply in enumerate(replies):
+                reply_region, reply_offset, sequence, raw_size, payload = _parse_block_report(reply)
+                if reply_region != region or reply_offset != offset + len(data) or (sequence & ~SEQUENCE_LAST) != expected_sequence:
+                    raise BulkTransferError(f'Out of sequence block report at offset {reply_offset}')
+                block = decode(payload)
+                if len(block) != raw_size:
+                    raise BulkTransferError(f'Block report at offset {reply_offset} decoded to {len(block)} bytes, expected {raw_size}')
+                data += block
+            if raw_size == 0:
+                # The device has reached the end of the region
+                break
+        return bytes(data)
+
+    def write(self, region, offset, data):
+        """Writes data to the region, pipelining up to a window of block reports before checking the replies.
+        """
+        data = bytes(data)
+        pos = 0
+        while pos < len(data):
+            requests = []
+            for sequence in range(self.window):
+                if pos >= len(data):
+                    break
+                payload, raw_size = encode(data[pos:pos + MAX_RAW_LENGTH])
+                requests.append(_block_report(ID_BULK_WRITE, region, offset + pos, sequence, raw_size, payload))
+                pos += raw_size
+
+            for request in requests:
+                reply = self._transact(request)[-1]
+                if reply[6] != request[6]:
+                    raise BulkTransferError(f'Block write at offset {(request[3] << 8) | request[4]} was rejected')
+
+        if self.get_crc(region, offset, len(data)) != crc32(data):
+            raise BulkTransferError('CRC mismatch after writing')
+
+    def get_hashes(self):
+        """Returns the content hash of each layer, followed by the macro buffer.
+        """
+        hashes = []
+        while True:
+            self.round_trips += 1
+            reply = self.transport(bytes(_report(ID_DYNAMIC_KEYMAP_GET_HASHES, len(hashes), HASHES_PER_REPORT)))[-1]
+            if reply[0] == ID_UNHANDLED:
+                raise BulkTransferError('Keymap hashes are not supported by the device')
+            count = reply[2]
+            for i in range(count):
+                hashes.append(int.from_bytes(reply[3 + i * 4:7 + i * 4], 'big'))
+            if count < HASHES_PER_REPORT:
+                return hashes
+
+    def sync_layers(self, cached, cached_hashes, layer_size):
+        """Updates a cached copy of the keymap, only reading the layers whose hash differs from `cached_hashes`.
+
+        Returns the updated copy, the device's hashes to cache alongside it, and the list of layers which were read.
+        """
+        cached = bytearray(cached)
+        hashes = self.get_hashes()
+        changed = []
+        for layer, offset in enumerate(range(0, len(cached), layer_size)):
+            if layer >= len(cached_hashes) - 1 or hashes[layer] != cached_hashes[layer]:
+                cached[offset:offset + layer_size] = self.read(REGION_KEYMAP, offset, layer_size)
+                changed.append(layer)
+        return bytes(cached), hashes, changed
+
+    def fetch_changed(self, region, cached, block_size=256):
+        """Updates a cached copy of the region, only reading the blocks whose CRC differs from the cache.
+
+        Returns the updated copy, and the list of (offset, size) spans which were read.
+        """
+        cached = bytearray(cached)
+        changed = []
+        if self.get_crc(region, 0, len(cached)) == crc32(cached):
+            return bytes(cached), changed
+
+        for offset in range(0, len(cached), block_size):
+            size = min(block_size, len(cached) - offset)
+            if self.get_crc(region, offset, size) != crc32(cached[offset:offset + size]):
+                cached[offset:offset + size] = self.read(region, offset, size)
+                changed.append((offset, size))
+        return bytes(cached), changed
+
+
+class LocalDevice:
+    """Stand-in for the firmware side of the protocol, backed by in-memory regions.
+    """
+    def __init__(self, keymap, macros=b'', max_window=MAX_WINDOW, layer_size=None):
+        self.regions = [bytearray(keymap), bytearray(macros)]
+        self.max_window = max_window
+        self.layer_size = layer_size or len(keymap)
+        self.reports_sent = 0
+        self.hashes = layer_hashes(self.regions[REGION_KEYMAP], self.layer_size, self.regions[REGION_MACRO])
+
+    def update(self, region, offset, data):
+        """Writes to a region, updating the content hashes the same way as `dynamic_keymap_hash_update()`.
+        """
+        for i, value in enumerate(data):
+            previous = self.regions[region][offset + i]
+            if region == REGION_KEYMAP:
+                slot, index = divmod(offset + i, self.layer_size)
+            else:
+                slot, index = len(self.hashes) - 1, offset + i
+            self.hashes[slot] = (self.hashes[slot] + _hash_byte(index, value) - _hash_byte(index, previous)) & 0xFFFFFFFF
+            self.regions[region][offset + i] = value
+
+    def __call__(self, request):
+        return self.receive(request)
+
+    def receive(self, request):
+        """Handles a single request report, returning the list of reports sent back.
+        """
+        report = bytearray(request)
+        replies = []
+        if report[0] == ID_DYNAMIC_KEYMAP_GET_HASHES:
+            self._get_hashes(report)
+        elif report[0] != ID_DYNAMIC_KEYMAP_BULK:
+            report[0] = ID_UNHANDLED
+        elif report[1] == ID_BULK_GET_INFO:
+            report[2:9] = bytes([BULK_VERSION, len(self.regions), len(self.regions[0]) >> 8, len(self.regions[0]) & 0xFF, len(self.regions[1]) >> 8, len(self.regions[1]) & 0xFF, self.max_window])
+        elif report[1] == ID_BULK_GET_CRC:
+            self._get_crc(report)
+        elif report[1] == ID_BULK_READ:
+            replies = self._read(report)
+        elif report[1] == ID_BULK_WRITE:
+            self._write(report)
+        else:
+            report[0] = ID_UNHANDLED
+
+        replies = replies or [report]
+        self.reports_sent += len(replies)
+        return [bytes(r) for r in replies]
+
+    def _get_hashes(self, report):
+        first = min(report[1], len(self.hashes))
+        count = min(report[2], len(self.hashes) - first, HASHES_PER_REPORT)
+        report[1:3] = bytes([first, count])
+        for i in range(count):
+            report[3 + i * 4:7 + i * 4] = self.hashes[first + i].to_bytes(4, 'big')
+
+    def _region_span(self, report):
+        region = report[2]
+        offset = (report[3] << 8) | report[4]
+        size = (report[5] << 8) | report[6]
+        if region >= len(self.regions) or offset > len(self.regions[region]):
+            return None
+        return region, offset, min(size, len(self.regions[region]) - offset)
+
+    def _get_crc(self, report):
+        span = self._region_span(report)
+        if span is None:
+            report[0] = ID_UNHANDLED
+            return
+        region, offset, size = span
+        crc = crc32(self.regions[region][offset:offset + size])
+        report[5:11] = bytes([size >> 8, size & 0xFF, crc >> 24, (crc >> 16) & 0xFF, (crc >> 8) & 0xFF, crc & 0xFF])
+
+    def _read(self, report):
+        span = self._region_span(report)
+        if span is None:
+            report[0] = ID_UNHANDLED
+            return [report]
+        region, offset, remaining = span
+        window = report[7] if 1 <= report[7] <= self.max_window else self.max_window
+
+        replies = []
+        for sequence in range(window):
+            chunk = self.regions[region][offset:offset + min(remaining, MAX_RAW_LENGTH)]
+            payload, raw_size = encode(chunk)
+            remaining -= raw_size
+            last = remaining == 0 or sequence + 1 >= window
+            replies.append(_block_report(ID_BULK_READ, region, offset, sequence | (SEQUENCE_LAST if last else 0), raw_size, payload))
+            offset += raw_size
+            if last:
+                break
+        return replies
+
+    def _write(self, report):
+        region, offset, _, raw_size, payload = _parse_block_report(report)
+        if region >= len(self.regions):
+            report[0] = ID_UNHANDLED
+            return
+        try:
+            data = decode(payload)
+        except BulkTransferError:
+            data = None
+        if data is None or len(data) != raw_size or offset + raw_size > len(self.regions[region]):
+            report[6] = 0
+            return
+        self.update(region, offset, data)
@@ -187,6 +187,22 @@ spi_status_t spi_receive(uint8_t *data, uint16_t length) {
     return SPI_STATUS_SUCCESS;
 }
 
+spi_status_t spi_exchange(const uint8_t *tx_data, uint8_t *rx_data, uint16_t length) {
+    spi_status_t status;
+
+    for (uint16_t i = 0; i < length; i++) {
+        status = spi_write(tx_data[i]);
+
+        if (status >= 0) {
+            rx_data[i] = status;
+        } else {
+            return status;
+        }
+    }
+
+    return SPI_STATUS_SUCCESS;
+}
+
 void spi_stop(void) {
     if (current_slave_pin != NO_PIN) {
         gpio_set_pin_output(current_slave_pin);
@@ -19,6 +19,7 @@
 #include "pin_defs.h"
 
 typedef uint8_t pin_t;
+typedef uint8_t port_data_t;
 
 /* Operation of GPIO by pin. */
 
@@ -36,3 +37,7 @@ typedef uint8_t pin_t;
 #define gpio_read_pin(pin) ((bool)(PINx_ADDRESS(pin) & _BV((pin)&0xF)))
 
 #define gpio_toggle_pin(pin) (PORTx_ADDRESS(pin) ^= _BV((pin)&0xF))
+
+/* Operation of GPIO by port, given any pin on it. */
+
+#define gpio_read_port(pin) ((port_data_t)PINx_ADDRESS(pin))
@@ -24,8 +24,9 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 
 // counter resolution 1ms
 // NOTE: union { uint32_t timer32; struct { uint16_t dummy; uint16_t timer16; }}
-volatile uint32_t timer_count;
-static uint32_t   saved_ms;
+volatile uint32_t       timer_count;
+static volatile uint8_t timer_count_wraps;
+static uint32_t         saved_ms;
 
 /** \brief timer initialization
  *
@@ -75,7 +76,8 @@ void timer_init(void) {
  */
 inline void timer_clear(void) {
     ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
-        timer_count = 0;
+        timer_count       = 0;
+        timer_count_wraps = 0;
     }
 }
 
@@ -93,7 +95,8 @@ void timer_save(void) {
  */
 void timer_restore(void) {
     ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
-        timer_count = saved_ms;
+        timer_count       = saved_ms;
+        timer_count_wraps = 0;
     }
 }
 
@@ -125,6 +128,69 @@ inline uint32_t timer_read32(void) {
     return t;
 }
 
+#if defined(__AVR_ATmega32A__)
+#    define TIMER_COMPARE_FLAG_REGISTER TIFR
+#    define TIMER_COMPARE_FLAG OCF0
+#elif defined(__AVR_ATtiny85__)
+#    define TIMER_COMPARE_FLAG_REGISTER TIFR
+#    define TIMER_COMPARE_FLAG OCF0A
+#else
+#    define TIMER_COMPARE_FLAG_REGISTER TIFR0
+#    define TIMER_COMPARE_FLAG OCF0A
+#endif
+
+// Microseconds per raw timer count, in 8.8 fixed point
+#define TIMER_RAW_US_Q8 ((1000UL << 8) / (TIMER_RAW_TOP + 1))
+
+/** \brief Read the millisecond count and the microseconds within that millisecond
+ *
+ * If the timer has reached the next millisecond but the interrupt hasn't run yet, the millisecond is counted here.
+ */
+static inline uint32_t timer_read_ms_us(uint8_t *wraps, uint16_t *us) {
+    uint32_t ms;
+    uint8_t  raw;
+
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        ms     = timer_count;
+        *wraps = timer_count_wraps;
+        raw    = TIMER_RAW;
+        if (TIMER_COMPARE_FLAG_REGISTER & _BV(TIMER_COMPARE_FLAG)) {
+            if (++ms == 0) {
+                (*wraps)++;
+            }
+            raw = TIMER_RAW;
+        }
+    }
+
+    *us = (uint16_t)(((uint32_t)raw * TIMER_RAW_US_Q8) >> 8);
+    return ms;
+}
+
+/** \brief timer read in microseconds
+ *
+ * The low 32 bits of timer_read_us64(), wrapping every ~71 minutes. The resolution is one count of timer 0, i.e.
+ * TIMER_PRESCALER / F_CPU seconds.
+ */
+uint32_t timer_read_us(void) {
+    uint8_t  wraps;
+    uint16_t us;
+    uint32_t ms = timer_read_ms_us(&wraps, &us);
+
+    return ms * 1000 + us;
+}
+
+/** \brief timer read in microseconds, 64-bit
+ *
+ * Shares its epoch with timer_read32(), but keeps counting when the millisecond count wraps.
+ */
+uint64_t timer_read_us64(void) {
+    uint8_t  wraps;
+    uint16_t us;
+    uint32_t ms = timer_read_ms_us(&wraps, &us);
+
+    return (((uint64_t)wraps << 32) | ms) * 1000 + us;
+}
+
 // excecuted once per 1ms.(excess for just timer count?)
 #ifndef __AVR_ATmega32A__
 #    define TIMER_INTERRUPT_VECTOR TIMER0_COMPA_vect
@@ -132,5 +198,7 @@ inline uint32_t timer_read32(void) {
 #    define TIMER_INTERRUPT_VECTOR TIMER0_COMP_vect
 #endif
 ISR(TIMER_INTERRUPT_VECTOR, ISR_NOBLOCK) {
-    timer_count++;
+    if (++timer_count == 0) {
+        timer_count_wraps++;
+    }
 }
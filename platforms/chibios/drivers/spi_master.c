@@ -445,6 +445,11 @@ spi_status_t spi_receive(uint8_t *data, uint16_t length) {
     return SPI_STATUS_SUCCESS;
 }
 
+spi_status_t spi_exchange(const uint8_t *tx_data, uint8_t *rx_data, uint16_t length) {
+    spiExchange(&SPI_DRIVER, length, tx_data, rx_data);
+    return SPI_STATUS_SUCCESS;
+}
+
 void spi_stop(void) {
     if (spiStarted) {
         spi_unselect();
@@ -44,6 +44,19 @@ static inline uint32_t detect_flash_size(void) {
 #endif
 }
 
+#ifdef WEAR_LEVELING_BACKGROUND_CONSOLIDATION
+// Checks whether the address within the backing store lies on a boundary between sectors, or at the end of the last one
+static bool is_sector_boundary(uint32_t address) {
+    for (flash_sector_t i = 0; i < sector_count; ++i) {
+        flash_offset_t offset = flashGetSectorOffset(flash, first_sector + i) - base_offset;
+        if (offset == address || offset + flashGetSectorSize(flash, first_sector + i) == address) {
+            return true;
+        }
+    }
+    return false;
+}
+#endif // WEAR_LEVELING_BACKGROUND_CONSOLIDATION
+
 bool backing_store_init(void) {
     bs_dprintf("Init\n");
     flash = (BaseFlash *)&EFLD1;
@@ -100,6 +113,13 @@ bool backing_store_init(void) {
 
 #endif // defined(WEAR_LEVELING_EFL_FIRST_SECTOR)
 
+#ifdef WEAR_LEVELING_BACKGROUND_CONSOLIDATION
+    if (!is_sector_boundary(WEAR_LEVELING_BANK_SIZE) || !is_sector_boundary(WEAR_LEVELING_BACKING_SIZE)) {
+        // A sector shared between the banks would be erased along with the inactive bank, taking the active bank's data with it. Fault.
+        chSysHalt("Background consolidation requires the wear_leveling banks to start and end on flash sector boundaries");
+    }
+#endif // WEAR_LEVELING_BACKGROUND_CONSOLIDATION
+
     return true;
 }
 
@@ -133,6 +153,37 @@ bool backing_store_erase(void) {
     return ret;
 }
 
+bool backing_store_erase_range(uint32_t address, size_t length) {
+#ifdef WEAR_LEVELING_DEBUG_OUTPUT
+    uint32_t start = timer_read32();
+#endif
+
+    // Only sectors starting within the range are erased, so the range needs to be aligned to sector boundaries
+    bool          ret = true;
+    flash_error_t status;
+    for (int i = 0; i < sector_count; ++i) {
+        flash_offset_t offset = flashGetSectorOffset(flash, first_sector + i) - base_offset;
+        if (offset < address || offset >= address + length) {
+            continue;
+        }
+
+        // Kick off the sector erase
+        status = flashStartEraseSector(flash, first_sector + i);
+        if (status != FLASH_NO_ERROR && status != FLASH_BUSY_ERASING) {
+            ret = false;
+        }
+
+        // Wait for the erase to complete
+        status = flashWaitErase(flash);
+        if (status != FLASH_NO_ERROR && status != FLASH_BUSY_ERASING) {
+            ret = false;
+        }
+    }
+
+    bs_dprintf("Backing store range erase took %ldms to complete\n", ((long)(timer_read32() - start)));
+    return ret;
+}
+
 bool backing_store_write(uint32_t address, backing_store_int_t value) {
     uint32_t offset = (base_offset + address);
     bs_dprintf("Write ");
@@ -45,6 +45,12 @@
 #    endif
 #endif
 
+// A range erase erases the sectors starting inside it. Where the MCU's sectors are all the same size, each consolidation
+// step erases one of them, otherwise the whole inactive bank is erased in a single step.
+#if !defined(BACKING_STORE_ERASE_SIZE) && defined(STM32_FLASH_SECTOR_SIZE)
+#    define BACKING_STORE_ERASE_SIZE (STM32_FLASH_SECTOR_SIZE)
+#endif
+
 // 2kB backing space allocated
 #ifndef WEAR_LEVELING_BACKING_SIZE
 #    define WEAR_LEVELING_BACKING_SIZE 2048
@@ -18,7 +18,8 @@
 #include <hal.h>
 #include "pin_defs.h"
 
-typedef ioline_t pin_t;
+typedef ioline_t     pin_t;
+typedef ioportmask_t port_data_t;
 
 /* Operation of GPIO by pin. */
 
@@ -43,3 +44,7 @@ typedef ioline_t pin_t;
 #define gpio_read_pin(pin) palReadLine(pin)
 
 #define gpio_toggle_pin(pin) palToggleLine(pin)
+
+/* Operation of GPIO by port, given any pin on it. */
+
+#define gpio_read_port(pin) ((port_data_t)palReadPort(PAL_PORT(pin)))
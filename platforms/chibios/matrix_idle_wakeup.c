@@ -0,0 +1,80 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <ch.h>
+#include <hal.h>
+
+#include "matrix_idle.h"
+#include "matrix_idle_wakeup.h"
+#include "wait.h"
+
+#if PAL_USE_CALLBACKS == TRUE
+
+#    ifndef MATRIX_INPUT_PRESSED_STATE
+#        define MATRIX_INPUT_PRESSED_STATE 0
+#    endif
+
+static BSEMAPHORE_DECL(wakeup_sem, true);
+
+#    if defined(MCU_STM32) || defined(MCU_AT32) || defined(MCU_GD32V)
+// EXTI has one line per pin number, shared by every port, so e.g. A1 and B1 can't both wake the MCU
+#        define MATRIX_IDLE_WAKEUP_SHARED_LINES
+static uint16_t wakeup_lines = 0;
+static pin_t    wakeup_line_pins[16];
+static bool     wakeup_polling = false;
+#    endif
+
+static void matrix_idle_wakeup_cb(void *arg) {
+    (void)arg;
+    chSysLockFromISR();
+    chBSemSignalI(&wakeup_sem);
+    chSysUnlockFromISR();
+}
+
+void matrix_idle_wakeup_enable(pin_t pin) {
+#    ifdef MATRIX_IDLE_WAKEUP_SHARED_LINES
+    uint8_t line = PAL_PAD(pin);
+    if (wakeup_lines & (1 << line)) {
+        if (wakeup_line_pins[line] != pin) {
+            wakeup_polling = true;
+        }
+        return;
+    }
+    wakeup_lines |= (1 << line);
+    wakeup_line_pins[line] = pin;
+#    endif
+    palEnableLineEvent(pin, MATRIX_INPUT_PRESSED_STATE ? PAL_EVENT_MODE_RISING_EDGE : PAL_EVENT_MODE_FALLING_EDGE);
+    palSetLineCallback(pin, matrix_idle_wakeup_cb, NULL);
+}
+
+void matrix_idle_wakeup_disable(pin_t pin) {
+#    ifdef MATRIX_IDLE_WAKEUP_SHARED_LINES
+    uint8_t line = PAL_PAD(pin);
+    if (!(wakeup_lines & (1 << line)) || wakeup_line_pins[line] != pin) {
+        // Never enabled, as the line belongs to another port's pin
+        return;
+    }
+    wakeup_lines &= ~(1 << line);
+#    endif
+    palDisableLineEvent(pin);
+    chBSemReset(&wakeup_sem, true);
+}
+
+bool matrix_idle_wakeup_wait(uint32_t timeout_ms) {
+#    ifdef MATRIX_IDLE_WAKEUP_SHARED_LINES
+    if (wakeup_polling) {
+        // Some inputs have no line of their own, so every input is polled instead
+        for (uint32_t i = 0; i < timeout_ms; i++) {
+            if (matrix_idle_inputs_active()) {
+                return true;
+            }
+            wait_ms(1);
+        }
+        return false;
+    }
+#    endif
+    // The thread sleeps, letting the idle thread put the core into WFI until the edge interrupt fires
+    return chBSemWaitTimeout(&wakeup_sem, TIME_MS2I(timeout_ms)) == MSG_OK;
+}
+
+#endif
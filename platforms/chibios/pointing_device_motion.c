@@ -0,0 +1,47 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <ch.h>
+#include <hal.h>
+
+#include "pointing_device.h"
+
+#if defined(POINTING_DEVICE_MOTION_INTERRUPT)
+#    include "usb_endpoints.h"
+#    include "usb_driver.h"
+
+extern usb_endpoint_in_t usb_endpoints_in[USB_ENDPOINT_IN_COUNT];
+
+bool pointing_device_host_ready(void) {
+    // The previous report has been taken by the host once the endpoint is idle
+    return usb_endpoint_in_is_inactive(&usb_endpoints_in[USB_ENDPOINT_IN_MOUSE]);
+}
+
+#    if PAL_USE_CALLBACKS == TRUE
+
+static volatile bool motion_triggered = false;
+
+static void pointing_device_motion_cb(void *arg) {
+    (void)arg;
+    motion_triggered = true;
+}
+
+void pointing_device_motion_interrupt_enable(void) {
+#        ifdef POINTING_DEVICE_MOTION_PIN_ACTIVE_LOW
+    palEnableLineEvent(POINTING_DEVICE_MOTION_PIN, PAL_EVENT_MODE_FALLING_EDGE);
+#        else
+    palEnableLineEvent(POINTING_DEVICE_MOTION_PIN, PAL_EVENT_MODE_RISING_EDGE);
+#        endif
+    palSetLineCallback(POINTING_DEVICE_MOTION_PIN, pointing_device_motion_cb, NULL);
+}
+
+bool pointing_device_motion_interrupt_triggered(void) {
+    if (!motion_triggered) {
+        return false;
+    }
+    motion_triggered = false;
+    return true;
+}
+
+#    endif
+#endif
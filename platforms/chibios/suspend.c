@@ -12,6 +12,9 @@
 #include "suspend.h"
 #include "led.h"
 #include "wait.h"
+#ifdef MATRIX_IDLE_ENABLE
+#    include "matrix_idle.h"
+#endif
 
 /** \brief suspend power down
  *
@@ -22,7 +25,14 @@ void suspend_power_down(void) {
     // on AVR, this enables the watchdog for 15ms (max), and goes to
     // SLEEP_MODE_PWR_DOWN
 
+#ifdef MATRIX_IDLE_ENABLE
+    // Returns as soon as a key is pressed, so that suspend_wakeup_condition() sees it straight away
+    if (!matrix_idle_sleep(17)) {
+        wait_ms(17);
+    }
+#else
     wait_ms(17);
+#endif
 }
 
 /** \brief suspend wakeup condition
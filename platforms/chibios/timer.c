@@ -5,6 +5,7 @@
 static uint32_t ticks_offset = 0;
 static uint32_t last_ticks   = 0;
 static uint32_t ms_offset    = 0;
+static uint64_t us_offset    = 0;
 static uint32_t saved_ms     = 0;
 #if CH_CFG_ST_RESOLUTION < 32
 static uint32_t last_systime = 0;
@@ -58,6 +59,14 @@ static void update_fn(struct ch_virtual_timer *timer, void *arg) {
 // OVERFLOW_ADJUST_TICKS corresponds to an integer number of seconds).
 #define OVERFLOW_ADJUST_MS (TIME_I2MS(OVERFLOW_ADJUST_TICKS))
 
+// Ticks to microseconds, rounding down so that the result never goes backwards.  TIME_I2US() rounds up, and only
+// returns 32 bits.  With the usual tick frequencies this is a multiplication, which also works in 32 bits.
+#if (1000000 % CH_CFG_ST_FREQUENCY) == 0
+#    define TICKS_TO_US(ticks) ((ticks) * (1000000 / CH_CFG_ST_FREQUENCY))
+#else
+#    define TICKS_TO_US(ticks) ((ticks) * 1000000 / CH_CFG_ST_FREQUENCY)
+#endif
+
 void timer_init(void) {
     timer_clear();
 #if CH_CFG_ST_RESOLUTION < 32
@@ -71,6 +80,7 @@ void timer_clear(void) {
     ticks_offset = get_system_time_ticks();
     last_ticks   = 0;
     ms_offset    = 0;
+    us_offset    = 0;
     chSysUnlock();
 }
 
@@ -87,6 +97,7 @@ void timer_restore(void) {
     ticks_offset = get_system_time_ticks();
     last_ticks   = 0;
     ms_offset    = platform_timer_restore_value();
+    us_offset    = (uint64_t)ms_offset * 1000;
     chSysUnlock();
 }
 
@@ -98,8 +109,9 @@ uint16_t timer_read(void) {
     return (uint16_t)timer_read32();
 }
 
-uint32_t timer_read32(void) {
-    syssts_t sts   = chSysGetStatusAndLockX();
+// Get the number of ticks since the timer was cleared, keeping it below the 32-bit limit.
+// This function must be called from within a system lock zone.
+static inline uint32_t get_elapsed_ticks(void) {
     uint32_t ticks = get_system_time_ticks() - ticks_offset;
     if (ticks < last_ticks) {
         // The 32-bit tick counter overflowed and wrapped around.  We cannot just extend the counter to 64 bits here,
@@ -111,10 +123,40 @@ uint32_t timer_read32(void) {
         ticks -= OVERFLOW_ADJUST_TICKS;
         ticks_offset += OVERFLOW_ADJUST_TICKS;
         ms_offset += OVERFLOW_ADJUST_MS;
+        us_offset += (uint64_t)OVERFLOW_ADJUST_MS * 1000;
     }
-    last_ticks              = ticks;
+    last_ticks = ticks;
+    return ticks;
+}
+
+uint32_t timer_read32(void) {
+    syssts_t sts            = chSysGetStatusAndLockX();
+    uint32_t ticks          = get_elapsed_ticks();
     uint32_t ms_offset_copy = ms_offset; // read while still holding the lock to ensure a consistent value
     chSysRestoreStatusX(sts);
 
     return (uint32_t)TIME_I2MS(ticks) + ms_offset_copy;
 }
+
+uint64_t timer_read_us64(void) {
+    syssts_t sts            = chSysGetStatusAndLockX();
+    uint32_t ticks          = get_elapsed_ticks();
+    uint64_t us_offset_copy = us_offset;
+    chSysRestoreStatusX(sts);
+
+    return TICKS_TO_US((uint64_t)ticks) + us_offset_copy;
+}
+
+uint32_t timer_read_us(void) {
+#if (1000000 % CH_CFG_ST_FREQUENCY) == 0
+    syssts_t sts            = chSysGetStatusAndLockX();
+    uint32_t ticks          = get_elapsed_ticks();
+    uint32_t us_offset_copy = (uint32_t)us_offset;
+    chSysRestoreStatusX(sts);
+
+    // The low 32 bits of timer_read_us64(), without the 64-bit arithmetic
+    return TICKS_TO_US(ticks) + us_offset_copy;
+#else
+    return (uint32_t)timer_read_us64();
+#endif
+}
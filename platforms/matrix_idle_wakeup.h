@@ -0,0 +1,15 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "gpio.h"
+
+/*
+ * Platform hooks that let a matrix input wake the MCU from
+ * matrix_idle_wakeup_wait(). Without them, the standard matrix falls back to
+ * polling its inputs.
+ */
+
+void matrix_idle_wakeup_enable(pin_t pin);
+void matrix_idle_wakeup_disable(pin_t pin);
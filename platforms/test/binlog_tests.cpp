@@ -0,0 +1,57 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "binlog.h"
+}
+
+/* The test sendchar() prints to stdout */
+static std::vector<uint8_t> capture_write(uint32_t id, const uint32_t *args, uint8_t count) {
+    testing::internal::CaptureStdout();
+    binlog_write(id, args, count);
+    std::string sent = testing::internal::GetCapturedStdout();
+    return std::vector<uint8_t>(sent.begin(), sent.end());
+}
+
+// The same ids are checked by lib/python/qmk/tests/test_qmk_binlog.py
+TEST(Binlog, IdMatchesDictionary) {
+    EXPECT_EQ(BINLOG_ID("hello"), 0x059355EA);
+    EXPECT_EQ(BINLOG_ID("scan rate: %d\n"), 0x5C1B1F8D);
+    EXPECT_EQ(BINLOG_ID("key %02X %s"), 0xA883ADE2);
+    EXPECT_EQ(BINLOG_ID(""), 0x050C5D1F);
+}
+
+TEST(Binlog, IdOfLongFormatIncludesLength) {
+    // Only the first BINLOG_HASH_LENGTH characters are hashed, then the length
+    EXPECT_EQ(BINLOG_ID("xxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxx"), 0x7C2ABF5F);
+    EXPECT_EQ(BINLOG_ID("xxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxx"), 0x7B2ABDCC);
+}
+
+TEST(Binlog, IdIsConstant) {
+    static_assert(BINLOG_ID("hello") == 0x059355EA, "BINLOG_ID() must fold to a constant");
+}
+
+TEST(Binlog, WritesFrame) {
+    const uint32_t args[] = {(uint32_t)-1, 300};
+    const std::vector<uint8_t> expected = {0xFA, 0x8D, 0x1F, 0x1B, 0x5C, 0xFF, 0xFF, 0xFF, 0xFF, 0x0F, 0xAC, 0x02};
+    EXPECT_EQ(capture_write(BINLOG_ID("scan rate: %d\n"), args, 2), expected);
+}
+
+TEST(Binlog, WritesFrameWithoutArguments) {
+    const std::vector<uint8_t> expected = {0xF8, 0xEA, 0x55, 0x93, 0x05};
+    EXPECT_EQ(capture_write(BINLOG_ID("hello"), NULL, 0), expected);
+}
+
+TEST(Binlog, ArgumentsAreLimited) {
+    const uint32_t       args[BINLOG_MAX_ARGS + 1] = {};
+    std::vector<uint8_t> sent                      = capture_write(0, args, BINLOG_MAX_ARGS + 1);
+
+    ASSERT_FALSE(sent.empty());
+    EXPECT_EQ(sent[0], BINLOG_FRAME_MARKER | BINLOG_MAX_ARGS);
+    EXPECT_EQ(sent.size(), 5 + BINLOG_MAX_ARGS);
+}
@@ -0,0 +1,119 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "console_ring.h"
+}
+
+class ConsoleRing : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        console_ring_consume(console_ring_used());
+
+        // Moves back to the start of the buffer, so wrapping happens in the same place in every test
+        print(std::string((CONSOLE_RING_BUFFER_SIZE - written % CONSOLE_RING_BUFFER_SIZE) % CONSOLE_RING_BUFFER_SIZE, ' '));
+        flush(CONSOLE_RING_BUFFER_SIZE);
+        console_ring_take_dropped();
+    }
+
+    // Characters stored since startup, which tells where in the buffer the next one goes
+    static size_t written;
+
+    bool write(uint8_t c) {
+        bool stored = console_ring_write(c);
+        written += stored;
+        return stored;
+    }
+
+    void print(const std::string &text) {
+        for (char c : text) {
+            write(c);
+        }
+    }
+
+    /* console_task(), sending at most `packet` characters at a time */
+    std::string flush(size_t packet) {
+        std::string          sent;
+        std::vector<uint8_t> data(packet);
+        size_t               size;
+        while ((size = console_ring_copy(data.data(), packet)) > 0) {
+            sent.append(reinterpret_cast<const char *>(data.data()), size);
+            console_ring_consume(size);
+        }
+        return sent;
+    }
+};
+
+size_t ConsoleRing::written = 0;
+
+TEST_F(ConsoleRing, KeepsOrder) {
+    print("hello world\n");
+    EXPECT_EQ(console_ring_used(), 12);
+    EXPECT_EQ(flush(8), "hello world\n");
+    EXPECT_EQ(console_ring_used(), 0);
+    EXPECT_EQ(console_ring_free(), CONSOLE_RING_BUFFER_SIZE);
+}
+
+TEST_F(ConsoleRing, CopySpansWrap) {
+    print(std::string(48, 'a'));
+    flush(CONSOLE_RING_BUFFER_SIZE);
+
+    // 16 characters before the end of the ring and 16 after, copied as a single packet
+    print(std::string(16, 'b') + std::string(16, 'c'));
+    uint8_t packet[32];
+    ASSERT_EQ(console_ring_copy(packet, sizeof(packet)), 32);
+    EXPECT_EQ(std::string(reinterpret_cast<const char *>(packet), 32), std::string(16, 'b') + std::string(16, 'c'));
+    EXPECT_EQ(console_ring_used(), 32) << "Copying should not consume";
+
+    // Only what is stored is copied
+    console_ring_consume(24);
+    EXPECT_EQ(console_ring_copy(packet, sizeof(packet)), 8);
+    EXPECT_EQ(std::string(reinterpret_cast<const char *>(packet), 8), std::string(8, 'c'));
+}
+
+TEST_F(ConsoleRing, WrapsManyTimes) {
+    std::string expected;
+    for (int i = 0; i < 1000; i++) {
+        std::string line = "line " + std::to_string(i) + "\n";
+        print(line);
+        expected += line;
+        if (i % 3 == 0) {
+            EXPECT_EQ(flush(32), expected);
+            expected.clear();
+        }
+    }
+    EXPECT_EQ(flush(32), expected);
+    EXPECT_EQ(console_ring_take_dropped(), 0);
+}
+
+TEST_F(ConsoleRing, DropsWhenFull) {
+    uint32_t before = get_console_dropped();
+
+    for (int i = 0; i < CONSOLE_RING_BUFFER_SIZE; i++) {
+        EXPECT_TRUE(write('x'));
+    }
+    EXPECT_EQ(console_ring_free(), 0);
+    EXPECT_FALSE(write('y'));
+    EXPECT_FALSE(write('y'));
+
+    // What was stored before the ring filled up is kept
+    EXPECT_EQ(flush(32), std::string(CONSOLE_RING_BUFFER_SIZE, 'x'));
+
+    EXPECT_EQ(console_ring_take_dropped(), 2);
+    EXPECT_EQ(console_ring_take_dropped(), 0);
+    EXPECT_EQ(get_console_dropped(), before + 2);
+}
+
+TEST_F(ConsoleRing, ConsumeIsClamped) {
+    print("abc");
+    console_ring_consume(10);
+    EXPECT_EQ(console_ring_used(), 0);
+
+    print("def");
+    EXPECT_EQ(flush(32), "def");
+}
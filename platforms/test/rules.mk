@@ -23,3 +23,43 @@ eeprom_legacy_emulated_flash_SRC := \
 	$(PLATFORM_PATH)/chibios/drivers/eeprom/eeprom_legacy_emulated_flash.c
 eeprom_legacy_emulated_flash_tiny_SRC := $(eeprom_legacy_emulated_flash_SRC)
 eeprom_legacy_emulated_flash_large_SRC := $(eeprom_legacy_emulated_flash_SRC)
+
+usb_report_mailbox_DEFS := -DNKRO_ENABLE -DMOUSE_SHARED_EP
+usb_report_mailbox_INC := \
+	$(TMK_PATH)/protocol/chibios
+usb_report_mailbox_SRC := \
+	$(TMK_PATH)/protocol/chibios/usb_report_mailbox.c \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/usb_report_mailbox_tests.cpp
+
+usb_polling_interval_INC := \
+	$(TMK_PATH)/protocol
+usb_polling_interval_SRC := \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/usb_polling_interval_tests.cpp
+usb_polling_interval_full_speed_DEFS := -DUSB_POLLING_INTERVAL_MS=4
+usb_polling_interval_full_speed_INC := $(usb_polling_interval_INC)
+usb_polling_interval_full_speed_SRC := $(usb_polling_interval_SRC)
+usb_polling_interval_high_speed_DEFS := -DUSB_HIGH_SPEED -DMOUSE_POLLING_INTERVAL_US=250
+usb_polling_interval_high_speed_INC := $(usb_polling_interval_INC)
+usb_polling_interval_high_speed_SRC := $(usb_polling_interval_SRC)
+usb_polling_interval_high_speed_ms_DEFS := -DUSB_HIGH_SPEED -DUSB_POLLING_INTERVAL_MS=2
+usb_polling_interval_high_speed_ms_INC := $(usb_polling_interval_INC)
+usb_polling_interval_high_speed_ms_SRC := $(usb_polling_interval_SRC)
+
+console_ring_DEFS := -DCONSOLE_RING_BUFFER_SIZE=64
+console_ring_INC := \
+	$(QUANTUM_PATH)/logging
+console_ring_SRC := \
+	$(QUANTUM_PATH)/logging/console_ring.c \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/console_ring_tests.cpp
+
+binlog_DEFS := -DBINLOG_ENABLE
+binlog_INC := \
+	$(QUANTUM_PATH)/logging
+binlog_SRC := \
+	$(QUANTUM_PATH)/logging/binlog.c \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/binlog_tests.cpp
+
+timer_SRC := \
+	$(PLATFORM_PATH)/timer.c \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/timer.c \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/timer_tests.cpp
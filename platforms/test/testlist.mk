@@ -1 +1,6 @@
 TEST_LIST += eeprom_legacy_emulated_flash_tiny eeprom_legacy_emulated_flash_large
+TEST_LIST += usb_report_mailbox
+TEST_LIST += usb_polling_interval_full_speed usb_polling_interval_high_speed usb_polling_interval_high_speed_ms
+TEST_LIST += console_ring
+TEST_LIST += binlog
+TEST_LIST += timer
@@ -17,7 +17,8 @@
 #include "timer.h"
 #include <stdatomic.h>
 
-static atomic_uint_least32_t current_time      = 0;
+// Kept in microseconds, so that the millisecond timer wraps while the 64-bit microsecond one doesn't
+static atomic_uint_least64_t current_time      = 0;
 static atomic_uint_least32_t async_tick_amount = 0;
 static atomic_uint_least32_t access_counter    = 0;
 
@@ -26,7 +27,7 @@ void simulate_async_tick(uint32_t t) {
 }
 
 uint32_t timer_read_internal(void) {
-    return current_time;
+    return TIMER_US_TO_MS(current_time);
 }
 
 uint32_t current_access_counter(void) {
@@ -49,24 +50,46 @@ void timer_clear(void) {
     access_counter    = 0;
 }
 
+static uint64_t timer_read_internal_us(void) {
+    if (access_counter++ > 0) {
+        current_time += TIMER_MS_TO_US(async_tick_amount);
+    }
+    return current_time;
+}
+
 uint16_t timer_read(void) {
     return (uint16_t)timer_read32();
 }
 
 uint32_t timer_read32(void) {
-    if (access_counter++ > 0) {
-        current_time += async_tick_amount;
-    }
-    return current_time;
+    return TIMER_US_TO_MS(timer_read_internal_us());
+}
+
+uint32_t timer_read_us(void) {
+    return (uint32_t)timer_read_internal_us();
+}
+
+uint64_t timer_read_us64(void) {
+    return timer_read_internal_us();
 }
 
 void set_time(uint32_t t) {
+    current_time   = TIMER_MS_TO_US(t);
+    access_counter = 0;
+}
+
+void set_time_us64(uint64_t t) {
     current_time   = t;
     access_counter = 0;
 }
 
 void advance_time(uint32_t ms) {
-    current_time += ms;
+    current_time += TIMER_MS_TO_US(ms);
+    access_counter = 0;
+}
+
+void advance_time_us(uint32_t us) {
+    current_time += us;
     access_counter = 0;
 }
 
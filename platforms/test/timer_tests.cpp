@@ -0,0 +1,75 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "timer.h"
+
+void set_time(uint32_t t);
+void set_time_us64(uint64_t t);
+void advance_time(uint32_t ms);
+void advance_time_us(uint32_t us);
+}
+
+class Timer : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        timer_init();
+    }
+};
+
+TEST_F(Timer, MicrosecondsShareMillisecondEpoch) {
+    set_time(1234);
+    advance_time_us(567);
+    EXPECT_EQ(timer_read32(), 1234);
+    EXPECT_EQ(timer_read_us(), 1234567);
+    EXPECT_EQ(timer_read_us64(), 1234567);
+
+    advance_time_us(433);
+    EXPECT_EQ(timer_read32(), 1235);
+}
+
+TEST_F(Timer, Conversions) {
+    EXPECT_EQ(TIMER_MS_TO_US(UINT32_MAX), 4294967295000ULL);
+    EXPECT_EQ(TIMER_US_TO_MS(4294967295999ULL), UINT32_MAX);
+    EXPECT_EQ(TIMER_US_TO_MS(999), 0);
+}
+
+TEST_F(Timer, MicrosecondsWrapAt32Bits) {
+    // 2^32 microseconds is a little over 71 minutes
+    set_time_us64(UINT32_MAX - 499);
+    uint32_t start = timer_read_us();
+    EXPECT_FALSE(timer_expired_us(start, start + 1000));
+
+    advance_time_us(1000);
+    EXPECT_LT(timer_read_us(), start);
+    EXPECT_EQ(timer_elapsed_us(start), 1000);
+    EXPECT_EQ(TIMER_DIFF_US(timer_read_us(), start), 1000);
+    EXPECT_TRUE(timer_expired_us(timer_read_us(), start + 1000));
+
+    EXPECT_EQ(timer_read_us64(), (uint64_t)UINT32_MAX + 501);
+}
+
+TEST_F(Timer, SixtyFourBitsOutlastMilliseconds) {
+    // The 32-bit millisecond timer wraps after ~49.7 days
+    set_time(UINT32_MAX - 1);
+    uint64_t start = timer_read_us64();
+
+    advance_time(3);
+    EXPECT_EQ(timer_read32(), 1);
+    EXPECT_EQ(timer_read_us64(), start + 3000);
+    EXPECT_EQ(timer_elapsed_us64(start), 3000);
+    EXPECT_EQ(timer_read_us64() / 1000, timer_read32() + (1ULL << 32));
+}
+
+TEST_F(Timer, SixteenBitMillisecondsWrap) {
+    set_time(UINT16_MAX);
+    uint16_t start = timer_read();
+    uint32_t us    = timer_read_us();
+
+    advance_time(2);
+    EXPECT_EQ(timer_read(), 1);
+    EXPECT_EQ(timer_elapsed(start), 2);
+    EXPECT_EQ(timer_elapsed_us(us), 2000);
+}
@@ -0,0 +1,78 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "usb_descriptor_common.h"
+}
+
+#ifdef USB_HIGH_SPEED
+
+#    ifdef USB_POLLING_INTERVAL_MS
+
+TEST(UsbPollingInterval, ConvertsPollingIntervalMs) {
+    EXPECT_EQ(USB_POLLING_INTERVAL_US, USB_POLLING_INTERVAL_MS * 1000UL);
+    EXPECT_EQ(USB_INTERVAL_US(KEYBOARD_POLLING_INTERVAL_US), USB_INTERVAL_MS(USB_POLLING_INTERVAL_MS));
+    EXPECT_EQ(USB_INTERVAL_US(MOUSE_POLLING_INTERVAL_US), USB_INTERVAL_MS(USB_POLLING_INTERVAL_MS));
+    EXPECT_EQ(USB_INTERVAL_US(SHARED_POLLING_INTERVAL_US), USB_INTERVAL_MS(USB_POLLING_INTERVAL_MS));
+    EXPECT_EQ(USB_INTERVAL_FULL_SPEED(USB_INTERVAL_US(KEYBOARD_POLLING_INTERVAL_US)), USB_POLLING_INTERVAL_MS);
+}
+
+#    else
+
+TEST(UsbPollingInterval, DefaultsTo8kHz) {
+    EXPECT_EQ(USB_POLLING_INTERVAL_US, 125);
+    EXPECT_EQ(USB_INTERVAL_US(KEYBOARD_POLLING_INTERVAL_US), 1);
+    EXPECT_EQ(USB_INTERVAL_US(SHARED_POLLING_INTERVAL_US), 1);
+}
+
+TEST(UsbPollingInterval, PerEndpointOverride) {
+    EXPECT_EQ(USB_INTERVAL_US(MOUSE_POLLING_INTERVAL_US), 2);
+}
+
+#    endif
+
+TEST(UsbPollingInterval, MicroframeExponent) {
+    EXPECT_EQ(USB_INTERVAL_US(125), 1);
+    EXPECT_EQ(USB_INTERVAL_US(250), 2);
+    EXPECT_EQ(USB_INTERVAL_US(500), 3);
+    EXPECT_EQ(USB_INTERVAL_MS(1), 4);
+    EXPECT_EQ(USB_INTERVAL_MS(8), 7);
+    EXPECT_EQ(USB_INTERVAL_MS(255), 11);
+}
+
+TEST(UsbPollingInterval, FullSpeedFrames) {
+    EXPECT_EQ(USB_INTERVAL_FULL_SPEED(USB_INTERVAL_US(125)), 1);
+    EXPECT_EQ(USB_INTERVAL_FULL_SPEED(USB_INTERVAL_MS(1)), 1);
+    EXPECT_EQ(USB_INTERVAL_FULL_SPEED(USB_INTERVAL_MS(2)), 2);
+    EXPECT_EQ(USB_INTERVAL_FULL_SPEED(USB_INTERVAL_MS(8)), 8);
+    EXPECT_EQ(USB_INTERVAL_FULL_SPEED(USB_INTERVAL_MS(128)), 128);
+    EXPECT_EQ(USB_INTERVAL_FULL_SPEED(USB_INTERVAL_MS(255)), 128);
+    EXPECT_EQ(USB_INTERVAL_FULL_SPEED(12), 255);
+}
+
+TEST(UsbPollingInterval, RoundsDownToPowerOfTwo) {
+    EXPECT_EQ(USB_INTERVAL_US(100), 1);
+    EXPECT_EQ(USB_INTERVAL_US(499), 2);
+    EXPECT_EQ(USB_INTERVAL_US(999), 3);
+    EXPECT_EQ(USB_INTERVAL_MS(10), 7);
+}
+
+#else
+
+TEST(UsbPollingInterval, MatchesPollingIntervalMs) {
+    EXPECT_EQ(USB_INTERVAL_US(KEYBOARD_POLLING_INTERVAL_US), USB_POLLING_INTERVAL_MS);
+    EXPECT_EQ(USB_INTERVAL_US(MOUSE_POLLING_INTERVAL_US), USB_POLLING_INTERVAL_MS);
+    EXPECT_EQ(USB_INTERVAL_US(SHARED_POLLING_INTERVAL_US), USB_POLLING_INTERVAL_MS);
+}
+
+TEST(UsbPollingInterval, WholeFrames) {
+    EXPECT_EQ(USB_INTERVAL_US(125), 1);
+    EXPECT_EQ(USB_INTERVAL_MS(1), 1);
+    EXPECT_EQ(USB_INTERVAL_US(2500), 2);
+    EXPECT_EQ(USB_INTERVAL_MS(255), 255);
+    EXPECT_EQ(USB_INTERVAL_MS(1000), 255);
+}
+
+#endif
@@ -0,0 +1,328 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <deque>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "usb_report_mailbox.h"
+#include "report.h"
+}
+
+/*
+ * Models an IN endpoint with a mailbox in front of its output buffers queue,
+ * the same way usb_driver.c drives it, and a host that only takes a report out
+ * of the queue when it polls.
+ */
+class SlowHost {
+   public:
+    SlowHost(usb_report_merge_t merge, size_t capacity, size_t queue_capacity) : pending(capacity), previous(capacity), queue_capacity(queue_capacity) {
+        mailbox = {merge, pending.data(), previous.data(), capacity, 0, 0, false};
+    }
+
+    /* usb_endpoint_in_send() */
+    void send(const void *data, size_t size) {
+        const uint8_t *report = static_cast<const uint8_t *>(data);
+        while (true) {
+            switch (usb_report_mailbox_post(&mailbox, report, size, queue.size() < queue_capacity)) {
+                case USB_REPORT_MAILBOX_SEND:
+                    queue.emplace_back(report, report + size);
+                    return;
+                case USB_REPORT_MAILBOX_HELD:
+                    return;
+                case USB_REPORT_MAILBOX_BLOCKED:
+                    // Waits for room in the queue, then queues the held report
+                    blocked++;
+                    while (queue.size() >= queue_capacity) {
+                        poll();
+                    }
+                    take_held();
+                    break;
+            }
+        }
+    }
+
+    /* The host reading a report, followed by usb_endpoint_in_tx_complete_cb() */
+    void poll(void) {
+        if (!queue.empty()) {
+            received.push_back(queue.front());
+            queue.pop_front();
+        }
+        if (queue.size() < queue_capacity) {
+            take_held();
+        }
+    }
+
+    void drain(void) {
+        while (!queue.empty() || mailbox.has_pending) {
+            poll();
+        }
+    }
+
+    std::vector<std::vector<uint8_t>> received;
+    usb_report_mailbox_t              mailbox;
+    int                               blocked = 0;
+
+   private:
+    void take_held(void) {
+        std::vector<uint8_t> report(mailbox.capacity);
+        size_t               size = usb_report_mailbox_take(&mailbox, report.data());
+        if (size > 0) {
+            report.resize(size);
+            queue.push_back(report);
+        }
+    }
+
+    std::vector<uint8_t>             pending;
+    std::vector<uint8_t>             previous;
+    size_t                           queue_capacity;
+    std::deque<std::vector<uint8_t>> queue;
+};
+
+static void set_key(report_keyboard_t *report, uint8_t key, bool pressed) {
+    for (uint8_t i = 0; i < KEYBOARD_REPORT_KEYS; i++) {
+        if (pressed ? report->keys[i] == 0 : report->keys[i] == key) {
+            report->keys[i] = pressed ? key : 0;
+            return;
+        }
+    }
+}
+
+static bool has_key(const uint8_t *report, uint8_t key) {
+    for (uint8_t i = 0; i < KEYBOARD_REPORT_KEYS; i++) {
+        if (report[2 + i] == key) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/* The number of times `key` changes state over a sequence of boot keyboard reports. */
+static int key_transitions(const std::vector<std::vector<uint8_t>> &reports, uint8_t key) {
+    int  transitions = 0;
+    bool pressed     = false;
+    for (const auto &report : reports) {
+        if (has_key(report.data(), key) != pressed) {
+            pressed = !pressed;
+            transitions++;
+        }
+    }
+    return transitions;
+}
+
+TEST(UsbReportMailbox, SendsDirectlyWhileQueueHasRoom) {
+    SlowHost       host(usb_report_merge_mouse, sizeof(report_mouse_t), 4);
+    report_mouse_t report = {};
+    report.x              = 1;
+
+    for (int i = 0; i < 4; i++) {
+        host.send(&report, sizeof(report));
+    }
+    EXPECT_FALSE(host.mailbox.has_pending);
+
+    host.drain();
+    EXPECT_EQ(host.received.size(), 4);
+}
+
+TEST(UsbReportMailbox, MouseBurstNeverBlocks) {
+    SlowHost       host(usb_report_merge_mouse, sizeof(report_mouse_t), 2);
+    report_mouse_t report = {};
+    report.x              = 3;
+    report.y              = -2;
+    report.v              = 1;
+
+    // The host polls once for every 8 reports
+    for (int i = 0; i < 1000; i++) {
+        host.send(&report, sizeof(report));
+        if (i % 8 == 7) {
+            host.poll();
+        }
+    }
+    host.drain();
+
+    EXPECT_EQ(host.blocked, 0);
+    EXPECT_LT(host.received.size(), 1000 / 4);
+
+    int x = 0, y = 0, v = 0;
+    for (const auto &received : host.received) {
+        report_mouse_t seen;
+        memcpy(&seen, received.data(), sizeof(seen));
+        x += seen.x;
+        y += seen.y;
+        v += seen.v;
+    }
+    EXPECT_EQ(x, 3000);
+    EXPECT_EQ(y, -2000);
+    EXPECT_EQ(v, 1000);
+}
+
+TEST(UsbReportMailbox, MouseMovementSaturationIsNotMerged) {
+    SlowHost       host(usb_report_merge_mouse, sizeof(report_mouse_t), 1);
+    report_mouse_t report = {};
+    report.x              = 100;
+
+    host.send(&report, sizeof(report));
+    host.send(&report, sizeof(report));
+    EXPECT_TRUE(host.mailbox.has_pending);
+
+    // 200 doesn't fit in the held report
+    host.send(&report, sizeof(report));
+    EXPECT_EQ(host.blocked, 1);
+
+    host.drain();
+    EXPECT_EQ(host.received.size(), 3);
+}
+
+TEST(UsbReportMailbox, MouseButtonChangeIsNotMerged) {
+    SlowHost       host(usb_report_merge_mouse, sizeof(report_mouse_t), 1);
+    report_mouse_t report = {};
+
+    host.send(&report, sizeof(report));
+    report.buttons = 1;
+    host.send(&report, sizeof(report));
+    report.buttons = 0;
+    host.send(&report, sizeof(report));
+    host.drain();
+
+    ASSERT_EQ(host.received.size(), 3);
+    EXPECT_EQ(host.received[1][offsetof(report_mouse_t, buttons)], 1);
+    EXPECT_EQ(host.received[2][offsetof(report_mouse_t, buttons)], 0);
+}
+
+TEST(UsbReportMailbox, KeyboardRollKeepsEveryTransition) {
+    SlowHost                          host(usb_report_merge_keyboard, sizeof(report_keyboard_t), 1);
+    std::vector<std::vector<uint8_t>> sent;
+    report_keyboard_t                 report = {};
+
+    // Rolling over keys, each pressed before the previous one is released
+    for (uint8_t key = KC_A; key <= KC_Z; key++) {
+        set_key(&report, key, true);
+        host.send(&report, sizeof(report));
+        sent.emplace_back((uint8_t *)&report, (uint8_t *)&report + sizeof(report));
+        if (key > KC_A) {
+            set_key(&report, key - 1, false);
+            host.send(&report, sizeof(report));
+            sent.emplace_back((uint8_t *)&report, (uint8_t *)&report + sizeof(report));
+        }
+        if (key % 3 == 0) {
+            host.poll();
+        }
+    }
+    set_key(&report, KC_Z, false);
+    host.send(&report, sizeof(report));
+    sent.emplace_back((uint8_t *)&report, (uint8_t *)&report + sizeof(report));
+    host.drain();
+
+    EXPECT_LT(host.received.size(), sent.size());
+    for (uint8_t key = KC_A; key <= KC_Z; key++) {
+        EXPECT_EQ(key_transitions(host.received, key), key_transitions(sent, key)) << "key " << (int)key;
+    }
+}
+
+TEST(UsbReportMailbox, KeyboardTapIsNeverMerged) {
+    SlowHost          host(usb_report_merge_keyboard, sizeof(report_keyboard_t), 1);
+    report_keyboard_t report = {};
+
+    host.send(&report, sizeof(report));
+    set_key(&report, KC_A, true);
+    host.send(&report, sizeof(report));
+    set_key(&report, KC_A, false);
+    host.send(&report, sizeof(report));
+    host.drain();
+
+    // Releasing the key the held report presses has to wait for it to be sent
+    EXPECT_EQ(host.blocked, 1);
+    EXPECT_EQ(key_transitions(host.received, KC_A), 2);
+}
+
+TEST(UsbReportMailbox, KeyboardModifierTapIsNeverMerged) {
+    SlowHost          host(usb_report_merge_keyboard, sizeof(report_keyboard_t), 1);
+    report_keyboard_t report = {};
+
+    host.send(&report, sizeof(report));
+    report.mods = MOD_BIT(KC_LEFT_SHIFT);
+    host.send(&report, sizeof(report));
+    report.mods |= MOD_BIT(KC_LEFT_CTRL);
+    host.send(&report, sizeof(report));
+    EXPECT_EQ(host.blocked, 0);
+
+    report.mods = 0;
+    host.send(&report, sizeof(report));
+    EXPECT_EQ(host.blocked, 1);
+
+    host.drain();
+    ASSERT_EQ(host.received.size(), 3);
+    EXPECT_EQ(host.received[1][0], MOD_BIT(KC_LEFT_SHIFT) | MOD_BIT(KC_LEFT_CTRL));
+    EXPECT_EQ(host.received[2][0], 0);
+}
+
+TEST(UsbReportMailbox, NkroCoalescesPresses) {
+    SlowHost      host(usb_report_merge_shared, sizeof(report_nkro_t), 1);
+    report_nkro_t report = {};
+    report.report_id     = REPORT_ID_NKRO;
+
+    host.send(&report, sizeof(report));
+    for (uint8_t key = KC_A; key <= KC_Z; key++) {
+        report.bits[key / 8] |= 1 << (key % 8);
+        host.send(&report, sizeof(report));
+    }
+    host.drain();
+
+    EXPECT_EQ(host.blocked, 0);
+    ASSERT_EQ(host.received.size(), 2);
+    EXPECT_EQ(memcmp(host.received[1].data(), &report, sizeof(report)), 0);
+}
+
+TEST(UsbReportMailbox, NkroConflictBlocks) {
+    SlowHost      host(usb_report_merge_shared, sizeof(report_nkro_t), 1);
+    report_nkro_t report = {};
+    report.report_id     = REPORT_ID_NKRO;
+
+    host.send(&report, sizeof(report));
+    report.bits[KC_A / 8] |= 1 << (KC_A % 8);
+    host.send(&report, sizeof(report));
+    report.bits[KC_A / 8] &= ~(1 << (KC_A % 8));
+    host.send(&report, sizeof(report));
+    host.drain();
+
+    EXPECT_EQ(host.blocked, 1);
+    EXPECT_EQ(host.received.size(), 3);
+}
+
+TEST(UsbReportMailbox, SharedReportIdsAreKeptInOrder) {
+    SlowHost       host(usb_report_merge_shared, sizeof(report_nkro_t), 1);
+    report_extra_t extra = {};
+    report_mouse_t mouse = {};
+    extra.report_id      = REPORT_ID_CONSUMER;
+    mouse.report_id      = REPORT_ID_MOUSE;
+    mouse.x              = 1;
+
+    host.send(&mouse, sizeof(mouse));
+    host.send(&mouse, sizeof(mouse));
+    host.send(&extra, sizeof(extra));
+    host.send(&mouse, sizeof(mouse));
+    host.drain();
+
+    ASSERT_EQ(host.received.size(), 4);
+    EXPECT_EQ(host.received[0][0], REPORT_ID_MOUSE);
+    EXPECT_EQ(host.received[1][0], REPORT_ID_MOUSE);
+    EXPECT_EQ(host.received[2][0], REPORT_ID_CONSUMER);
+    EXPECT_EQ(host.received[3][0], REPORT_ID_MOUSE);
+}
+
+TEST(UsbReportMailbox, ResetDropsHeldReport) {
+    SlowHost       host(usb_report_merge_mouse, sizeof(report_mouse_t), 1);
+    report_mouse_t report = {};
+
+    host.send(&report, sizeof(report));
+    host.send(&report, sizeof(report));
+    EXPECT_TRUE(host.mailbox.has_pending);
+
+    usb_report_mailbox_reset(&host.mailbox);
+    EXPECT_FALSE(host.mailbox.has_pending);
+
+    host.drain();
+    EXPECT_EQ(host.received.size(), 1);
+}
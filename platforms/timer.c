@@ -14,3 +14,11 @@ uint16_t timer_elapsed(uint16_t last) {
 uint32_t timer_elapsed32(uint32_t last) {
     return TIMER_DIFF_32(timer_read32(), last);
 }
+
+uint32_t timer_elapsed_us(uint32_t last) {
+    return TIMER_DIFF_US(timer_read_us(), last);
+}
+
+uint64_t timer_elapsed_us64(uint64_t last) {
+    return timer_read_us64() - last;
+}
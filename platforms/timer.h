@@ -28,6 +28,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #define TIMER_DIFF_16(a, b) (uint16_t)((a) - (b))
 #define TIMER_DIFF_32(a, b) (uint32_t)((a) - (b))
 #define TIMER_DIFF_RAW(a, b) TIMER_DIFF_8(a, b)
+#define TIMER_DIFF_US(a, b) TIMER_DIFF_32(a, b)
 
 #ifdef __cplusplus
 extern "C" {
@@ -44,9 +45,20 @@ uint32_t timer_read32(void);
 uint16_t timer_elapsed(uint16_t last);
 uint32_t timer_elapsed32(uint32_t last);
 
+// Microseconds since the timer was cleared, with the same epoch as timer_read32(). The resolution depends on the
+// platform's timer, e.g. CH_CFG_ST_FREQUENCY on ChibiOS. The 32-bit value wraps every ~71 minutes, the 64-bit one doesn't.
+uint32_t timer_read_us(void);
+uint64_t timer_read_us64(void);
+uint32_t timer_elapsed_us(uint32_t last);
+uint64_t timer_elapsed_us64(uint64_t last);
+
+#define TIMER_MS_TO_US(ms) ((uint64_t)(ms) * 1000)
+#define TIMER_US_TO_MS(us) ((uint32_t)((us) / 1000))
+
 // Utility functions to check if a future time has expired & autmatically handle time wrapping if checked / reset frequently (half of max value)
-#define timer_expired(current, future) ((uint16_t)(current - future) < UINT16_MAX / 2)
-#define timer_expired32(current, future) ((uint32_t)(current - future) < UINT32_MAX / 2)
+#define timer_expired(current, future) ((uint16_t)((current) - (future)) < UINT16_MAX / 2)
+#define timer_expired32(current, future) ((uint32_t)((current) - (future)) < UINT32_MAX / 2)
+#define timer_expired_us(current, future) timer_expired32(current, future)
 
 // Use an appropriate timer integer size based on architecture (16-bit will overflow sooner)
 #if FAST_TIMER_T_SIZE < 32
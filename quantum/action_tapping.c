@@ -1,11 +1,14 @@
 #include <stdint.h>
 #include <stdbool.h>
+#include <string.h>
 
 #include "action.h"
 #include "action_layer.h"
 #include "action_tapping.h"
 #include "keycode.h"
+#include "matrix.h"
 #include "timer.h"
+#include "util.h"
 
 #ifndef NO_ACTION_TAPPING
 
@@ -49,22 +52,24 @@ __attribute__((weak)) bool get_permissive_hold(uint16_t keycode, keyrecord_t *re
 }
 #    endif
 
-#    if defined(CHORDAL_HOLD)
-extern const char chordal_hold_layout[MATRIX_ROWS][MATRIX_COLS] PROGMEM;
-
+#    if defined(CHORDAL_HOLD) || defined(PREDICTIVE_TAP_HOLD)
 #        define REGISTERED_TAPS_SIZE 8
-// Array of tap-hold keys that have been settled as tapped but not yet released.
-static keypos_t registered_taps[REGISTERED_TAPS_SIZE] = {};
-static uint8_t  num_registered_taps                   = 0;
+// Tap-hold keys that have been settled as tapped but not yet released, as a
+// bitmap for keys in the matrix, and an array for the others, e.g. combos.
+static matrix_row_t registered_taps[MATRIX_ROWS]                = {};
+static keypos_t     registered_taps_other[REGISTERED_TAPS_SIZE] = {};
+static uint8_t      num_registered_taps_other                   = 0;
 
-/** Adds `key` to the registered_taps array. */
+/** Adds `key` to the registered taps. */
 static void registered_taps_add(keypos_t key);
-/** Returns the index of `key` in registered_taps, or -1 if not found. */
-static int8_t registered_tap_find(keypos_t key);
-/** Removes index `i` from the registered_taps array. */
-static void registered_taps_del_index(uint8_t i);
-/** Logs the registered_taps array for debugging. */
+/** Removes `key` from the registered taps, returning whether it was there. */
+static bool registered_taps_del(keypos_t key);
+/** Logs the registered taps for debugging. */
 static void debug_registered_taps(void);
+#    endif
+
+#    if defined(CHORDAL_HOLD)
+extern const char chordal_hold_layout[MATRIX_ROWS][MATRIX_COLS] PROGMEM;
 
 /** \brief Finds which queued events should be held according to Chordal Hold.
  *
@@ -88,6 +93,15 @@ static bool is_mt_or_lt(uint16_t keycode) {
 }
 #    endif // CHORDAL_HOLD
 
+#    ifdef PREDICTIVE_TAP_HOLD
+/** \brief Learns the typing cadence of tap-hold keys from the events as they come from the matrix. */
+static void cadence_track(keyrecord_t *record);
+/** \brief Whether a tap-hold key pressed while typing quickly can be settled as tapped straight away. */
+static bool predict_tap_on_press(keyrecord_t *record);
+/** \brief Whether the tapping key can be settled as tapped when another key is pressed. */
+static bool predict_tap_on_interrupt(keyrecord_t *record);
+#    endif
+
 #    ifdef HOLD_ON_OTHER_KEY_PRESS_PER_KEY
 __attribute__((weak)) bool get_hold_on_other_key_press(uint16_t keycode, keyrecord_t *record) {
     return false;
@@ -98,25 +112,51 @@ __attribute__((weak)) bool get_hold_on_other_key_press(uint16_t keycode, keyreco
 #        include "process_auto_shift.h"
 #    endif
 
+#    if WAITING_BUFFER_SIZE < 2 || WAITING_BUFFER_SIZE > 255
+#        error "WAITING_BUFFER_SIZE must be between 2 and 255"
+#    endif
+
 static keyrecord_t tapping_key                         = {};
 static keyrecord_t waiting_buffer[WAITING_BUFFER_SIZE] = {};
 static uint8_t     waiting_buffer_head                 = 0;
 static uint8_t     waiting_buffer_tail                 = 0;
 
+/* Summary of the queued events, so that looking up a key doesn't need to scan
+ * the buffer: the keys in the matrix with a press or a release queued, how
+ * many events were queued for a key and state that already had one, and the
+ * number of queued presses. */
+static matrix_row_t waiting_buffer_presses_of[MATRIX_ROWS]  = {};
+static matrix_row_t waiting_buffer_releases_of[MATRIX_ROWS] = {};
+static uint8_t      waiting_buffer_repeats                  = 0;
+static uint8_t      waiting_buffer_presses                  = 0;
+
 static bool process_tapping(keyrecord_t *record);
 static bool waiting_buffer_enq(keyrecord_t record);
+static void waiting_buffer_pop(void);
 static void waiting_buffer_clear(void);
+static bool waiting_buffer_find(keyevent_t event);
 static bool waiting_buffer_typed(keyevent_t event);
 static bool waiting_buffer_has_anykey_pressed(void);
 static void waiting_buffer_scan_tap(void);
 static void debug_tapping_key(void);
 static void debug_waiting_buffer(void);
 
+static inline bool key_in_matrix(keypos_t key) {
+    return key.row < MATRIX_ROWS && key.col < MATRIX_COLS;
+}
+
+static inline bool key_bit_is_set(const matrix_row_t *bits, keypos_t key) {
+    return bits[key.row] & ((matrix_row_t)1 << key.col);
+}
+
 /** \brief Action Tapping Process
  *
  * FIXME: Needs doc
  */
 void action_tapping_process(keyrecord_t record) {
+#    ifdef PREDICTIVE_TAP_HOLD
+    cadence_track(&record);
+#    endif
     if (process_tapping(&record)) {
         if (IS_EVENT(record.event)) {
             ac_dprintf("processed: ");
@@ -137,7 +177,7 @@ void action_tapping_process(keyrecord_t record) {
     if (IS_EVENT(record.event) && waiting_buffer_head != waiting_buffer_tail) {
         ac_dprintf("---- action_exec: process waiting_buffer -----\n");
     }
-    for (; waiting_buffer_tail != waiting_buffer_head; waiting_buffer_tail = (waiting_buffer_tail + 1) % WAITING_BUFFER_SIZE) {
+    for (; waiting_buffer_tail != waiting_buffer_head; waiting_buffer_pop()) {
         if (process_tapping(&waiting_buffer[waiting_buffer_tail])) {
             ac_dprintf("processed: waiting_buffer[%u] =", waiting_buffer_tail);
             debug_record(waiting_buffer[waiting_buffer_tail]);
@@ -205,19 +245,15 @@ void action_tapping_process(keyrecord_t record) {
 bool process_tapping(keyrecord_t *keyp) {
     const keyevent_t event = keyp->event;
 
-#    if defined(CHORDAL_HOLD)
-    if (!event.pressed) {
-        const int8_t i = registered_tap_find(event.key);
-        if (i != -1) {
-            // If a tap-hold key was previously settled as tapped, set its
-            // tap.count correspondingly on release.
-            keyp->tap.count = 1;
-            registered_taps_del_index(i);
-            ac_dprintf("Found tap release for [%d]\n", i);
-            debug_registered_taps();
-        }
+#    if defined(CHORDAL_HOLD) || defined(PREDICTIVE_TAP_HOLD)
+    if (!event.pressed && registered_taps_del(event.key)) {
+        // If a tap-hold key was previously settled as tapped, set its
+        // tap.count correspondingly on release.
+        keyp->tap.count = 1;
+        ac_dprintf("Found tap release for %02X%02X\n", event.key.row, event.key.col);
+        debug_registered_taps();
     }
-#    endif // CHORDAL_HOLD
+#    endif
 
     // state machine is in the "reset" state, no tapping key is to be
     // processed
@@ -225,6 +261,18 @@ bool process_tapping(keyrecord_t *keyp) {
         if (!IS_EVENT(event)) {
             // early return for tick events
         } else if (event.pressed && is_tap_record(keyp)) {
+#    ifdef PREDICTIVE_TAP_HOLD
+            if (predict_tap_on_press(keyp)) {
+                // the key has been tapped every time it was pressed while
+                // typing this quickly, so settle it as tapped straight away
+                ac_dprintf("Tapping: Predicted tap(Press tap key).\n");
+                keyp->tap.count = 1;
+                registered_taps_add(event.key);
+                debug_registered_taps();
+                process_record(keyp);
+                return true;
+            }
+#    endif
             // the currently pressed key is a tapping key, therefore transition
             // into the "pressed" tapping key state
             ac_dprintf("Tapping: Start(Press tap key).\n");
@@ -307,7 +355,7 @@ bool process_tapping(keyrecord_t *keyp) {
                     uint8_t first_tap = waiting_buffer_find_chordal_hold_tap();
                     ac_dprintf("first_tap = %u\n", first_tap);
                     if (first_tap < WAITING_BUFFER_SIZE) {
-                        for (; waiting_buffer_tail != first_tap; waiting_buffer_tail = (waiting_buffer_tail + 1) % WAITING_BUFFER_SIZE) {
+                        for (; waiting_buffer_tail != first_tap; waiting_buffer_pop()) {
                             ac_dprintf("Processing [%u]\n", waiting_buffer_tail);
                             process_record(&waiting_buffer[waiting_buffer_tail]);
                         }
@@ -374,6 +422,22 @@ bool process_tapping(keyrecord_t *keyp) {
                     if (event.pressed) {
                         tapping_key.tap.interrupted = true;
 
+#    ifdef PREDICTIVE_TAP_HOLD
+                        if (predict_tap_on_interrupt(keyp)) {
+                            // the other key came as soon after the tapping key
+                            // as it does when this key is rolled as a tap
+                            ac_dprintf("Tapping: End. Predicted tap\n");
+                            tapping_key.tap.interrupted = false;
+                            tapping_key.tap.count       = 1;
+                            registered_taps_add(tapping_key.event.key);
+                            debug_registered_taps();
+                            process_record(&tapping_key);
+                            tapping_key = (keyrecord_t){0};
+                            debug_tapping_key();
+                            // enqueue
+                            return false;
+                        }
+#    endif
 #    if defined(CHORDAL_HOLD)
                         if (is_mt_or_lt(tapping_keycode) && !get_chordal_hold(tapping_keycode, &tapping_key, get_record_keycode(keyp, false), keyp)) {
                             // In process_action(), HOLD_ON_OTHER_KEY_PRESS
@@ -406,8 +470,7 @@ bool process_tapping(keyrecord_t *keyp) {
 #    if defined(CHORDAL_HOLD)
                             if (waiting_buffer_tail != waiting_buffer_head && is_tap_record(&waiting_buffer[waiting_buffer_tail])) {
                                 tapping_key = waiting_buffer[waiting_buffer_tail];
-                                // Pop tail from the queue.
-                                waiting_buffer_tail = (waiting_buffer_tail + 1) % WAITING_BUFFER_SIZE;
+                                waiting_buffer_pop();
                                 debug_waiting_buffer();
                             } else
 #    endif // CHORDAL_HOLD
@@ -584,42 +647,87 @@ bool waiting_buffer_enq(keyrecord_t record) {
     waiting_buffer[waiting_buffer_head] = record;
     waiting_buffer_head                 = (waiting_buffer_head + 1) % WAITING_BUFFER_SIZE;
 
+    if (record.event.pressed) {
+        waiting_buffer_presses++;
+    }
+    if (key_in_matrix(record.event.key)) {
+        matrix_row_t *queued = record.event.pressed ? waiting_buffer_presses_of : waiting_buffer_releases_of;
+        if (key_bit_is_set(queued, record.event.key)) {
+            waiting_buffer_repeats++;
+        }
+        queued[record.event.key.row] |= (matrix_row_t)1 << record.event.key.col;
+    }
+
     ac_dprintf("waiting_buffer_enq: ");
     debug_waiting_buffer();
     return true;
 }
 
+/** \brief Waiting buffer pop
+ *
+ * Removes the oldest event from the waiting buffer.
+ */
+void waiting_buffer_pop(void) {
+    const keyevent_t event = waiting_buffer[waiting_buffer_tail].event;
+    waiting_buffer_tail    = (waiting_buffer_tail + 1) % WAITING_BUFFER_SIZE;
+
+    if (event.pressed) {
+        waiting_buffer_presses--;
+    }
+    if (key_in_matrix(event.key)) {
+        // Only scan for another event of the same key and state if there can be one
+        if (waiting_buffer_repeats > 0 && waiting_buffer_find(event)) {
+            waiting_buffer_repeats--;
+        } else {
+            (event.pressed ? waiting_buffer_presses_of : waiting_buffer_releases_of)[event.key.row] &= ~((matrix_row_t)1 << event.key.col);
+        }
+    }
+}
+
 /** \brief Waiting buffer clear
  *
  * FIXME: Needs docs
  */
 void waiting_buffer_clear(void) {
-    waiting_buffer_head = 0;
-    waiting_buffer_tail = 0;
+    waiting_buffer_head    = 0;
+    waiting_buffer_tail    = 0;
+    waiting_buffer_repeats = 0;
+    waiting_buffer_presses = 0;
+    memset(waiting_buffer_presses_of, 0, sizeof(waiting_buffer_presses_of));
+    memset(waiting_buffer_releases_of, 0, sizeof(waiting_buffer_releases_of));
 }
 
-/** \brief Waiting buffer typed
+/** \brief Waiting buffer find
  *
- * FIXME: Needs docs
+ * Returns whether an event for the same key and state as `event` is queued.
  */
-bool waiting_buffer_typed(keyevent_t event) {
+bool waiting_buffer_find(keyevent_t event) {
     for (uint8_t i = waiting_buffer_tail; i != waiting_buffer_head; i = (i + 1) % WAITING_BUFFER_SIZE) {
-        if (KEYEQ(event.key, waiting_buffer[i].event.key) && event.pressed != waiting_buffer[i].event.pressed) {
+        if (KEYEQ(event.key, waiting_buffer[i].event.key) && event.pressed == waiting_buffer[i].event.pressed) {
             return true;
         }
     }
     return false;
 }
 
+/** \brief Waiting buffer typed
+ *
+ * Returns whether the opposite event of `event` is queued, i.e. the key was typed while tapping.
+ */
+bool waiting_buffer_typed(keyevent_t event) {
+    if (key_in_matrix(event.key)) {
+        return key_bit_is_set(event.pressed ? waiting_buffer_releases_of : waiting_buffer_presses_of, event.key);
+    }
+    event.pressed = !event.pressed;
+    return waiting_buffer_find(event);
+}
+
 /** \brief Waiting buffer has anykey pressed
  *
- * FIXME: Needs docs
+ * Returns whether any press is queued.
  */
 __attribute__((unused)) bool waiting_buffer_has_anykey_pressed(void) {
-    for (uint8_t i = waiting_buffer_tail; i != waiting_buffer_head; i = (i + 1) % WAITING_BUFFER_SIZE) {
-        if (waiting_buffer[i].event.pressed) return true;
-    }
-    return false;
+    return waiting_buffer_presses > 0;
 }
 
 /** \brief Scan buffer for tapping
@@ -634,6 +742,11 @@ void waiting_buffer_scan_tap(void) {
         return;
     }
 
+    // early return if the tapping key's release isn't queued
+    if (!waiting_buffer_typed(tapping_key.event)) {
+        return;
+    }
+
 #    if (defined(AUTO_SHIFT_ENABLE) && defined(RETRO_SHIFT))
     TAP_DEFINE_KEYCODE;
 #    endif
@@ -655,6 +768,57 @@ void waiting_buffer_scan_tap(void) {
     }
 }
 
+#    if defined(CHORDAL_HOLD) || defined(PREDICTIVE_TAP_HOLD)
+static void registered_taps_add(keypos_t key) {
+    if (key_in_matrix(key)) {
+        registered_taps[key.row] |= (matrix_row_t)1 << key.col;
+        return;
+    }
+
+    if (num_registered_taps_other >= REGISTERED_TAPS_SIZE) {
+        ac_dprintf("TAPS OVERFLOW: CLEAR ALL STATES\n");
+        clear_keyboard();
+        num_registered_taps_other = 0;
+    }
+
+    registered_taps_other[num_registered_taps_other] = key;
+    ++num_registered_taps_other;
+}
+
+static bool registered_taps_del(keypos_t key) {
+    if (key_in_matrix(key)) {
+        if (!key_bit_is_set(registered_taps, key)) {
+            return false;
+        }
+        registered_taps[key.row] &= ~((matrix_row_t)1 << key.col);
+        return true;
+    }
+
+    for (uint8_t i = 0; i < num_registered_taps_other; ++i) {
+        if (KEYEQ(registered_taps_other[i], key)) {
+            registered_taps_other[i] = registered_taps_other[--num_registered_taps_other];
+            return true;
+        }
+    }
+    return false;
+}
+
+static void debug_registered_taps(void) {
+    ac_dprintf("registered_taps = { ");
+    for (uint8_t row = 0; row < MATRIX_ROWS; ++row) {
+        for (uint8_t col = 0; col < MATRIX_COLS; ++col) {
+            if (registered_taps[row] & ((matrix_row_t)1 << col)) {
+                ac_dprintf("%02X%02X ", row, col);
+            }
+        }
+    }
+    for (uint8_t i = 0; i < num_registered_taps_other; ++i) {
+        ac_dprintf("%02X%02X ", registered_taps_other[i].row, registered_taps_other[i].col);
+    }
+    ac_dprintf("}\n");
+}
+#    endif
+
 #    ifdef CHORDAL_HOLD
 __attribute__((weak)) bool get_chordal_hold(uint16_t tap_hold_keycode, keyrecord_t *tap_hold_record, uint16_t other_keycode, keyrecord_t *other_record) {
     return get_chordal_hold_default(tap_hold_record, other_record);
@@ -677,43 +841,6 @@ __attribute__((weak)) char chordal_hold_handedness(keypos_t key) {
     return (char)pgm_read_byte(&chordal_hold_layout[key.row][key.col]);
 }
 
-static void registered_taps_add(keypos_t key) {
-    if (num_registered_taps >= REGISTERED_TAPS_SIZE) {
-        ac_dprintf("TAPS OVERFLOW: CLEAR ALL STATES\n");
-        clear_keyboard();
-        num_registered_taps = 0;
-    }
-
-    registered_taps[num_registered_taps] = key;
-    ++num_registered_taps;
-}
-
-static int8_t registered_tap_find(keypos_t key) {
-    for (int8_t i = 0; i < num_registered_taps; ++i) {
-        if (KEYEQ(registered_taps[i], key)) {
-            return i;
-        }
-    }
-    return -1;
-}
-
-static void registered_taps_del_index(uint8_t i) {
-    if (i < num_registered_taps) {
-        --num_registered_taps;
-        if (i < num_registered_taps) {
-            registered_taps[i] = registered_taps[num_registered_taps];
-        }
-    }
-}
-
-static void debug_registered_taps(void) {
-    ac_dprintf("registered_taps = { ");
-    for (int8_t i = 0; i < num_registered_taps; ++i) {
-        ac_dprintf("%02X%02X ", registered_taps[i].row, registered_taps[i].col);
-    }
-    ac_dprintf("}\n");
-}
-
 static uint8_t waiting_buffer_find_chordal_hold_tap(void) {
     keyrecord_t *prev         = &tapping_key;
     uint16_t     prev_keycode = get_record_keycode(&tapping_key, false);
@@ -741,7 +868,7 @@ static void waiting_buffer_chordal_hold_taps_until(keypos_t key) {
             registered_taps_add(record->event.key);
         }
         process_record(record);
-        waiting_buffer_tail = (waiting_buffer_tail + 1) % WAITING_BUFFER_SIZE;
+        waiting_buffer_pop();
 
         if (KEYEQ(key, record->event.key) && record->event.pressed) {
             break;
@@ -750,7 +877,7 @@ static void waiting_buffer_chordal_hold_taps_until(keypos_t key) {
 }
 
 static void waiting_buffer_process_regular(void) {
-    for (; waiting_buffer_tail != waiting_buffer_head; waiting_buffer_tail = (waiting_buffer_tail + 1) % WAITING_BUFFER_SIZE) {
+    for (; waiting_buffer_tail != waiting_buffer_head; waiting_buffer_pop()) {
         if (is_tap_record(&waiting_buffer[waiting_buffer_tail])) {
             break; // Stop once a tap-hold key event is reached.
         }
@@ -761,6 +888,199 @@ static void waiting_buffer_process_regular(void) {
 }
 #    endif // CHORDAL_HOLD
 
+#    ifdef PREDICTIVE_TAP_HOLD
+/* What a tap-hold key was used for before. A press counts as a tap if the key
+ * was released within the tapping term without another key being pressed and
+ * released under it, and as a hold otherwise; the rest of the keymap is left to
+ * decide what the press did.
+ *
+ * Intervals are moving averages, in 1/16 ms, of the time from the press of
+ * the key to the press of the next key. Counts are halved together when one
+ * overflows, so a key that's changed use is relearnt. */
+typedef struct {
+    keypos_t key;
+    keypos_t other;
+    uint16_t pressed_at;
+    uint16_t other_pressed_at;
+    uint16_t tap_interval;
+    uint16_t hold_interval;
+    uint8_t  taps;
+    uint8_t  holds;
+    uint8_t  streak_taps;
+    uint8_t  streak_holds;
+    bool     used : 1;
+    bool     down : 1;
+    bool     interrupted : 1;
+    bool     nested : 1;
+    bool     in_streak : 1;
+    bool     predicted : 1;
+} tap_hold_cadence_t;
+
+static tap_hold_cadence_t          cadences[PREDICTIVE_TAP_HOLD_KEYS] = {};
+static uint16_t                    last_press_time                    = 0;
+static bool                        last_press_valid                   = false;
+static predictive_tap_hold_stats_t predictive_stats                   = {};
+
+__attribute__((weak)) bool get_predictive_tap_hold(uint16_t keycode, keyrecord_t *record) {
+    return true;
+}
+
+const predictive_tap_hold_stats_t *predictive_tap_hold_get_stats(void) {
+    return &predictive_stats;
+}
+
+void predictive_tap_hold_reset(void) {
+    memset(cadences, 0, sizeof(cadences));
+    last_press_valid = false;
+    predictive_stats = (predictive_tap_hold_stats_t){0};
+}
+
+static tap_hold_cadence_t *cadence_find(keypos_t key) {
+    for (uint8_t i = 0; i < PREDICTIVE_TAP_HOLD_KEYS; i++) {
+        if (cadences[i].used && KEYEQ(cadences[i].key, key)) {
+            return &cadences[i];
+        }
+    }
+    return NULL;
+}
+
+/* Finds the entry of a key, or takes over the one that's learnt least. */
+static tap_hold_cadence_t *cadence_alloc(keypos_t key) {
+    tap_hold_cadence_t *found = cadence_find(key);
+    if (found) {
+        return found;
+    }
+    for (uint8_t i = 0; i < PREDICTIVE_TAP_HOLD_KEYS; i++) {
+        tap_hold_cadence_t *cadence = &cadences[i];
+        if (!cadence->down && (!found || cadence->taps + cadence->holds < found->taps + found->holds)) {
+            found = cadence;
+        }
+    }
+    if (found) {
+        *found = (tap_hold_cadence_t){.key = key, .used = true};
+    }
+    return found;
+}
+
+static void cadence_count(uint8_t *count, uint8_t *other) {
+    if (*count == UINT8_MAX) {
+        *count >>= 1;
+        *other >>= 1;
+    }
+    (*count)++;
+}
+
+static void cadence_average(uint16_t *average, uint8_t *count, uint8_t *other, uint16_t interval) {
+    const uint16_t sample = MIN(interval, 4095) << 4;
+    if (*count == 0) {
+        *average = sample;
+    } else {
+        *average += ((int32_t)sample - *average) / 8;
+    }
+    cadence_count(count, other);
+}
+
+static void cadence_track(keyrecord_t *record) {
+    const keyevent_t event = record->event;
+    if (event.type != KEY_EVENT) {
+        return;
+    }
+
+    if (event.pressed) {
+        for (uint8_t i = 0; i < PREDICTIVE_TAP_HOLD_KEYS; i++) {
+            tap_hold_cadence_t *cadence = &cadences[i];
+            if (cadence->down && !cadence->interrupted) {
+                cadence->interrupted      = true;
+                cadence->other            = event.key;
+                cadence->other_pressed_at = event.time;
+            }
+        }
+        if (is_tap_record(record)) {
+            tap_hold_cadence_t *cadence = cadence_alloc(event.key);
+            if (cadence) {
+                cadence->down        = true;
+                cadence->interrupted = false;
+                cadence->nested      = false;
+                cadence->predicted   = false;
+                cadence->in_streak   = last_press_valid && TIMER_DIFF_16(event.time, last_press_time) < PREDICTIVE_TAP_HOLD_STREAK_TERM;
+                cadence->pressed_at  = event.time;
+            }
+        }
+        last_press_time  = event.time;
+        last_press_valid = true;
+        return;
+    }
+
+    for (uint8_t i = 0; i < PREDICTIVE_TAP_HOLD_KEYS; i++) {
+        tap_hold_cadence_t *cadence = &cadences[i];
+        if (cadence->down && cadence->interrupted && KEYEQ(cadence->other, event.key)) {
+            cadence->nested = true;
+        }
+    }
+
+    tap_hold_cadence_t *cadence = cadence_find(event.key);
+    if (!cadence || !cadence->down) {
+        return;
+    }
+    cadence->down = false;
+
+    const bool tapped = !cadence->nested && TIMER_DIFF_16(event.time, cadence->pressed_at) < GET_TAPPING_TERM(get_record_keycode(record, false), record);
+    ac_dprintf("PREDICTIVE_TAP_HOLD: %s%s\n", tapped ? "tap" : "hold", cadence->predicted ? " (predicted)" : "");
+    if (cadence->predicted && !tapped) {
+        predictive_stats.misfires++;
+    }
+    if (cadence->in_streak) {
+        if (tapped) {
+            cadence_count(&cadence->streak_taps, &cadence->streak_holds);
+        } else {
+            cadence_count(&cadence->streak_holds, &cadence->streak_taps);
+        }
+    }
+    if (cadence->interrupted) {
+        const uint16_t interval = TIMER_DIFF_16(cadence->other_pressed_at, cadence->pressed_at);
+        if (tapped) {
+            cadence_average(&cadence->tap_interval, &cadence->taps, &cadence->holds, interval);
+        } else {
+            cadence_average(&cadence->hold_interval, &cadence->holds, &cadence->taps, interval);
+        }
+    }
+}
+
+static bool predict_tap_on_press(keyrecord_t *record) {
+    tap_hold_cadence_t *cadence = cadence_find(record->event.key);
+    if (!cadence || !cadence->down || !cadence->in_streak) {
+        return false;
+    }
+    if (cadence->streak_taps < PREDICTIVE_TAP_HOLD_MIN_SAMPLES || (uint16_t)cadence->streak_holds * PREDICTIVE_TAP_HOLD_CONFIDENCE > cadence->streak_taps) {
+        return false;
+    }
+    if (!get_predictive_tap_hold(get_record_keycode(record, false), record)) {
+        return false;
+    }
+    cadence->predicted = true;
+    predictive_stats.predictions++;
+    return true;
+}
+
+static bool predict_tap_on_interrupt(keyrecord_t *record) {
+    tap_hold_cadence_t *cadence = cadence_find(tapping_key.event.key);
+    if (!cadence || !cadence->down || cadence->taps < PREDICTIVE_TAP_HOLD_MIN_SAMPLES || cadence->holds < PREDICTIVE_TAP_HOLD_MIN_SAMPLES) {
+        return false;
+    }
+    // Only when rolls and holds are told apart well, and this is a roll
+    const uint16_t interval = MIN(TIMER_DIFF_16(record->event.time, tapping_key.event.time), 4095) << 4;
+    if (cadence->hold_interval < cadence->tap_interval + (PREDICTIVE_TAP_HOLD_MARGIN << 4) || interval > cadence->tap_interval) {
+        return false;
+    }
+    if (!get_predictive_tap_hold(get_record_keycode(&tapping_key, false), &tapping_key)) {
+        return false;
+    }
+    cadence->predicted = true;
+    predictive_stats.predictions++;
+    return true;
+}
+#    endif // PREDICTIVE_TAP_HOLD
+
 /** \brief Logs tapping key if ACTION_DEBUG is enabled. */
 static void debug_tapping_key(void) {
     ac_dprintf("TAPPING_KEY=");
@@ -32,7 +32,10 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #    define TAPPING_TOGGLE 5
 #endif
 
-#define WAITING_BUFFER_SIZE 8
+/* number of key events that can be held back while a tap-hold key is undecided */
+#ifndef WAITING_BUFFER_SIZE
+#    define WAITING_BUFFER_SIZE 16
+#endif
 
 #ifndef NO_ACTION_TAPPING
 uint16_t get_record_keycode(keyrecord_t *record, bool update_layer_cache);
@@ -111,6 +114,66 @@ char chordal_hold_handedness(keypos_t key);
 extern const char chordal_hold_layout[MATRIX_ROWS][MATRIX_COLS] PROGMEM;
 #endif
 
+#ifdef PREDICTIVE_TAP_HOLD
+/* number of tap-hold keys whose typing cadence is learnt */
+#    ifndef PREDICTIVE_TAP_HOLD_KEYS
+#        define PREDICTIVE_TAP_HOLD_KEYS 8
+#    endif
+
+/* number of taps and holds of a key needed before its cadence is trusted */
+#    ifndef PREDICTIVE_TAP_HOLD_MIN_SAMPLES
+#        define PREDICTIVE_TAP_HOLD_MIN_SAMPLES 8
+#    endif
+
+/* presses closer together than this(ms) are typing */
+#    ifndef PREDICTIVE_TAP_HOLD_STREAK_TERM
+#        define PREDICTIVE_TAP_HOLD_STREAK_TERM 125
+#    endif
+
+/* taps needed for every hold while typing before a key is tapped on press */
+#    ifndef PREDICTIVE_TAP_HOLD_CONFIDENCE
+#        define PREDICTIVE_TAP_HOLD_CONFIDENCE 16
+#    endif
+
+/* least gap(ms) between the rolled and the held timing of a key before it is used */
+#    ifndef PREDICTIVE_TAP_HOLD_MARGIN
+#        define PREDICTIVE_TAP_HOLD_MARGIN 40
+#    endif
+
+/**
+ * Callback to say whether a tap-hold key may be settled as tapped early, from
+ * how it has been used before.
+ *
+ * In keymap.c, define the callback
+ *
+ *     bool get_predictive_tap_hold(uint16_t keycode, keyrecord_t* record) {
+ *        // Conditions...
+ *     }
+ *
+ * This callback is called when the typing cadence of the key says it is being
+ * tapped: when it is pressed in the middle of typing and has nearly always
+ * been tapped then, or when another key is pressed after it as soon as it is
+ * when the key is rolled as a tap. Returning false leaves the key to be
+ * settled as usual. The default returns true.
+ *
+ * @param keycode  Keycode of the tap-hold key.
+ * @param record   Record from the tap-hold press event.
+ * @return True if the tap-hold key may be settled as tapped.
+ */
+bool get_predictive_tap_hold(uint16_t keycode, keyrecord_t *record);
+
+typedef struct {
+    uint32_t predictions; // tap-hold keys settled as tapped early
+    uint32_t misfires;    // of those, keys then held past the tapping term or over another key
+} predictive_tap_hold_stats_t;
+
+/** Gets how often taps were predicted and how often wrongly. */
+const predictive_tap_hold_stats_t *predictive_tap_hold_get_stats(void);
+
+/** Forgets the learnt typing cadence and the statistics. */
+void predictive_tap_hold_reset(void);
+#endif
+
 #ifdef DYNAMIC_TAPPING_TERM_ENABLE
 extern uint16_t g_tapping_term;
 #endif
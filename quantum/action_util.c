@@ -37,7 +37,9 @@ static uint8_t suppressed_mods    = 0;
 // report_keyboard_t keyboard_report = {};
 report_keyboard_t *keyboard_report = &(report_keyboard_t){};
 #ifdef NKRO_ENABLE
-report_nkro_t *nkro_report = &(report_nkro_t){};
+static report_nkro_bitmap_t nkro_report_storage = {};
+report_nkro_t              *nkro_report         = &nkro_report_storage.report;
+report_nkro_bitmap_t       *nkro_bitmap         = &nkro_report_storage;
 #endif
 
 extern inline void add_key(uint8_t key);
@@ -283,34 +285,53 @@ static uint8_t get_mods_for_report(void) {
     return mods;
 }
 
+#ifndef PROTOCOL_VUSB
+static report_keyboard_t last_6kro_report;
+#endif
+
 void send_6kro_report(void) {
     keyboard_report->mods = get_mods_for_report();
 
 #ifdef PROTOCOL_VUSB
     host_keyboard_send(keyboard_report);
 #else
-    static report_keyboard_t last_report;
-
     /* Only send the report if there are changes to propagate to the host. */
-    if (memcmp(keyboard_report, &last_report, sizeof(report_keyboard_t)) != 0) {
-        memcpy(&last_report, keyboard_report, sizeof(report_keyboard_t));
+    if (memcmp(keyboard_report, &last_6kro_report, sizeof(report_keyboard_t)) != 0) {
+        memcpy(&last_6kro_report, keyboard_report, sizeof(report_keyboard_t));
         host_keyboard_send(keyboard_report);
     }
 #endif
 }
 
 #ifdef NKRO_ENABLE
-void send_nkro_report(void) {
-    nkro_report->mods = get_mods_for_report();
+static report_nkro_bitmap_t last_nkro_report;
 
-    static report_nkro_t last_report;
+void send_nkro_report(void) {
+    nkro_report->mods      = get_mods_for_report();
+    nkro_report->report_id = REPORT_ID_NKRO;
 
     /* Only send the report if there are changes to propagate to the host. */
-    if (memcmp(nkro_report, &last_report, sizeof(report_nkro_t)) != 0) {
-        memcpy(&last_report, nkro_report, sizeof(report_nkro_t));
+    if (nkro_bitmap_changed(nkro_bitmap, &last_nkro_report)) {
+        last_nkro_report = *nkro_bitmap;
         host_nkro_send(nkro_report);
     }
 }
+
+/** \brief Moves the held keys to the report now in use, after switching between boot and report protocol, or toggling NKRO
+ *
+ * The host stops reading the previous report, so the next report is sent even if it matches the last one sent in this format.
+ */
+static void switch_keyboard_report(bool nkro) {
+    if (nkro) {
+        nkro_bitmap_from_keys(nkro_bitmap, keyboard_report);
+        memset(&last_nkro_report, 0xFF, sizeof(last_nkro_report));
+    } else {
+        nkro_bitmap_to_keys(nkro_bitmap, keyboard_report);
+#    ifndef PROTOCOL_VUSB
+        memset(&last_6kro_report, 0xFF, sizeof(last_6kro_report));
+#    endif
+    }
+}
 #endif
 
 /** \brief Send keyboard report
@@ -319,7 +340,15 @@ void send_nkro_report(void) {
  */
 void send_keyboard_report(void) {
 #ifdef NKRO_ENABLE
-    if (usb_device_state_get_protocol() == USB_PROTOCOL_REPORT && keymap_config.nkro) {
+    static bool last_nkro = false;
+    bool        nkro      = usb_device_state_get_protocol() == USB_PROTOCOL_REPORT && keymap_config.nkro;
+
+    if (nkro != last_nkro) {
+        switch_keyboard_report(nkro);
+        last_nkro = nkro;
+    }
+
+    if (nkro) {
         send_nkro_report();
     } else {
         send_6kro_report();
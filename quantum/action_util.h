@@ -27,7 +27,8 @@ extern "C" {
 
 extern report_keyboard_t *keyboard_report;
 #ifdef NKRO_ENABLE
-extern report_nkro_t *nkro_report;
+extern report_nkro_t        *nkro_report;
+extern report_nkro_bitmap_t *nkro_bitmap;
 #endif
 
 void send_keyboard_report(void);
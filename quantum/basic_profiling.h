@@ -19,12 +19,18 @@
         PROFILE_CALL_NAMED(1000, "matrix_task", {
             matrix_task();
         });
+
+    PROFILE_CALL_TICKS and PROFILE_CALL_TICKS_NAMED print the average number of
+    timestamp ticks spent in each call instead -- CPU cycles on ChibiOS, or
+    timer 0 ticks (64 cycles each) on AVR.
 */
 
 #if defined(PROTOCOL_LUFA) || defined(PROTOCOL_VUSB)
 #    define TIMESTAMP_GETTER TCNT0
+#    define TIMESTAMP_ELAPSED(start, end) ((uint8_t)((end) - (start)))
 #elif defined(PROTOCOL_CHIBIOS)
 #    define TIMESTAMP_GETTER chSysGetRealtimeCounterX()
+#    define TIMESTAMP_ELAPSED(start, end) ((uint32_t)((end) - (start)))
 #else
 #    error Unknown protocol in use
 #endif
@@ -34,6 +40,10 @@
 #    define PROFILE_CALL_NAMED(count, name, call) \
         do {                                      \
         } while (0)
+#    define PROFILE_CALL_TICKS_NAMED(count, name, call) \
+        do {                                            \
+            call;                                       \
+        } while (0)
 #else
 #    define PROFILE_CALL_NAMED(count, name, call)                                                                         \
         do {                                                                                                              \
@@ -62,6 +72,24 @@
             }                                                                                                             \
         } while (0)
 
+#    define PROFILE_CALL_TICKS_NAMED(count, name, call)                                                        \
+        do {                                                                                                   \
+            static uint32_t sum            = 0;                                                                \
+            static uint32_t write_location = 0;                                                                \
+            uint32_t        start_ts       = TIMESTAMP_GETTER;                                                 \
+            do {                                                                                               \
+                call;                                                                                          \
+            } while (0);                                                                                       \
+            sum += TIMESTAMP_ELAPSED(start_ts, TIMESTAMP_GETTER);                                              \
+            ++write_location;                                                                                  \
+            if (write_location >= ((uint32_t)count)) {                                                         \
+                dprintf("%s -- Average ticks per call: %lu\n", (name), (unsigned long)(sum / write_location)); \
+                sum            = 0;                                                                            \
+                write_location = 0;                                                                            \
+            }                                                                                                  \
+        } while (0)
+
 #endif // CONSOLE_ENABLE
 
 #define PROFILE_CALL(count, call) PROFILE_CALL_NAMED(count, #call, call)
+#define PROFILE_CALL_TICKS(count, call) PROFILE_CALL_TICKS_NAMED(count, #call, call)
@@ -16,6 +16,8 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 /*
 Basic global debounce algorithm. Used in 99% of keyboards at time of implementation
 When no state changes have occured for DEBOUNCE milliseconds, we push the state.
+The time is measured in microseconds, so the state is pushed as soon as DEBOUNCE
+milliseconds have passed, rather than up to a millisecond earlier or later.
 */
 #include "debounce.h"
 #include "timer.h"
@@ -31,8 +33,8 @@ When no state changes have occured for DEBOUNCE milliseconds, we push the state.
 #endif
 
 #if DEBOUNCE > 0
-static bool         debouncing = false;
-static fast_timer_t debouncing_time;
+static bool     debouncing = false;
+static uint32_t debouncing_time;
 
 void debounce_init(uint8_t num_rows) {}
 
@@ -41,8 +43,8 @@ bool debounce(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, bool
 
     if (changed) {
         debouncing      = true;
-        debouncing_time = timer_read_fast();
-    } else if (debouncing && timer_elapsed_fast(debouncing_time) >= DEBOUNCE) {
+        debouncing_time = timer_read_us();
+    } else if (debouncing && timer_elapsed_us(debouncing_time) >= DEBOUNCE * 1000UL) {
         size_t matrix_size = num_rows * sizeof(matrix_row_t);
         if (memcmp(cooked, raw, matrix_size) != 0) {
             memcpy(cooked, raw, matrix_size);
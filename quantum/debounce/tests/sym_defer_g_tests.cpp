@@ -254,3 +254,18 @@ TEST_F(DebounceTest, AsyncTickOneKeyShort1) {
     async_time_jumps_ = DEBOUNCE;
     runEvents();
 }
+
+TEST_F(DebounceTest, MicrosecondTimerWraps) {
+    addEvents({
+        /* Time, Inputs, Outputs */
+        {0, {{0, 1, DOWN}}, {}},
+
+        {5, {}, {{0, 1, DOWN}}},
+        {6, {{0, 1, UP}}, {}},
+
+        {11, {}, {{0, 1, UP}}},
+    });
+    /* The 32-bit microsecond timer wraps 4294967.296ms after it was cleared */
+    time_offset_ = 4294967 - 3;
+    runEvents();
+}
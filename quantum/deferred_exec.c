@@ -156,6 +156,15 @@ void deferred_exec_advanced_task(deferred_executor_t *table, size_t table_count,
     }
 }
 
+bool deferred_exec_advanced_pending(deferred_executor_t *table, size_t table_count) {
+    for (int i = 0; i < table_count; ++i) {
+        if (table[i].token != INVALID_DEFERRED_TOKEN) {
+            return true;
+        }
+    }
+    return false;
+}
+
 //------------------------------------
 // Basic API: used by user-mode code, guaranteed to not collide with core deferred execution
 //
@@ -175,3 +184,6 @@ bool cancel_deferred_exec(deferred_token token) {
 void deferred_exec_task(void) {
     deferred_exec_advanced_task(basic_executors, MAX_DEFERRED_EXECUTORS, &last_deferred_exec_check);
 }
+bool deferred_exec_pending(void) {
+    return deferred_exec_advanced_pending(basic_executors, MAX_DEFERRED_EXECUTORS);
+}
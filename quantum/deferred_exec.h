@@ -65,6 +65,13 @@ bool cancel_deferred_exec(deferred_token token);
  */
 void deferred_exec_task(void);
 
+/**
+ * Checks whether any deferred execution is still scheduled.
+ *
+ * @return true if at least one executor is waiting to be invoked, otherwise false
+ */
+bool deferred_exec_pending(void);
+
 //------------------------------------
 // Advanced API: used when a custom-allocated table is used, primarily for core code.
 //------------------------------------
@@ -119,3 +126,12 @@ bool cancel_deferred_exec_advanced(deferred_executor_t *table, size_t table_coun
  * @param last_execution_time[in,out] the last execution time -- this will be checked first to determine if execution is needed, and updated if execution occurred
  */
 void deferred_exec_advanced_task(deferred_executor_t *table, size_t table_count, uint32_t *last_execution_time);
+
+/**
+ * Checks whether any deferred execution in the custom table is still scheduled.
+ *
+ * @param table[in] the custom table used for storage
+ * @param table_count[in] the number of available items in the table
+ * @return true if at least one executor is waiting to be invoked, otherwise false
+ */
+bool deferred_exec_advanced_pending(deferred_executor_t *table, size_t table_count);
@@ -30,6 +30,10 @@
 #    define DYNAMIC_KEYMAP_EEPROM_START (EECONFIG_SIZE)
 #endif
 
+#if defined(POINTING_DEVICE_ENABLE) && defined(POINTING_DEVICE_AUTO_MOUSE_ENABLE)
+#    include "pointing_device_auto_mouse.h"
+#endif
+
 #ifdef ENCODER_ENABLE
 #    include "encoder.h"
 #else
@@ -101,13 +105,106 @@ _Static_assert((DYNAMIC_KEYMAP_EEPROM_MAX_ADDR) - (DYNAMIC_KEYMAP_MACRO_EEPROM_A
 #    define DYNAMIC_KEYMAP_MACRO_DELAY TAP_CODE_DELAY
 #endif
 
+#define DYNAMIC_KEYMAP_LAYER_SIZE (MATRIX_ROWS * MATRIX_COLS * 2)
+#define DYNAMIC_KEYMAP_ENCODER_LAYER_SIZE (NUM_ENCODERS * 2 * 2)
+
+#ifdef DYNAMIC_KEYMAP_HASH_ENABLE
+// Content hashes of each layer (including its encoder mappings), followed by the macro buffer.
+// Each hash is the sum of a mix of every byte's position and value, so that it can be updated
+// as bytes are written rather than re-reading the whole layer. Calculated on first use.
+static uint32_t dynamic_keymap_hashes[DYNAMIC_KEYMAP_LAYER_COUNT + 1];
+static bool     dynamic_keymap_hashes_valid = false;
+
+static uint32_t dynamic_keymap_hash_byte(uint16_t index, uint8_t value) {
+    // MurmurHash3 finalizer
+    uint32_t h = ((uint32_t)index << 8) | value;
+    h ^= h >> 16;
+    h *= 0x85EBCA6B;
+    h ^= h >> 13;
+    h *= 0xC2B2AE35;
+    h ^= h >> 16;
+    return h;
+}
+
+// Determines which hash covers the given EEPROM address, and the byte's position within it.
+static bool dynamic_keymap_hash_location(uintptr_t address, uint8_t *hash, uint16_t *index) {
+    if (address >= DYNAMIC_KEYMAP_EEPROM_ADDR && address < DYNAMIC_KEYMAP_EEPROM_ADDR + (DYNAMIC_KEYMAP_LAYER_COUNT * DYNAMIC_KEYMAP_LAYER_SIZE)) {
+        uint16_t offset = address - DYNAMIC_KEYMAP_EEPROM_ADDR;
+        *hash           = offset / DYNAMIC_KEYMAP_LAYER_SIZE;
+        *index          = offset % DYNAMIC_KEYMAP_LAYER_SIZE;
+        return true;
+    }
+#ifdef ENCODER_MAP_ENABLE
+    if (address >= DYNAMIC_KEYMAP_ENCODER_EEPROM_ADDR && address < DYNAMIC_KEYMAP_ENCODER_EEPROM_ADDR + (DYNAMIC_KEYMAP_LAYER_COUNT * DYNAMIC_KEYMAP_ENCODER_LAYER_SIZE)) {
+        uint16_t offset = address - DYNAMIC_KEYMAP_ENCODER_EEPROM_ADDR;
+        *hash           = offset / DYNAMIC_KEYMAP_ENCODER_LAYER_SIZE;
+        *index          = DYNAMIC_KEYMAP_LAYER_SIZE + (offset % DYNAMIC_KEYMAP_ENCODER_LAYER_SIZE);
+        return true;
+    }
+#endif // ENCODER_MAP_ENABLE
+    if (address >= DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR && address < DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE) {
+        *hash  = DYNAMIC_KEYMAP_LAYER_COUNT;
+        *index = address - DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR;
+        return true;
+    }
+    return false;
+}
+
+// Updates the hashes for data about to be written to EEPROM, must be called before the write.
+static void dynamic_keymap_hash_update(void *address, const uint8_t *data, uint16_t size) {
+    if (!dynamic_keymap_hashes_valid) {
+        return;
+    }
+    uint8_t previous[32];
+    while (size > 0) {
+        uint16_t chunk = size < sizeof(previous) ? size : sizeof(previous);
+        eeprom_read_block(previous, address, chunk);
+        for (uint16_t i = 0; i < chunk; i++) {
+            uint8_t  hash;
+            uint16_t index;
+            if (previous[i] != data[i] && dynamic_keymap_hash_location((uintptr_t)address + i, &hash, &index)) {
+                dynamic_keymap_hashes[hash] += dynamic_keymap_hash_byte(index, data[i]) - dynamic_keymap_hash_byte(index, previous[i]);
+            }
+        }
+        address += chunk;
+        data += chunk;
+        size -= chunk;
+    }
+}
+
+static uint32_t dynamic_keymap_hash_region(const void *address, uint16_t size, uint16_t first_index) {
+    uint32_t hash = 0;
+    for (uint16_t i = 0; i < size; i++) {
+        hash += dynamic_keymap_hash_byte(first_index + i, eeprom_read_byte(address + i));
+    }
+    return hash;
+}
+
+uint32_t dynamic_keymap_get_hash(uint8_t index) {
+    if (index > DYNAMIC_KEYMAP_LAYER_COUNT) {
+        return 0;
+    }
+    if (!dynamic_keymap_hashes_valid) {
+        for (uint8_t layer = 0; layer < DYNAMIC_KEYMAP_LAYER_COUNT; layer++) {
+            dynamic_keymap_hashes[layer] = dynamic_keymap_hash_region((void *)(uintptr_t)DYNAMIC_KEYMAP_EEPROM_ADDR + (layer * DYNAMIC_KEYMAP_LAYER_SIZE), DYNAMIC_KEYMAP_LAYER_SIZE, 0);
+#ifdef ENCODER_MAP_ENABLE
+            dynamic_keymap_hashes[layer] += dynamic_keymap_hash_region((void *)(uintptr_t)DYNAMIC_KEYMAP_ENCODER_EEPROM_ADDR + (layer * DYNAMIC_KEYMAP_ENCODER_LAYER_SIZE), DYNAMIC_KEYMAP_ENCODER_LAYER_SIZE, DYNAMIC_KEYMAP_LAYER_SIZE);
+#endif // ENCODER_MAP_ENABLE
+        }
+        dynamic_keymap_hashes[DYNAMIC_KEYMAP_LAYER_COUNT] = dynamic_keymap_hash_region((void *)(uintptr_t)DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR, DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE, 0);
+        dynamic_keymap_hashes_valid                       = true;
+    }
+    return dynamic_keymap_hashes[index];
+}
+#endif // DYNAMIC_KEYMAP_HASH_ENABLE
+
 uint8_t dynamic_keymap_get_layer_count(void) {
     return DYNAMIC_KEYMAP_LAYER_COUNT;
 }
 
 void *dynamic_keymap_key_to_eeprom_address(uint8_t layer, uint8_t row, uint8_t column) {
     // TODO: optimize this with some left shifts
-    return ((void *)DYNAMIC_KEYMAP_EEPROM_ADDR) + (layer * MATRIX_ROWS * MATRIX_COLS * 2) + (row * MATRIX_COLS * 2) + (column * 2);
+    return ((void *)(uintptr_t)DYNAMIC_KEYMAP_EEPROM_ADDR) + (layer * MATRIX_ROWS * MATRIX_COLS * 2) + (row * MATRIX_COLS * 2) + (column * 2);
 }
 
 uint16_t dynamic_keymap_get_keycode(uint8_t layer, uint8_t row, uint8_t column) {
@@ -123,13 +220,20 @@ void dynamic_keymap_set_keycode(uint8_t layer, uint8_t row, uint8_t column, uint
     if (layer >= DYNAMIC_KEYMAP_LAYER_COUNT || row >= MATRIX_ROWS || column >= MATRIX_COLS) return;
     void *address = dynamic_keymap_key_to_eeprom_address(layer, row, column);
     // Big endian, so we can read/write EEPROM directly from host if we want
-    eeprom_update_byte(address, (uint8_t)(keycode >> 8));
-    eeprom_update_byte(address + 1, (uint8_t)(keycode & 0xFF));
+    uint8_t data[2] = {(uint8_t)(keycode >> 8), (uint8_t)(keycode & 0xFF)};
+#ifdef DYNAMIC_KEYMAP_HASH_ENABLE
+    dynamic_keymap_hash_update(address, data, sizeof(data));
+#endif
+    eeprom_update_byte(address, data[0]);
+    eeprom_update_byte(address + 1, data[1]);
+#if defined(POINTING_DEVICE_ENABLE) && defined(POINTING_DEVICE_AUTO_MOUSE_ENABLE)
+    auto_mouse_keymap_changed();
+#endif
 }
 
 #ifdef ENCODER_MAP_ENABLE
 void *dynamic_keymap_encoder_to_eeprom_address(uint8_t layer, uint8_t encoder_id) {
-    return ((void *)DYNAMIC_KEYMAP_ENCODER_EEPROM_ADDR) + (layer * NUM_ENCODERS * 2 * 2) + (encoder_id * 2 * 2);
+    return ((void *)(uintptr_t)DYNAMIC_KEYMAP_ENCODER_EEPROM_ADDR) + (layer * NUM_ENCODERS * 2 * 2) + (encoder_id * 2 * 2);
 }
 
 uint16_t dynamic_keymap_get_encoder(uint8_t layer, uint8_t encoder_id, bool clockwise) {
@@ -143,14 +247,23 @@ uint16_t dynamic_keymap_get_encoder(uint8_t layer, uint8_t encoder_id, bool cloc
 
 void dynamic_keymap_set_encoder(uint8_t layer, uint8_t encoder_id, bool clockwise, uint16_t keycode) {
     if (layer >= DYNAMIC_KEYMAP_LAYER_COUNT || encoder_id >= NUM_ENCODERS) return;
-    void *address = dynamic_keymap_encoder_to_eeprom_address(layer, encoder_id);
+    void *address = dynamic_keymap_encoder_to_eeprom_address(layer, encoder_id) + (clockwise ? 0 : 2);
     // Big endian, so we can read/write EEPROM directly from host if we want
-    eeprom_update_byte(address + (clockwise ? 0 : 2), (uint8_t)(keycode >> 8));
-    eeprom_update_byte(address + (clockwise ? 0 : 2) + 1, (uint8_t)(keycode & 0xFF));
+    uint8_t data[2] = {(uint8_t)(keycode >> 8), (uint8_t)(keycode & 0xFF)};
+#ifdef DYNAMIC_KEYMAP_HASH_ENABLE
+    dynamic_keymap_hash_update(address, data, sizeof(data));
+#endif
+    eeprom_update_byte(address, data[0]);
+    eeprom_update_byte(address + 1, data[1]);
 }
 #endif // ENCODER_MAP_ENABLE
 
 void dynamic_keymap_reset(void) {
+#ifdef DYNAMIC_KEYMAP_HASH_ENABLE
+    // Hashes are recalculated on next use, rather than updated for every key
+    dynamic_keymap_hashes_valid = false;
+#endif
+
     // Reset the keymaps in EEPROM to what is in flash.
     for (int layer = 0; layer < DYNAMIC_KEYMAP_LAYER_COUNT; layer++) {
         for (int row = 0; row < MATRIX_ROWS; row++) {
@@ -167,9 +280,22 @@ void dynamic_keymap_reset(void) {
     }
 }
 
+static void dynamic_keymap_update_buffer(void *target, const uint8_t *data, uint16_t size) {
+#if defined(EEPROM_WEAR_LEVELING) && defined(WEAR_LEVELING_LOG_COMPRESSION)
+    // Update as a single block, so that wear-leveling can log the whole buffer at once rather than byte-by-byte
+    eeprom_update_block(data, target, size);
+#else
+    // Other drivers rewrite the whole block if any byte differs, so only update the bytes that changed
+    for (uint16_t i = 0; i < size; i++) {
+        eeprom_update_byte(target, data[i]);
+        target++;
+    }
+#endif
+}
+
 void dynamic_keymap_get_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
     uint16_t dynamic_keymap_eeprom_size = DYNAMIC_KEYMAP_LAYER_COUNT * MATRIX_ROWS * MATRIX_COLS * 2;
-    void *   source                     = (void *)(DYNAMIC_KEYMAP_EEPROM_ADDR + offset);
+    void *   source                     = (void *)(uintptr_t)(DYNAMIC_KEYMAP_EEPROM_ADDR + offset);
     uint8_t *target                     = data;
     for (uint16_t i = 0; i < size; i++) {
         if (offset + i < dynamic_keymap_eeprom_size) {
@@ -184,15 +310,19 @@ void dynamic_keymap_get_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
 
 void dynamic_keymap_set_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
     uint16_t dynamic_keymap_eeprom_size = DYNAMIC_KEYMAP_LAYER_COUNT * MATRIX_ROWS * MATRIX_COLS * 2;
-    void *   target                     = (void *)(DYNAMIC_KEYMAP_EEPROM_ADDR + offset);
-    uint8_t *source                     = data;
-    for (uint16_t i = 0; i < size; i++) {
-        if (offset + i < dynamic_keymap_eeprom_size) {
-            eeprom_update_byte(target, *source);
-        }
-        source++;
-        target++;
+    if (offset >= dynamic_keymap_eeprom_size) {
+        return;
     }
+    if (size > dynamic_keymap_eeprom_size - offset) {
+        size = dynamic_keymap_eeprom_size - offset;
+    }
+#ifdef DYNAMIC_KEYMAP_HASH_ENABLE
+    dynamic_keymap_hash_update((void *)(uintptr_t)(DYNAMIC_KEYMAP_EEPROM_ADDR + offset), data, size);
+#endif
+    dynamic_keymap_update_buffer((void *)(uintptr_t)(DYNAMIC_KEYMAP_EEPROM_ADDR + offset), data, size);
+#if defined(POINTING_DEVICE_ENABLE) && defined(POINTING_DEVICE_AUTO_MOUSE_ENABLE)
+    auto_mouse_keymap_changed();
+#endif
 }
 
 uint16_t keycode_at_keymap_location(uint8_t layer_num, uint8_t row, uint8_t column) {
@@ -220,7 +350,7 @@ uint16_t dynamic_keymap_macro_get_buffer_size(void) {
 }
 
 void dynamic_keymap_macro_get_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
-    void *   source = (void *)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + offset);
+    void *   source = (void *)(uintptr_t)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + offset);
     uint8_t *target = data;
     for (uint16_t i = 0; i < size; i++) {
         if (offset + i < DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE) {
@@ -234,15 +364,16 @@ void dynamic_keymap_macro_get_buffer(uint16_t offset, uint16_t size, uint8_t *da
 }
 
 void dynamic_keymap_macro_set_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
-    void *   target = (void *)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + offset);
-    uint8_t *source = data;
-    for (uint16_t i = 0; i < size; i++) {
-        if (offset + i < DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE) {
-            eeprom_update_byte(target, *source);
-        }
-        source++;
-        target++;
+    if (offset >= DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE) {
+        return;
+    }
+    if (size > DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE - offset) {
+        size = DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE - offset;
     }
+#ifdef DYNAMIC_KEYMAP_HASH_ENABLE
+    dynamic_keymap_hash_update((void *)(uintptr_t)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + offset), data, size);
+#endif
+    dynamic_keymap_update_buffer((void *)(uintptr_t)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + offset), data, size);
 }
 
 typedef struct send_string_eeprom_state_t {
@@ -257,8 +388,12 @@ char send_string_get_next_eeprom(void *arg) {
 }
 
 void dynamic_keymap_macro_reset(void) {
-    void *p   = (void *)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR);
-    void *end = (void *)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE);
+#ifdef DYNAMIC_KEYMAP_HASH_ENABLE
+    dynamic_keymap_hashes_valid = false;
+#endif
+
+    void *p   = (void *)(uintptr_t)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR);
+    void *end = (void *)(uintptr_t)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE);
     while (p != end) {
         eeprom_update_byte(p, 0);
         ++p;
@@ -274,15 +409,15 @@ void dynamic_keymap_macro_send(uint8_t id) {
     // If it's not zero, then we are in the middle
     // of buffer writing, possibly an aborted buffer
     // write. So do nothing.
-    void *p = (void *)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE - 1);
+    void *p = (void *)(uintptr_t)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE - 1);
     if (eeprom_read_byte(p) != 0) {
         return;
     }
 
     // Skip N null characters
     // p will then point to the Nth macro
-    p         = (void *)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR);
-    void *end = (void *)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE);
+    p         = (void *)(uintptr_t)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR);
+    void *end = (void *)(uintptr_t)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE);
     while (id > 0) {
         // If we are past the end of the buffer, then there is
         // no Nth macro in the buffer.
@@ -296,5 +431,14 @@ void dynamic_keymap_macro_send(uint8_t id) {
     }
 
     send_string_eeprom_state_t state = {p};
+#ifdef SEND_STRING_ASYNC_ENABLE
+    if (send_string_async_with_delay_impl(send_string_get_next_eeprom, &state, DYNAMIC_KEYMAP_MACRO_DELAY)) {
+        return;
+    }
+    // The macro doesn't fit in the queue, so finish typing out what is queued before typing it out
+    // immediately, rather than interleaving the two
+    send_string_async_flush();
+    state.ptr = p;
+#endif
     send_string_with_delay_impl(send_string_get_next_eeprom, &state, DYNAMIC_KEYMAP_MACRO_DELAY);
 }
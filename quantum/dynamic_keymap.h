@@ -38,6 +38,13 @@ void dynamic_keymap_reset(void);
 void dynamic_keymap_get_buffer(uint16_t offset, uint16_t size, uint8_t *data);
 void dynamic_keymap_set_buffer(uint16_t offset, uint16_t size, uint8_t *data);
 
+#ifdef DYNAMIC_KEYMAP_HASH_ENABLE
+// Content hash of a layer, including its encoder mappings, or of the macro buffer when index is
+// the layer count. These are kept up to date as keycodes and macros are written, so that host
+// applications can skip reading layers which haven't changed.
+uint32_t dynamic_keymap_get_hash(uint8_t index);
+#endif
+
 // This overrides the one in quantum/keymap_common.c
 // uint16_t keymap_key_to_keycode(uint8_t layer, keypos_t key);
 
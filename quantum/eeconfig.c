@@ -12,6 +12,10 @@
 #    include "haptic.h"
 #endif
 
+#if defined(POINTING_DEVICE_ENABLE) && defined(POINTING_DEVICE_ACCEL_ENABLE)
+#    include "pointing_device_accel.h"
+#endif
+
 #if defined(VIA_ENABLE)
 bool via_eeprom_is_valid(void);
 void via_eeprom_set_valid(bool valid);
@@ -65,6 +69,10 @@ void eeconfig_init_quantum(void) {
 #if defined(HAPTIC_ENABLE)
     haptic_reset();
 #endif
+    eeprom_update_byte(EECONFIG_POINTING_DEVICE, 0);
+#if defined(POINTING_DEVICE_ENABLE) && defined(POINTING_DEVICE_ACCEL_ENABLE)
+    pointing_device_accel_init();
+#endif
 
 #if (EECONFIG_KB_DATA_SIZE) > 0
     eeconfig_init_kb_datablock();
@@ -265,6 +273,21 @@ void eeconfig_update_haptic(uint32_t val) {
     eeprom_update_dword(EECONFIG_HAPTIC, val);
 }
 
+/** \brief eeconfig read pointing device
+ *
+ * Reads the pointing device settings, e.g. the acceleration curve and level.
+ */
+uint8_t eeconfig_read_pointing_device(void) {
+    return eeprom_read_byte(EECONFIG_POINTING_DEVICE);
+}
+/** \brief eeconfig update pointing device
+ *
+ * Writes the pointing device settings.
+ */
+void eeconfig_update_pointing_device(uint8_t val) {
+    eeprom_update_byte(EECONFIG_POINTING_DEVICE, val);
+}
+
 /** \brief eeconfig read split handedness
  *
  * FIXME: needs doc
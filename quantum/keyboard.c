@@ -140,9 +140,20 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #ifdef OS_DETECTION_ENABLE
 #    include "os_detection.h"
 #endif
+#if defined(WEAR_LEVELING_ENABLE) && defined(WEAR_LEVELING_BACKGROUND_CONSOLIDATION)
+#    include "wear_leveling.h"
+#endif
 #ifdef LAYER_LOCK_ENABLE
 #    include "layer_lock.h"
 #endif
+#ifdef SEND_STRING_ASYNC_ENABLE
+#    include "send_string.h"
+#endif
+#ifdef MATRIX_IDLE_ENABLE
+#    include "matrix_idle.h"
+#else
+#    define matrix_idle_task() true
+#endif
 
 static uint32_t last_input_modification_time = 0;
 uint32_t        last_input_activity_time(void) {
@@ -219,6 +230,31 @@ uint32_t get_matrix_scan_rate(void) {
 #    define matrix_scan_perf_task()
 #endif
 
+#if defined(DEBUG_USB_REPORT_RATE)
+static uint32_t report_rate_timer     = 0;
+static uint32_t report_rate_count     = 0;
+static uint32_t last_usb_report_count = 0;
+
+void usb_report_perf_task(void) {
+    uint32_t timer_now = timer_read32();
+    if (TIMER_DIFF_32(timer_now, report_rate_timer) >= 1000) {
+        uint32_t report_count = host_report_count();
+        last_usb_report_count = report_count - report_rate_count;
+#    if defined(CONSOLE_ENABLE)
+        dprintf("usb report rate: %lu\n", last_usb_report_count);
+#    endif
+        report_rate_timer = timer_now;
+        report_rate_count = report_count;
+    }
+}
+
+uint32_t get_usb_report_rate(void) {
+    return last_usb_report_count;
+}
+#else
+#    define usb_report_perf_task()
+#endif
+
 #ifdef MATRIX_HAS_GHOST
 static matrix_row_t get_real_keys(uint8_t row, matrix_row_t rowdata) {
     matrix_row_t out = 0;
@@ -413,6 +449,9 @@ __attribute__((weak)) void housekeeping_task_user(void) {}
  * Invokes hooks for executing code after QMK is done after each loop iteration.
  */
 void housekeeping_task(void) {
+#if defined(WEAR_LEVELING_ENABLE) && defined(WEAR_LEVELING_BACKGROUND_CONSOLIDATION)
+    wear_leveling_task();
+#endif
     housekeeping_task_modules();
     housekeeping_task_kb();
     housekeeping_task_user();
@@ -529,7 +568,7 @@ void keyboard_init(void) {
     haptic_init();
 #endif
 
-#if defined(DEBUG_MATRIX_SCAN_RATE) && defined(CONSOLE_ENABLE)
+#if (defined(DEBUG_MATRIX_SCAN_RATE) || defined(DEBUG_USB_REPORT_RATE)) && defined(CONSOLE_ENABLE)
     debug_enable = true;
 #endif
 
@@ -555,9 +594,9 @@ void switch_events(uint8_t row, uint8_t col, bool pressed) {
  * internal QMK state machine.
  */
 static inline void generate_tick_event(void) {
-    static uint16_t last_tick = 0;
-    const uint16_t  now       = timer_read();
-    if (TIMER_DIFF_16(now, last_tick) != 0) {
+    static fast_timer_t last_tick = 0;
+    const fast_timer_t  now       = timer_read_fast();
+    if (TIMER_DIFF_FAST(now, last_tick) != 0) {
         action_exec(MAKE_TICK_EVENT);
         last_tick = now;
     }
@@ -571,7 +610,7 @@ static inline void generate_tick_event(void) {
  * @return false Matrix didn't change
  */
 static bool matrix_task(void) {
-    if (!matrix_can_read()) {
+    if (!matrix_can_read() || !matrix_idle_task()) {
         generate_tick_event();
         return false;
     }
@@ -702,6 +741,10 @@ void quantum_task(void) {
 #ifdef LAYER_LOCK_ENABLE
     layer_lock_task();
 #endif
+
+#ifdef SEND_STRING_ASYNC_ENABLE
+    send_string_async_task();
+#endif
 }
 
 /** \brief Main task that is repeatedly called as fast as possible. */
@@ -795,4 +838,6 @@ void keyboard_task(void) {
 #ifdef OS_DETECTION_ENABLE
     os_detection_task();
 #endif
+
+    usb_report_perf_task();
 }
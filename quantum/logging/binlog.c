@@ -0,0 +1,27 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "binlog.h"
+#include "sendchar.h"
+
+static void binlog_send_varint(uint32_t value) {
+    while (value >= 0x80) {
+        sendchar((uint8_t)(value | 0x80));
+        value >>= 7;
+    }
+    sendchar((uint8_t)value);
+}
+
+void binlog_write(uint32_t id, const uint32_t *args, uint8_t count) {
+    if (count > BINLOG_MAX_ARGS) {
+        count = BINLOG_MAX_ARGS;
+    }
+
+    sendchar(BINLOG_FRAME_MARKER | count);
+    for (uint8_t i = 0; i < 4; i++) {
+        sendchar((uint8_t)(id >> (i * 8)));
+    }
+    for (uint8_t i = 0; i < count; i++) {
+        binlog_send_varint(args[i]);
+    }
+}
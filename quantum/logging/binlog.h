@@ -0,0 +1,84 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include "debug.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Binary structured logging.
+ *
+ * With BINLOG_ENABLE, binlog() doesn't format anything on the keyboard. The
+ * format string is reduced to a 32 bit id at compile time, so the string
+ * itself never reaches flash, and only the id and the integer arguments are
+ * sent over the console. `qmk generate-binlog-dictionary` extracts the format
+ * strings from the sources into a dictionary at build time, which
+ * `qmk binlog-console` uses to turn the messages back into text.
+ *
+ * Each message is sent as:
+ *
+ *   BINLOG_FRAME_MARKER | argument count, never part of UTF-8 text
+ *   id, 4 bytes little endian
+ *   each argument as an unsigned LEB128 varint of its 32 bit value
+ *
+ * so it can be mixed with normal console output. Without BINLOG_ENABLE,
+ * binlog() falls back to xprintf().
+ *
+ * Format strings must be string literals, and only take integer arguments
+ * (%d, %i, %u, %x, %X, %c, %b, with flags, width and the l modifier).
+ */
+
+#define BINLOG_FRAME_MARKER 0xF8
+#define BINLOG_MAX_ARGS 7
+
+/* Only the first BINLOG_HASH_LENGTH characters of a format string are hashed, followed by its length */
+#define BINLOG_HASH_LENGTH 64
+
+#define BINLOG_FNV_OFFSET UINT32_C(2166136261)
+#define BINLOG_FNV_PRIME UINT32_C(16777619)
+
+/*
+ * FNV-1a, unrolled so that it folds to a constant. Characters past the end of
+ * the string are hashed as the identity, so that the string is only
+ * referenced once per step and the expansion stays linear.
+ */
+#define BINLOG_FNV_CHAR(s, i) ((i) < sizeof(s) - 1 ? (uint8_t)(s)[(i) < sizeof(s) ? (i) : 0] : 0)
+#define BINLOG_FNV_MUL(s, i) ((i) < sizeof(s) - 1 ? BINLOG_FNV_PRIME : UINT32_C(1))
+#define BINLOG_FNV_1(h, s, i) ((uint32_t)(((h) ^ BINLOG_FNV_CHAR(s, i)) * BINLOG_FNV_MUL(s, i)))
+#define BINLOG_FNV_4(h, s, i) BINLOG_FNV_1(BINLOG_FNV_1(BINLOG_FNV_1(BINLOG_FNV_1(h, s, i), s, i + 1), s, i + 2), s, i + 3)
+#define BINLOG_FNV_16(h, s, i) BINLOG_FNV_4(BINLOG_FNV_4(BINLOG_FNV_4(BINLOG_FNV_4(h, s, i), s, i + 4), s, i + 8), s, i + 12)
+#define BINLOG_FNV_64(h, s, i) BINLOG_FNV_16(BINLOG_FNV_16(BINLOG_FNV_16(BINLOG_FNV_16(h, s, i), s, i + 16), s, i + 32), s, i + 48)
+
+/* The id of a format string literal, as computed by lib/python/qmk/binlog.py */
+#define BINLOG_ID(fmt) ((uint32_t)((BINLOG_FNV_64(BINLOG_FNV_OFFSET, fmt, 0) ^ (uint32_t)(sizeof(fmt) - 1)) * BINLOG_FNV_PRIME))
+
+void binlog_write(uint32_t id, const uint32_t *args, uint8_t count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#if defined(BINLOG_ENABLE) && !defined(NO_PRINT) && !defined(USER_PRINT)
+#    define binlog(fmt, ...)                                                                                                                     \
+        do {                                                                                                                                     \
+            _Static_assert(sizeof((const uint32_t[]){__VA_ARGS__}) / sizeof(uint32_t) <= BINLOG_MAX_ARGS, "binlog() takes at most 7 arguments"); \
+            binlog_write(BINLOG_ID(fmt), (const uint32_t[]){__VA_ARGS__}, sizeof((const uint32_t[]){__VA_ARGS__}) / sizeof(uint32_t));           \
+        } while (0)
+#else
+#    define binlog(fmt, ...) xprintf(fmt, ##__VA_ARGS__)
+#endif
+
+#ifndef NO_DEBUG
+#    define dbinlog(fmt, ...)                                    \
+        do {                                                     \
+            if (debug_config.enable) binlog(fmt, ##__VA_ARGS__); \
+        } while (0)
+#else
+#    define dbinlog(fmt, ...)
+#endif
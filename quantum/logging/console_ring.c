@@ -0,0 +1,60 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "console_ring.h"
+
+_Static_assert((CONSOLE_RING_BUFFER_SIZE & (CONSOLE_RING_BUFFER_SIZE - 1)) == 0, "CONSOLE_RING_BUFFER_SIZE must be a power of two");
+_Static_assert(CONSOLE_RING_BUFFER_SIZE <= 32768, "CONSOLE_RING_BUFFER_SIZE must be at most 32768");
+
+#define CONSOLE_RING_MASK (CONSOLE_RING_BUFFER_SIZE - 1)
+
+static uint8_t  ring[CONSOLE_RING_BUFFER_SIZE];
+static uint16_t head          = 0; // Free-running, masked on access
+static uint16_t tail          = 0;
+static uint32_t dropped       = 0;
+static uint32_t dropped_total = 0;
+
+bool console_ring_write(uint8_t c) {
+    if ((uint16_t)(head - tail) >= CONSOLE_RING_BUFFER_SIZE) {
+        dropped++;
+        dropped_total++;
+        return false;
+    }
+    ring[head & CONSOLE_RING_MASK] = c;
+    head++;
+    return true;
+}
+
+size_t console_ring_copy(uint8_t *data, size_t size) {
+    size_t used = (uint16_t)(head - tail);
+    if (size > used) {
+        size = used;
+    }
+    for (size_t i = 0; i < size; i++) {
+        data[i] = ring[(uint16_t)(tail + i) & CONSOLE_RING_MASK];
+    }
+    return size;
+}
+
+void console_ring_consume(size_t size) {
+    size_t used = (uint16_t)(head - tail);
+    tail += size < used ? size : used;
+}
+
+size_t console_ring_used(void) {
+    return (uint16_t)(head - tail);
+}
+
+size_t console_ring_free(void) {
+    return CONSOLE_RING_BUFFER_SIZE - console_ring_used();
+}
+
+uint32_t console_ring_take_dropped(void) {
+    uint32_t count = dropped;
+    dropped        = 0;
+    return count;
+}
+
+uint32_t get_console_dropped(void) {
+    return dropped_total;
+}
@@ -0,0 +1,41 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * A RAM ring buffer for console output. sendchar() stores each character in
+ * the ring, and console_task() copies the contents out of it into a packet
+ * buffer, a full endpoint-sized packet at a time, so printing never waits for
+ * the host.
+ *
+ * Characters that don't fit, e.g. while nothing on the host is listening, are
+ * dropped and counted. There is a single writer and a single reader, both on
+ * the main thread.
+ */
+
+#ifndef CONSOLE_RING_BUFFER_SIZE
+#    define CONSOLE_RING_BUFFER_SIZE 1024
+#endif
+
+/* Appends a character, returning false if the ring is full and it was dropped */
+bool console_ring_write(uint8_t c);
+
+/* Copies up to `size` of the oldest characters into `data`, across the wrap, returning how many were copied */
+size_t console_ring_copy(uint8_t *data, size_t size);
+
+/* Removes `size` characters, after they have been sent */
+void console_ring_consume(size_t size);
+
+size_t console_ring_used(void);
+size_t console_ring_free(void);
+
+/* Returns the number of characters dropped since the last call */
+uint32_t console_ring_take_dropped(void);
+
+/* Returns the number of characters dropped since startup */
+uint32_t get_console_dropped(void);
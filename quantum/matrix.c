@@ -21,6 +21,14 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include "matrix.h"
 #include "debounce.h"
 #include "atomic_util.h"
+#ifdef MATRIX_READ_PROFILE
+#    include "debug.h"
+#    include "basic_profiling.h"
+#endif
+#ifdef MATRIX_IDLE_ENABLE
+#    include "matrix_idle.h"
+#    include "matrix_idle_wakeup.h"
+#endif
 
 #ifdef SPLIT_KEYBOARD
 #    include "split_common/split_util.h"
@@ -51,6 +59,15 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #    define MATRIX_INPUT_PRESSED_STATE 0
 #endif
 
+// Sample each column port once per row, using the port grouping generated from info.json
+#ifdef MATRIX_COL_PORT_READ_ENABLE
+#    ifndef MATRIX_COL_PORTS
+#        error MATRIX_COL_PORT_READ_ENABLE requires the column pins to come from matrix_pins in info.json or keymap.json
+#    elif defined(gpio_read_port) && !defined(MATRIX_COL_PINS_RIGHT)
+#        define MATRIX_COL_PORT_READ
+#    endif
+#endif
+
 #ifdef DIRECT_PINS
 static SPLIT_MUTABLE pin_t direct_pins[ROWS_PER_HAND][MATRIX_COLS] = DIRECT_PINS;
 #elif (DIODE_DIRECTION == ROW2COL) || (DIODE_DIRECTION == COL2ROW)
@@ -172,6 +189,23 @@ __attribute__((weak)) void matrix_init_pins(void) {
     }
 }
 
+#            ifdef MATRIX_COL_PORT_READ
+static inline matrix_row_t read_cols_on_ports(void) {
+    port_data_t ports[MATRIX_COL_PORT_COUNT];
+
+    // Pressed keys read as set bits
+#                define MATRIX_COL_PORT_SAMPLE(index, pin) ports[index] = MATRIX_INPUT_PRESSED_STATE ? gpio_read_port(pin) : ~gpio_read_port(pin);
+    MATRIX_COL_PORTS(MATRIX_COL_PORT_SAMPLE)
+
+    // Move each run of bits to the columns they belong to
+    matrix_row_t row_value = 0;
+#                define MATRIX_COL_PORT_SHIFT(index, mask, left_shift, right_shift) row_value |= (matrix_row_t)((ports[index] & (mask)) >> (right_shift)) << (left_shift);
+    MATRIX_COL_PORT_SHIFTS(MATRIX_COL_PORT_SHIFT)
+
+    return row_value;
+}
+#            endif
+
 __attribute__((weak)) void matrix_read_cols_on_row(matrix_row_t current_matrix[], uint8_t current_row) {
     // Start with a clear matrix row
     matrix_row_t current_row_value = 0;
@@ -181,6 +215,9 @@ __attribute__((weak)) void matrix_read_cols_on_row(matrix_row_t current_matrix[]
     }
     matrix_output_select_delay();
 
+#            ifdef MATRIX_COL_PORT_READ
+    current_row_value = read_cols_on_ports();
+#            else
     // For each col...
     matrix_row_t row_shifter = MATRIX_ROW_SHIFTER;
     for (uint8_t col_index = 0; col_index < MATRIX_COLS; col_index++, row_shifter <<= 1) {
@@ -189,6 +226,7 @@ __attribute__((weak)) void matrix_read_cols_on_row(matrix_row_t current_matrix[]
         // Populate the matrix row with the state of the col pin
         current_row_value |= pin_state ? 0 : row_shifter;
     }
+#            endif
 
     // Unselect row
     unselect_row(current_row);
@@ -270,6 +308,99 @@ __attribute__((weak)) void matrix_read_rows_on_col(matrix_row_t current_matrix[]
 #    error DIODE_DIRECTION is not defined!
 #endif
 
+#if defined(MATRIX_IDLE_ENABLE) && (defined(DIRECT_PINS) || (defined(MATRIX_ROW_PINS) && defined(MATRIX_COL_PINS)))
+__attribute__((weak)) void matrix_idle_wakeup_enable(pin_t pin) {}
+
+__attribute__((weak)) void matrix_idle_wakeup_disable(pin_t pin) {}
+
+static void matrix_idle_set_wakeup(pin_t pin, bool enable) {
+    if (pin == NO_PIN) {
+        return;
+    }
+    if (enable) {
+        matrix_idle_wakeup_enable(pin);
+    } else {
+        matrix_idle_wakeup_disable(pin);
+    }
+}
+
+static void matrix_idle_set_wakeups(bool enable) {
+#    ifdef DIRECT_PINS
+    for (uint8_t row = 0; row < ROWS_PER_HAND; row++) {
+        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+            matrix_idle_set_wakeup(direct_pins[row][col], enable);
+        }
+    }
+#    elif (DIODE_DIRECTION == COL2ROW)
+    for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+        matrix_idle_set_wakeup(col_pins[col], enable);
+    }
+#    elif (DIODE_DIRECTION == ROW2COL)
+    for (uint8_t row = 0; row < ROWS_PER_HAND; row++) {
+        matrix_idle_set_wakeup(row_pins[row], enable);
+    }
+#    endif
+}
+
+bool matrix_idle_inputs_active(void) {
+#    ifdef DIRECT_PINS
+    for (uint8_t row = 0; row < ROWS_PER_HAND; row++) {
+        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+            if (readMatrixPin(direct_pins[row][col]) == 0) {
+                return true;
+            }
+        }
+    }
+#    elif (DIODE_DIRECTION == COL2ROW)
+    for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+        if (readMatrixPin(col_pins[col]) == 0) {
+            return true;
+        }
+    }
+#    elif (DIODE_DIRECTION == ROW2COL)
+    for (uint8_t row = 0; row < ROWS_PER_HAND; row++) {
+        if (readMatrixPin(row_pins[row]) == 0) {
+            return true;
+        }
+    }
+#    endif
+    return false;
+}
+
+bool matrix_idle_arm(void) {
+    // Select everything, so that any key press pulls its input low
+#    if !defined(DIRECT_PINS) && (DIODE_DIRECTION == COL2ROW)
+    for (uint8_t row = 0; row < ROWS_PER_HAND; row++) {
+        select_row(row);
+    }
+#    elif !defined(DIRECT_PINS) && (DIODE_DIRECTION == ROW2COL)
+    for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+        select_col(col);
+    }
+#    endif
+    matrix_output_select_delay();
+
+    if (matrix_idle_inputs_active()) {
+        return false;
+    }
+    matrix_idle_set_wakeups(true);
+
+    // A key may have been pressed before its wakeup was enabled
+    return !matrix_idle_inputs_active();
+}
+
+void matrix_idle_disarm(void) {
+    matrix_idle_set_wakeups(false);
+#    if !defined(DIRECT_PINS) && (DIODE_DIRECTION == COL2ROW)
+    unselect_rows();
+    matrix_io_delay();
+#    elif !defined(DIRECT_PINS) && (DIODE_DIRECTION == ROW2COL)
+    unselect_cols();
+    matrix_io_delay();
+#    endif
+}
+#endif
+
 void matrix_init(void) {
 #ifdef SPLIT_KEYBOARD
     // Set pinout for right half if pinout for that half is defined
@@ -326,13 +457,21 @@ uint8_t matrix_scan(void) {
 #if defined(DIRECT_PINS) || (DIODE_DIRECTION == COL2ROW)
     // Set row, read cols
     for (uint8_t current_row = 0; current_row < ROWS_PER_HAND; current_row++) {
+#    ifdef MATRIX_READ_PROFILE
+        PROFILE_CALL_TICKS(1000, matrix_read_cols_on_row(curr_matrix, current_row));
+#    else
         matrix_read_cols_on_row(curr_matrix, current_row);
+#    endif
     }
 #elif (DIODE_DIRECTION == ROW2COL)
     // Set col, read rows
     matrix_row_t row_shifter = MATRIX_ROW_SHIFTER;
     for (uint8_t current_col = 0; current_col < MATRIX_COLS; current_col++, row_shifter <<= 1) {
+#    ifdef MATRIX_READ_PROFILE
+        PROFILE_CALL_TICKS(1000, matrix_read_rows_on_col(curr_matrix, current_col, row_shifter));
+#    else
         matrix_read_rows_on_col(curr_matrix, current_col, row_shifter);
+#    endif
     }
 #endif
 
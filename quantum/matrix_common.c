@@ -130,6 +130,12 @@ __attribute__((weak)) void matrix_output_select_delay(void) {
     waitInputPinDelay();
 }
 __attribute__((weak)) void matrix_output_unselect_delay(uint8_t line, bool key_pressed) {
+#ifdef MATRIX_IO_DELAY_ONLY_PRESSED
+    // Inputs are only pulled low through pressed keys, otherwise there's nothing to wait for
+    if (!key_pressed) {
+        return;
+    }
+#endif
     matrix_io_delay();
 }
 
@@ -0,0 +1,142 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "matrix_idle.h"
+#include "matrix.h"
+#include "keyboard.h"
+#include "timer.h"
+#include "wait.h"
+
+#ifdef RGBLIGHT_ENABLE
+#    include "rgblight.h"
+#endif
+
+#ifdef RGB_MATRIX_ENABLE
+#    include "rgb_matrix.h"
+#endif
+
+#ifdef LED_MATRIX_ENABLE
+#    include "led_matrix.h"
+#endif
+
+#ifdef DEFERRED_EXEC_ENABLE
+#    include "deferred_exec.h"
+#endif
+
+// Milliseconds without input before scanning less often
+#ifndef MATRIX_ADAPTIVE_SCAN_TIMEOUT
+#    define MATRIX_ADAPTIVE_SCAN_TIMEOUT 1000
+#endif
+
+// Milliseconds between scans once idle
+#ifndef MATRIX_ADAPTIVE_SCAN_INTERVAL
+#    define MATRIX_ADAPTIVE_SCAN_INTERVAL 10
+#endif
+
+// Milliseconds without input before sleeping until a key is pressed
+#ifndef MATRIX_IDLE_TIMEOUT
+#    define MATRIX_IDLE_TIMEOUT 30000
+#endif
+
+// Longest single sleep, so that the rest of the main loop still runs now and then
+#ifndef MATRIX_IDLE_SLEEP_TIMEOUT
+#    define MATRIX_IDLE_SLEEP_TIMEOUT 100
+#endif
+
+static uint32_t last_scan_time = 0;
+
+__attribute__((weak)) bool matrix_idle_arm(void) {
+    return false;
+}
+
+__attribute__((weak)) void matrix_idle_disarm(void) {}
+
+__attribute__((weak)) bool matrix_idle_inputs_active(void) {
+    return true;
+}
+
+__attribute__((weak)) bool matrix_idle_wakeup_wait(uint32_t timeout_ms) {
+    for (uint32_t i = 0; i < timeout_ms; i++) {
+        if (matrix_idle_inputs_active()) {
+            return true;
+        }
+        wait_ms(1);
+    }
+    return false;
+}
+
+bool matrix_idle_sleep(uint32_t timeout_ms) {
+    bool armed = matrix_idle_arm();
+    if (armed) {
+        matrix_idle_wakeup_wait(timeout_ms);
+    }
+    matrix_idle_disarm();
+    return armed;
+}
+
+static bool matrix_is_idle(void) {
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        if (matrix_get_row(row)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Whether the rest of the main loop can be held up for a whole sleep
+static bool matrix_idle_can_sleep(void) {
+#if defined(ENCODER_ENABLE) || defined(POINTING_DEVICE_ENABLE)
+    // Polled rather than wired to the matrix inputs, so their movement can't wake the MCU
+    return false;
+#else
+#    if defined(RGBLIGHT_ENABLE) && defined(RGBLIGHT_USE_TIMER)
+    if (rgblight_is_enabled() && rgblight_get_mode() > RGBLIGHT_MODE_STATIC_LIGHT) {
+        return false;
+    }
+#    endif
+#    ifdef RGB_MATRIX_ENABLE
+    if (rgb_matrix_is_enabled() && !rgb_matrix_get_suspend_state() && rgb_matrix_get_mode() > RGB_MATRIX_SOLID_COLOR
+#        if RGB_MATRIX_TIMEOUT > 0
+        && last_input_activity_elapsed() <= (uint32_t)RGB_MATRIX_TIMEOUT
+#        endif
+    ) {
+        return false;
+    }
+#    endif
+#    ifdef LED_MATRIX_ENABLE
+    if (led_matrix_is_enabled() && !led_matrix_get_suspend_state() && led_matrix_get_mode() > LED_MATRIX_SOLID
+#        if LED_MATRIX_TIMEOUT > 0
+        && last_input_activity_elapsed() <= (uint32_t)LED_MATRIX_TIMEOUT
+#        endif
+    ) {
+        return false;
+    }
+#    endif
+#    ifdef DEFERRED_EXEC_ENABLE
+    if (deferred_exec_pending()) {
+        return false;
+    }
+#    endif
+    return true;
+#endif
+}
+
+bool matrix_idle_task(void) {
+    uint32_t idle_time = last_input_activity_elapsed();
+
+    if (idle_time >= MATRIX_ADAPTIVE_SCAN_TIMEOUT) {
+#ifndef SPLIT_KEYBOARD
+        // Held keys have to be scanned for their release, and the other half of a split can't wake this one
+        if (idle_time >= MATRIX_IDLE_TIMEOUT && matrix_is_idle() && matrix_idle_can_sleep() && matrix_idle_sleep(MATRIX_IDLE_SLEEP_TIMEOUT)) {
+            last_scan_time = timer_read32();
+            return true;
+        }
+#endif
+        if (timer_elapsed32(last_scan_time) < MATRIX_ADAPTIVE_SCAN_INTERVAL) {
+            return false;
+        }
+    }
+
+    last_scan_time = timer_read32();
+    return true;
+}
@@ -0,0 +1,61 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*
+ * Reduces matrix scanning while the keyboard isn't being used.
+ *
+ * After MATRIX_ADAPTIVE_SCAN_TIMEOUT milliseconds without input, the matrix is
+ * only scanned every MATRIX_ADAPTIVE_SCAN_INTERVAL milliseconds. After
+ * MATRIX_IDLE_TIMEOUT milliseconds, every row (or column) is selected at once
+ * so that any key press changes an input, and the MCU sleeps until one does.
+ * The sleep is skipped while encoders, pointing devices, lighting animations or
+ * deferred executors need the main loop to keep running.
+ */
+
+/**
+ * \brief Whether the matrix should be scanned on this pass of the main loop.
+ *
+ * May sleep until a key is pressed, if the keyboard has been idle long enough.
+ */
+bool matrix_idle_task(void);
+
+/**
+ * \brief Sleep until a key is pressed, or `timeout_ms` has passed.
+ *
+ * \return false if a key was already pressed, or the matrix can't be armed
+ */
+bool matrix_idle_sleep(uint32_t timeout_ms);
+
+/**
+ * \brief Select every row (or column) at once and arm the inputs to wake the MCU.
+ *
+ * Implemented by the standard matrix; custom matrices can implement it as well.
+ *
+ * \return false if an input is already active, or the matrix can't be armed
+ */
+bool matrix_idle_arm(void);
+
+/**
+ * \brief Disarm the inputs and unselect every row (or column) again.
+ */
+void matrix_idle_disarm(void);
+
+/**
+ * \brief Whether any input is active while the matrix is armed.
+ */
+bool matrix_idle_inputs_active(void);
+
+/**
+ * \brief Wait until an armed input wakes the MCU, or `timeout_ms` has passed.
+ *
+ * Without a platform implementation, polls matrix_idle_inputs_active() every
+ * millisecond.
+ *
+ * \return true if woken by an input
+ */
+bool matrix_idle_wakeup_wait(uint32_t timeout_ms);
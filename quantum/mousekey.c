@@ -52,6 +52,24 @@ static int8_t  mousekey_y_inertia = 0; // ...
 #ifdef MK_KINETIC_SPEED
 static uint16_t mouse_timer = 0;
 #endif
+#ifdef MK_SMOOTH_SPEED
+// 32-bit, as keys can be held for longer than it takes a 16-bit timer to wrap
+static uint32_t mousekey_cursor_timer = 0; // when the cursor keys were first held
+static uint32_t mousekey_wheel_timer  = 0; // when the wheel keys were first held
+static uint16_t mousekey_frame_timer  = 0;
+static struct {
+    int8_t x;
+    int8_t y;
+    int8_t v;
+    int8_t h;
+} mousekey_dir = {}; // -1 / 0 / 1 for each direction held, the report only carries motion still to be sent
+static struct {
+    int32_t x;
+    int32_t y;
+    int32_t v;
+    int32_t h;
+} mousekey_remainder = {}; // fractions of a count moved but not yet sent
+#endif
 
 #ifndef MK_3_SPEED
 
@@ -304,6 +322,53 @@ static int8_t calc_inertia(int8_t direction, int8_t velocity) {
 
 #    endif
 
+#    ifdef MK_SMOOTH_SPEED
+
+/*
+ * Smooth movement algorithm
+ *
+ * Follows the accelerated mode, but spreads each step over its interval: the
+ * step is worked out from how long the keys have been held, and every frame
+ * moves by its share of it. What is left of a count is carried into the next
+ * frame rather than rounded away.
+ */
+static uint16_t smooth_unit(uint8_t delta, uint8_t max_speed, uint8_t time_to_max, uint8_t interval, uint8_t max, uint32_t held) {
+    // step per interval, in 1/256ths of a count
+    uint32_t unit = (uint32_t)delta * max_speed * 256;
+    if (mousekey_accel & (1 << 0)) {
+        unit /= 4;
+    } else if (mousekey_accel & (1 << 1)) {
+        unit /= 2;
+    } else if (!(mousekey_accel & (1 << 2)) && held + interval < (uint32_t)time_to_max * interval) {
+        unit = unit * (held + interval) / ((uint32_t)time_to_max * interval);
+    }
+
+    if (unit > (uint32_t)max * 256) {
+        unit = (uint32_t)max * 256;
+    } else if (unit < 256) {
+        unit = 256;
+    }
+    return unit;
+}
+
+/* Moves by the whole counts travelled, keeping the rest in 1/256ths of a count per interval for the next frame. */
+static int8_t smooth_step(int32_t *remainder, int32_t distance, uint8_t interval, uint8_t max) {
+    int32_t count = 256 * (int32_t)(interval ? interval : 1);
+    *remainder += distance;
+    int32_t step = *remainder / count;
+    *remainder -= step * count;
+
+    // motion beyond the report range is dropped, as in the other modes
+    if (step > max) {
+        step = max;
+    } else if (step < -max) {
+        step = -max;
+    }
+    return step;
+}
+
+#    endif
+
 void mousekey_task(void) {
     // report cursor and scroll movement independently
     report_mouse_t tmpmr = mouse_report;
@@ -313,7 +378,38 @@ void mousekey_task(void) {
     mouse_report.v = 0;
     mouse_report.h = 0;
 
-#    ifdef MOUSEKEY_INERTIA
+#    if defined(MK_SMOOTH_SPEED)
+
+    uint16_t frame = timer_elapsed(mousekey_frame_timer);
+    if (frame >= MOUSEKEY_FRAME_INTERVAL) {
+        mousekey_frame_timer = timer_read();
+
+        uint32_t held = timer_elapsed32(mousekey_cursor_timer);
+        if ((mousekey_dir.x || mousekey_dir.y) && held > mk_delay * 10) {
+            int32_t distance = (int32_t)smooth_unit(MOUSEKEY_MOVE_DELTA, mk_max_speed, mk_time_to_max, mk_interval, MOUSEKEY_MOVE_MAX, held - mk_delay * 10) * frame;
+            /* diagonal move [1/sqrt(2)] */
+            if (mousekey_dir.x && mousekey_dir.y) distance = distance * 181 / 256;
+            if (mousekey_dir.x) mouse_report.x = smooth_step(&mousekey_remainder.x, mousekey_dir.x * distance, mk_interval, MOUSEKEY_MOVE_MAX);
+            if (mousekey_dir.y) mouse_report.y = smooth_step(&mousekey_remainder.y, mousekey_dir.y * distance, mk_interval, MOUSEKEY_MOVE_MAX);
+        }
+
+        held = timer_elapsed32(mousekey_wheel_timer);
+        if ((mousekey_dir.v || mousekey_dir.h) && held > mk_wheel_delay * 10) {
+            int32_t distance = (int32_t)smooth_unit(MOUSEKEY_WHEEL_DELTA, mk_wheel_max_speed, mk_wheel_time_to_max, mk_wheel_interval, MOUSEKEY_WHEEL_MAX, held - mk_wheel_delay * 10) * frame;
+            /* diagonal move [1/sqrt(2)] */
+            if (mousekey_dir.v && mousekey_dir.h) distance = distance * 181 / 256;
+            if (mousekey_dir.v) mouse_report.v = smooth_step(&mousekey_remainder.v, mousekey_dir.v * distance, mk_wheel_interval, MOUSEKEY_WHEEL_MAX);
+            if (mousekey_dir.h) mouse_report.h = smooth_step(&mousekey_remainder.h, mousekey_dir.h * distance, mk_wheel_interval, MOUSEKEY_WHEEL_MAX);
+        }
+    }
+
+    // forget the fractions of released keys
+    if (!mousekey_dir.x) mousekey_remainder.x = 0;
+    if (!mousekey_dir.y) mousekey_remainder.y = 0;
+    if (!mousekey_dir.v) mousekey_remainder.v = 0;
+    if (!mousekey_dir.h) mousekey_remainder.h = 0;
+
+#    elif defined(MOUSEKEY_INERTIA)
 
     // if an animation is in progress and it's time for the next frame
     if ((mousekey_frame) && timer_elapsed(last_timer_c) > ((mousekey_frame > 1) ? mk_interval : mk_delay * 10)) {
@@ -357,8 +453,9 @@ void mousekey_task(void) {
         }
     }
 
-#    endif // MOUSEKEY_INERTIA or not
+#    endif // MK_SMOOTH_SPEED, MOUSEKEY_INERTIA or not
 
+#    ifndef MK_SMOOTH_SPEED
     if ((tmpmr.v || tmpmr.h) && timer_elapsed(last_timer_w) > (mousekey_wheel_repeat ? mk_wheel_interval : mk_wheel_delay * 10)) {
         if (mousekey_wheel_repeat != UINT8_MAX) mousekey_wheel_repeat++;
         if (tmpmr.v != 0) mouse_report.v = wheel_unit() * ((tmpmr.v > 0) ? 1 : -1);
@@ -376,6 +473,7 @@ void mousekey_task(void) {
             }
         }
     }
+#    endif
 
     if (has_mouse_report_changed(&mouse_report, &tmpmr) || should_mousekey_report_send(&mouse_report)) {
         mousekey_send();
@@ -390,8 +488,39 @@ void mousekey_on(uint8_t code) {
         mouse_timer = timer_read();
     }
 #    endif
+#    ifdef MK_SMOOTH_SPEED
+    // speed ramps up from the first cursor or wheel key pressed
+    if (IS_MOUSEKEY_MOVE(code) && !mousekey_dir.x && !mousekey_dir.y) {
+        mousekey_cursor_timer = timer_read32();
+    } else if (IS_MOUSEKEY_WHEEL(code) && !mousekey_dir.v && !mousekey_dir.h) {
+        mousekey_wheel_timer = timer_read32();
+    }
+#        ifdef MOUSEKEY_OVERLAP_RESET
+    else if (IS_MOUSEKEY_MOVE(code) || IS_MOUSEKEY_WHEEL(code)) {
+        mousekey_cursor_timer = timer_read32() - mk_delay * 10 - MOUSEKEY_OVERLAP_MOVE_DELTA * mk_interval;
+        mousekey_wheel_timer  = timer_read32() - mk_wheel_delay * 10 - MOUSEKEY_OVERLAP_WHEEL_DELTA * mk_wheel_interval;
+    }
+#        endif
 
-#    if defined(MOUSEKEY_OVERLAP_RESET) && !defined(MOUSEKEY_INERTIA)
+    if (code == QK_MOUSE_CURSOR_UP)
+        mousekey_dir.y = -1;
+    else if (code == QK_MOUSE_CURSOR_DOWN)
+        mousekey_dir.y = 1;
+    else if (code == QK_MOUSE_CURSOR_LEFT)
+        mousekey_dir.x = -1;
+    else if (code == QK_MOUSE_CURSOR_RIGHT)
+        mousekey_dir.x = 1;
+    else if (code == QK_MOUSE_WHEEL_UP)
+        mousekey_dir.v = 1;
+    else if (code == QK_MOUSE_WHEEL_DOWN)
+        mousekey_dir.v = -1;
+    else if (code == QK_MOUSE_WHEEL_LEFT)
+        mousekey_dir.h = -1;
+    else if (code == QK_MOUSE_WHEEL_RIGHT)
+        mousekey_dir.h = 1;
+#    endif
+
+#    if defined(MOUSEKEY_OVERLAP_RESET) && !defined(MOUSEKEY_INERTIA) && !defined(MK_SMOOTH_SPEED)
     // If mouse report is not zero, the current mousekey press is overlapping
     // with another. Restart acceleration for smoother directional transition.
     if (mouse_report.x || mouse_report.y || mouse_report.h || mouse_report.v) {
@@ -402,7 +531,7 @@ void mousekey_on(uint8_t code) {
         mousekey_wheel_repeat = MOUSEKEY_OVERLAP_WHEEL_DELTA;
 #        endif
     }
-#    endif // defined(MOUSEKEY_OVERLAP_RESET) && !defined(MOUSEKEY_INERTIA)
+#    endif // defined(MOUSEKEY_OVERLAP_RESET) && !defined(MOUSEKEY_INERTIA) && !defined(MK_SMOOTH_SPEED)
 
 #    ifdef MOUSEKEY_INERTIA
 
@@ -447,6 +576,25 @@ void mousekey_on(uint8_t code) {
 }
 
 void mousekey_off(uint8_t code) {
+#    ifdef MK_SMOOTH_SPEED
+    if (code == QK_MOUSE_CURSOR_UP && mousekey_dir.y < 0)
+        mousekey_dir.y = 0;
+    else if (code == QK_MOUSE_CURSOR_DOWN && mousekey_dir.y > 0)
+        mousekey_dir.y = 0;
+    else if (code == QK_MOUSE_CURSOR_LEFT && mousekey_dir.x < 0)
+        mousekey_dir.x = 0;
+    else if (code == QK_MOUSE_CURSOR_RIGHT && mousekey_dir.x > 0)
+        mousekey_dir.x = 0;
+    else if (code == QK_MOUSE_WHEEL_UP && mousekey_dir.v > 0)
+        mousekey_dir.v = 0;
+    else if (code == QK_MOUSE_WHEEL_DOWN && mousekey_dir.v < 0)
+        mousekey_dir.v = 0;
+    else if (code == QK_MOUSE_WHEEL_LEFT && mousekey_dir.h < 0)
+        mousekey_dir.h = 0;
+    else if (code == QK_MOUSE_WHEEL_RIGHT && mousekey_dir.h > 0)
+        mousekey_dir.h = 0;
+#    endif
+
 #    ifdef MOUSEKEY_INERTIA
 
     // key release clears impulse unless opposite direction is held
@@ -635,7 +783,22 @@ void mousekey_send(void) {
     uint16_t time = timer_read();
     if (mouse_report.x || mouse_report.y) last_timer_c = time;
     if (mouse_report.v || mouse_report.h) last_timer_w = time;
+#ifdef POINTING_DEVICE_HIRES_SCROLL_ENABLE
+    // Wheel keys step whole detents, the host may count in fractions of one
+    report_mouse_t report = mouse_report;
+    report.h *= mouse_wheel_resolution(true);
+    report.v *= mouse_wheel_resolution(false);
+    host_mouse_send(&report);
+#else
     host_mouse_send(&mouse_report);
+#endif
+#ifdef MK_SMOOTH_SPEED
+    // each press moves one step, held keys move on in mousekey_task
+    mouse_report.x = 0;
+    mouse_report.y = 0;
+    mouse_report.v = 0;
+    mouse_report.h = 0;
+#endif
 }
 
 void mousekey_clear(void) {
@@ -650,6 +813,10 @@ void mousekey_clear(void) {
     mousekey_x_dir     = 0;
     mousekey_y_dir     = 0;
 #endif
+#ifdef MK_SMOOTH_SPEED
+    memset(&mousekey_dir, 0, sizeof(mousekey_dir));
+    memset(&mousekey_remainder, 0, sizeof(mousekey_remainder));
+#endif
 }
 
 static void mousekey_debug(void) {
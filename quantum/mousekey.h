@@ -92,6 +92,10 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #        define MOUSEKEY_WHEEL_TIME_TO_MAX 40
 #    endif
 
+#    ifndef MOUSEKEY_FRAME_INTERVAL
+#        define MOUSEKEY_FRAME_INTERVAL 1 // one USB frame
+#    endif
+
 #    ifndef MOUSEKEY_FRICTION
 #        define MOUSEKEY_FRICTION 24 // 0 to 255
 #    endif
@@ -174,6 +178,10 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 
 #endif /* #ifndef MK_3_SPEED */
 
+#if defined(MK_SMOOTH_SPEED) && (defined(MK_3_SPEED) || defined(MK_COMBINED) || defined(MK_KINETIC_SPEED) || defined(MOUSEKEY_INERTIA))
+#    error "MK_SMOOTH_SPEED cannot be used with another mouse keys mode"
+#endif
+
 #ifndef MOUSEKEY_OVERLAP_MOVE_DELTA
 #    define MOUSEKEY_OVERLAP_MOVE_DELTA MOUSEKEY_MOVE_DELTA
 #endif
@@ -35,6 +35,19 @@
 #    endif
 #endif
 
+#if defined(POINTING_DEVICE_ACCEL_ENABLE) && defined(POINTING_DEVICE_COMBINED)
+#    error POINTING_DEVICE_ACCEL_ENABLE not supported with POINTING_DEVICE_COMBINED.
+#endif
+
+#if defined(POINTING_DEVICE_GESTURES_MOMENTUM_ENABLE) && defined(POINTING_DEVICE_COMBINED)
+#    error POINTING_DEVICE_GESTURES_MOMENTUM_ENABLE not supported with POINTING_DEVICE_COMBINED.
+#endif
+
+#ifdef POINTING_DEVICE_GESTURES_MOMENTUM_ENABLE
+#    include "deferred_exec.h"
+#    include "util.h"
+#endif
+
 #if defined(SPLIT_POINTING_ENABLE)
 #    include "transactions.h"
 #    include "keyboard.h"
@@ -102,6 +115,247 @@ const pointing_device_driver_t custom_pointing_device_driver = {
 
 const pointing_device_driver_t *pointing_device_driver = &POINTING_DEVICE_DRIVER(POINTING_DEVICE_DRIVER_NAME);
 
+#ifdef POINTING_DEVICE_MOTION_INTERRUPT
+#    ifndef POINTING_DEVICE_MOTION_PIN
+#        error "POINTING_DEVICE_MOTION_INTERRUPT requires POINTING_DEVICE_MOTION_PIN"
+#    endif
+#    if defined(SPLIT_POINTING_ENABLE)
+#        error POINTING_DEVICE_MOTION_INTERRUPT not supported when sharing the pointing device report between sides.
+#    endif
+
+// Motion read from the sensor but not yet sent to the host
+static struct {
+    int32_t x;
+    int32_t y;
+    int32_t h;
+    int32_t v;
+} motion_accumulator = {};
+
+// Whether the last report read from the driver was at the limit of its range, in which case the driver may still hold motion
+static bool motion_clamped = false;
+
+/**
+ * @brief Enables the interrupt on the motion pin
+ *
+ * Platforms without pin interrupts leave this empty, and the motion pin is only polled.
+ */
+__attribute__((weak)) void pointing_device_motion_interrupt_enable(void) {}
+
+/**
+ * @brief Whether the motion pin has fired since the last call
+ *
+ * @return true if the sensor has signalled motion
+ */
+__attribute__((weak)) bool pointing_device_motion_interrupt_triggered(void) {
+    return false;
+}
+
+/**
+ * @brief Whether the host has taken the last mouse report
+ *
+ * Reports are only built from the accumulated motion once this returns true, so that they carry the latest motion when the host polls.
+ *
+ * @return true if a new report can be sent
+ */
+__attribute__((weak)) bool pointing_device_host_ready(void) {
+    return true;
+}
+
+static bool pointing_device_motion_pending(void) {
+    // Counts the driver couldn't fit in the last report are read before the pin signals motion again
+    if (motion_clamped) {
+        return true;
+    }
+    // The interrupt catches motion signalled and cleared between two passes of the main loop
+    bool triggered = pointing_device_motion_interrupt_triggered();
+#    ifdef POINTING_DEVICE_MOTION_PIN_ACTIVE_LOW
+    return triggered || !gpio_read_pin(POINTING_DEVICE_MOTION_PIN);
+#    else
+    return triggered || gpio_read_pin(POINTING_DEVICE_MOTION_PIN);
+#    endif
+}
+
+static void pointing_device_motion_accumulate(report_mouse_t mouse_report) {
+    motion_accumulator.x += mouse_report.x;
+    motion_accumulator.y += mouse_report.y;
+    motion_accumulator.h += mouse_report.h;
+    motion_accumulator.v += mouse_report.v;
+    motion_clamped             = mouse_report.x == XY_REPORT_MIN || mouse_report.x == XY_REPORT_MAX || mouse_report.y == XY_REPORT_MIN || mouse_report.y == XY_REPORT_MAX;
+    local_mouse_report.buttons = mouse_report.buttons;
+}
+
+/**
+ * @brief Moves as much of the accumulated motion as fits into the report, keeping the rest for the next one
+ *
+ * @param[in] mouse_report report_mouse_t
+ * @return report_mouse_t with the accumulated motion
+ */
+static report_mouse_t pointing_device_motion_take(report_mouse_t mouse_report) {
+    mouse_report.x = CONSTRAIN_HID_XY(motion_accumulator.x);
+    mouse_report.y = CONSTRAIN_HID_XY(motion_accumulator.y);
+    mouse_report.h = CONSTRAIN_HID_HV(motion_accumulator.h);
+    mouse_report.v = CONSTRAIN_HID_HV(motion_accumulator.v);
+    motion_accumulator.x -= mouse_report.x;
+    motion_accumulator.y -= mouse_report.y;
+    motion_accumulator.h -= mouse_report.h;
+    motion_accumulator.v -= mouse_report.v;
+    return mouse_report;
+}
+#endif
+
+#ifdef POINTING_DEVICE_HIRES_SCROLL_ENABLE
+// Scroll not yet sent, in the steps the host divides each detent into
+static struct {
+    int32_t h;
+    int32_t v;
+} hires_scroll = {};
+#endif
+
+/**
+ * @brief Divides value, carrying the remainder of the division into the next call
+ *
+ * @param[in] value int32_t
+ * @param[in] divisor uint16_t
+ * @param[in] remainder int32_t pointer to the carried remainder
+ * @return int32_t quotient
+ */
+static int32_t pointing_device_divide(int32_t value, uint16_t divisor, int32_t *remainder) {
+    *remainder += value;
+    int32_t quotient = *remainder / divisor;
+    *remainder -= quotient * divisor;
+    return quotient;
+}
+
+/**
+ * @brief Scales the motion and scroll of a report by numerator / denominator without losing fractions
+ *
+ * Whatever doesn't make a whole count is carried into the next call with the same remainder, so slow motion still
+ * moves the pointer, and the scroll is kept in fractions of a detent when the host has enabled high resolution scrolling.
+ * Each caller keeps its own remainder, so that scaling one mode doesn't disturb another.
+ *
+ * @param[in] mouse_report report_mouse_t
+ * @param[in] numerator uint8_t
+ * @param[in] denominator uint8_t
+ * @param[in] remainder pointing_device_scale_remainder_t pointer to the caller's carried fractions
+ * @return report_mouse_t with scaled values
+ */
+report_mouse_t pointing_device_scale_report(report_mouse_t mouse_report, uint8_t numerator, uint8_t denominator, pointing_device_scale_remainder_t *remainder) {
+    if (denominator == 0) {
+        return mouse_report;
+    }
+    // Remainders of another denominator are converted into the new one's units
+    if (denominator != remainder->denominator) {
+        if (remainder->denominator != 0) {
+            remainder->x = remainder->x * denominator / remainder->denominator;
+            remainder->y = remainder->y * denominator / remainder->denominator;
+            remainder->h = remainder->h * denominator / remainder->denominator;
+            remainder->v = remainder->v * denominator / remainder->denominator;
+        }
+        remainder->denominator = denominator;
+    }
+
+    // Divided first, as the CONSTRAIN_HID macros evaluate their argument more than once
+    int32_t x      = pointing_device_divide((int32_t)mouse_report.x * numerator, denominator, &remainder->x);
+    int32_t y      = pointing_device_divide((int32_t)mouse_report.y * numerator, denominator, &remainder->y);
+    mouse_report.x = CONSTRAIN_HID_XY(x);
+    mouse_report.y = CONSTRAIN_HID_XY(y);
+#ifdef POINTING_DEVICE_HIRES_SCROLL_ENABLE
+    // Sent with the whole detents of the report by pointing_device_hires_scroll()
+    hires_scroll.h += pointing_device_divide((int32_t)mouse_report.h * numerator * mouse_wheel_resolution(true), denominator, &remainder->h);
+    hires_scroll.v += pointing_device_divide((int32_t)mouse_report.v * numerator * mouse_wheel_resolution(false), denominator, &remainder->v);
+    mouse_report.h = 0;
+    mouse_report.v = 0;
+#else
+    int32_t h      = pointing_device_divide((int32_t)mouse_report.h * numerator, denominator, &remainder->h);
+    int32_t v      = pointing_device_divide((int32_t)mouse_report.v * numerator, denominator, &remainder->v);
+    mouse_report.h = CONSTRAIN_HID_HV(h);
+    mouse_report.v = CONSTRAIN_HID_HV(v);
+#endif
+    return mouse_report;
+}
+
+#ifdef POINTING_DEVICE_HIRES_SCROLL_ENABLE
+/**
+ * @brief Converts the scroll of the report into the steps the host counts in
+ *
+ * Drivers and keymaps scroll in whole detents, which are multiplied up once the host has enabled the resolution multiplier.
+ * Fractions of a detent from pointing_device_scale_report() are added on top, and scroll beyond the report range is carried.
+ *
+ * @param[in] mouse_report report_mouse_t
+ * @return report_mouse_t with the scroll to send
+ */
+static report_mouse_t pointing_device_hires_scroll(report_mouse_t mouse_report) {
+    hires_scroll.h += (int32_t)mouse_report.h * mouse_wheel_resolution(true);
+    hires_scroll.v += (int32_t)mouse_report.v * mouse_wheel_resolution(false);
+    mouse_report.h = CONSTRAIN_HID_HV(hires_scroll.h);
+    mouse_report.v = CONSTRAIN_HID_HV(hires_scroll.v);
+    hires_scroll.h -= mouse_report.h;
+    hires_scroll.v -= mouse_report.v;
+    return mouse_report;
+}
+#endif
+
+#ifdef POINTING_DEVICE_GESTURES_MOMENTUM_ENABLE
+// The rates per second are converted into steps
+static momentum_context_t momentum = {.config = {
+                                          .friction = POINTING_DEVICE_MOMENTUM_FRICTION,
+                                          .coef     = POINTING_DEVICE_MOMENTUM_FRICTION == MOMENTUM_FRICTION_KINETIC ? (uint32_t)POINTING_DEVICE_MOMENTUM_DECELERATION * 256 * POINTING_DEVICE_MOMENTUM_STEP_MS * POINTING_DEVICE_MOMENTUM_STEP_MS / 1000000 : (uint32_t)65536 * POINTING_DEVICE_MOMENTUM_STEP_MS / POINTING_DEVICE_MOMENTUM_DECAY_MS,
+                                          .trigger  = (uint32_t)POINTING_DEVICE_MOMENTUM_TRIGGER * 256 * POINTING_DEVICE_MOMENTUM_STEP_MS / 1000,
+                                          .release  = POINTING_DEVICE_MOMENTUM_RELEASE_MS,
+                                          .step     = POINTING_DEVICE_MOMENTUM_STEP_MS,
+                                      }};
+
+// The glide is worked out on its own executor, so that it follows the clock rather than how often reports are sent
+static deferred_executor_t momentum_executors[1] = {0};
+static deferred_token      momentum_token        = INVALID_DEFERRED_TOKEN;
+
+static uint32_t pointing_device_momentum_callback(uint32_t trigger_time, void *cb_arg) {
+    // Catch up on the steps missed while the main loop was busy
+    uint32_t steps = TIMER_DIFF_32(timer_read32(), trigger_time) / POINTING_DEVICE_MOMENTUM_STEP_MS + 1;
+    for (uint32_t i = 0; i < steps; i++) {
+        if (!momentum_step(&momentum)) {
+            momentum_token = INVALID_DEFERRED_TOKEN;
+            return 0;
+        }
+    }
+    return steps * POINTING_DEVICE_MOMENTUM_STEP_MS;
+}
+
+/**
+ * @brief Stops the pointer gliding
+ *
+ * Whatever has glided but not yet been sent is dropped.
+ */
+void pointing_device_momentum_stop(void) {
+    cancel_deferred_exec_advanced(momentum_executors, ARRAY_SIZE(momentum_executors), momentum_token);
+    momentum_token = INVALID_DEFERRED_TOKEN;
+    momentum_stop(&momentum);
+}
+
+/**
+ * @brief Tracks the speed of the motion, and adds the glide once it has stopped
+ *
+ * @param[in] mouse_report report_mouse_t
+ * @return report_mouse_t with the glide since the last report
+ */
+static report_mouse_t pointing_device_momentum_apply(report_mouse_t mouse_report) {
+    if (mouse_report.buttons) {
+        // Clicking stops the glide, and dragging doesn't start one
+        pointing_device_momentum_stop();
+    } else {
+        momentum_update(&momentum, mouse_report.x, mouse_report.y);
+        if (momentum.status.state != MOMENTUM_IDLE && momentum_token == INVALID_DEFERRED_TOKEN) {
+            momentum_token = defer_exec_advanced(momentum_executors, ARRAY_SIZE(momentum_executors), POINTING_DEVICE_MOMENTUM_STEP_MS, pointing_device_momentum_callback, NULL);
+        }
+    }
+
+    momentum_t glide = momentum_take(&momentum, XY_REPORT_MAX);
+    mouse_report.x   = CONSTRAIN_HID_XY(mouse_report.x + glide.dx);
+    mouse_report.y   = CONSTRAIN_HID_XY(mouse_report.y + glide.dy);
+    return mouse_report;
+}
+#endif
+
 /**
  * @brief Keyboard level code pointing device initialisation
  *
@@ -174,8 +428,14 @@ __attribute__((weak)) void pointing_device_init(void) {
 #    else
         gpio_set_pin_input(POINTING_DEVICE_MOTION_PIN);
 #    endif
+#endif
+#ifdef POINTING_DEVICE_MOTION_INTERRUPT
+        pointing_device_motion_interrupt_enable();
 #endif
     }
+#ifdef POINTING_DEVICE_ACCEL_ENABLE
+    pointing_device_accel_init();
+#endif
 
     pointing_device_init_kb();
     pointing_device_init_user();
@@ -254,6 +514,24 @@ __attribute__((weak)) bool pointing_device_task(void) {
     };
 #endif
 
+#ifdef POINTING_DEVICE_GESTURES_MOMENTUM_ENABLE
+    // The glide moves on between reports too
+    static uint32_t last_momentum_exec = 0;
+    deferred_exec_advanced_task(momentum_executors, ARRAY_SIZE(momentum_executors), &last_momentum_exec);
+#endif
+
+#ifdef POINTING_DEVICE_MOTION_INTERRUPT
+    // Read the sensor as soon as it has motion, between reports too, so that
+    // its counters never overflow
+    if (pointing_device_motion_pending()) {
+        pointing_device_motion_accumulate(pointing_device_driver->get_report((report_mouse_t){.buttons = local_mouse_report.buttons}));
+    }
+    // Build the next report only once the host has taken the last one
+    if (!pointing_device_host_ready()) {
+        return false;
+    }
+#endif
+
 #if (POINTING_DEVICE_TASK_THROTTLE_MS > 0)
     static uint32_t last_exec = 0;
     if (timer_elapsed32(last_exec) < POINTING_DEVICE_TASK_THROTTLE_MS) {
@@ -263,35 +541,39 @@ __attribute__((weak)) bool pointing_device_task(void) {
 #endif
 
     // Gather report info
-#ifdef POINTING_DEVICE_MOTION_PIN
-#    if defined(SPLIT_POINTING_ENABLE)
-#        error POINTING_DEVICE_MOTION_PIN not supported when sharing the pointing device report between sides.
-#    endif
-#    ifdef POINTING_DEVICE_MOTION_PIN_ACTIVE_LOW
+#ifdef POINTING_DEVICE_MOTION_INTERRUPT
+    local_mouse_report = pointing_device_motion_take(local_mouse_report);
+#else
+#    ifdef POINTING_DEVICE_MOTION_PIN
+#        if defined(SPLIT_POINTING_ENABLE)
+#            error POINTING_DEVICE_MOTION_PIN not supported when sharing the pointing device report between sides.
+#        endif
+#        ifdef POINTING_DEVICE_MOTION_PIN_ACTIVE_LOW
     if (!gpio_read_pin(POINTING_DEVICE_MOTION_PIN))
-#    else
+#        else
     if (gpio_read_pin(POINTING_DEVICE_MOTION_PIN))
-#    endif
+#        endif
     {
-#endif
+#    endif
 
-#if defined(SPLIT_POINTING_ENABLE)
-#    if defined(POINTING_DEVICE_COMBINED)
+#    if defined(SPLIT_POINTING_ENABLE)
+#        if defined(POINTING_DEVICE_COMBINED)
         static uint8_t old_buttons = 0;
         local_mouse_report.buttons = old_buttons;
         local_mouse_report         = pointing_device_driver->get_report(local_mouse_report);
         old_buttons                = local_mouse_report.buttons;
-#    elif defined(POINTING_DEVICE_LEFT) || defined(POINTING_DEVICE_RIGHT)
+#        elif defined(POINTING_DEVICE_LEFT) || defined(POINTING_DEVICE_RIGHT)
         local_mouse_report = POINTING_DEVICE_THIS_SIDE ? pointing_device_driver->get_report(local_mouse_report) : shared_mouse_report;
+#        else
+#            error "You need to define the side(s) the pointing device is on. POINTING_DEVICE_COMBINED / POINTING_DEVICE_LEFT / POINTING_DEVICE_RIGHT"
+#        endif
 #    else
-#        error "You need to define the side(s) the pointing device is on. POINTING_DEVICE_COMBINED / POINTING_DEVICE_LEFT / POINTING_DEVICE_RIGHT"
-#    endif
-#else
     local_mouse_report = pointing_device_driver->get_report(local_mouse_report);
-#endif // defined(SPLIT_POINTING_ENABLE)
+#    endif // defined(SPLIT_POINTING_ENABLE)
 
-#ifdef POINTING_DEVICE_MOTION_PIN
+#    ifdef POINTING_DEVICE_MOTION_PIN
     }
+#    endif
 #endif
 
     // allow kb to intercept and modify report
@@ -306,7 +588,16 @@ __attribute__((weak)) bool pointing_device_task(void) {
     local_mouse_report = is_keyboard_left() ? pointing_device_task_combined_kb(local_mouse_report, shared_mouse_report) : pointing_device_task_combined_kb(shared_mouse_report, local_mouse_report);
 #else
     local_mouse_report = pointing_device_adjust_by_defines(local_mouse_report);
+#    ifdef POINTING_DEVICE_ACCEL_ENABLE
+    local_mouse_report = pointing_device_accel_apply(local_mouse_report);
+#    endif
+#    ifdef POINTING_DEVICE_GESTURES_MOMENTUM_ENABLE
+    local_mouse_report = pointing_device_momentum_apply(local_mouse_report);
+#    endif
     local_mouse_report = pointing_device_task_kb(local_mouse_report);
+#endif
+#ifdef POINTING_DEVICE_HIRES_SCROLL_ENABLE
+    local_mouse_report = pointing_device_hires_scroll(local_mouse_report);
 #endif
     // automatic mouse layer function
 #ifdef POINTING_DEVICE_AUTO_MOUSE_ENABLE
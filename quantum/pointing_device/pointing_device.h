@@ -31,6 +31,12 @@ typedef struct {
 #ifdef POINTING_DEVICE_AUTO_MOUSE_ENABLE
 #    include "pointing_device_auto_mouse.h"
 #endif
+#ifdef POINTING_DEVICE_ACCEL_ENABLE
+#    include "pointing_device_accel.h"
+#endif
+#ifdef POINTING_DEVICE_GESTURES_MOMENTUM_ENABLE
+#    include "pointing_device_gestures.h"
+#endif
 
 #if defined(POINTING_DEVICE_DRIVER_adns5050)
 #    include "drivers/sensors/adns5050.h"
@@ -111,8 +117,18 @@ typedef int32_t hv_clamp_range_t;
 typedef int16_t hv_clamp_range_t;
 #endif
 
+// Fractions of a count left over by pointing_device_scale_report(), kept by each caller
+typedef struct {
+    int32_t  x;
+    int32_t  y;
+    int32_t  h;
+    int32_t  v;
+    uint16_t denominator;
+} pointing_device_scale_remainder_t;
+
 #define CONSTRAIN_HID(amt) ((amt) < INT8_MIN ? INT8_MIN : ((amt) > INT8_MAX ? INT8_MAX : (amt)))
 #define CONSTRAIN_HID_XY(amt) ((amt) < XY_REPORT_MIN ? XY_REPORT_MIN : ((amt) > XY_REPORT_MAX ? XY_REPORT_MAX : (amt)))
+#define CONSTRAIN_HID_HV(amt) ((amt) < HV_REPORT_MIN ? HV_REPORT_MIN : ((amt) > HV_REPORT_MAX ? HV_REPORT_MAX : (amt)))
 
 void           pointing_device_init(void);
 bool           pointing_device_task(void);
@@ -128,8 +144,42 @@ report_mouse_t pointing_device_task_kb(report_mouse_t mouse_report);
 report_mouse_t pointing_device_task_user(report_mouse_t mouse_report);
 uint8_t        pointing_device_handle_buttons(uint8_t buttons, bool pressed, pointing_device_buttons_t button);
 report_mouse_t pointing_device_adjust_by_defines(report_mouse_t mouse_report);
+report_mouse_t pointing_device_scale_report(report_mouse_t mouse_report, uint8_t numerator, uint8_t denominator, pointing_device_scale_remainder_t *remainder);
 void           pointing_device_keycode_handler(uint16_t keycode, bool pressed);
 
+#if defined(POINTING_DEVICE_MOTION_INTERRUPT)
+void pointing_device_motion_interrupt_enable(void);
+bool pointing_device_motion_interrupt_triggered(void);
+bool pointing_device_host_ready(void);
+#endif
+
+#if defined(POINTING_DEVICE_GESTURES_MOMENTUM_ENABLE)
+// Fixed timestep the glide is worked out at, in milliseconds
+#    ifndef POINTING_DEVICE_MOMENTUM_STEP_MS
+#        define POINTING_DEVICE_MOMENTUM_STEP_MS 2
+#    endif
+#    ifndef POINTING_DEVICE_MOMENTUM_FRICTION
+#        define POINTING_DEVICE_MOMENTUM_FRICTION MOMENTUM_FRICTION_VISCOUS
+#    endif
+// Viscous friction, time for the glide to slow to about a third of its speed, in milliseconds
+#    ifndef POINTING_DEVICE_MOMENTUM_DECAY_MS
+#        define POINTING_DEVICE_MOMENTUM_DECAY_MS 200
+#    endif
+// Kinetic friction, speed lost every second, in counts per second
+#    ifndef POINTING_DEVICE_MOMENTUM_DECELERATION
+#        define POINTING_DEVICE_MOMENTUM_DECELERATION 4000
+#    endif
+// Speed the motion needs to be going when it stops to glide, in counts per second
+#    ifndef POINTING_DEVICE_MOMENTUM_TRIGGER
+#        define POINTING_DEVICE_MOMENTUM_TRIGGER 500
+#    endif
+// Time without motion after which it has stopped, in milliseconds
+#    ifndef POINTING_DEVICE_MOMENTUM_RELEASE_MS
+#        define POINTING_DEVICE_MOMENTUM_RELEASE_MS 20
+#    endif
+void pointing_device_momentum_stop(void);
+#endif
+
 #if defined(SPLIT_POINTING_ENABLE)
 void     pointing_device_set_shared_report(report_mouse_t report);
 uint16_t pointing_device_get_shared_cpi(void);
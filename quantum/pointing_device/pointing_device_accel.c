@@ -0,0 +1,153 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#ifdef POINTING_DEVICE_ACCEL_ENABLE
+
+#    include <stdlib.h>
+#    include <string.h>
+#    include "pointing_device_accel.h"
+#    include "pointing_device.h"
+#    include "eeconfig.h"
+#    include "keycodes.h"
+#    include "progmem.h"
+#    include "util.h"
+
+/*
+ * The curves are tabulated by the compiler from integer expressions, so that
+ * nothing but a table lookup and a multiply is left for each report. Each
+ * entry is the shape of the curve at that speed, from 0 to 255, which the
+ * level scales into the extra gain.
+ */
+#    define ACCEL_SPAN ((uint32_t)(POINTING_DEVICE_ACCEL_LUT_SIZE - 1 - POINTING_DEVICE_ACCEL_OFFSET))
+#    define ACCEL_D(i) ((uint32_t)((i) > POINTING_DEVICE_ACCEL_OFFSET ? (i) - POINTING_DEVICE_ACCEL_OFFSET : 0))
+
+#    define ACCEL_LINEAR(i) (255 * ACCEL_D(i) / ACCEL_SPAN)
+// Smoothstep, 3t^2 - 2t^3
+#    define ACCEL_SIGMOID(i) (255 * (3 * ACCEL_D(i) * ACCEL_D(i) * ACCEL_SPAN - 2 * ACCEL_D(i) * ACCEL_D(i) * ACCEL_D(i)) / (ACCEL_SPAN * ACCEL_SPAN * ACCEL_SPAN))
+// Square, t^2
+#    define ACCEL_POWER(i) (255 * ACCEL_D(i) * ACCEL_D(i) / (ACCEL_SPAN * ACCEL_SPAN))
+
+#    define ACCEL_LUT4(curve, i) curve(i), curve(i + 1), curve(i + 2), curve(i + 3)
+#    define ACCEL_LUT16(curve, i) ACCEL_LUT4(curve, i), ACCEL_LUT4(curve, i + 4), ACCEL_LUT4(curve, i + 8), ACCEL_LUT4(curve, i + 12)
+#    define ACCEL_LUT(curve) ACCEL_LUT16(curve, 0), ACCEL_LUT16(curve, 16), ACCEL_LUT16(curve, 32), ACCEL_LUT16(curve, 48)
+
+_Static_assert(POINTING_DEVICE_ACCEL_LUT_SIZE == 64, "ACCEL_LUT() expands to 64 entries");
+
+static const uint8_t PROGMEM accel_curves[POINTING_DEVICE_ACCEL_CURVE_COUNT][POINTING_DEVICE_ACCEL_LUT_SIZE] = {
+    [POINTING_DEVICE_ACCEL_CURVE_LINEAR]  = {ACCEL_LUT(ACCEL_LINEAR)},
+    [POINTING_DEVICE_ACCEL_CURVE_SIGMOID] = {ACCEL_LUT(ACCEL_SIGMOID)},
+    [POINTING_DEVICE_ACCEL_CURVE_POWER]   = {ACCEL_LUT(ACCEL_POWER)},
+};
+
+static pointing_device_accel_config_t accel_config = {};
+
+// Fractions of a count left over by the gain, carried into the next report
+static struct {
+    int32_t x;
+    int32_t y;
+} accel_remainder = {};
+
+/**
+ * @brief Loads the acceleration settings, restoring the defaults if there are none in EEPROM
+ */
+void pointing_device_accel_init(void) {
+    memset(&accel_remainder, 0, sizeof(accel_remainder));
+    accel_config.raw = eeconfig_read_pointing_device();
+    if (!accel_config.is_valid || accel_config.curve >= POINTING_DEVICE_ACCEL_CURVE_COUNT) {
+        accel_config.raw      = 0;
+        accel_config.is_valid = true;
+        accel_config.curve    = POINTING_DEVICE_ACCEL_DEFAULT_CURVE;
+        accel_config.level    = POINTING_DEVICE_ACCEL_DEFAULT_LEVEL;
+        eeconfig_update_pointing_device(accel_config.raw);
+    }
+}
+
+/**
+ * @brief Gain applied to motion at the given speed
+ *
+ * @param[in] speed uint16_t counts per report
+ * @return uint16_t gain in 1/256ths
+ */
+uint16_t pointing_device_accel_gain(uint16_t speed) {
+    uint8_t index = MIN((uint32_t)speed * (POINTING_DEVICE_ACCEL_LUT_SIZE - 1) / POINTING_DEVICE_ACCEL_SPEED_MAX, POINTING_DEVICE_ACCEL_LUT_SIZE - 1);
+    uint8_t shape = pgm_read_byte(&accel_curves[accel_config.curve][index]);
+    return 256 + (((uint32_t)accel_config.level * POINTING_DEVICE_ACCEL_LEVEL_GAIN * shape) >> 8);
+}
+
+static int32_t pointing_device_accel_scale(int32_t value, uint16_t gain, int32_t *remainder) {
+    *remainder += value * gain;
+    int32_t scaled = *remainder / 256;
+    *remainder -= scaled * 256;
+    return scaled;
+}
+
+/**
+ * @brief Accelerates the motion of the report by its speed
+ *
+ * @param[in] mouse_report report_mouse_t
+ * @return report_mouse_t with accelerated motion
+ */
+report_mouse_t pointing_device_accel_apply(report_mouse_t mouse_report) {
+    if (accel_config.level == 0 || (mouse_report.x == 0 && mouse_report.y == 0)) {
+        return mouse_report;
+    }
+
+    // Approximates the length of the motion without a square root
+    uint16_t x     = abs(mouse_report.x);
+    uint16_t y     = abs(mouse_report.y);
+    uint16_t speed = MAX(x, y) + MIN(x, y) / 2;
+    uint16_t gain  = pointing_device_accel_gain(speed);
+
+    // Scaled first, as CONSTRAIN_HID_XY evaluates its argument more than once
+    int32_t scaled_x = pointing_device_accel_scale(mouse_report.x, gain, &accel_remainder.x);
+    int32_t scaled_y = pointing_device_accel_scale(mouse_report.y, gain, &accel_remainder.y);
+    mouse_report.x   = CONSTRAIN_HID_XY(scaled_x);
+    mouse_report.y   = CONSTRAIN_HID_XY(scaled_y);
+    return mouse_report;
+}
+
+void pointing_device_accel_set_curve(pointing_device_accel_curve_t curve) {
+    if (curve >= POINTING_DEVICE_ACCEL_CURVE_COUNT) {
+        return;
+    }
+    accel_config.curve = curve;
+    eeconfig_update_pointing_device(accel_config.raw);
+}
+
+pointing_device_accel_curve_t pointing_device_accel_get_curve(void) {
+    return accel_config.curve;
+}
+
+void pointing_device_accel_set_level(uint8_t level) {
+    accel_config.level = MIN(level, POINTING_DEVICE_ACCEL_LEVEL_MAX);
+    eeconfig_update_pointing_device(accel_config.raw);
+}
+
+uint8_t pointing_device_accel_get_level(void) {
+    return accel_config.level;
+}
+
+bool process_pointing_device_accel(uint16_t keycode, keyrecord_t *record) {
+    if (record->event.pressed) {
+        switch (keycode) {
+            case QK_POINTING_ACCEL_CURVE_NEXT:
+                pointing_device_accel_set_curve((accel_config.curve + 1) % POINTING_DEVICE_ACCEL_CURVE_COUNT);
+                return false;
+
+            case QK_POINTING_ACCEL_UP:
+                if (accel_config.level < POINTING_DEVICE_ACCEL_LEVEL_MAX) {
+                    pointing_device_accel_set_level(accel_config.level + 1);
+                }
+                return false;
+
+            case QK_POINTING_ACCEL_DOWN:
+                if (accel_config.level > 0) {
+                    pointing_device_accel_set_level(accel_config.level - 1);
+                }
+                return false;
+        }
+    }
+    return true;
+}
+
+#endif // POINTING_DEVICE_ACCEL_ENABLE
@@ -0,0 +1,68 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "action.h"
+#include "report.h"
+
+/* check settings and set defaults */
+#ifndef POINTING_DEVICE_ACCEL_ENABLE
+#    error "POINTING_DEVICE_ACCEL_ENABLE not defined! check config settings"
+#endif
+
+// Speed, in counts per report, at which the curves reach full gain
+#ifndef POINTING_DEVICE_ACCEL_SPEED_MAX
+#    define POINTING_DEVICE_ACCEL_SPEED_MAX 63
+#endif
+// Speed, in counts per report, below which motion isn't accelerated
+#ifndef POINTING_DEVICE_ACCEL_OFFSET
+#    define POINTING_DEVICE_ACCEL_OFFSET 2
+#endif
+// Extra gain at full speed for each level, in 1/256ths
+#ifndef POINTING_DEVICE_ACCEL_LEVEL_GAIN
+#    define POINTING_DEVICE_ACCEL_LEVEL_GAIN 48
+#endif
+#ifndef POINTING_DEVICE_ACCEL_DEFAULT_CURVE
+#    define POINTING_DEVICE_ACCEL_DEFAULT_CURVE POINTING_DEVICE_ACCEL_CURVE_SIGMOID
+#endif
+#ifndef POINTING_DEVICE_ACCEL_DEFAULT_LEVEL
+#    define POINTING_DEVICE_ACCEL_DEFAULT_LEVEL 4
+#endif
+
+#define POINTING_DEVICE_ACCEL_LEVEL_MAX 15
+#define POINTING_DEVICE_ACCEL_LUT_SIZE 64
+
+#if POINTING_DEVICE_ACCEL_OFFSET >= POINTING_DEVICE_ACCEL_LUT_SIZE - 1
+#    error "POINTING_DEVICE_ACCEL_OFFSET must be below 63"
+#endif
+
+typedef enum {
+    POINTING_DEVICE_ACCEL_CURVE_LINEAR,
+    POINTING_DEVICE_ACCEL_CURVE_SIGMOID,
+    POINTING_DEVICE_ACCEL_CURVE_POWER,
+    POINTING_DEVICE_ACCEL_CURVE_COUNT,
+} pointing_device_accel_curve_t;
+
+typedef union {
+    uint8_t raw;
+    struct {
+        uint8_t level : 4;
+        uint8_t curve : 2;
+        uint8_t reserved : 1;
+        bool    is_valid : 1;
+    };
+} pointing_device_accel_config_t;
+
+_Static_assert(sizeof(pointing_device_accel_config_t) == sizeof(uint8_t), "pointing_device_accel_config_t out of size spec.");
+
+void                          pointing_device_accel_init(void);
+report_mouse_t                pointing_device_accel_apply(report_mouse_t mouse_report);
+uint16_t                      pointing_device_accel_gain(uint16_t speed);
+void                          pointing_device_accel_set_curve(pointing_device_accel_curve_t curve);
+pointing_device_accel_curve_t pointing_device_accel_get_curve(void);
+void                          pointing_device_accel_set_level(uint8_t level);
+uint8_t                       pointing_device_accel_get_level(void);
+bool                          process_pointing_device_accel(uint16_t keycode, keyrecord_t *record);
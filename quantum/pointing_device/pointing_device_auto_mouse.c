@@ -23,6 +23,9 @@
 #    include "debug.h"
 #    include "action_util.h"
 #    include "quantum_keycodes.h"
+#    include "keymap_introspection.h"
+#    include "matrix.h"
+#    include "util.h"
 
 /* local data structure for tracking auto mouse */
 static auto_mouse_context_t auto_mouse_context = {
@@ -31,6 +34,11 @@ static auto_mouse_context_t auto_mouse_context = {
     .config.debounce = (uint8_t)(AUTO_MOUSE_DEBOUNCE),
 };
 
+/* positions of mouse keys on each layer, and of the keys pressed as mouse keys */
+static matrix_row_t auto_mouse_keys[AUTO_MOUSE_KEY_LAYERS][MATRIX_ROWS];
+static matrix_row_t auto_mouse_keys_held[MATRIX_ROWS];
+static bool         auto_mouse_keys_valid = false;
+
 /* local functions */
 static bool is_mouse_record(uint16_t keycode, keyrecord_t* record);
 static void auto_mouse_reset(void);
@@ -117,6 +125,7 @@ int8_t get_auto_mouse_key_tracker(void) {
 static void auto_mouse_reset(void) {
     memset(&auto_mouse_context.status, 0, sizeof(auto_mouse_context.status));
     memset(&auto_mouse_context.timer, 0, sizeof(auto_mouse_context.timer));
+    memset(auto_mouse_keys_held, 0, sizeof(auto_mouse_keys_held));
 }
 
 /**
@@ -236,11 +245,21 @@ void auto_mouse_layer_off(void) {
  * @return bool of pointing_device activation
  */
 __attribute__((weak)) bool auto_mouse_activation(report_mouse_t mouse_report) {
+#    if AUTO_MOUSE_THRESHOLD_TIME > 0
+    // drop movement that has not reached the threshold in time, so that drift never adds up to it
+    total_mouse_movement_t* total = &auto_mouse_context.total_mouse_movement;
+    if ((!total->x && !total->y && !total->h && !total->v) || timer_elapsed(auto_mouse_context.timer.motion) > AUTO_MOUSE_THRESHOLD_TIME) {
+        *total                          = (total_mouse_movement_t){.x = 0, .y = 0, .h = 0, .v = 0};
+        auto_mouse_context.timer.motion = timer_read();
+    }
+#    endif
     auto_mouse_context.total_mouse_movement.x += mouse_report.x;
     auto_mouse_context.total_mouse_movement.y += mouse_report.y;
     auto_mouse_context.total_mouse_movement.h += mouse_report.h;
     auto_mouse_context.total_mouse_movement.v += mouse_report.v;
-    return abs(auto_mouse_context.total_mouse_movement.x) > AUTO_MOUSE_THRESHOLD || abs(auto_mouse_context.total_mouse_movement.y) > AUTO_MOUSE_THRESHOLD || abs(auto_mouse_context.total_mouse_movement.h) > AUTO_MOUSE_THRESHOLD || abs(auto_mouse_context.total_mouse_movement.v) > AUTO_MOUSE_THRESHOLD || mouse_report.buttons;
+    // less movement keeps the target layer on than turns it on
+    int16_t threshold = layer_state_is((AUTO_MOUSE_TARGET_LAYER)) ? AUTO_MOUSE_HOLD_THRESHOLD : AUTO_MOUSE_THRESHOLD;
+    return abs(auto_mouse_context.total_mouse_movement.x) > threshold || abs(auto_mouse_context.total_mouse_movement.y) > threshold || abs(auto_mouse_context.total_mouse_movement.h) > threshold || abs(auto_mouse_context.total_mouse_movement.v) > threshold || mouse_report.buttons;
 }
 
 /**
@@ -419,19 +438,89 @@ bool process_auto_mouse(uint16_t keycode, keyrecord_t* record) {
     return true;
 }
 
+/**
+ * @brief Mark the mouse key positions as out of date
+ *
+ * Call when the keymap changes at runtime, the positions are rebuilt from the keymap on next use
+ */
+void auto_mouse_keymap_changed(void) {
+    auto_mouse_keys_valid = false;
+}
+
+/**
+ * @brief Local function to build the mouse key positions of each layer from the keymap
+ */
+static void auto_mouse_keys_update(void) {
+    memset(auto_mouse_keys, 0, sizeof(auto_mouse_keys));
+    uint8_t layers = MIN(AUTO_MOUSE_KEY_LAYERS, keymap_layer_count());
+    for (uint8_t layer = 0; layer < layers; layer++) {
+        for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+            for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+                if (IS_MOUSEKEY(keycode_at_keymap_location(layer, row, col))) {
+                    auto_mouse_keys[layer][row] |= MATRIX_ROW_SHIFTER << col;
+                }
+            }
+        }
+    }
+    auto_mouse_keys_valid = true;
+}
+
+/**
+ * @brief Local function to check if a pressed key is on a mouse key position
+ *
+ * Looks the key up on the layer its keycode came from
+ *
+ * @params keycode[in] uint16_t
+ * @params key[in]     keypos_t inside the matrix
+ * @return bool true: key is on a mouse key position false: key is not on a mouse key position
+ */
+static bool is_mouse_position(uint16_t keycode, keypos_t key) {
+    uint8_t layer;
+#    if !defined(NO_ACTION_LAYER) && !defined(STRICT_LAYER_RELEASE)
+    if (!disable_action_cache) {
+        layer = read_source_layers_cache(key);
+    } else
+#    endif
+        layer = layer_switch_get_layer(key);
+    // layers past the map are checked by keycode
+    if (layer >= AUTO_MOUSE_KEY_LAYERS) return IS_MOUSEKEY(keycode);
+    if (!auto_mouse_keys_valid) auto_mouse_keys_update();
+    return auto_mouse_keys[layer][key.row] & (MATRIX_ROW_SHIFTER << key.col);
+}
+
 /**
  * @brief Local function to handle checking if a keycode is a mouse button
  *
- * Starts code stack for checking keyrecord if defined as mousekey
+ * Starts code stack for checking keyrecord if defined as mousekey. Keys in the matrix are
+ * tracked by position, so a key released is a mouse key if it was when pressed
  *
  * @params keycode[in] uint16_t
  * @params record[in]  keyrecord_t pointer
  * @return bool true: keyrecord is mousekey false: keyrecord is not mousekey
  */
 static bool is_mouse_record(uint16_t keycode, keyrecord_t* record) {
-    // allow for keyboard to hook in and override if need be
-    if (is_mouse_record_kb(keycode, record) || IS_MOUSEKEY(keycode)) return true;
-    return false;
+    keypos_t key = record->event.key;
+    // combos, repeated keys and encoders are checked by keycode
+    if (key.row >= MATRIX_ROWS || key.col >= MATRIX_COLS
+#    if defined(COMBO_ENABLE) || defined(REPEAT_KEY_ENABLE)
+        || record->keycode
+#    endif
+    ) {
+        // allow for keyboard to hook in and override if need be
+        return is_mouse_record_kb(keycode, record) || IS_MOUSEKEY(keycode);
+    }
+
+    matrix_row_t bit  = MATRIX_ROW_SHIFTER << key.col;
+    bool         held = auto_mouse_keys_held[key.row] & bit;
+    if (record->event.pressed) {
+        held = is_mouse_position(keycode, key) || is_mouse_record_kb(keycode, record);
+    }
+    if (held && record->event.pressed) {
+        auto_mouse_keys_held[key.row] |= bit;
+    } else {
+        auto_mouse_keys_held[key.row] &= ~bit;
+    }
+    return held;
 }
 
 /**
@@ -45,6 +45,20 @@
 #ifndef AUTO_MOUSE_THRESHOLD
 #    define AUTO_MOUSE_THRESHOLD 10
 #endif
+#ifndef AUTO_MOUSE_HOLD_THRESHOLD
+#    define AUTO_MOUSE_HOLD_THRESHOLD AUTO_MOUSE_THRESHOLD
+#endif
+#ifndef AUTO_MOUSE_THRESHOLD_TIME
+#    define AUTO_MOUSE_THRESHOLD_TIME 0
+#endif
+#ifndef AUTO_MOUSE_KEY_LAYERS
+// The map takes MATRIX_ROWS * sizeof(matrix_row_t) bytes of RAM per layer, most keymaps fit in 8
+#    define AUTO_MOUSE_KEY_LAYERS 8
+#endif
+#if AUTO_MOUSE_KEY_LAYERS > MAX_LAYER
+#    undef AUTO_MOUSE_KEY_LAYERS
+#    define AUTO_MOUSE_KEY_LAYERS MAX_LAYER
+#endif
 
 /* data structure */
 typedef struct {
@@ -63,6 +77,7 @@ typedef struct {
     struct {
         uint16_t active;
         uint16_t delay;
+        uint16_t motion;
     } timer;
     struct {
         bool   is_activated;
@@ -86,6 +101,7 @@ int8_t        get_auto_mouse_key_tracker(void);                         // get k
 void          auto_mouse_layer_off(void);                               // disable target layer if appropriate (DO NOT USE in layer_state_set stack!!)
 layer_state_t remove_auto_mouse_layer(layer_state_t state, bool force); // remove auto mouse target layer from state if appropriate (can be forced)
 bool          is_auto_mouse_active(void);                               // check if target layer is active
+void          auto_mouse_keymap_changed(void);                          // rebuild the mouse key positions from the keymap on next use
 /* ----------For custom pointing device activation----------------------------------------------------------- */
 bool auto_mouse_activation(report_mouse_t mouse_report); // handles pointing device trigger conditions for target layer activation (overwritable)
 
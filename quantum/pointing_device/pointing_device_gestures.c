@@ -13,10 +13,40 @@
  * You should have received a copy of the GNU General Public License
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
+#include <stdlib.h>
 #include <string.h>
 #include "pointing_device_gestures.h"
 #include "timer.h"
 
+#if defined(POINTING_DEVICE_GESTURES_CURSOR_GLIDE_ENABLE) || defined(POINTING_DEVICE_GESTURES_MULTI_TOUCH_ENABLE)
+static inline uint16_t sqrt32(uint32_t x) {
+    uint32_t l, m, h;
+
+    if (x == 0) {
+        return 0;
+    } else if (x > (UINT16_MAX >> 2)) {
+        /* Safe upper bound to avoid integer overflow with m * m */
+        h = UINT16_MAX;
+    } else {
+        /* Upper bound based on closest log2 */
+        h = (1 << (((__builtin_clzl(1) - __builtin_clzl(x) + 1) + 1) >> 1));
+    }
+    /* Lower bound based on closest log2 */
+    l = (1 << ((__builtin_clzl(1) - __builtin_clzl(x)) >> 1));
+
+    /* Binary search to find integer square root */
+    while (l != h - 1) {
+        m = (l + h) / 2;
+        if (m * m <= x) {
+            l = m;
+        } else {
+            h = m;
+        }
+    }
+    return l;
+}
+#endif
+
 #ifdef POINTING_DEVICE_GESTURES_CURSOR_GLIDE_ENABLE
 #    ifdef POINTING_DEVICE_MOTION_PIN
 #        error POINTING_DEVICE_MOTION_PIN not supported when using inertial cursor. Need repeated calls to get_report() to generate glide events.
@@ -76,33 +106,6 @@ cursor_glide_t cursor_glide_check(cursor_glide_context_t* glide) {
     }
 }
 
-static inline uint16_t sqrt32(uint32_t x) {
-    uint32_t l, m, h;
-
-    if (x == 0) {
-        return 0;
-    } else if (x > (UINT16_MAX >> 2)) {
-        /* Safe upper bound to avoid integer overflow with m * m */
-        h = UINT16_MAX;
-    } else {
-        /* Upper bound based on closest log2 */
-        h = (1 << (((__builtin_clzl(1) - __builtin_clzl(x) + 1) + 1) >> 1));
-    }
-    /* Lower bound based on closest log2 */
-    l = (1 << ((__builtin_clzl(1) - __builtin_clzl(x)) >> 1));
-
-    /* Binary search to find integer square root */
-    while (l != h - 1) {
-        m = (l + h) / 2;
-        if (m * m <= x) {
-            l = m;
-        } else {
-            h = m;
-        }
-    }
-    return l;
-}
-
 cursor_glide_t cursor_glide_start(cursor_glide_context_t* glide) {
     cursor_glide_t         invalid_report = {0, 0, false};
     cursor_glide_status_t* status         = &glide->status;
@@ -131,3 +134,292 @@ void cursor_glide_update(cursor_glide_context_t* glide, mouse_xy_report_t dx, mo
     status->z   = z;
 }
 #endif
+
+#ifdef POINTING_DEVICE_GESTURES_MULTI_TOUCH_ENABLE
+static void multi_touch_stop(multi_touch_context_t* context) {
+    memset(&context->status, 0, sizeof(context->status));
+    momentum_stop(&context->momentum);
+}
+
+/* Divides the Q8 distance into whole steps, carrying what is left of a step into the next call */
+static int32_t multi_touch_steps(int32_t distance, uint16_t step_px, int32_t* remainder) {
+    int32_t step = (int32_t)step_px << 8;
+    int32_t steps;
+
+    if (step == 0) {
+        return 0;
+    }
+    *remainder += distance;
+    steps = *remainder / step;
+    *remainder -= steps * step;
+    return steps;
+}
+
+static uint16_t multi_touch_distance(const multi_touch_point_t* points) {
+    int32_t dx = (int32_t)points[1].x - points[0].x;
+    int32_t dy = (int32_t)points[1].y - points[0].y;
+
+    return sqrt32(dx * dx + dy * dy);
+}
+
+multi_touch_t multi_touch_update(multi_touch_context_t* context, const multi_touch_point_t* points, uint8_t count) {
+    multi_touch_status_t* status = &context->status;
+    multi_touch_t         report = {0};
+    int32_t               x, y, dx, dy;
+    uint16_t              distance;
+
+    if (count != 2) {
+        if (count == 0 && status->state == MULTI_TOUCH_SCROLL && timer_elapsed(context->momentum.status.timer) < context->momentum.config.release) {
+            /* Fingers lifted while scrolling, carry on at their speed */
+            status->state = MULTI_TOUCH_MOMENTUM;
+            status->timer = timer_read();
+        } else if (count != 0 || status->state != MULTI_TOUCH_MOMENTUM) {
+            /* Touching the sensor stops the momentum */
+            multi_touch_stop(context);
+            return report;
+        }
+        return multi_touch_check(context);
+    }
+
+    x        = (int32_t)points[0].x + points[1].x;
+    y        = (int32_t)points[0].y + points[1].y;
+    distance = multi_touch_distance(points);
+
+    if (status->state == MULTI_TOUCH_IDLE || status->state == MULTI_TOUCH_MOMENTUM) {
+        /* Fingers touched down, nothing to report until they have moved */
+        multi_touch_stop(context);
+        status->state          = MULTI_TOUCH_PENDING;
+        status->x              = x;
+        status->y              = y;
+        status->start_x        = x;
+        status->start_y        = y;
+        status->distance       = distance;
+        status->start_distance = distance;
+        return report;
+    }
+
+    /* Movement of the midpoint in Q8 pixels, the sums being twice the midpoint */
+    dx = (x - status->x) * 128;
+    dy = (y - status->y) * 128;
+
+    switch (status->state) {
+        case MULTI_TOUCH_PENDING:
+            /* Whichever the fingers do first, move together or apart, decides the gesture */
+            if (labs((int32_t)distance - status->start_distance) >= context->config.pinch_trigger_px) {
+                status->state = MULTI_TOUCH_PINCH;
+            } else if (labs(x - status->start_x) + labs(y - status->start_y) >= 2 * context->config.scroll_trigger_px) {
+                status->state = MULTI_TOUCH_SCROLL;
+            }
+            break;
+        case MULTI_TOUCH_SCROLL:
+            momentum_update(&context->momentum, (int16_t)(x - status->x), (int16_t)(y - status->y));
+            report.h = multi_touch_steps(dx, context->config.scroll_px, &status->h);
+            report.v = multi_touch_steps(dy, context->config.scroll_px, &status->v);
+            break;
+        case MULTI_TOUCH_PINCH:
+            report.zoom = multi_touch_steps(((int32_t)distance - status->distance) * 256, context->config.pinch_px, &status->zoom);
+            break;
+        default:
+            break;
+    }
+
+    status->x        = x;
+    status->y        = y;
+    status->distance = distance;
+    report.valid     = status->state != MULTI_TOUCH_PENDING;
+    return report;
+}
+
+multi_touch_t multi_touch_check(multi_touch_context_t* context) {
+    multi_touch_status_t* status = &context->status;
+    multi_touch_t         report = {0};
+    momentum_t            glide;
+    bool                  moving;
+
+    if (status->state != MULTI_TOUCH_MOMENTUM || timer_elapsed(status->timer) < context->momentum.config.step) {
+        report.valid = status->state == MULTI_TOUCH_MOMENTUM;
+        return report;
+    }
+
+    status->timer = timer_read();
+    moving        = momentum_step(&context->momentum);
+    glide         = momentum_take(&context->momentum, INT16_MAX);
+    /* The glide is in half pixels, the sums being twice the midpoint */
+    report.h     = multi_touch_steps((int32_t)glide.dx * 128, context->config.scroll_px, &status->h);
+    report.v     = multi_touch_steps((int32_t)glide.dy * 128, context->config.scroll_px, &status->v);
+    report.valid = moving || glide.valid;
+
+    if (!report.valid) {
+        multi_touch_stop(context);
+    }
+    return report;
+}
+#endif
+
+#if defined(POINTING_DEVICE_GESTURES_MOMENTUM_ENABLE) || defined(POINTING_DEVICE_GESTURES_MULTI_TOUCH_ENABLE)
+/* Fastest speed tracked, Q8 counts per step, which keeps the friction within 32 bits */
+#    define MOMENTUM_SPEED_MAX (((int32_t)1 << 16) - 1)
+/* Slowest speed glided at, Q8 counts per step */
+#    define MOMENTUM_SPEED_MIN 16
+
+static int32_t momentum_clamp(int32_t speed) {
+    if (speed > MOMENTUM_SPEED_MAX) {
+        return MOMENTUM_SPEED_MAX;
+    } else if (speed < -MOMENTUM_SPEED_MAX) {
+        return -MOMENTUM_SPEED_MAX;
+    }
+    return speed;
+}
+
+/* Approximates the length of the velocity without a square root */
+static int32_t momentum_speed(const momentum_status_t* status) {
+    int32_t x = labs(status->vx);
+    int32_t y = labs(status->vy);
+
+    return x > y ? x + y / 2 : y + x / 2;
+}
+
+/* Measures the speed of the motion since the last sample, in Q8 counts per step */
+static int32_t momentum_sample(int32_t distance, uint16_t elapsed, uint16_t step) {
+    return momentum_clamp(momentum_clamp(distance * 256 / elapsed) * step);
+}
+
+/* Multiplies the speed by a scale in 1/32768ths, rounding to the nearest */
+static int32_t momentum_scale(int32_t speed, uint32_t scale) {
+    int32_t scaled = (int32_t)(((uint32_t)labs(speed) * scale + 16384) >> 15);
+
+    return speed < 0 ? -scaled : scaled;
+}
+
+/* Slows the glide down by a step of friction, returns false once it has stopped */
+static bool momentum_friction(momentum_context_t* context) {
+    momentum_status_t* status = &context->status;
+    int32_t            speed  = momentum_speed(status);
+    int32_t            loss_x, loss_y;
+    uint32_t           scale;
+
+    switch (context->config.friction) {
+        case MOMENTUM_FRICTION_KINETIC:
+            if (speed <= context->config.coef) {
+                return false;
+            }
+            /*
+             * Scale both axes by the same share of the speed
+             * Done this way instead of taking the speed off each axis separately, so that diagonal glides keep their direction.
+             */
+            scale      = (uint32_t)(speed - context->config.coef) * 32768 / speed;
+            status->vx = momentum_scale(status->vx, scale);
+            status->vy = momentum_scale(status->vy, scale);
+            break;
+        default:
+            loss_x = (int32_t)(((uint32_t)labs(status->vx) * context->config.coef + 32768) >> 16);
+            loss_y = (int32_t)(((uint32_t)labs(status->vy) * context->config.coef + 32768) >> 16);
+            if (loss_x == 0 && loss_y == 0) {
+                /* Too slow for the friction to have any effect left */
+                return false;
+            }
+            status->vx -= status->vx < 0 ? -loss_x : loss_x;
+            status->vy -= status->vy < 0 ? -loss_y : loss_y;
+            break;
+    }
+    return momentum_speed(status) >= MOMENTUM_SPEED_MIN;
+}
+
+static int16_t momentum_take_axis(int32_t* glide, int16_t limit) {
+    int32_t counts = *glide / 256;
+
+    if (counts > limit) {
+        counts = limit;
+    } else if (counts < -limit) {
+        counts = -limit;
+    }
+    *glide -= counts * 256;
+    return (int16_t)counts;
+}
+
+void momentum_stop(momentum_context_t* context) {
+    memset(&context->status, 0, sizeof(context->status));
+}
+
+void momentum_update(momentum_context_t* context, int16_t dx, int16_t dy) {
+    momentum_status_t* status = &context->status;
+    uint16_t           elapsed, weight;
+    int32_t            sx, sy;
+
+    if (dx == 0 && dy == 0) {
+        return;
+    }
+    if (status->state != MOMENTUM_TRACKING) {
+        /* Motion takes over from any glide, its speed is only known from the time to the next motion */
+        momentum_stop(context);
+        status->state = MOMENTUM_TRACKING;
+        status->timer = timer_read();
+        return;
+    }
+
+    /* Motion read within the same millisecond is measured together */
+    status->dx += dx;
+    status->dy += dy;
+    elapsed = timer_elapsed(status->timer);
+    if (elapsed == 0) {
+        return;
+    }
+    sx            = momentum_sample(status->dx, elapsed, context->config.step);
+    sy            = momentum_sample(status->dy, elapsed, context->config.step);
+    status->dx    = 0;
+    status->dy    = 0;
+    status->timer = timer_read();
+
+    if (!status->sampled) {
+        status->vx      = sx;
+        status->vy      = sy;
+        status->sampled = true;
+        return;
+    }
+    /* Each sample is weighted by the time it covers, so the average doesn't depend on how often the sensor reports */
+    weight = elapsed < context->config.release ? elapsed : context->config.release;
+    status->vx += (sx - status->vx) * weight / context->config.release;
+    status->vy += (sy - status->vy) * weight / context->config.release;
+}
+
+bool momentum_step(momentum_context_t* context) {
+    momentum_status_t* status = &context->status;
+
+    switch (status->state) {
+        case MOMENTUM_TRACKING:
+            if (timer_elapsed(status->timer) < context->config.release) {
+                return true;
+            }
+            /* The motion has stopped, carry on at its speed if fast enough */
+            if (!status->sampled || momentum_speed(status) < context->config.trigger) {
+                momentum_stop(context);
+                return false;
+            }
+            status->state = MOMENTUM_GLIDING;
+            /* fall through */
+        case MOMENTUM_GLIDING:
+            status->x += status->vx;
+            status->y += status->vy;
+            if (!momentum_friction(context)) {
+                /* Keep what has glided until it is taken */
+                status->state = MOMENTUM_IDLE;
+                status->vx    = 0;
+                status->vy    = 0;
+                return false;
+            }
+            return true;
+        default:
+            return false;
+    }
+}
+
+momentum_t momentum_take(momentum_context_t* context, int16_t limit) {
+    momentum_status_t* status = &context->status;
+    momentum_t         glide  = {0};
+
+    glide.dx    = momentum_take_axis(&status->x, limit);
+    glide.dy    = momentum_take_axis(&status->y, limit);
+    glide.valid = status->state == MOMENTUM_GLIDING || glide.dx != 0 || glide.dy != 0;
+    return glide;
+}
+#endif
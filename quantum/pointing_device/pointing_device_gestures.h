@@ -56,3 +56,114 @@ cursor_glide_t cursor_glide_start(cursor_glide_context_t* glide);
 /* Update glide engine on the latest cursor movement, cursor glide is based on the final movement */
 void cursor_glide_update(cursor_glide_context_t* glide, mouse_xy_report_t dx, mouse_xy_report_t dy, uint16_t z);
 #endif
+
+#if defined(POINTING_DEVICE_GESTURES_MOMENTUM_ENABLE) || defined(POINTING_DEVICE_GESTURES_MULTI_TOUCH_ENABLE)
+typedef enum {
+    MOMENTUM_FRICTION_VISCOUS, /* Loses a share of its speed each step, slowing down exponentially */
+    MOMENTUM_FRICTION_KINETIC, /* Loses the same speed each step, slowing down linearly */
+} momentum_friction_t;
+
+typedef struct {
+    int16_t dx;
+    int16_t dy;
+    bool    valid; /* Still gliding, or glide left to report */
+} momentum_t;
+
+typedef struct {
+    momentum_friction_t friction;
+    uint16_t            coef;    /* Viscous: share of the speed lost each step, in 1/65536ths. Kinetic: speed lost each step, Q8 counts per step */
+    uint16_t            trigger; /* Speed needed when the motion stops to start gliding, Q8 counts per step */
+    uint16_t            release; /* Time without motion after which it has stopped, in milliseconds */
+    uint16_t            step;    /* Fixed timestep momentum_step() is called at, in milliseconds */
+} momentum_config_t;
+
+typedef enum {
+    MOMENTUM_IDLE,
+    MOMENTUM_TRACKING,
+    MOMENTUM_GLIDING,
+} momentum_state_t;
+
+typedef struct {
+    momentum_state_t state;
+    bool             sampled; /* The speed has been measured between two motions */
+    int32_t          vx;      /* Speed along x, Q8 counts per step */
+    int32_t          vy;      /* Speed along y, Q8 counts per step */
+    int32_t          dx;      /* Motion along x since the speed was last measured, counts */
+    int32_t          dy;      /* Motion along y since the speed was last measured, counts */
+    int32_t          x;       /* Glide along x not yet taken, Q8 counts */
+    int32_t          y;       /* Glide along y not yet taken, Q8 counts */
+    uint16_t         timer;   /* Time the speed was last measured */
+} momentum_status_t;
+
+typedef struct {
+    momentum_config_t config;
+    momentum_status_t status;
+} momentum_context_t;
+
+/* Update the momentum engine on motion from the sensor, measuring its speed */
+void momentum_update(momentum_context_t* context, int16_t dx, int16_t dy);
+
+/* Advance the momentum engine by one fixed step, returns false once there is nothing left to track or glide */
+bool momentum_step(momentum_context_t* context);
+
+/* Take the whole counts glided since the last call, up to limit on each axis, carrying the rest */
+momentum_t momentum_take(momentum_context_t* context, int16_t limit);
+
+/* Stop tracking and gliding, dropping any glide not yet taken */
+void momentum_stop(momentum_context_t* context);
+#endif
+
+#ifdef POINTING_DEVICE_GESTURES_MULTI_TOUCH_ENABLE
+typedef struct {
+    uint16_t x;
+    uint16_t y;
+} multi_touch_point_t;
+
+typedef struct {
+    mouse_hv_report_t h;     /* Horizontal scroll, in wheel detents */
+    mouse_hv_report_t v;     /* Vertical scroll, in wheel detents */
+    int8_t            zoom;  /* Pinch steps, positive as the fingers spread apart */
+    bool              valid; /* A scroll, pinch or momentum is in progress */
+} multi_touch_t;
+
+typedef struct {
+    uint16_t scroll_trigger_px; /* Pixels the fingers need to move together to start scrolling */
+    uint16_t pinch_trigger_px;  /* Pixels the distance between the fingers needs to change to start a pinch */
+    uint16_t scroll_px;         /* Pixels of movement per wheel detent */
+    uint16_t pinch_px;          /* Pixels of change in distance per pinch step */
+} multi_touch_config_t;
+
+typedef enum {
+    MULTI_TOUCH_IDLE,
+    MULTI_TOUCH_PENDING,
+    MULTI_TOUCH_SCROLL,
+    MULTI_TOUCH_PINCH,
+    MULTI_TOUCH_MOMENTUM,
+} multi_touch_state_t;
+
+typedef struct {
+    multi_touch_state_t state;
+    int32_t             x;              /* Sum of the fingers' x, twice the midpoint */
+    int32_t             y;              /* Sum of the fingers' y, twice the midpoint */
+    uint16_t            distance;       /* Distance between the fingers */
+    uint16_t            start_distance; /* Distance between the fingers when they touched down */
+    int32_t             start_x;        /* Sum of the fingers' x when they touched down */
+    int32_t             start_y;        /* Sum of the fingers' y when they touched down */
+    int32_t             h;              /* Horizontal scroll not yet sent, Q8 pixels */
+    int32_t             v;              /* Vertical scroll not yet sent, Q8 pixels */
+    int32_t             zoom;           /* Pinch not yet sent, Q8 pixels */
+    uint16_t            timer;          /* Time the momentum last stepped */
+} multi_touch_status_t;
+
+typedef struct {
+    multi_touch_config_t config;
+    multi_touch_status_t status;
+    momentum_context_t   momentum; /* Scroll momentum, counting in half pixels like the sums of the fingers' positions */
+} multi_touch_context_t;
+
+/* Update the gesture engine with the fingers on the sensor, gives the scroll and pinch steps to report */
+multi_touch_t multi_touch_update(multi_touch_context_t* context, const multi_touch_point_t* points, uint8_t count);
+
+/* Check momentum conditions between sensor reports, gives the momentum scroll to report */
+multi_touch_t multi_touch_check(multi_touch_context_t* context);
+#endif
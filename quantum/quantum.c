@@ -403,6 +403,9 @@ bool process_record_quantum(keyrecord_t *record) {
 #ifdef DYNAMIC_TAPPING_TERM_ENABLE
             process_dynamic_tapping_term(keycode, record) &&
 #endif
+#if defined(POINTING_DEVICE_ENABLE) && defined(POINTING_DEVICE_ACCEL_ENABLE)
+            process_pointing_device_accel(keycode, record) &&
+#endif
 #ifdef SPACE_CADET_ENABLE
             process_space_cadet(keycode, record) &&
 #endif
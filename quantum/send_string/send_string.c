@@ -326,3 +326,292 @@ void send_string_with_delay_P(const char *string, uint8_t interval) {
     send_string_with_delay_impl(send_string_get_next_progmem, &state, interval);
 }
 #endif
+
+#ifdef SEND_STRING_ASYNC_ENABLE
+#    include "timer.h"
+
+#    ifndef SEND_STRING_ASYNC_BUFFER_SIZE
+#        define SEND_STRING_ASYNC_BUFFER_SIZE 128
+#    endif
+
+// Minimum time between reports, so that each one is seen by the host
+#    ifndef SEND_STRING_ASYNC_REPORT_INTERVAL
+#        ifdef USB_POLLING_INTERVAL_MS
+#            define SEND_STRING_ASYNC_REPORT_INTERVAL USB_POLLING_INTERVAL_MS
+#        else
+#            define SEND_STRING_ASYNC_REPORT_INTERVAL 1
+#        endif
+#    endif
+
+_Static_assert(SEND_STRING_ASYNC_BUFFER_SIZE >= 4 && SEND_STRING_ASYNC_BUFFER_SIZE <= 0x8000, "SEND_STRING_ASYNC_BUFFER_SIZE must be between 4 and 32768");
+
+typedef enum send_string_async_action_t {
+    SEND_STRING_ASYNC_WAIT,
+    SEND_STRING_ASYNC_REGISTER,
+    SEND_STRING_ASYNC_UNREGISTER,
+#    if defined(AUDIO_ENABLE) && defined(SENDSTRING_BELL)
+    SEND_STRING_ASYNC_BELL,
+#    endif
+} send_string_async_action_t;
+
+// A single step of typing out a string, followed by a delay before the next step
+typedef struct send_string_async_step_t {
+    uint8_t  action;
+    uint8_t  keycode;
+    uint16_t delay;
+} send_string_async_step_t;
+
+// Queued strings are stored back to back, each as the interval followed by the NUL-terminated string
+static char     send_string_async_buffer[SEND_STRING_ASYNC_BUFFER_SIZE];
+static uint16_t send_string_async_head  = 0;
+static uint16_t send_string_async_tail  = 0;
+static uint16_t send_string_async_count = 0;
+
+// The steps for the character currently being typed, the most a character needs is a dead key with shift and AltGr
+static send_string_async_step_t send_string_async_steps[8];
+static uint8_t                  send_string_async_step_count = 0;
+static uint8_t                  send_string_async_step_index = 0;
+
+static bool     send_string_async_in_string = false;
+static uint8_t  send_string_async_interval  = 0;
+static bool     send_string_async_waiting   = false;
+static uint32_t send_string_async_timer     = 0;
+static uint16_t send_string_async_delay     = 0;
+
+// Keycodes registered by queued strings, so that they can be released on cancellation
+static uint8_t send_string_async_held[32];
+
+static char send_string_async_next(void) {
+    char ret               = send_string_async_buffer[send_string_async_tail];
+    send_string_async_tail = (send_string_async_tail + 1) % SEND_STRING_ASYNC_BUFFER_SIZE;
+    send_string_async_count--;
+    return ret;
+}
+
+static void send_string_async_add_step(uint8_t action, uint8_t keycode, uint32_t delay) {
+    send_string_async_step_t *step = &send_string_async_steps[send_string_async_step_count++];
+    step->action                   = action;
+    step->keycode                  = keycode;
+    step->delay                    = delay > UINT16_MAX ? UINT16_MAX : delay;
+}
+
+// Mirrors send_char_with_delay()
+static void send_string_async_add_char(char ascii_code, uint8_t interval) {
+#    if defined(AUDIO_ENABLE) && defined(SENDSTRING_BELL)
+    if (ascii_code == '\a') { // BEL
+        send_string_async_add_step(SEND_STRING_ASYNC_BELL, 0, 0);
+        return;
+    }
+#    endif
+
+    uint8_t keycode    = pgm_read_byte(&ascii_to_keycode_lut[(uint8_t)ascii_code]);
+    bool    is_shifted = PGM_LOADBIT(ascii_to_shift_lut, (uint8_t)ascii_code);
+    bool    is_altgred = PGM_LOADBIT(ascii_to_altgr_lut, (uint8_t)ascii_code);
+    bool    is_dead    = PGM_LOADBIT(ascii_to_dead_lut, (uint8_t)ascii_code);
+
+    if (is_shifted) {
+        send_string_async_add_step(SEND_STRING_ASYNC_REGISTER, KC_LEFT_SHIFT, interval);
+    }
+    if (is_altgred) {
+        send_string_async_add_step(SEND_STRING_ASYNC_REGISTER, KC_RIGHT_ALT, interval);
+    }
+    send_string_async_add_step(SEND_STRING_ASYNC_REGISTER, keycode, interval);
+    send_string_async_add_step(SEND_STRING_ASYNC_UNREGISTER, keycode, interval);
+    if (is_altgred) {
+        send_string_async_add_step(SEND_STRING_ASYNC_UNREGISTER, KC_RIGHT_ALT, interval);
+    }
+    if (is_shifted) {
+        send_string_async_add_step(SEND_STRING_ASYNC_UNREGISTER, KC_LEFT_SHIFT, interval);
+    }
+    if (is_dead) {
+        send_string_async_add_step(SEND_STRING_ASYNC_REGISTER, KC_SPACE, TAP_CODE_DELAY);
+        send_string_async_add_step(SEND_STRING_ASYNC_UNREGISTER, KC_SPACE, interval);
+    }
+}
+
+// Decodes the next character of the queued strings into steps, mirroring send_string_with_delay_impl()
+static bool send_string_async_decode(void) {
+    send_string_async_step_count = 0;
+    send_string_async_step_index = 0;
+
+    while (send_string_async_step_count == 0) {
+        if (!send_string_async_in_string) {
+            if (send_string_async_count == 0) {
+                return false;
+            }
+            send_string_async_interval  = send_string_async_next();
+            send_string_async_in_string = true;
+        }
+
+        uint8_t interval   = send_string_async_interval;
+        char    ascii_code = send_string_async_next();
+        if (!ascii_code) {
+            send_string_async_in_string = false;
+        } else if (ascii_code == SS_QMK_PREFIX) {
+            ascii_code = send_string_async_next();
+
+            if (ascii_code == SS_TAP_CODE || ascii_code == SS_DOWN_CODE || ascii_code == SS_UP_CODE) {
+                uint8_t keycode = send_string_async_next();
+                if (!keycode) {
+                    // Truncated string, don't read into the next one
+                    send_string_async_in_string = false;
+                    continue;
+                }
+                if (ascii_code == SS_TAP_CODE) {
+                    send_string_async_add_step(SEND_STRING_ASYNC_REGISTER, keycode, keycode == KC_CAPS_LOCK ? TAP_HOLD_CAPS_DELAY : TAP_CODE_DELAY);
+                    send_string_async_add_step(SEND_STRING_ASYNC_UNREGISTER, keycode, interval);
+                } else {
+                    send_string_async_add_step(ascii_code == SS_DOWN_CODE ? SEND_STRING_ASYNC_REGISTER : SEND_STRING_ASYNC_UNREGISTER, keycode, interval);
+                }
+            } else {
+                uint32_t ms = 0;
+                if (ascii_code == SS_DELAY_CODE) {
+                    ascii_code = send_string_async_next();
+                    while (isdigit(ascii_code)) {
+                        ms *= 10;
+                        ms += ascii_code - '0';
+                        if (ms > UINT16_MAX) {
+                            ms = UINT16_MAX;
+                        }
+                        ascii_code = send_string_async_next();
+                    }
+                }
+                send_string_async_add_step(SEND_STRING_ASYNC_WAIT, 0, ms + interval);
+            }
+
+            // if we had a delay that terminated with a null, we're done
+            if (ascii_code == 0) {
+                send_string_async_in_string = false;
+            }
+        } else {
+            send_string_async_add_char(ascii_code, interval);
+        }
+    }
+    return true;
+}
+
+bool send_string_async_with_delay_impl(char (*getter)(void *), void *arg, uint8_t interval) {
+    // Copy into the free space, only committing once the whole string fits
+    uint16_t head       = send_string_async_head;
+    uint16_t count      = send_string_async_count;
+    char     ascii_code = interval;
+    do {
+        if (count == SEND_STRING_ASYNC_BUFFER_SIZE) {
+            return false;
+        }
+        send_string_async_buffer[head] = ascii_code;
+        head                           = (head + 1) % SEND_STRING_ASYNC_BUFFER_SIZE;
+        count++;
+        ascii_code = getter(arg);
+    } while (ascii_code);
+
+    if (count == SEND_STRING_ASYNC_BUFFER_SIZE) {
+        return false;
+    }
+    send_string_async_buffer[head] = 0;
+    send_string_async_head         = (head + 1) % SEND_STRING_ASYNC_BUFFER_SIZE;
+    send_string_async_count        = count + 1;
+    return true;
+}
+
+bool send_string_async(const char *string) {
+    return send_string_async_with_delay(string, TAP_CODE_DELAY);
+}
+
+bool send_string_async_with_delay(const char *string, uint8_t interval) {
+    send_string_memory_state_t state = {string};
+    return send_string_async_with_delay_impl(send_string_get_next_ram, &state, interval);
+}
+
+#    if defined(__AVR__)
+bool send_string_async_P(const char *string) {
+    return send_string_async_with_delay_P(string, TAP_CODE_DELAY);
+}
+
+bool send_string_async_with_delay_P(const char *string, uint8_t interval) {
+    send_string_memory_state_t state = {string};
+    return send_string_async_with_delay_impl(send_string_get_next_progmem, &state, interval);
+}
+#    endif
+
+uint16_t send_string_async_free(void) {
+    return SEND_STRING_ASYNC_BUFFER_SIZE - send_string_async_count;
+}
+
+bool send_string_async_active(void) {
+    return send_string_async_count > 0 || send_string_async_in_string || send_string_async_step_index < send_string_async_step_count || send_string_async_waiting;
+}
+
+void send_string_async_cancel(void) {
+    send_string_async_head       = 0;
+    send_string_async_tail       = 0;
+    send_string_async_count      = 0;
+    send_string_async_in_string  = false;
+    send_string_async_step_count = 0;
+    send_string_async_step_index = 0;
+    send_string_async_waiting    = false;
+
+    for (uint16_t keycode = 0; keycode < 256; keycode++) {
+        if (send_string_async_held[keycode / 8] & (1 << (keycode % 8))) {
+            send_string_async_held[keycode / 8] &= ~(1 << (keycode % 8));
+            unregister_code(keycode);
+        }
+    }
+}
+
+void send_string_async_task(void) {
+    if (send_string_async_waiting) {
+        if (timer_elapsed32(send_string_async_timer) < send_string_async_delay) {
+            return;
+        }
+        send_string_async_waiting = false;
+    }
+
+    while (send_string_async_step_index < send_string_async_step_count || send_string_async_decode()) {
+        send_string_async_step_t *step  = &send_string_async_steps[send_string_async_step_index++];
+        uint16_t                  delay = step->delay;
+
+        switch (step->action) {
+            case SEND_STRING_ASYNC_REGISTER:
+                send_string_async_held[step->keycode / 8] |= 1 << (step->keycode % 8);
+                register_code(step->keycode);
+                break;
+            case SEND_STRING_ASYNC_UNREGISTER:
+                send_string_async_held[step->keycode / 8] &= ~(1 << (step->keycode % 8));
+                unregister_code(step->keycode);
+                break;
+#    if defined(AUDIO_ENABLE) && defined(SENDSTRING_BELL)
+            case SEND_STRING_ASYNC_BELL:
+                PLAY_SONG(bell_song);
+                break;
+#    endif
+        }
+
+        // At most one report per task, and no more often than the host polls for them
+        if (step->action == SEND_STRING_ASYNC_REGISTER || step->action == SEND_STRING_ASYNC_UNREGISTER) {
+            if (delay < SEND_STRING_ASYNC_REPORT_INTERVAL) {
+                delay = SEND_STRING_ASYNC_REPORT_INTERVAL;
+            }
+        } else if (delay == 0) {
+            continue;
+        }
+
+        send_string_async_timer   = timer_read32();
+        send_string_async_delay   = delay;
+        send_string_async_waiting = true;
+        return;
+    }
+}
+
+void send_string_async_flush(void) {
+    while (send_string_async_active()) {
+        send_string_async_task();
+        if (send_string_async_waiting) {
+            uint32_t elapsed = timer_elapsed32(send_string_async_timer);
+            if (elapsed < send_string_async_delay) {
+                wait_ms(send_string_async_delay - elapsed);
+            }
+        }
+    }
+}
+#endif // SEND_STRING_ASYNC_ENABLE
@@ -24,6 +24,7 @@
  */
 
 #include <stdint.h>
+#include <stdbool.h>
 
 #include "progmem.h"
 #include "send_string_keycodes.h"
@@ -169,4 +170,89 @@ void send_string_with_delay_P(const char *string, uint8_t interval);
  */
 void send_string_with_delay_impl(char (*getter)(void *), void *arg, uint8_t interval);
 
+#if defined(SEND_STRING_ASYNC_ENABLE) || defined(__DOXYGEN__)
+/**
+ * \brief Queue a string of ASCII characters to be typed out without blocking.
+ *
+ * The string is copied into a buffer of `SEND_STRING_ASYNC_BUFFER_SIZE` bytes, and typed out by `send_string_async_task()`
+ * from the main loop, producing the same reports as `send_string()`. Matrix scanning and other tasks keep running while it is typed.
+ *
+ * \param string The string to type out.
+ *
+ * \return `false` if there is not enough space left in the buffer, in which case nothing is queued.
+ */
+bool send_string_async(const char *string);
+
+/**
+ * \brief Queue a string of ASCII characters to be typed out without blocking, with a delay between each character.
+ *
+ * \param string The string to type out.
+ * \param interval The amount of time, in milliseconds, to wait before typing the next character.
+ *
+ * \return `false` if there is not enough space left in the buffer, in which case nothing is queued.
+ */
+bool send_string_async_with_delay(const char *string, uint8_t interval);
+
+#    if defined(__AVR__) || defined(__DOXYGEN__)
+/**
+ * \brief Queue a PROGMEM string of ASCII characters to be typed out without blocking.
+ *
+ * On ARM devices, this function is simply an alias for send_string_async_with_delay(string, 0).
+ *
+ * \param string The string to type out.
+ */
+bool send_string_async_P(const char *string);
+
+/**
+ * \brief Queue a PROGMEM string of ASCII characters to be typed out without blocking, with a delay between each character.
+ *
+ * On ARM devices, this function is simply an alias for send_string_async_with_delay(string, interval).
+ *
+ * \param string The string to type out.
+ * \param interval The amount of time, in milliseconds, to wait before typing the next character.
+ */
+bool send_string_async_with_delay_P(const char *string, uint8_t interval);
+#    else
+#        define send_string_async_P(string) send_string_async_with_delay(string, 0)
+#        define send_string_async_with_delay_P(string, interval) send_string_async_with_delay(string, interval)
+#    endif
+
+/**
+ * \brief Shortcut macro for send_string_async_with_delay_P(PSTR(string), 0).
+ */
+#    define SEND_STRING_ASYNC(string) send_string_async_with_delay_P(PSTR(string), 0)
+
+/**
+ * \brief Queue the string returned by the getter function, see `send_string_with_delay_impl()`.
+ *
+ * \return `false` if there is not enough space left in the buffer, in which case nothing is queued.
+ */
+bool send_string_async_with_delay_impl(char (*getter)(void *), void *arg, uint8_t interval);
+
+/**
+ * \brief Number of bytes left in the queue. Each queued string takes its length plus two bytes.
+ */
+uint16_t send_string_async_free(void);
+
+/**
+ * \brief Whether any queued string is still being typed out.
+ */
+bool send_string_async_active(void);
+
+/**
+ * \brief Discard all queued strings, releasing any keys they are holding down.
+ */
+void send_string_async_cancel(void);
+
+/**
+ * \brief Types out the next step of the queued strings, once the delay after the previous one has elapsed.
+ */
+void send_string_async_task(void);
+
+/**
+ * \brief Types out everything queued, blocking until it is done.
+ */
+void send_string_async_flush(void);
+#endif
+
 /** \} */
@@ -57,4 +57,14 @@ uint32_t sync_timer_elapsed32(uint32_t last) {
     if (is_keyboard_master()) return timer_elapsed32(last);
     return TIMER_DIFF_32(sync_timer_read32(), last);
 }
+
+uint32_t sync_timer_read_us(void) {
+    if (is_keyboard_master()) return timer_read_us();
+    return (uint32_t)sync_timer_ms * 1000 + timer_read_us();
+}
+
+uint32_t sync_timer_elapsed_us(uint32_t last) {
+    if (is_keyboard_master()) return timer_elapsed_us(last);
+    return TIMER_DIFF_US(sync_timer_read_us(), last);
+}
 #endif
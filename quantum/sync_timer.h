@@ -39,6 +39,8 @@ uint16_t sync_timer_read(void);
 uint32_t sync_timer_read32(void);
 uint16_t sync_timer_elapsed(uint16_t last);
 uint32_t sync_timer_elapsed32(uint32_t last);
+uint32_t sync_timer_read_us(void);
+uint32_t sync_timer_elapsed_us(uint32_t last);
 #else
 #    define sync_timer_init()
 #    define sync_timer_clear()
@@ -47,6 +49,8 @@ uint32_t sync_timer_elapsed32(uint32_t last);
 #    define sync_timer_read32() timer_read32()
 #    define sync_timer_elapsed(t) timer_elapsed(t)
 #    define sync_timer_elapsed32(t) timer_elapsed32(t)
+#    define sync_timer_read_us() timer_read_us()
+#    define sync_timer_elapsed_us(t) timer_elapsed_us(t)
 #endif
 
 #ifdef __cplusplus
@@ -276,6 +276,258 @@ __attribute__((weak)) bool via_command_kb(uint8_t *data, uint8_t length) {
     return false;
 }
 
+#ifdef VIA_BULK_TRANSFER_ENABLE
+_Static_assert(VIA_BULK_MAX_RAW_LENGTH <= UINT8_MAX, "VIA_BULK_MAX_RAW_LENGTH must fit within a single byte");
+_Static_assert(VIA_BULK_MAX_WINDOW >= 1 && VIA_BULK_MAX_WINDOW <= (VIA_BULK_SEQUENCE_LAST), "VIA_BULK_MAX_WINDOW must be between 1 and 128");
+
+static uint16_t via_bulk_region_size(uint8_t region) {
+    switch (region) {
+        case id_bulk_region_keymap:
+            return dynamic_keymap_get_layer_count() * MATRIX_ROWS * MATRIX_COLS * 2;
+        case id_bulk_region_macro:
+            return dynamic_keymap_macro_get_buffer_size();
+        default:
+            return 0;
+    }
+}
+
+static void via_bulk_get_buffer(uint8_t region, uint16_t offset, uint16_t size, uint8_t *data) {
+    if (region == id_bulk_region_keymap) {
+        dynamic_keymap_get_buffer(offset, size, data);
+    } else {
+        dynamic_keymap_macro_get_buffer(offset, size, data);
+    }
+}
+
+static void via_bulk_set_buffer(uint8_t region, uint16_t offset, uint16_t size, uint8_t *data) {
+    if (region == id_bulk_region_keymap) {
+        dynamic_keymap_set_buffer(offset, size, data);
+    } else {
+        dynamic_keymap_macro_set_buffer(offset, size, data);
+    }
+}
+
+// Same polynomial and conventions as zlib's crc32(), bitwise to keep the
+// firmware size down -- it's only run on request from the host.
+static uint32_t via_bulk_crc32(uint8_t region, uint16_t offset, uint16_t size) {
+    uint8_t  buffer[32];
+    uint32_t crc = 0xFFFFFFFF;
+    while (size > 0) {
+        uint16_t chunk = size < sizeof(buffer) ? size : sizeof(buffer);
+        via_bulk_get_buffer(region, offset, chunk, buffer);
+        for (uint16_t i = 0; i < chunk; i++) {
+            crc ^= buffer[i];
+            for (uint8_t bit = 0; bit < 8; bit++) {
+                crc = (crc >> 1) ^ (0xEDB88320 & -(crc & 1));
+            }
+        }
+        offset += chunk;
+        size -= chunk;
+    }
+    return ~crc;
+}
+
+// Number of times the 2-byte value at the start of data repeats, limited to what fits in a single token.
+static uint8_t via_bulk_repeat_count(const uint8_t *data, uint16_t size) {
+    uint8_t count = 1;
+    while (count < 129 && (count + 1) * 2 <= size && data[count * 2] == data[0] && data[count * 2 + 1] == data[1]) {
+        count++;
+    }
+    return size >= 2 ? count : 0;
+}
+
+// Encodes as many leading bytes of data as fit in a block report's payload.
+// Returns the number of raw bytes encoded.
+static uint8_t via_bulk_encode(const uint8_t *data, uint8_t size, uint8_t *payload, uint8_t *payload_size) {
+    uint8_t in  = 0;
+    uint8_t out = 0;
+    while (in < size) {
+        uint8_t repeats = via_bulk_repeat_count(&data[in], size - in);
+        if (repeats >= 2) {
+            if (out + 3 > VIA_BULK_PAYLOAD_SIZE) {
+                break;
+            }
+            payload[out++] = 0x80 | (repeats - 2);
+            payload[out++] = data[in];
+            payload[out++] = data[in + 1];
+            in += repeats * 2;
+            continue;
+        }
+
+        // Literal bytes up until the next repeat
+        uint8_t literal = 1;
+        while (in + literal < size && literal < 128 && via_bulk_repeat_count(&data[in + literal], size - in - literal) < 2) {
+            literal++;
+        }
+        if (out + 1 + literal > VIA_BULK_PAYLOAD_SIZE) {
+            if (out + 2 > VIA_BULK_PAYLOAD_SIZE) {
+                break;
+            }
+            literal = VIA_BULK_PAYLOAD_SIZE - out - 1;
+        }
+        payload[out++] = literal - 1;
+        memcpy(&payload[out], &data[in], literal);
+        out += literal;
+        in += literal;
+    }
+    *payload_size = out;
+    return in;
+}
+
+// Decodes a block report's payload into the region.
+// Returns false without writing anything if the payload is malformed, or doesn't fit the region.
+static bool via_bulk_decode(uint8_t region, uint16_t offset, uint8_t raw_size, uint8_t *payload, uint8_t payload_size) {
+    uint16_t region_size = via_bulk_region_size(region);
+    if (payload_size > VIA_BULK_PAYLOAD_SIZE || offset > region_size || raw_size > region_size - offset) {
+        return false;
+    }
+
+    uint16_t decoded_size = 0;
+    for (uint8_t i = 0; i < payload_size;) {
+        uint8_t token = payload[i++];
+        uint8_t count = (token & 0x7F);
+        if (token & 0x80) {
+            decoded_size += (count + 2) * 2;
+            i += 2;
+        } else {
+            decoded_size += count + 1;
+            i += count + 1;
+        }
+        if (i > payload_size) {
+            return false;
+        }
+    }
+    if (decoded_size != raw_size) {
+        return false;
+    }
+
+    for (uint8_t i = 0; i < payload_size;) {
+        uint8_t token = payload[i++];
+        uint8_t count = (token & 0x7F);
+        if (token & 0x80) {
+            uint8_t fill[32];
+            for (uint8_t j = 0; j < sizeof(fill); j++) {
+                fill[j] = payload[i + (j & 1)];
+            }
+            uint16_t remaining = (count + 2) * 2;
+            while (remaining > 0) {
+                uint8_t chunk = remaining < sizeof(fill) ? remaining : sizeof(fill);
+                via_bulk_set_buffer(region, offset, chunk, fill);
+                offset += chunk;
+                remaining -= chunk;
+            }
+            i += 2;
+        } else {
+            via_bulk_set_buffer(region, offset, count + 1, &payload[i]);
+            offset += count + 1;
+            i += count + 1;
+        }
+    }
+    return true;
+}
+
+static void via_bulk_command(uint8_t *data, uint8_t length) {
+    // data = [ command_id, bulk_command_id, bulk_data ]
+    uint8_t *command_id      = &(data[0]);
+    uint8_t *bulk_command_id = &(data[1]);
+    uint8_t *bulk_data       = &(data[2]);
+
+    switch (*bulk_command_id) {
+        case id_bulk_get_info: {
+            uint16_t keymap_size = via_bulk_region_size(id_bulk_region_keymap);
+            uint16_t macro_size  = via_bulk_region_size(id_bulk_region_macro);
+            bulk_data[0]         = VIA_BULK_VERSION;
+            bulk_data[1]         = id_bulk_region_count;
+            bulk_data[2]         = keymap_size >> 8;
+            bulk_data[3]         = keymap_size & 0xFF;
+            bulk_data[4]         = macro_size >> 8;
+            bulk_data[5]         = macro_size & 0xFF;
+            bulk_data[6]         = VIA_BULK_MAX_WINDOW;
+            break;
+        }
+        case id_bulk_get_crc: {
+            uint8_t  region      = bulk_data[0];
+            uint16_t offset      = (bulk_data[1] << 8) | bulk_data[2];
+            uint16_t size        = (bulk_data[3] << 8) | bulk_data[4];
+            uint16_t region_size = via_bulk_region_size(region);
+            if (region >= id_bulk_region_count || offset > region_size) {
+                *command_id = id_unhandled;
+                break;
+            }
+            if (size > region_size - offset) {
+                size = region_size - offset;
+            }
+            uint32_t crc = via_bulk_crc32(region, offset, size);
+            bulk_data[3] = size >> 8;
+            bulk_data[4] = size & 0xFF;
+            bulk_data[5] = (crc >> 24) & 0xFF;
+            bulk_data[6] = (crc >> 16) & 0xFF;
+            bulk_data[7] = (crc >> 8) & 0xFF;
+            bulk_data[8] = crc & 0xFF;
+            break;
+        }
+        case id_bulk_read: {
+            uint8_t  region      = bulk_data[0];
+            uint16_t offset      = (bulk_data[1] << 8) | bulk_data[2];
+            uint16_t remaining   = (bulk_data[3] << 8) | bulk_data[4];
+            uint8_t  window      = bulk_data[5];
+            uint16_t region_size = via_bulk_region_size(region);
+            if (region >= id_bulk_region_count || offset > region_size) {
+                *command_id = id_unhandled;
+                break;
+            }
+            if (remaining > region_size - offset) {
+                remaining = region_size - offset;
+            }
+            if (window < 1 || window > VIA_BULK_MAX_WINDOW) {
+                window = VIA_BULK_MAX_WINDOW;
+            }
+
+            uint8_t buffer[VIA_BULK_MAX_RAW_LENGTH];
+            for (uint8_t sequence = 0;; sequence++) {
+                uint8_t chunk = remaining < sizeof(buffer) ? remaining : sizeof(buffer);
+                uint8_t payload_size;
+                via_bulk_get_buffer(region, offset, chunk, buffer);
+                memset(&bulk_data[6], 0, VIA_BULK_PAYLOAD_SIZE);
+                uint8_t raw_size = via_bulk_encode(buffer, chunk, &bulk_data[6], &payload_size);
+                remaining -= raw_size;
+
+                bool last    = remaining == 0 || sequence + 1 >= window;
+                bulk_data[0] = region;
+                bulk_data[1] = offset >> 8;
+                bulk_data[2] = offset & 0xFF;
+                bulk_data[3] = sequence | (last ? VIA_BULK_SEQUENCE_LAST : 0);
+                bulk_data[4] = raw_size;
+                bulk_data[5] = payload_size;
+                offset += raw_size;
+                if (last) {
+                    // The final report of the window is sent by raw_hid_receive()
+                    break;
+                }
+                raw_hid_send(data, length);
+            }
+            break;
+        }
+        case id_bulk_write: {
+            uint8_t  region = bulk_data[0];
+            uint16_t offset = (bulk_data[1] << 8) | bulk_data[2];
+            if (region >= id_bulk_region_count) {
+                *command_id = id_unhandled;
+                break;
+            }
+            if (!via_bulk_decode(region, offset, bulk_data[4], &bulk_data[6], bulk_data[5])) {
+                bulk_data[4] = 0;
+            }
+            break;
+        }
+        default: {
+            *command_id = id_unhandled;
+            break;
+        }
+    }
+}
+#endif // VIA_BULK_TRANSFER_ENABLE
+
 void raw_hid_receive(uint8_t *data, uint8_t length) {
     uint8_t *command_id   = &(data[0]);
     uint8_t *command_data = &(data[1]);
@@ -436,6 +688,32 @@ void raw_hid_receive(uint8_t *data, uint8_t length) {
             dynamic_keymap_set_buffer(offset, size, &command_data[3]);
             break;
         }
+#ifdef DYNAMIC_KEYMAP_HASH_ENABLE
+        case id_dynamic_keymap_get_hashes: {
+            uint8_t first = command_data[0];
+            uint8_t count = command_data[1];
+            uint8_t total = dynamic_keymap_get_layer_count() + 1;
+            if (first > total) {
+                first = total;
+            }
+            if (count > total - first) {
+                count = total - first;
+            }
+            if (count > VIA_KEYMAP_HASHES_PER_REPORT) {
+                count = VIA_KEYMAP_HASHES_PER_REPORT;
+            }
+            command_data[0] = first;
+            command_data[1] = count;
+            for (uint8_t i = 0; i < count; i++) {
+                uint32_t hash             = dynamic_keymap_get_hash(first + i);
+                command_data[2 + (i * 4)] = hash >> 24;
+                command_data[3 + (i * 4)] = hash >> 16;
+                command_data[4 + (i * 4)] = hash >> 8;
+                command_data[5 + (i * 4)] = hash & 0xFF;
+            }
+            break;
+        }
+#endif
 #ifdef ENCODER_MAP_ENABLE
         case id_dynamic_keymap_get_encoder: {
             uint16_t keycode = dynamic_keymap_get_encoder(command_data[0], command_data[1], command_data[2] != 0);
@@ -447,6 +725,12 @@ void raw_hid_receive(uint8_t *data, uint8_t length) {
             dynamic_keymap_set_encoder(command_data[0], command_data[1], command_data[2] != 0, (command_data[3] << 8) | command_data[4]);
             break;
         }
+#endif
+#ifdef VIA_BULK_TRANSFER_ENABLE
+        case id_dynamic_keymap_bulk: {
+            via_bulk_command(data, length);
+            break;
+        }
 #endif
         default: {
             // The command ID is not known
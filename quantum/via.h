@@ -93,9 +93,67 @@ enum via_command_id {
     id_dynamic_keymap_set_buffer            = 0x13,
     id_dynamic_keymap_get_encoder           = 0x14,
     id_dynamic_keymap_set_encoder           = 0x15,
+    id_dynamic_keymap_bulk                  = 0x16,
+    id_dynamic_keymap_get_hashes            = 0x17,
     id_unhandled                            = 0xFF,
 };
 
+// Content hashes of each layer, followed by the macro buffer, enabled with DYNAMIC_KEYMAP_HASH_ENABLE.
+// Hosts can skip reading layers which are unchanged since they were last read.
+//
+// data = [ id_dynamic_keymap_get_hashes, first, count ] -> [ first, count, hash (4) * count ]
+//
+// The count is clamped to VIA_KEYMAP_HASHES_PER_REPORT and to the number of hashes after `first`,
+// the hash at index `layer count` being the macro buffer. Each hash is a 32-bit sum over the
+// bytes of the layer, see dynamic_keymap_get_hash().
+#define VIA_KEYMAP_HASHES_PER_REPORT 7
+
+// Bulk transfer of the dynamic keymap and macro buffers, enabled with VIA_BULK_TRANSFER_ENABLE.
+// All multi-byte values are big-endian, and requests are stateless -- the host acknowledges
+// each window of streamed reports by requesting the next one.
+//
+// data = [ id_dynamic_keymap_bulk, via_bulk_command_id, ... ]
+//
+// id_bulk_get_info:  [ ]                                                          -> [ version, region count, keymap size (2), macro size (2), max window ]
+// id_bulk_get_crc:   [ region, offset (2), length (2) ]                           -> [ region, offset (2), length (2), CRC-32 (4) ]
+// id_bulk_read:      [ region, offset (2), length (2), window ]                   -> up to `window` block reports
+// id_bulk_write:     block report                                                 -> block report header, raw length set to 0 if rejected
+//
+// Block report: [ region, offset (2), sequence, raw length, encoded length, encoded data (up to 24) ]
+// The sequence number counts reports within a window, with VIA_BULK_SEQUENCE_LAST set on the final
+// report of a window. The CRC-32 is the same as zlib's crc32(), and the length is clamped to the region.
+//
+// Encoded data is a series of tokens:
+//     0b0nnnnnnn, followed by n+1 literal bytes
+//     0b1nnnnnnn, followed by a 2-byte value repeated n+2 times
+enum via_bulk_command_id {
+    id_bulk_get_info = 0x01,
+    id_bulk_get_crc  = 0x02,
+    id_bulk_read     = 0x03,
+    id_bulk_write    = 0x04,
+};
+
+enum via_bulk_region_id {
+    id_bulk_region_keymap = 0x00,
+    id_bulk_region_macro  = 0x01,
+    id_bulk_region_count,
+};
+
+#define VIA_BULK_VERSION 0x01
+#define VIA_BULK_SEQUENCE_LAST 0x80
+#define VIA_BULK_HEADER_SIZE 8
+#define VIA_BULK_PAYLOAD_SIZE (32 - VIA_BULK_HEADER_SIZE)
+
+// Maximum number of block reports streamed for each id_bulk_read request
+#ifndef VIA_BULK_MAX_WINDOW
+#    define VIA_BULK_MAX_WINDOW 16
+#endif
+
+// Maximum number of raw bytes covered by a single block report, which is also the size of the read buffer on the stack
+#ifndef VIA_BULK_MAX_RAW_LENGTH
+#    define VIA_BULK_MAX_RAW_LENGTH 128
+#endif
+
 enum via_keyboard_value_id {
     id_uptime              = 0x01,
     id_layout_options      = 0x02,
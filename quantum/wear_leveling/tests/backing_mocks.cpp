@@ -20,9 +20,10 @@ void MockBackingStore::reset_instance() {
 
     backing_init_invoke_count   = 0;
     backing_unlock_invoke_count = 0;
-    backing_erase_invoke_count  = 0;
-    backing_write_invoke_count  = 0;
-    backing_lock_invoke_count   = 0;
+    backing_erase_invoke_count       = 0;
+    backing_erase_range_invoke_count = 0;
+    backing_write_invoke_count       = 0;
+    backing_lock_invoke_count        = 0;
 
     init_success_callback   = [](std::uint64_t) { return true; };
     erase_success_callback  = [](std::uint64_t) { return true; };
@@ -30,9 +31,25 @@ void MockBackingStore::reset_instance() {
     write_success_callback  = [](std::uint64_t, std::uint32_t) { return true; };
     lock_success_callback   = [](std::uint64_t) { return true; };
 
+    power_loss_countdown = -1;
+    power_lost           = false;
+
     write_log.clear();
 }
 
+bool MockBackingStore::consume_power() {
+    if (power_loss_countdown == 0) {
+        power_lost = true;
+    }
+    if (power_lost) {
+        return false;
+    }
+    if (power_loss_countdown > 0) {
+        --power_loss_countdown;
+    }
+    return true;
+}
+
 bool MockBackingStore::init(void) {
     ++backing_init_invoke_count;
 
@@ -57,6 +74,11 @@ bool MockBackingStore::unlock(void) {
 bool MockBackingStore::erase(void) {
     ++backing_erase_invoke_count;
 
+    // Drop the erase entirely if power has been lost
+    if (!consume_power()) {
+        return false;
+    }
+
     // Erase each slot
     for (std::size_t i = 0; i < backing_storage.size(); ++i) {
         // Drop out of erase early with failure if we need to
@@ -75,6 +97,27 @@ bool MockBackingStore::erase(void) {
     return true;
 }
 
+bool MockBackingStore::erase_range(uint32_t address, std::size_t length) {
+    ++backing_erase_range_invoke_count;
+
+    EXPECT_TRUE(address % BACKING_STORE_WRITE_SIZE == 0) << "Supplied address was not aligned with the backing store integral size";
+    EXPECT_TRUE(length % BACKING_STORE_WRITE_SIZE == 0) << "Supplied length was not aligned with the backing store integral size";
+    EXPECT_TRUE(address + length <= WEAR_LEVELING_BACKING_SIZE) << "Address would result of out-of-bounds access";
+
+    // Drop the erase entirely if power has been lost
+    if (!consume_power()) {
+        return false;
+    }
+
+    // Erase each slot in the range
+    for (std::size_t i = address / BACKING_STORE_WRITE_SIZE; i < (address + length) / BACKING_STORE_WRITE_SIZE; ++i) {
+        backing_storage[i].erase();
+    }
+
+    ++backing_erasure_count;
+    return true;
+}
+
 bool MockBackingStore::write(uint32_t address, backing_store_int_t value) {
     ++backing_write_invoke_count;
 
@@ -88,6 +131,11 @@ bool MockBackingStore::write(uint32_t address, backing_store_int_t value) {
         return false;
     }
 
+    // Drop the write entirely if power has been lost
+    if (!consume_power()) {
+        return false;
+    }
+
     // Write the complement as we're simulating flash memory -- 0xFF means 0x00
     std::size_t index = address / BACKING_STORE_WRITE_SIZE;
     backing_storage[index].set(~value);
@@ -141,6 +189,10 @@ extern "C" bool backing_store_erase(void) {
     return MockBackingStore::Instance().erase();
 }
 
+extern "C" bool backing_store_erase_range(uint32_t address, size_t length) {
+    return MockBackingStore::Instance().erase_range(address, length);
+}
+
 extern "C" bool backing_store_write(uint32_t address, backing_store_int_t value) {
     return MockBackingStore::Instance().write(address, value);
 }
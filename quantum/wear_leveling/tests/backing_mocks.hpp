@@ -94,6 +94,7 @@ class MockBackingStore {
     std::uint64_t backing_init_invoke_count;
     std::uint64_t backing_unlock_invoke_count;
     std::uint64_t backing_erase_invoke_count;
+    std::uint64_t backing_erase_range_invoke_count;
     std::uint64_t backing_write_invoke_count;
     std::uint64_t backing_lock_invoke_count;
 
@@ -108,6 +109,14 @@ class MockBackingStore {
     // Whether locks should succeed
     std::function<bool(std::uint64_t)> lock_success_callback;
 
+    // Number of erase/write operations remaining before a simulated power loss, or -1 if power loss is disabled
+    std::int64_t power_loss_countdown;
+    // Whether a simulated power loss has occurred, causing all subsequent erases/writes to be dropped
+    bool power_lost;
+
+    // Tracks an erase/write operation, returning false if it should be dropped due to a simulated power loss
+    bool consume_power();
+
     template <typename... Args>
     void append_log(Args&&... args) {
         if (write_log.size() < MOCK_WRITE_LOG_MAX_ENTRIES::value) {
@@ -141,6 +150,9 @@ class MockBackingStore {
     std::uint64_t erase_invoke_count() const {
         return backing_erase_invoke_count;
     }
+    std::uint64_t erase_range_invoke_count() const {
+        return backing_erase_range_invoke_count;
+    }
     std::uint64_t write_invoke_count() const {
         return backing_write_invoke_count;
     }
@@ -159,6 +171,7 @@ class MockBackingStore {
     bool init();
     bool unlock();
     bool erase();
+    bool erase_range(std::uint32_t address, std::size_t length);
     bool write(std::uint32_t address, backing_store_int_t value);
     bool lock();
     bool read(std::uint32_t address, backing_store_int_t& value) const;
@@ -180,6 +193,19 @@ class MockBackingStore {
         lock_success_callback = callback;
     }
 
+    // Simulated power loss -- after the specified number of erase/write operations, all subsequent ones are dropped
+    void set_power_loss_after(std::uint64_t operations) {
+        power_loss_countdown = (std::int64_t)operations;
+        power_lost           = false;
+    }
+    void restore_power() {
+        power_loss_countdown = -1;
+        power_lost           = false;
+    }
+    bool is_power_lost() const {
+        return power_lost;
+    }
+
     auto storage_begin() const -> decltype(backing_storage.begin()) {
         return backing_storage.begin();
     }
@@ -63,4 +63,59 @@ wear_leveling_8byte_SRC := \
 	$(wear_leveling_common_SRC) \
 	$(QUANTUM_PATH)/wear_leveling/tests/wear_leveling_8byte.cpp
 wear_leveling_8byte_INC := \
+	$(wear_leveling_common_INC)
+
+wear_leveling_2byte_background_DEFS := \
+	$(wear_leveling_common_DEFS) \
+	-DBACKING_STORE_WRITE_SIZE=2 \
+	-DWEAR_LEVELING_BACKING_SIZE=128 \
+	-DWEAR_LEVELING_LOGICAL_SIZE=16 \
+	-DWEAR_LEVELING_BACKGROUND_CONSOLIDATION \
+	-DBACKING_STORE_ERASE_SIZE=16 \
+	-DWEAR_LEVELING_CONSOLIDATION_STEP_SIZE=4
+wear_leveling_2byte_background_SRC := \
+	$(wear_leveling_common_SRC) \
+	$(QUANTUM_PATH)/wear_leveling/tests/wear_leveling_background.cpp
+wear_leveling_2byte_background_INC := \
+	$(wear_leveling_common_INC)
+
+wear_leveling_8byte_background_DEFS := \
+	$(wear_leveling_common_DEFS) \
+	-DBACKING_STORE_WRITE_SIZE=8 \
+	-DWEAR_LEVELING_BACKING_SIZE=256 \
+	-DWEAR_LEVELING_LOGICAL_SIZE=16 \
+	-DWEAR_LEVELING_BACKGROUND_CONSOLIDATION \
+	-DBACKING_STORE_ERASE_SIZE=32 \
+	-DWEAR_LEVELING_CONSOLIDATION_STEP_SIZE=8
+wear_leveling_8byte_background_SRC := \
+	$(wear_leveling_common_SRC) \
+	$(QUANTUM_PATH)/wear_leveling/tests/wear_leveling_background.cpp
+wear_leveling_8byte_background_INC := \
+	$(wear_leveling_common_INC)
+
+wear_leveling_2byte_compressed_background_DEFS := \
+	$(wear_leveling_common_DEFS) \
+	-DBACKING_STORE_WRITE_SIZE=2 \
+	-DWEAR_LEVELING_BACKING_SIZE=256 \
+	-DWEAR_LEVELING_LOGICAL_SIZE=32 \
+	-DWEAR_LEVELING_BACKGROUND_CONSOLIDATION \
+	-DWEAR_LEVELING_LOG_COMPRESSION \
+	-DBACKING_STORE_ERASE_SIZE=16 \
+	-DWEAR_LEVELING_CONSOLIDATION_STEP_SIZE=4
+wear_leveling_2byte_compressed_background_SRC := \
+	$(wear_leveling_common_SRC) \
+	$(QUANTUM_PATH)/wear_leveling/tests/wear_leveling_background.cpp
+wear_leveling_2byte_compressed_background_INC := \
+	$(wear_leveling_common_INC)
+
+wear_leveling_2byte_compressed_DEFS := \
+	$(wear_leveling_common_DEFS) \
+	-DBACKING_STORE_WRITE_SIZE=2 \
+	-DWEAR_LEVELING_BACKING_SIZE=65536 \
+	-DWEAR_LEVELING_LOGICAL_SIZE=32768 \
+	-DWEAR_LEVELING_LOG_COMPRESSION
+wear_leveling_2byte_compressed_SRC := \
+	$(wear_leveling_common_SRC) \
+	$(QUANTUM_PATH)/wear_leveling/tests/wear_leveling_2byte_compressed.cpp
+wear_leveling_2byte_compressed_INC := \
 	$(wear_leveling_common_INC)
\ No newline at end of file
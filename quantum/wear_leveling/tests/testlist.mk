@@ -3,4 +3,8 @@ TEST_LIST += \
 	wear_leveling_2byte_optimized_writes \
 	wear_leveling_2byte \
 	wear_leveling_4byte \
-	wear_leveling_8byte
+	wear_leveling_8byte \
+	wear_leveling_2byte_background \
+	wear_leveling_8byte_background \
+	wear_leveling_2byte_compressed \
+	wear_leveling_2byte_compressed_background
@@ -0,0 +1,168 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#include <numeric>
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include "backing_mocks.hpp"
+
+static std::array<std::uint8_t, WEAR_LEVELING_LOGICAL_SIZE> verify_data;
+
+class WearLeveling2ByteCompressed : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        verify_data.fill(0);
+        MockBackingStore::Instance().reset_instance();
+        wear_leveling_init();
+    }
+};
+
+static wear_leveling_status_t test_write(const uint32_t address, const void* value, size_t length) {
+    memcpy(&verify_data[address], value, length);
+    return wear_leveling_write(address, value, length);
+}
+
+/**
+ * Verifies the logical data matches what was written, both from the cache and after replaying the write log.
+ */
+static void verify_readback(void) {
+    std::array<std::uint8_t, WEAR_LEVELING_LOGICAL_SIZE> readback;
+    EXPECT_EQ(wear_leveling_read(0, readback.data(), WEAR_LEVELING_LOGICAL_SIZE), WEAR_LEVELING_SUCCESS) << "Failed to read back the saved data";
+    EXPECT_TRUE(memcmp(readback.data(), verify_data.data(), WEAR_LEVELING_LOGICAL_SIZE) == 0) << "Readback did not match";
+
+    EXPECT_EQ(wear_leveling_init(), WEAR_LEVELING_SUCCESS) << "Re-initialisation failed";
+    EXPECT_EQ(wear_leveling_read(0, readback.data(), WEAR_LEVELING_LOGICAL_SIZE), WEAR_LEVELING_SUCCESS) << "Failed to read back the saved data";
+    EXPECT_TRUE(memcmp(readback.data(), verify_data.data(), WEAR_LEVELING_LOGICAL_SIZE) == 0) << "Replayed readback did not match";
+}
+
+/**
+ * Decodes the header of the extended write log entry starting at the given backing store write.
+ */
+static write_log_entry_t read_extended_entry(std::size_t index) {
+    auto&             inst = MockBackingStore::Instance();
+    write_log_entry_t e;
+    for (std::size_t i = 0; i < 4; ++i) {
+        e.raw16[i] = (inst.log_begin() + index + i)->value;
+    }
+    EXPECT_EQ(LOG_ENTRY_GET_TYPE(e), LOG_ENTRY_TYPE_EXTENDED) << "Invalid write log entry type";
+    return e;
+}
+
+/**
+ * This test verifies a repeated 2-byte pattern, such as a layer full of the same keycode, is written as a single fill entry.
+ */
+TEST_F(WearLeveling2ByteCompressed, FillPattern_SingleEntry) {
+    auto& inst = MockBackingStore::Instance();
+
+    std::vector<std::uint8_t> testvalue(1000);
+    for (std::size_t i = 0; i < testvalue.size(); i += 2) {
+        testvalue[i + 0] = 0x12;
+        testvalue[i + 1] = 0x34;
+    }
+    EXPECT_EQ(test_write(1000, testvalue.data(), testvalue.size()), WEAR_LEVELING_SUCCESS) << "Write returned incorrect status";
+
+    EXPECT_EQ(std::distance(inst.log_begin(), inst.log_end()), 4) << "Fill should have been written as a single extended entry";
+    auto e = read_extended_entry(0);
+    EXPECT_EQ(LOG_ENTRY_EXTENDED_GET_SUBTYPE(e), LOG_ENTRY_EXTENDED_FILL) << "Invalid extended entry subtype";
+    EXPECT_EQ(LOG_ENTRY_EXTENDED_GET_ADDRESS(e), 1000) << "Invalid extended entry address";
+    EXPECT_EQ(LOG_ENTRY_EXTENDED_GET_LENGTH(e), testvalue.size()) << "Invalid extended entry length";
+
+    verify_readback();
+}
+
+/**
+ * This test verifies non-repeating data is written as a single range entry, followed by the literal bytes.
+ */
+TEST_F(WearLeveling2ByteCompressed, Range_SingleEntry) {
+    auto& inst = MockBackingStore::Instance();
+
+    std::vector<std::uint8_t> testvalue(100);
+    std::iota(testvalue.begin(), testvalue.end(), 0x20);
+    EXPECT_EQ(test_write(2001, testvalue.data(), testvalue.size()), WEAR_LEVELING_SUCCESS) << "Write returned incorrect status";
+
+    // 4 writes for the header, including the first 3 bytes, then the remaining 97 bytes padded to the write size
+    EXPECT_EQ(std::distance(inst.log_begin(), inst.log_end()), 4 + 49);
+    auto e = read_extended_entry(0);
+    EXPECT_EQ(LOG_ENTRY_EXTENDED_GET_SUBTYPE(e), LOG_ENTRY_EXTENDED_RANGE) << "Invalid extended entry subtype";
+    EXPECT_EQ(LOG_ENTRY_EXTENDED_GET_ADDRESS(e), 2001) << "Invalid extended entry address";
+    EXPECT_EQ(LOG_ENTRY_EXTENDED_GET_LENGTH(e), testvalue.size()) << "Invalid extended entry length";
+
+    verify_readback();
+}
+
+/**
+ * This test verifies that writing back the consolidated values results in a restore entry, rather than the literal bytes.
+ */
+TEST_F(WearLeveling2ByteCompressed, ConsolidatedData_RestoreEntry) {
+    auto& inst = MockBackingStore::Instance();
+
+    // Set up consolidated data directly in the backing store
+    for (std::size_t i = 0; i < WEAR_LEVELING_LOGICAL_SIZE; ++i) {
+        verify_data[i] = (std::uint8_t)(i * 7);
+    }
+    for (std::size_t i = 0; i < WEAR_LEVELING_LOGICAL_SIZE; i += BACKING_STORE_WRITE_SIZE) {
+        backing_store_int_t v;
+        memcpy(&v, &verify_data[i], sizeof(v));
+        (inst.storage_begin() + (i / BACKING_STORE_WRITE_SIZE))->set(~v);
+    }
+    write_log_entry_t checksum;
+    checksum.raw64 = fnv_64a_buf(verify_data.data(), WEAR_LEVELING_LOGICAL_SIZE, FNV1A_64_INIT);
+    for (std::size_t i = 0; i < 4; ++i) {
+        (inst.storage_begin() + (WEAR_LEVELING_LOGICAL_SIZE / BACKING_STORE_WRITE_SIZE) + i)->set(~checksum.raw16[i]);
+    }
+    EXPECT_EQ(wear_leveling_init(), WEAR_LEVELING_SUCCESS) << "Init returned incorrect status";
+
+    // Overwrite a block, then write back the original values
+    std::vector<std::uint8_t> original(verify_data.begin() + 3000, verify_data.begin() + 3200);
+    std::vector<std::uint8_t> testvalue(original.size(), 0x55);
+    EXPECT_EQ(test_write(3000, testvalue.data(), testvalue.size()), WEAR_LEVELING_SUCCESS) << "Write returned incorrect status";
+    EXPECT_EQ(test_write(3000, original.data(), original.size()), WEAR_LEVELING_SUCCESS) << "Write returned incorrect status";
+
+    EXPECT_EQ(std::distance(inst.log_begin(), inst.log_end()), 8) << "Both writes should have been a single extended entry each";
+    auto e = read_extended_entry(4);
+    EXPECT_EQ(LOG_ENTRY_EXTENDED_GET_SUBTYPE(e), LOG_ENTRY_EXTENDED_RESTORE) << "Invalid extended entry subtype";
+    EXPECT_EQ(LOG_ENTRY_EXTENDED_GET_ADDRESS(e), 3000) << "Invalid extended entry address";
+    EXPECT_EQ(LOG_ENTRY_EXTENDED_GET_LENGTH(e), original.size()) << "Invalid extended entry length";
+
+    verify_readback();
+}
+
+/**
+ * This test verifies only the modified parts of a large write are written to the log.
+ */
+TEST_F(WearLeveling2ByteCompressed, ModifiedSpansOnly) {
+    auto& inst = MockBackingStore::Instance();
+
+    std::vector<std::uint8_t> testvalue(512);
+    std::iota(testvalue.begin(), testvalue.end(), 0x20);
+    EXPECT_EQ(test_write(4000, testvalue.data(), testvalue.size()), WEAR_LEVELING_SUCCESS) << "Write returned incorrect status";
+    auto initial_entries = std::distance(inst.log_begin(), inst.log_end());
+
+    // Modify two bytes far apart, then rewrite the whole block
+    testvalue[10]  = 0xAA;
+    testvalue[400] = 0xBB;
+    EXPECT_EQ(test_write(4000, testvalue.data(), testvalue.size()), WEAR_LEVELING_SUCCESS) << "Write returned incorrect status";
+
+    // Each modified byte should result in a single multibyte entry of 2 backing writes
+    EXPECT_EQ(std::distance(inst.log_begin(), inst.log_end()) - initial_entries, 4) << "Unmodified data should not have been written";
+
+    verify_readback();
+}
+
+/**
+ * This test verifies that extended entries can be mixed with the regular encodings during playback.
+ */
+TEST_F(WearLeveling2ByteCompressed, MixedEntries_Playback) {
+    std::vector<std::uint8_t> testvalue(64);
+    std::iota(testvalue.begin(), testvalue.end(), 0x80);
+    std::fill(testvalue.begin() + 20, testvalue.begin() + 40, 0x00);
+
+    for (uint32_t address = 0; address < 256; address += 37) {
+        EXPECT_EQ(test_write(address, testvalue.data(), testvalue.size()), WEAR_LEVELING_SUCCESS) << "Write returned incorrect status";
+        uint16_t v = 1;
+        EXPECT_EQ(test_write(address + 2, &v, sizeof(v)), WEAR_LEVELING_SUCCESS) << "Write returned incorrect status";
+        uint8_t b = 0x42;
+        EXPECT_EQ(test_write(20000 + address, &b, sizeof(b)), WEAR_LEVELING_SUCCESS) << "Write returned incorrect status";
+    }
+
+    verify_readback();
+}
@@ -0,0 +1,294 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#include <algorithm>
+#include <numeric>
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include "backing_mocks.hpp"
+
+class WearLevelingBackground : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        MockBackingStore::Instance().reset_instance();
+        wear_leveling_init();
+    }
+};
+
+using logical_data_t = std::array<std::uint8_t, WEAR_LEVELING_LOGICAL_SIZE>;
+
+// Location of the last write attempted by run_workload()
+static std::uint32_t last_write_address, last_write_length;
+
+/**
+ * Runs background consolidation until it completes, returning the number of steps taken.
+ */
+static int run_background_consolidation(void) {
+    int                    steps = 0;
+    wear_leveling_status_t status;
+    do {
+        status = wear_leveling_task();
+        ++steps;
+    } while (status == WEAR_LEVELING_SUCCESS && steps < 1000);
+    EXPECT_EQ(status, WEAR_LEVELING_CONSOLIDATED) << "Background consolidation should have completed";
+    return steps;
+}
+
+/**
+ * Performs a deterministic sequence of writes of up to max_length bytes, interleaved with background consolidation steps for the first part of the sequence only, so that in-line consolidation also occurs.
+ * Stops at the first failure, keeping track of the data known to have been persisted, as well as the data including the failed write.
+ */
+static void run_workload(logical_data_t& committed, logical_data_t& pending, std::uint32_t max_length = 1) {
+    committed.fill(0);
+    pending.fill(0);
+    for (int i = 0; i < 96; ++i) {
+        std::uint32_t address = (i * 7) % WEAR_LEVELING_LOGICAL_SIZE;
+        std::uint32_t length  = std::min<std::uint32_t>(1 + (i % max_length), WEAR_LEVELING_LOGICAL_SIZE - address);
+        std::uint8_t  values[WEAR_LEVELING_LOGICAL_SIZE];
+
+        last_write_address = address;
+        last_write_length  = length;
+        pending            = committed;
+        for (std::uint32_t j = 0; j < length; ++j) {
+            values[j]            = (std::uint8_t)(i + j + 0x10);
+            pending[address + j] = values[j];
+        }
+        if (wear_leveling_write(address, values, length) == WEAR_LEVELING_FAILED) {
+            return;
+        }
+        committed = pending;
+
+        if (i < 48 && wear_leveling_task() == WEAR_LEVELING_FAILED) {
+            return;
+        }
+    }
+}
+
+/**
+ * This test verifies that background consolidation never erases the entire backing store, and that each step performs a bounded amount of work.
+ */
+TEST_F(WearLevelingBackground, BackgroundConsolidation_BoundedSteps) {
+    auto& inst = MockBackingStore::Instance();
+
+    // Fill the write log up to the consolidation threshold
+    for (int i = 0; i < (WEAR_LEVELING_CONSOLIDATION_THRESHOLD) / (BACKING_STORE_WRITE_SIZE); ++i) {
+        std::uint8_t value = (std::uint8_t)(i + 0x20);
+        EXPECT_EQ(wear_leveling_write(i, &value, sizeof(value)), WEAR_LEVELING_SUCCESS) << "Write should not have consolidated in-line";
+    }
+
+    int steps = 0;
+    while (true) {
+        std::uint64_t writes       = inst.write_invoke_count();
+        std::uint64_t erase_ranges = inst.erase_range_invoke_count();
+
+        wear_leveling_status_t status = wear_leveling_task();
+        ++steps;
+
+        EXPECT_LE(inst.erase_range_invoke_count() - erase_ranges, 1) << "Each step should erase at most once";
+        EXPECT_LE(inst.write_invoke_count() - writes, ((WEAR_LEVELING_CONSOLIDATION_STEP_SIZE) + sizeof(write_log_entry_t)) / (BACKING_STORE_WRITE_SIZE)) << "Each step should write a bounded amount of data";
+        EXPECT_TRUE(inst.is_locked()) << "Backing store should be locked between steps";
+
+        if (status != WEAR_LEVELING_SUCCESS) {
+            EXPECT_EQ(status, WEAR_LEVELING_CONSOLIDATED) << "Background consolidation should have completed";
+            break;
+        }
+        ASSERT_LT(steps, 1000) << "Background consolidation did not complete";
+    }
+
+    EXPECT_GT(steps, 1) << "Consolidation should have been split into multiple steps";
+    EXPECT_EQ(inst.erase_invoke_count(), 0) << "The entire backing store should not have been erased";
+    EXPECT_EQ(wear_leveling_task(), WEAR_LEVELING_SUCCESS) << "No further consolidation should be pending";
+
+    // Verify the data survives a restart
+    logical_data_t readback;
+    EXPECT_EQ(wear_leveling_init(), WEAR_LEVELING_SUCCESS) << "Init returned incorrect status";
+    EXPECT_EQ(wear_leveling_read(0, readback.data(), readback.size()), WEAR_LEVELING_SUCCESS) << "Failed to read";
+    for (int i = 0; i < WEAR_LEVELING_LOGICAL_SIZE; ++i) {
+        EXPECT_EQ(readback[i], i < (WEAR_LEVELING_CONSOLIDATION_THRESHOLD) / (BACKING_STORE_WRITE_SIZE) ? i + 0x20 : 0) << "Invalid readback";
+    }
+}
+
+/**
+ * This test verifies that writes made while background consolidation is in progress are readable immediately, and are replayed into the new bank.
+ */
+TEST_F(WearLevelingBackground, WritesDuringConsolidation_Preserved) {
+    logical_data_t expected;
+    expected.fill(0);
+
+    for (int i = 0; i < 64; ++i) {
+        std::uint32_t address = (i * 5) % WEAR_LEVELING_LOGICAL_SIZE;
+        std::uint8_t  value   = (std::uint8_t)(i + 0x40);
+        expected[address]     = value;
+        EXPECT_NE(wear_leveling_write(address, &value, sizeof(value)), WEAR_LEVELING_FAILED) << "Write failed";
+        EXPECT_NE(wear_leveling_task(), WEAR_LEVELING_FAILED) << "Background consolidation failed";
+
+        logical_data_t readback;
+        EXPECT_EQ(wear_leveling_read(0, readback.data(), readback.size()), WEAR_LEVELING_SUCCESS) << "Failed to read";
+        EXPECT_EQ(readback, expected) << "Cached data did not match while consolidating";
+    }
+
+    logical_data_t readback;
+    EXPECT_EQ(wear_leveling_init(), WEAR_LEVELING_SUCCESS) << "Init returned incorrect status";
+    EXPECT_EQ(wear_leveling_read(0, readback.data(), readback.size()), WEAR_LEVELING_SUCCESS) << "Failed to read";
+    EXPECT_EQ(readback, expected) << "Persisted data did not match";
+}
+
+/**
+ * This test verifies that multi-byte writes made while background consolidation is in progress, including ones spanning several write log entries, are readable immediately and persisted.
+ */
+TEST_F(WearLevelingBackground, MultiByteWritesDuringConsolidation_Preserved) {
+    logical_data_t expected;
+    expected.fill(0);
+
+    for (int i = 0; i < 64; ++i) {
+        std::uint32_t address = (i * 5) % WEAR_LEVELING_LOGICAL_SIZE;
+        std::uint32_t length  = std::min<std::uint32_t>(1 + (i % 12), WEAR_LEVELING_LOGICAL_SIZE - address);
+        for (std::uint32_t j = 0; j < length; ++j) {
+            expected[address + j] = (std::uint8_t)(i * 3 + j);
+        }
+        EXPECT_NE(wear_leveling_write(address, &expected[address], length), WEAR_LEVELING_FAILED) << "Write failed";
+        EXPECT_NE(wear_leveling_task(), WEAR_LEVELING_FAILED) << "Background consolidation failed";
+
+        logical_data_t readback;
+        EXPECT_EQ(wear_leveling_read(0, readback.data(), readback.size()), WEAR_LEVELING_SUCCESS) << "Failed to read";
+        EXPECT_EQ(readback, expected) << "Cached data did not match while consolidating";
+    }
+
+    logical_data_t readback;
+    EXPECT_EQ(wear_leveling_init(), WEAR_LEVELING_SUCCESS) << "Init returned incorrect status";
+    EXPECT_EQ(wear_leveling_read(0, readback.data(), readback.size()), WEAR_LEVELING_SUCCESS) << "Failed to read";
+    EXPECT_EQ(readback, expected) << "Persisted data did not match";
+}
+
+/**
+ * This test verifies that a write to data which has already been copied to the inactive bank is replayed into the inactive bank's write log.
+ */
+TEST_F(WearLevelingBackground, WriteToCopiedData_Replayed) {
+    for (int i = 0; i < (WEAR_LEVELING_CONSOLIDATION_THRESHOLD) / (BACKING_STORE_WRITE_SIZE); ++i) {
+        std::uint8_t value = (std::uint8_t)(i + 0x20);
+        EXPECT_EQ(wear_leveling_write(i, &value, sizeof(value)), WEAR_LEVELING_SUCCESS) << "Write failed";
+    }
+
+    // Erase the inactive bank, then copy the first chunk of data
+    for (int i = 0; i < (WEAR_LEVELING_BANK_SIZE) / (WEAR_LEVELING_ERASE_STEP_SIZE) + 1; ++i) {
+        EXPECT_EQ(wear_leveling_task(), WEAR_LEVELING_SUCCESS) << "Background consolidation step failed";
+    }
+
+    std::uint8_t value = 0x99;
+    EXPECT_EQ(wear_leveling_write(0, &value, sizeof(value)), WEAR_LEVELING_SUCCESS) << "Write failed";
+    run_background_consolidation();
+
+    value = 0;
+    EXPECT_EQ(wear_leveling_init(), WEAR_LEVELING_SUCCESS) << "Init returned incorrect status";
+    EXPECT_EQ(wear_leveling_read(0, &value, sizeof(value)), WEAR_LEVELING_SUCCESS) << "Failed to read";
+    EXPECT_EQ(value, 0x99) << "Write made during consolidation was lost";
+}
+
+/**
+ * This test verifies that if the write log fills up without any background steps, consolidation completes in-line without erasing the entire backing store, including for multi-byte writes spanning the bank switch.
+ */
+TEST_F(WearLevelingBackground, LogFull_ConsolidatesInline) {
+    auto& inst = MockBackingStore::Instance();
+
+    logical_data_t testvalue;
+    bool           consolidated = false;
+    for (int i = 0; i < 8; ++i) {
+        std::iota(testvalue.begin(), testvalue.end(), (std::uint8_t)(i * 0x20));
+        wear_leveling_status_t status = wear_leveling_write(0, testvalue.data(), testvalue.size());
+        EXPECT_NE(status, WEAR_LEVELING_FAILED) << "Write failed";
+        consolidated |= (status == WEAR_LEVELING_CONSOLIDATED);
+
+        logical_data_t readback;
+        EXPECT_EQ(wear_leveling_init(), WEAR_LEVELING_SUCCESS) << "Init returned incorrect status";
+        EXPECT_EQ(wear_leveling_read(0, readback.data(), readback.size()), WEAR_LEVELING_SUCCESS) << "Failed to read";
+        EXPECT_EQ(readback, testvalue) << "Persisted data did not match";
+    }
+
+    EXPECT_TRUE(consolidated) << "Consolidation should have occurred";
+    EXPECT_EQ(inst.erase_invoke_count(), 0) << "The entire backing store should not have been erased";
+}
+
+/**
+ * This test verifies that the background consolidation completes after resuming from a restart part-way through.
+ */
+TEST_F(WearLevelingBackground, RestartDuringConsolidation_Resumes) {
+    logical_data_t expected;
+    expected.fill(0);
+    for (int i = 0; i < (WEAR_LEVELING_CONSOLIDATION_THRESHOLD) / (BACKING_STORE_WRITE_SIZE); ++i) {
+        std::uint8_t value = (std::uint8_t)(i + 0x60);
+        expected[i]        = value;
+        EXPECT_EQ(wear_leveling_write(i, &value, sizeof(value)), WEAR_LEVELING_SUCCESS) << "Write failed";
+    }
+
+    // Only perform some of the steps before "restarting"
+    EXPECT_EQ(wear_leveling_task(), WEAR_LEVELING_SUCCESS) << "Background consolidation step failed";
+    EXPECT_EQ(wear_leveling_task(), WEAR_LEVELING_SUCCESS) << "Background consolidation step failed";
+
+    logical_data_t readback;
+    EXPECT_EQ(wear_leveling_init(), WEAR_LEVELING_SUCCESS) << "Init returned incorrect status";
+    EXPECT_EQ(wear_leveling_read(0, readback.data(), readback.size()), WEAR_LEVELING_SUCCESS) << "Failed to read";
+    EXPECT_EQ(readback, expected) << "Persisted data did not match";
+
+    // Consolidation restarts from the beginning, as the log is still over the threshold
+    run_background_consolidation();
+    EXPECT_EQ(wear_leveling_init(), WEAR_LEVELING_SUCCESS) << "Init returned incorrect status";
+    EXPECT_EQ(wear_leveling_read(0, readback.data(), readback.size()), WEAR_LEVELING_SUCCESS) << "Failed to read";
+    EXPECT_EQ(readback, expected) << "Persisted data did not match";
+}
+
+/**
+ * Cuts the power at every erase/write operation of a workload including background and in-line consolidations, checking that previously-written data is never lost.
+ */
+static void run_power_loss_workloads(std::uint32_t max_length) {
+    auto& inst = MockBackingStore::Instance();
+
+    // Work out the total number of operations of a workload without any power loss
+    logical_data_t committed, pending;
+    run_workload(committed, pending, max_length);
+    const std::uint64_t total_operations = inst.write_invoke_count() + inst.erase_invoke_count() + inst.erase_range_invoke_count();
+    EXPECT_GT(inst.erase_range_invoke_count(), 0) << "Workload should have triggered consolidation";
+
+    for (std::uint64_t n = 0; n <= total_operations; ++n) {
+        inst.reset_instance();
+        EXPECT_EQ(wear_leveling_init(), WEAR_LEVELING_SUCCESS) << "Init returned incorrect status";
+
+        inst.set_power_loss_after(n);
+        run_workload(committed, pending, max_length);
+        inst.restore_power();
+
+        logical_data_t readback;
+        EXPECT_NE(wear_leveling_init(), WEAR_LEVELING_FAILED) << "Init failed after power loss at operation " << n;
+        EXPECT_EQ(wear_leveling_read(0, readback.data(), readback.size()), WEAR_LEVELING_SUCCESS) << "Failed to read";
+        EXPECT_TRUE(readback == committed || readback == pending || max_length > 1) << "Data was lost after power loss at operation " << n;
+        // A multi-byte write can be logged as several backing store writes, so only the data outside of the interrupted write is guaranteed to be intact
+        for (std::uint32_t i = 0; i < WEAR_LEVELING_LOGICAL_SIZE; ++i) {
+            if (i < last_write_address || i >= last_write_address + last_write_length) {
+                EXPECT_EQ(readback[i], committed[i]) << "Data was lost at offset " << i << " after power loss at operation " << n;
+            }
+        }
+
+        // Make sure everything continues to work after recovery
+        logical_data_t testvalue;
+        for (int i = 0; i < 4; ++i) {
+            std::iota(testvalue.begin(), testvalue.end(), (std::uint8_t)(n + i * 0x40));
+            EXPECT_NE(wear_leveling_write(0, testvalue.data(), testvalue.size()), WEAR_LEVELING_FAILED) << "Write failed after power loss at operation " << n;
+            EXPECT_NE(wear_leveling_task(), WEAR_LEVELING_FAILED) << "Background consolidation failed after power loss at operation " << n;
+        }
+        EXPECT_NE(wear_leveling_init(), WEAR_LEVELING_FAILED) << "Init failed";
+        EXPECT_EQ(wear_leveling_read(0, readback.data(), readback.size()), WEAR_LEVELING_SUCCESS) << "Failed to read";
+        EXPECT_EQ(readback, testvalue) << "Data mismatch after recovering from power loss at operation " << n;
+    }
+}
+
+/**
+ * This test verifies that a power loss at any erase/write operation during a workload of single-byte writes never loses previously-written data.
+ */
+TEST_F(WearLevelingBackground, PowerLossAtEveryStep_Recovers) {
+    run_power_loss_workloads(1);
+}
+
+/**
+ * This test verifies that a power loss at any erase/write operation during a workload of multi-byte writes never loses previously-written data.
+ */
+TEST_F(WearLevelingBackground, PowerLossAtEveryStep_MultiByte_Recovers) {
+    run_power_loss_workloads(12);
+}
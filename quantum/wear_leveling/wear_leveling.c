@@ -153,7 +153,80 @@
         ║  │Address >> 1 ║
         ║  └── Value: 1  ║
         ╚════════════════╝
-        0 <= Address <= 0x3FFE (16382) */
+        0 <= Address <= 0x3FFE (16382)
+
+    Log compression:
+
+        Enabled with WEAR_LEVELING_LOG_COMPRESSION. Bulk writes, such as a VIA
+        keymap upload, would otherwise use one log entry per 5 bytes of data
+        (or fewer), filling the write log after a few hundred bytes.
+
+        Only the modified spans of a write are logged. Each span is then split
+        into runs, and any run of at least WEAR_LEVELING_LOG_COMPRESSION_MIN_LENGTH
+        bytes is encoded using a single extended log entry:
+
+        ╔ Extended Log Entry (2, 4, 8-byte) ════════════════════════════════════╗
+        ║11SSSYYY║YYYYYYYY║YYYYYYYY║LLLLLLLL║LLLLLLLL║AAAAAAAA║BBBBBBBB║CCCCCCCC║
+        ║  └┬┘└┬┘║└──┬───┘║└──┬───┘║└──┬───┘║└──┬───┘║└──┬───┘║└──┬───┘║└──┬───┘║
+        ║  SubAdd║ Address║ Address║ Length ║ Length ║Value[0]║Value[1]║Value[2]║
+        ╚════════╩════════╩════════╩════════╩════════╩════════╩════════╩════════╝
+
+        Subtypes:
+            * Range: the first 3 bytes are stored in the entry itself, with the
+                remaining (Length-3) bytes following in subsequent backing store
+                writes, padded with zeros to the write size.
+            * Fill: Value[0] and Value[1] are repeated for Length bytes.
+            * Restore: the bytes are copied from the consolidated data, i.e. an
+                all-zero XOR delta against the consolidated data. Only emitted
+                while the write log isn't being copied by background
+                consolidation, as the destination bank's consolidated data
+                differs.
+
+        Logs written without compression are played back unchanged, and
+        extended entries are always understood during playback.
+
+    Background consolidation:
+
+        Enabled with WEAR_LEVELING_BACKGROUND_CONSOLIDATION. Erasing the whole
+        backing store and rewriting the consolidated data in one go can block
+        for tens of milliseconds on MCU flash, so instead the backing store is
+        split into two equally-sized banks, each laid out as above:
+
+        ╔ Bank ═══════════════════════════════════════════════════════════╗
+        ║ Consolidated data │ FNV1a_64 │ Generation │ Write log ...       ║
+        ║  (logical size)   │ 8 bytes  │  8 bytes   │                     ║
+        ╚═════════════════════════════════════════════════════════════════╝
+
+        The FNV1a_64 covers the consolidated data followed by the 32-bit
+        generation counter, and is written last -- a bank is only considered
+        valid once its checksum matches. On startup the valid bank with the
+        newest generation is used.
+
+        Once the active bank's write log passes
+        WEAR_LEVELING_CONSOLIDATION_THRESHOLD bytes, consolidation into the
+        inactive bank is performed in small steps by wear_leveling_task():
+            * The inactive bank is erased, WEAR_LEVELING_ERASE_STEP_SIZE bytes
+                at a time.
+            * The cache is copied to the inactive bank's consolidated area,
+                WEAR_LEVELING_CONSOLIDATION_STEP_SIZE bytes at a time, followed
+                by the incremented generation counter.
+            * Write log entries appended to the active bank since the copy
+                started are copied verbatim to the inactive bank's write log,
+                so that any cache changes made mid-copy are replayed.
+            * The checksum is written, committing the inactive bank as the new
+                active bank.
+
+        Writes keep being appended to the active bank's write log throughout,
+        and reads are served from the cache. If the active bank fills up before
+        background consolidation completes, the remaining steps are executed
+        in-line. A power loss at any point leaves the previous bank intact. */
+
+#ifdef WEAR_LEVELING_BACKGROUND_CONSOLIDATION
+/**
+ * Background consolidation progress.
+ */
+typedef enum consolidation_state_t { CONSOLIDATION_IDLE = 0, CONSOLIDATION_ERASING, CONSOLIDATION_COPYING_DATA, CONSOLIDATION_COPYING_LOG } consolidation_state_t;
+#endif // WEAR_LEVELING_BACKGROUND_CONSOLIDATION
 
 /**
  * Storage area for the wear-leveling cache.
@@ -162,8 +235,25 @@ static struct __attribute__((__aligned__(BACKING_STORE_WRITE_SIZE))) {
     __attribute__((__aligned__(BACKING_STORE_WRITE_SIZE))) uint8_t cache[(WEAR_LEVELING_LOGICAL_SIZE)];
     uint32_t                                                       write_address;
     bool                                                           unlocked;
+#ifdef WEAR_LEVELING_BACKGROUND_CONSOLIDATION
+    uint32_t bank_address; // Start of the active bank
+    uint32_t generation;   // Generation counter of the active bank
+    struct {
+        consolidation_state_t state;
+        uint32_t              target;      // Start of the bank being consolidated into
+        uint32_t              offset;      // Progress within the current step
+        uint32_t              log_address; // Next write location in the target bank's write log
+        uint64_t              checksum;    // Running FNV1a_64 of the data copied so far
+    } consolidation;
+#endif // WEAR_LEVELING_BACKGROUND_CONSOLIDATION
 } wear_leveling;
 
+#ifdef WEAR_LEVELING_BACKGROUND_CONSOLIDATION
+#    define ACTIVE_BANK_ADDRESS (wear_leveling.bank_address)
+#else
+#    define ACTIVE_BANK_ADDRESS 0
+#endif // WEAR_LEVELING_BACKGROUND_CONSOLIDATION
+
 /**
  * Locking helper: status
  */
@@ -202,38 +292,71 @@ static inline backing_store_lock_status_t wear_leveling_lock(void) {
  */
 static void wear_leveling_clear_cache(void) {
     memset(wear_leveling.cache, 0, (WEAR_LEVELING_LOGICAL_SIZE));
-    wear_leveling.write_address = (WEAR_LEVELING_LOGICAL_SIZE) + 8; // +8 is due to the FNV1a_64 of the consolidated buffer
+    wear_leveling.write_address = ACTIVE_BANK_ADDRESS + (WEAR_LEVELING_LOG_START);
 }
 
 /**
- * Reads the consolidated data from the backing store into the cache.
- * Does not consider the write log.
+ * Reads an 8-byte entry, such as a checksum, from the backing store.
  */
-static wear_leveling_status_t wear_leveling_read_consolidated(void) {
-    wl_dprintf("Reading consolidated data\n");
+static bool wear_leveling_read_entry(uint32_t address, write_log_entry_t *entry) {
+#if BACKING_STORE_WRITE_SIZE == 2
+    return backing_store_read_bulk(address, entry->raw16, 4);
+#elif BACKING_STORE_WRITE_SIZE == 4
+    return backing_store_read_bulk(address, entry->raw32, 2);
+#elif BACKING_STORE_WRITE_SIZE == 8
+    return backing_store_read(address, &entry->raw64);
+#endif
+}
+
+/**
+ * Writes an 8-byte entry, such as a checksum, to the backing store.
+ */
+static bool wear_leveling_write_entry(uint32_t address, write_log_entry_t *entry) {
+#if BACKING_STORE_WRITE_SIZE == 2
+    return backing_store_write_bulk(address, entry->raw16, 4);
+#elif BACKING_STORE_WRITE_SIZE == 4
+    return backing_store_write_bulk(address, entry->raw32, 2);
+#elif BACKING_STORE_WRITE_SIZE == 8
+    return backing_store_write(address, entry->raw64);
+#endif
+}
+
+/**
+ * Calculates the checksum stored alongside the consolidated data, based off the current cache.
+ */
+static uint64_t wear_leveling_checksum(void) {
+    uint64_t checksum = fnv_64a_buf(wear_leveling.cache, (WEAR_LEVELING_LOGICAL_SIZE), FNV1A_64_INIT);
+#ifdef WEAR_LEVELING_BACKGROUND_CONSOLIDATION
+    checksum = fnv_64a_buf(&wear_leveling.generation, sizeof(wear_leveling.generation), checksum);
+#endif // WEAR_LEVELING_BACKGROUND_CONSOLIDATION
+    return checksum;
+}
 
+/**
+ * Reads the consolidated data of the active bank from the backing store into the cache.
+ * Does not consider the write log.
+ *
+ * @param valid[out] whether the checksum of the consolidated data matched
+ */
+static wear_leveling_status_t wear_leveling_read_consolidated_bank(bool *valid) {
     wear_leveling_status_t status = WEAR_LEVELING_SUCCESS;
-    if (!backing_store_read_bulk(0, (backing_store_int_t *)wear_leveling.cache, sizeof(wear_leveling.cache) / sizeof(backing_store_int_t))) {
+    *valid                        = false;
+    if (!backing_store_read_bulk(ACTIVE_BANK_ADDRESS, (backing_store_int_t *)wear_leveling.cache, sizeof(wear_leveling.cache) / sizeof(backing_store_int_t))) {
         wl_dprintf("Failed to read from backing store\n");
         status = WEAR_LEVELING_FAILED;
     }
 
     // Verify the FNV1a_64 result
     if (status != WEAR_LEVELING_FAILED) {
-        uint64_t          expected = fnv_64a_buf(wear_leveling.cache, (WEAR_LEVELING_LOGICAL_SIZE), FNV1A_64_INIT);
+        uint64_t          expected = wear_leveling_checksum();
         write_log_entry_t entry;
         wl_dprintf("Reading checksum\n");
-#if BACKING_STORE_WRITE_SIZE == 2
-        backing_store_read_bulk((WEAR_LEVELING_LOGICAL_SIZE), entry.raw16, 4);
-#elif BACKING_STORE_WRITE_SIZE == 4
-        backing_store_read_bulk((WEAR_LEVELING_LOGICAL_SIZE), entry.raw32, 2);
-#elif BACKING_STORE_WRITE_SIZE == 8
-        backing_store_read((WEAR_LEVELING_LOGICAL_SIZE) + 0, &entry.raw64);
-#endif
+        wear_leveling_read_entry(ACTIVE_BANK_ADDRESS + (WEAR_LEVELING_LOGICAL_SIZE), &entry);
         // If we have a mismatch, clear the cache but do not flag a failure,
         // which will cater for the completely clean MCU case.
         if (entry.raw64 == expected) {
             wl_dprintf("Checksum matches, consolidated data is correct\n");
+            *valid = true;
         } else {
             wl_dprintf("Checksum mismatch, clearing cache\n");
             wear_leveling_clear_cache();
@@ -249,7 +372,43 @@ static wear_leveling_status_t wear_leveling_read_consolidated(void) {
 }
 
 /**
- * Writes the current cache to consolidated data at the beginning of the backing store.
+ * Reads the consolidated data from the backing store into the cache.
+ * Does not consider the write log.
+ */
+static wear_leveling_status_t wear_leveling_read_consolidated(void) {
+    wl_dprintf("Reading consolidated data\n");
+
+    bool valid;
+#ifdef WEAR_LEVELING_BACKGROUND_CONSOLIDATION
+    // Try the bank with the newest generation first, falling back to the other bank if its checksum doesn't match
+    write_log_entry_t generations[2];
+    wear_leveling_read_entry((WEAR_LEVELING_LOGICAL_SIZE) + 8, &generations[0]);
+    wear_leveling_read_entry((WEAR_LEVELING_BANK_SIZE) + (WEAR_LEVELING_LOGICAL_SIZE) + 8, &generations[1]);
+    const int newest = ((int32_t)(generations[1].raw32[0] - generations[0].raw32[0]) > 0) ? 1 : 0;
+    for (int i = 0; i < 2; ++i) {
+        const int bank             = (newest + i) % 2;
+        wear_leveling.bank_address = bank * (WEAR_LEVELING_BANK_SIZE);
+        wear_leveling.generation   = generations[bank].raw32[0];
+        wl_dprintf("Trying bank %d, generation %lu\n", bank, (unsigned long)wear_leveling.generation);
+
+        wear_leveling_status_t status = wear_leveling_read_consolidated_bank(&valid);
+        if (status == WEAR_LEVELING_FAILED || valid) {
+            return status;
+        }
+    }
+
+    // Neither bank has valid consolidated data, so start from scratch with the first bank
+    wear_leveling.bank_address = 0;
+    wear_leveling.generation   = 0;
+    wear_leveling_clear_cache();
+    return WEAR_LEVELING_SUCCESS;
+#else
+    return wear_leveling_read_consolidated_bank(&valid);
+#endif // WEAR_LEVELING_BACKGROUND_CONSOLIDATION
+}
+
+/**
+ * Writes the current cache to consolidated data at the beginning of the active bank.
  * Does not clear the write log.
  * Pre-condition: this is just after an erase, so we can write directly without reading.
  */
@@ -258,41 +417,173 @@ static wear_leveling_status_t wear_leveling_write_consolidated(void) {
 
     backing_store_lock_status_t lock_status = wear_leveling_unlock();
     wear_leveling_status_t      status      = WEAR_LEVELING_CONSOLIDATED;
-    if (!backing_store_write_bulk(0, (backing_store_int_t *)wear_leveling.cache, sizeof(wear_leveling.cache) / sizeof(backing_store_int_t))) {
+    if (!backing_store_write_bulk(ACTIVE_BANK_ADDRESS, (backing_store_int_t *)wear_leveling.cache, sizeof(wear_leveling.cache) / sizeof(backing_store_int_t))) {
         wl_dprintf("Failed to write to backing store\n");
         status = WEAR_LEVELING_FAILED;
     }
 
+#ifdef WEAR_LEVELING_BACKGROUND_CONSOLIDATION
+    if (status != WEAR_LEVELING_FAILED) {
+        // Write out the generation counter, which is covered by the checksum
+        write_log_entry_t entry = {.raw64 = 0};
+        entry.raw32[0]          = wear_leveling.generation;
+        wl_dprintf("Writing generation\n");
+        if (!wear_leveling_write_entry(ACTIVE_BANK_ADDRESS + (WEAR_LEVELING_LOGICAL_SIZE) + 8, &entry)) {
+            status = WEAR_LEVELING_FAILED;
+        }
+    }
+#endif // WEAR_LEVELING_BACKGROUND_CONSOLIDATION
+
     if (status != WEAR_LEVELING_FAILED) {
         // Write out the FNV1a_64 result of the consolidated data
         write_log_entry_t entry;
-        entry.raw64 = fnv_64a_buf(wear_leveling.cache, (WEAR_LEVELING_LOGICAL_SIZE), FNV1A_64_INIT);
+        entry.raw64 = wear_leveling_checksum();
         wl_dprintf("Writing checksum\n");
-        do {
-#if BACKING_STORE_WRITE_SIZE == 2
-            if (!backing_store_write_bulk((WEAR_LEVELING_LOGICAL_SIZE), entry.raw16, 4)) {
-                status = WEAR_LEVELING_FAILED;
+        if (!wear_leveling_write_entry(ACTIVE_BANK_ADDRESS + (WEAR_LEVELING_LOGICAL_SIZE), &entry)) {
+            status = WEAR_LEVELING_FAILED;
+        }
+    }
+
+    if (lock_status == STATUS_SUCCESS) {
+        wear_leveling_lock();
+    }
+    return status;
+}
+
+#ifdef WEAR_LEVELING_BACKGROUND_CONSOLIDATION
+/**
+ * Starts a background consolidation into the inactive bank. No backing store operations occur until wear_leveling_consolidate_step().
+ */
+static void wear_leveling_consolidate_begin(void) {
+    wl_dprintf("Starting background consolidation\n");
+    wear_leveling.consolidation.state  = CONSOLIDATION_ERASING;
+    wear_leveling.consolidation.target = (ACTIVE_BANK_ADDRESS == 0) ? (WEAR_LEVELING_BANK_SIZE) : 0;
+    wear_leveling.consolidation.offset = 0;
+}
+
+/**
+ * Performs a single bounded step of background consolidation.
+ * Pre-condition: the backing store is unlocked.
+ *
+ * @return WEAR_LEVELING_SUCCESS if more steps are required, WEAR_LEVELING_CONSOLIDATED once the inactive bank has been committed
+ */
+static wear_leveling_status_t wear_leveling_consolidate_step(void) {
+    const uint32_t target = wear_leveling.consolidation.target;
+    switch (wear_leveling.consolidation.state) {
+        case CONSOLIDATION_ERASING: {
+            if (!backing_store_erase_range(target + wear_leveling.consolidation.offset, (WEAR_LEVELING_ERASE_STEP_SIZE))) {
+                wl_dprintf("Failed to erase backing store\n");
                 break;
             }
-#elif BACKING_STORE_WRITE_SIZE == 4
-            if (!backing_store_write_bulk((WEAR_LEVELING_LOGICAL_SIZE), entry.raw32, 2)) {
-                status = WEAR_LEVELING_FAILED;
+            wear_leveling.consolidation.offset += (WEAR_LEVELING_ERASE_STEP_SIZE);
+
+            if (wear_leveling.consolidation.offset >= (WEAR_LEVELING_BANK_SIZE)) {
+                wear_leveling.consolidation.state    = CONSOLIDATION_COPYING_DATA;
+                wear_leveling.consolidation.offset   = 0;
+                wear_leveling.consolidation.checksum = FNV1A_64_INIT;
+                // Anything appended to the active write log from here on needs to be replayed in the target bank
+                wear_leveling.consolidation.log_address = wear_leveling.write_address;
+            }
+            return WEAR_LEVELING_SUCCESS;
+        }
+
+        case CONSOLIDATION_COPYING_DATA: {
+            const uint32_t offset    = wear_leveling.consolidation.offset;
+            const uint32_t remaining = (WEAR_LEVELING_LOGICAL_SIZE) - offset;
+            const uint32_t length    = remaining < (WEAR_LEVELING_CONSOLIDATION_STEP_SIZE) ? remaining : (WEAR_LEVELING_CONSOLIDATION_STEP_SIZE);
+            if (!backing_store_write_bulk(target + offset, (backing_store_int_t *)&wear_leveling.cache[offset], length / (BACKING_STORE_WRITE_SIZE))) {
+                wl_dprintf("Failed to write to backing store\n");
                 break;
             }
-#elif BACKING_STORE_WRITE_SIZE == 8
-            if (!backing_store_write((WEAR_LEVELING_LOGICAL_SIZE), entry.raw64)) {
-                status = WEAR_LEVELING_FAILED;
+            wear_leveling.consolidation.checksum = fnv_64a_buf(&wear_leveling.cache[offset], length, wear_leveling.consolidation.checksum);
+            wear_leveling.consolidation.offset += length;
+
+            if (wear_leveling.consolidation.offset >= (WEAR_LEVELING_LOGICAL_SIZE)) {
+                // Write out the next generation counter -- the bank stays invalid until the checksum is written
+                uint32_t          generation = wear_leveling.generation + 1;
+                write_log_entry_t entry      = {.raw64 = 0};
+                entry.raw32[0]               = generation;
+                if (!wear_leveling_write_entry(target + (WEAR_LEVELING_LOGICAL_SIZE) + 8, &entry)) {
+                    wl_dprintf("Failed to write generation\n");
+                    break;
+                }
+                wear_leveling.consolidation.checksum = fnv_64a_buf(&generation, sizeof(generation), wear_leveling.consolidation.checksum);
+
+                // Swap the offset over to the source write log, keeping track of the destination separately
+                wear_leveling.consolidation.state       = CONSOLIDATION_COPYING_LOG;
+                wear_leveling.consolidation.offset      = wear_leveling.consolidation.log_address;
+                wear_leveling.consolidation.log_address = target + (WEAR_LEVELING_LOG_START);
+            }
+            return WEAR_LEVELING_SUCCESS;
+        }
+
+        case CONSOLIDATION_COPYING_LOG: {
+            const uint32_t remaining = wear_leveling.write_address - wear_leveling.consolidation.offset;
+            if (remaining > 0) {
+                backing_store_int_t values[(WEAR_LEVELING_CONSOLIDATION_STEP_SIZE) / (BACKING_STORE_WRITE_SIZE)];
+                const uint32_t      length = remaining < (WEAR_LEVELING_CONSOLIDATION_STEP_SIZE) ? remaining : (WEAR_LEVELING_CONSOLIDATION_STEP_SIZE);
+                if (!backing_store_read_bulk(wear_leveling.consolidation.offset, values, length / (BACKING_STORE_WRITE_SIZE))) {
+                    wl_dprintf("Failed to read from backing store\n");
+                    break;
+                }
+                if (!backing_store_write_bulk(wear_leveling.consolidation.log_address, values, length / (BACKING_STORE_WRITE_SIZE))) {
+                    wl_dprintf("Failed to write to backing store\n");
+                    break;
+                }
+                wear_leveling.consolidation.offset += length;
+                wear_leveling.consolidation.log_address += length;
+                return WEAR_LEVELING_SUCCESS;
+            }
+
+            // Write log is caught up, commit the target bank by writing the checksum
+            write_log_entry_t entry;
+            entry.raw64 = wear_leveling.consolidation.checksum;
+            if (!wear_leveling_write_entry(target + (WEAR_LEVELING_LOGICAL_SIZE), &entry)) {
+                wl_dprintf("Failed to write checksum\n");
                 break;
             }
-#endif
-        } while (0);
+
+            wl_dprintf("Background consolidation complete\n");
+            wear_leveling.bank_address        = target;
+            wear_leveling.generation          = wear_leveling.generation + 1;
+            wear_leveling.write_address       = wear_leveling.consolidation.log_address;
+            wear_leveling.consolidation.state = CONSOLIDATION_IDLE;
+            return WEAR_LEVELING_CONSOLIDATED;
+        }
+
+        default:
+            return WEAR_LEVELING_SUCCESS;
+    }
+
+    // Something failed -- abandon this attempt, the inactive bank is erased again on the next one
+    wear_leveling.consolidation.state = CONSOLIDATION_IDLE;
+    return WEAR_LEVELING_FAILED;
+}
+
+/**
+ * Runs any remaining background consolidation steps in-line, starting a new consolidation if none is in progress.
+ */
+static wear_leveling_status_t wear_leveling_consolidate_finish(void) {
+    if (wear_leveling.consolidation.state == CONSOLIDATION_IDLE) {
+        wear_leveling_consolidate_begin();
+    }
+
+    backing_store_lock_status_t lock_status = wear_leveling_unlock();
+    if (lock_status == STATUS_FAILURE) {
+        return WEAR_LEVELING_FAILED;
     }
 
+    wear_leveling_status_t status;
+    do {
+        status = wear_leveling_consolidate_step();
+    } while (status == WEAR_LEVELING_SUCCESS);
+
     if (lock_status == STATUS_SUCCESS) {
         wear_leveling_lock();
     }
     return status;
 }
+#endif // WEAR_LEVELING_BACKGROUND_CONSOLIDATION
 
 /**
  * Forces a write of the current cache.
@@ -300,6 +591,18 @@ static wear_leveling_status_t wear_leveling_write_consolidated(void) {
  * During this operation, there is the potential for data loss if a power loss occurs.
  */
 static wear_leveling_status_t wear_leveling_consolidate_force(void) {
+#ifdef WEAR_LEVELING_BACKGROUND_CONSOLIDATION
+    // Prefer consolidating into the inactive bank, which is safe against power loss
+    if (wear_leveling_consolidate_finish() == WEAR_LEVELING_CONSOLIDATED) {
+        return WEAR_LEVELING_CONSOLIDATED;
+    }
+
+    // Otherwise fall back to erasing everything and starting again from the first bank
+    wear_leveling.consolidation.state = CONSOLIDATION_IDLE;
+    wear_leveling.bank_address        = 0;
+    wear_leveling.generation          = wear_leveling.generation + 1;
+#endif // WEAR_LEVELING_BACKGROUND_CONSOLIDATION
+
     wl_dprintf("Erasing backing store\n");
 
     // Erase the backing store. Expectation is that any un-written values that are read back after this call come back as zero.
@@ -316,7 +619,7 @@ static wear_leveling_status_t wear_leveling_consolidate_force(void) {
     }
 
     // Next write of the log occurs after the consolidated values at the start of the backing store.
-    wear_leveling.write_address = (WEAR_LEVELING_LOGICAL_SIZE) + 8; // +8 due to the FNV1a_64 of the consolidated area
+    wear_leveling.write_address = ACTIVE_BANK_ADDRESS + (WEAR_LEVELING_LOG_START);
 
     return status;
 }
@@ -329,9 +632,20 @@ static wear_leveling_status_t wear_leveling_consolidate_force(void) {
  * @return true if consolidation occurred
  */
 static wear_leveling_status_t wear_leveling_consolidate_if_needed(void) {
+#ifdef WEAR_LEVELING_BACKGROUND_CONSOLIDATION
+    // Space for the largest possible log entry is kept free, so that entries never straddle the end of the active bank
+    if (wear_leveling.write_address + sizeof(write_log_entry_t) > ACTIVE_BANK_ADDRESS + (WEAR_LEVELING_BANK_SIZE)) {
+        return wear_leveling_consolidate_force();
+    }
+
+    if (wear_leveling.consolidation.state == CONSOLIDATION_IDLE && wear_leveling.write_address >= ACTIVE_BANK_ADDRESS + (WEAR_LEVELING_LOG_START) + (WEAR_LEVELING_CONSOLIDATION_THRESHOLD)) {
+        wear_leveling_consolidate_begin();
+    }
+#else
     if (wear_leveling.write_address >= (WEAR_LEVELING_BACKING_SIZE)) {
         return wear_leveling_consolidate_force();
     }
+#endif // WEAR_LEVELING_BACKGROUND_CONSOLIDATION
 
     return WEAR_LEVELING_SUCCESS;
 }
@@ -348,7 +662,12 @@ static wear_leveling_status_t wear_leveling_append_raw(backing_store_int_t value
         return WEAR_LEVELING_FAILED;
     }
     wear_leveling.write_address += (BACKING_STORE_WRITE_SIZE);
+#ifdef WEAR_LEVELING_BACKGROUND_CONSOLIDATION
+    // Space for the whole entry has already been checked by wear_leveling_write_raw()
+    return WEAR_LEVELING_SUCCESS;
+#else
     return wear_leveling_consolidate_if_needed();
+#endif // WEAR_LEVELING_BACKGROUND_CONSOLIDATION
 }
 
 /**
@@ -410,6 +729,125 @@ static wear_leveling_status_t wear_leveling_write_raw_multibyte(uint32_t address
     return status;
 }
 
+/**
+ * Reads a single byte of the active bank's consolidated data from the backing store.
+ */
+static bool wear_leveling_read_consolidated_byte(uint32_t address, uint8_t *value) {
+    const uint32_t      offset = address % (BACKING_STORE_WRITE_SIZE);
+    backing_store_int_t word;
+    if (!backing_store_read(ACTIVE_BANK_ADDRESS + address - offset, &word)) {
+        return false;
+    }
+    *value = ((const uint8_t *)&word)[offset];
+    return true;
+}
+
+#ifdef WEAR_LEVELING_LOG_COMPRESSION
+/**
+ * Determines how many leading bytes of the supplied data match the consolidated data.
+ */
+static size_t wear_leveling_restore_run_length(uint32_t address, const uint8_t *p, size_t length) {
+#    ifdef WEAR_LEVELING_BACKGROUND_CONSOLIDATION
+    // Entries appended once the data copy has started get replayed against the target bank's consolidated data instead
+    if (wear_leveling.consolidation.state != CONSOLIDATION_IDLE && wear_leveling.consolidation.state != CONSOLIDATION_ERASING) {
+        return 0;
+    }
+#    endif // WEAR_LEVELING_BACKGROUND_CONSOLIDATION
+    size_t run = 0;
+    while (run < length) {
+        uint8_t v;
+        if (!wear_leveling_read_consolidated_byte(address + run, &v) || v != p[run]) {
+            break;
+        }
+        ++run;
+    }
+    return run;
+}
+
+/**
+ * Determines how many leading bytes of the supplied data repeat the first 2-byte pattern.
+ */
+static size_t wear_leveling_fill_run_length(const uint8_t *p, size_t length) {
+    size_t run = length < 2 ? length : 2;
+    while (run < length && p[run] == p[run % 2]) {
+        ++run;
+    }
+    return run;
+}
+
+/**
+ * Handles writing extended-encoded data to the backing store, covering as many leading bytes of the data as is worthwhile.
+ *
+ * @param consumed[out] the number of bytes covered by the log entry, or zero if the regular encodings are more compact
+ * @return true if consolidation occurred
+ */
+static wear_leveling_status_t wear_leveling_write_raw_extended(uint32_t address, const uint8_t *p, size_t length, size_t *consumed) {
+    const size_t limit = length > LOG_ENTRY_EXTENDED_MAX_LENGTH ? LOG_ENTRY_EXTENDED_MAX_LENGTH : length;
+    *consumed          = 0;
+    if (limit < (WEAR_LEVELING_LOG_COMPRESSION_MIN_LENGTH)) {
+        return WEAR_LEVELING_SUCCESS;
+    }
+
+    uint8_t subtype;
+    size_t  run = wear_leveling_restore_run_length(address, p, limit);
+    if (run >= (WEAR_LEVELING_LOG_COMPRESSION_MIN_LENGTH)) {
+        subtype = LOG_ENTRY_EXTENDED_RESTORE;
+    } else if ((run = wear_leveling_fill_run_length(p, limit)) >= (WEAR_LEVELING_LOG_COMPRESSION_MIN_LENGTH)) {
+        subtype = LOG_ENTRY_EXTENDED_FILL;
+    } else {
+        // Literal bytes, up until the next run which can be encoded more compactly
+        subtype = LOG_ENTRY_EXTENDED_RANGE;
+        run     = 1;
+        while (run < limit && wear_leveling_restore_run_length(address + run, p + run, limit - run) < (WEAR_LEVELING_LOG_COMPRESSION_MIN_LENGTH) && wear_leveling_fill_run_length(p + run, limit - run) < (WEAR_LEVELING_LOG_COMPRESSION_MIN_LENGTH)) {
+            ++run;
+        }
+#    ifdef WEAR_LEVELING_BACKGROUND_CONSOLIDATION
+        // Entries may not straddle the end of the active bank
+        const size_t available = ACTIVE_BANK_ADDRESS + (WEAR_LEVELING_BANK_SIZE) - wear_leveling.write_address - sizeof(write_log_entry_t);
+        const size_t max_run   = LOG_ENTRY_EXTENDED_HEADER_BYTES + (available / (BACKING_STORE_WRITE_SIZE)) * (BACKING_STORE_WRITE_SIZE);
+        if (run > max_run) {
+            run = max_run;
+        }
+#    endif // WEAR_LEVELING_BACKGROUND_CONSOLIDATION
+        if (run < (WEAR_LEVELING_LOG_COMPRESSION_MIN_LENGTH)) {
+            return WEAR_LEVELING_SUCCESS;
+        }
+    }
+
+    write_log_entry_t log = LOG_ENTRY_MAKE_EXTENDED(subtype, address, run);
+    if (subtype == LOG_ENTRY_EXTENDED_RANGE) {
+        memcpy(&log.raw8[5], p, LOG_ENTRY_EXTENDED_HEADER_BYTES);
+    } else if (subtype == LOG_ENTRY_EXTENDED_FILL) {
+        log.raw8[5] = p[0];
+        log.raw8[6] = p[1];
+    }
+    *consumed = run;
+
+    // Write to the backing store. See the extended log format in the documentation header at the top of the file.
+    wear_leveling_status_t status = WEAR_LEVELING_SUCCESS;
+    for (size_t i = 0; i < sizeof(log); i += (BACKING_STORE_WRITE_SIZE)) {
+        backing_store_int_t value;
+        memcpy(&value, &log.raw8[i], sizeof(value));
+        status = wear_leveling_append_raw(value);
+        if (status != WEAR_LEVELING_SUCCESS) {
+            return status;
+        }
+    }
+
+    if (subtype == LOG_ENTRY_EXTENDED_RANGE) {
+        for (size_t i = LOG_ENTRY_EXTENDED_HEADER_BYTES; i < run; i += (BACKING_STORE_WRITE_SIZE)) {
+            backing_store_int_t value = 0;
+            memcpy(&value, &p[i], (run - i) < sizeof(value) ? (run - i) : sizeof(value));
+            status = wear_leveling_append_raw(value);
+            if (status != WEAR_LEVELING_SUCCESS) {
+                return status;
+            }
+        }
+    }
+    return status;
+}
+#endif // WEAR_LEVELING_LOG_COMPRESSION
+
 /**
  * Handles the actual writing of logical data into the write log section of the backing store.
  */
@@ -417,7 +855,35 @@ static wear_leveling_status_t wear_leveling_write_raw(uint32_t address, const vo
     const uint8_t *        p         = value;
     size_t                 remaining = length;
     wear_leveling_status_t status    = WEAR_LEVELING_SUCCESS;
+#ifdef WEAR_LEVELING_BACKGROUND_CONSOLIDATION
+    bool consolidated = false;
+#endif // WEAR_LEVELING_BACKGROUND_CONSOLIDATION
     while (remaining > 0) {
+#ifdef WEAR_LEVELING_BACKGROUND_CONSOLIDATION
+        // Make sure the next entry fits in the active bank. Consolidation carries over the write log written so far, so
+        // unlike a full erase, the remaining entries still need to be appended to the new bank's write log.
+        status = wear_leveling_consolidate_if_needed();
+        if (status == WEAR_LEVELING_FAILED) {
+            return status;
+        }
+        consolidated |= (status == WEAR_LEVELING_CONSOLIDATED);
+#endif // WEAR_LEVELING_BACKGROUND_CONSOLIDATION
+#ifdef WEAR_LEVELING_LOG_COMPRESSION
+        // Runs of bytes are encoded using a single extended entry
+        size_t consumed;
+        status = wear_leveling_write_raw_extended(address, p, remaining, &consumed);
+        if (status != WEAR_LEVELING_SUCCESS) {
+            // If consolidation occurred, then the cache has already been written to the consolidated area. No need to continue.
+            // If a failure occurred, pass it on.
+            return status;
+        }
+        if (consumed > 0) {
+            remaining -= consumed;
+            address += (uint32_t)consumed;
+            p += consumed;
+            continue;
+        }
+#endif // WEAR_LEVELING_LOG_COMPRESSION
 #if BACKING_STORE_WRITE_SIZE == 2
         // Small-write optimizations - uint16_t, 0 or 1, address is even, address <16384:
         if (remaining >= 2 && address % 2 == 0 && address < 16384) {
@@ -466,9 +932,69 @@ static wear_leveling_status_t wear_leveling_write_raw(uint32_t address, const vo
         p += this_length;
     }
 
+#ifdef WEAR_LEVELING_BACKGROUND_CONSOLIDATION
+    if (consolidated) {
+        status = WEAR_LEVELING_CONSOLIDATED;
+    }
+#endif // WEAR_LEVELING_BACKGROUND_CONSOLIDATION
     return status;
 }
 
+/**
+ * "Replays" a single extended write log entry, whose first backing store write has already been read.
+ *
+ * @param address[in,out] the location of the remainder of the entry, updated to the location of the next entry
+ * @return false if the entry could not be played back
+ */
+static bool wear_leveling_playback_extended(write_log_entry_t *log, uint32_t *address) {
+    const uint32_t end = ACTIVE_BANK_ADDRESS + (WEAR_LEVELING_BANK_SIZE);
+#if BACKING_STORE_WRITE_SIZE != 8
+    const size_t header_remaining = sizeof(*log) - (BACKING_STORE_WRITE_SIZE);
+    if (*address + header_remaining > end || !backing_store_read_bulk(*address, (backing_store_int_t *)&log->raw8[BACKING_STORE_WRITE_SIZE], header_remaining / (BACKING_STORE_WRITE_SIZE))) {
+        wl_dprintf("Failed to load from backing store, skipping playback of write log\n");
+        return false;
+    }
+    *address += header_remaining;
+#endif // BACKING_STORE_WRITE_SIZE != 8
+
+    const uint32_t a = LOG_ENTRY_EXTENDED_GET_ADDRESS(*log);
+    const uint32_t l = LOG_ENTRY_EXTENDED_GET_LENGTH(*log);
+    if (a + l > (WEAR_LEVELING_LOGICAL_SIZE)) {
+        return false;
+    }
+
+    switch (LOG_ENTRY_EXTENDED_GET_SUBTYPE(*log)) {
+        case LOG_ENTRY_EXTENDED_RANGE: {
+            memcpy(&wear_leveling.cache[a], &log->raw8[5], l < LOG_ENTRY_EXTENDED_HEADER_BYTES ? l : LOG_ENTRY_EXTENDED_HEADER_BYTES);
+            for (uint32_t i = LOG_ENTRY_EXTENDED_HEADER_BYTES; i < l; i += (BACKING_STORE_WRITE_SIZE)) {
+                backing_store_int_t value;
+                if (*address + (BACKING_STORE_WRITE_SIZE) > end || !backing_store_read(*address, &value)) {
+                    wl_dprintf("Failed to load from backing store, skipping playback of write log\n");
+                    return false;
+                }
+                *address += (BACKING_STORE_WRITE_SIZE);
+                memcpy(&wear_leveling.cache[a + i], &value, (l - i) < sizeof(value) ? (l - i) : sizeof(value));
+            }
+        } break;
+        case LOG_ENTRY_EXTENDED_FILL: {
+            for (uint32_t i = 0; i < l; ++i) {
+                wear_leveling.cache[a + i] = log->raw8[5 + (i % 2)];
+            }
+        } break;
+        case LOG_ENTRY_EXTENDED_RESTORE: {
+            for (uint32_t i = 0; i < l; ++i) {
+                if (!wear_leveling_read_consolidated_byte(a + i, &wear_leveling.cache[a + i])) {
+                    wl_dprintf("Failed to load from backing store, skipping playback of write log\n");
+                    return false;
+                }
+            }
+        } break;
+        default:
+            return false;
+    }
+    return true;
+}
+
 /**
  * "Replays" the write log from the backing store, updating the local cache with updated values.
  */
@@ -477,8 +1003,8 @@ static wear_leveling_status_t wear_leveling_playback_log(void) {
 
     wear_leveling_status_t status          = WEAR_LEVELING_SUCCESS;
     bool                   cancel_playback = false;
-    uint32_t               address         = (WEAR_LEVELING_LOGICAL_SIZE) + 8; // +8 due to the FNV1a_64 of the consolidated area
-    while (!cancel_playback && address < (WEAR_LEVELING_BACKING_SIZE)) {
+    uint32_t               address         = ACTIVE_BANK_ADDRESS + (WEAR_LEVELING_LOG_START);
+    while (!cancel_playback && address < ACTIVE_BANK_ADDRESS + (WEAR_LEVELING_BANK_SIZE)) {
         backing_store_int_t value;
         bool                ok = backing_store_read(address, &value);
         if (!ok) {
@@ -590,6 +1116,12 @@ static wear_leveling_status_t wear_leveling_playback_log(void) {
                 wear_leveling.cache[a + 1] = 0;
             } break;
 #endif // BACKING_STORE_WRITE_SIZE == 2
+            case LOG_ENTRY_TYPE_EXTENDED: {
+                if (!wear_leveling_playback_extended(&log, &address)) {
+                    cancel_playback = true;
+                    status          = WEAR_LEVELING_FAILED;
+                }
+            } break;
             default: {
                 cancel_playback = true;
                 status          = WEAR_LEVELING_FAILED;
@@ -617,6 +1149,13 @@ static wear_leveling_status_t wear_leveling_playback_log(void) {
 wear_leveling_status_t wear_leveling_init(void) {
     wl_dprintf("Init\n");
 
+#ifdef WEAR_LEVELING_BACKGROUND_CONSOLIDATION
+    // Any in-progress consolidation is abandoned, the inactive bank is erased again on the next one
+    wear_leveling.consolidation.state = CONSOLIDATION_IDLE;
+    wear_leveling.bank_address        = 0;
+    wear_leveling.generation          = 0;
+#endif // WEAR_LEVELING_BACKGROUND_CONSOLIDATION
+
     // Reset the cache
     wear_leveling_clear_cache();
 
@@ -661,6 +1200,11 @@ wear_leveling_status_t wear_leveling_erase(void) {
 
     // Perform the erase
     bool ret = backing_store_erase();
+#ifdef WEAR_LEVELING_BACKGROUND_CONSOLIDATION
+    wear_leveling.consolidation.state = CONSOLIDATION_IDLE;
+    wear_leveling.bank_address        = 0;
+    wear_leveling.generation          = 0;
+#endif // WEAR_LEVELING_BACKGROUND_CONSOLIDATION
     wear_leveling_clear_cache();
 
     // Lock the backing store if we acquired the lock successfully
@@ -671,6 +1215,52 @@ wear_leveling_status_t wear_leveling_erase(void) {
     return ret ? WEAR_LEVELING_SUCCESS : WEAR_LEVELING_FAILED;
 }
 
+#ifdef WEAR_LEVELING_LOG_COMPRESSION
+/**
+ * Helper type used to describe a modified span of logical data.
+ */
+typedef struct wear_leveling_span_t {
+    uint32_t address;
+    uint32_t length;
+} wear_leveling_span_t;
+
+/**
+ * Determines which spans of the supplied data differ from the cache, ignoring unchanged gaps too short to be worth splitting on.
+ *
+ * @return the number of spans found
+ */
+static size_t wear_leveling_find_modified_spans(uint32_t address, const uint8_t *p, size_t length, wear_leveling_span_t *spans) {
+    size_t count = 0;
+    size_t i     = 0;
+    while (i < length) {
+        // Skip over unchanged data
+        while (i < length && p[i] == wear_leveling.cache[address + i]) {
+            ++i;
+        }
+        if (i == length) {
+            break;
+        }
+
+        // Extend the span until there's a long enough run of unchanged data
+        const size_t start = i;
+        size_t       end   = i + 1;
+        for (i = end; i < length && (i - end) < (WEAR_LEVELING_LOG_COMPRESSION_MIN_LENGTH); ++i) {
+            if (p[i] != wear_leveling.cache[address + i]) {
+                end = i + 1;
+            }
+        }
+
+        if (count < (WEAR_LEVELING_LOG_COMPRESSION_MAX_SPANS)) {
+            spans[count].address = address + (uint32_t)start;
+            ++count;
+        }
+        spans[count - 1].length = address + (uint32_t)end - spans[count - 1].address;
+        i                       = end;
+    }
+    return count;
+}
+#endif // WEAR_LEVELING_LOG_COMPRESSION
+
 /**
  * Writes logical data into the backing store. Skips writes if there are no changes to values.
  */
@@ -688,6 +1278,12 @@ wear_leveling_status_t wear_leveling_write(const uint32_t address, const void *v
         return true;
     }
 
+#ifdef WEAR_LEVELING_LOG_COMPRESSION
+    // Only the modified parts of the data need to be written to the log
+    wear_leveling_span_t spans[WEAR_LEVELING_LOG_COMPRESSION_MAX_SPANS];
+    const size_t         span_count = wear_leveling_find_modified_spans(address, value, length, spans);
+#endif // WEAR_LEVELING_LOG_COMPRESSION
+
     // Update the cache before writing to the backing store -- if we hit the end of the backing store during writes to the log then we'll force a consolidation in-line
     memcpy(&wear_leveling.cache[address], value, length);
 
@@ -699,7 +1295,28 @@ wear_leveling_status_t wear_leveling_write(const uint32_t address, const void *v
     }
 
     // Perform the actual write
+#ifdef WEAR_LEVELING_LOG_COMPRESSION
+    wear_leveling_status_t status       = WEAR_LEVELING_SUCCESS;
+    bool                   consolidated = false;
+    for (size_t i = 0; i < span_count; ++i) {
+        status = wear_leveling_write_raw(spans[i].address, (const uint8_t *)value + (spans[i].address - address), spans[i].length);
+        if (status == WEAR_LEVELING_FAILED) {
+            break;
+        }
+        consolidated |= (status == WEAR_LEVELING_CONSOLIDATED);
+#    ifndef WEAR_LEVELING_BACKGROUND_CONSOLIDATION
+        // Consolidation has written out the whole cache, including any remaining spans
+        if (consolidated) {
+            break;
+        }
+#    endif // WEAR_LEVELING_BACKGROUND_CONSOLIDATION
+    }
+    if (status != WEAR_LEVELING_FAILED && consolidated) {
+        status = WEAR_LEVELING_CONSOLIDATED;
+    }
+#else
     wear_leveling_status_t status = wear_leveling_write_raw(address, value, length);
+#endif // WEAR_LEVELING_LOG_COMPRESSION
     switch (status) {
         case WEAR_LEVELING_CONSOLIDATED:
         case WEAR_LEVELING_FAILED:
@@ -743,6 +1360,36 @@ wear_leveling_status_t wear_leveling_read(const uint32_t address, void *value, s
     return WEAR_LEVELING_SUCCESS;
 }
 
+/**
+ * Performs a single step of any pending background consolidation.
+ */
+wear_leveling_status_t wear_leveling_task(void) {
+#ifdef WEAR_LEVELING_BACKGROUND_CONSOLIDATION
+    if (wear_leveling.consolidation.state == CONSOLIDATION_IDLE) {
+        return WEAR_LEVELING_SUCCESS;
+    }
+
+    // Unlock the backing store
+    backing_store_lock_status_t lock_status = wear_leveling_unlock();
+    if (lock_status == STATUS_FAILURE) {
+        wear_leveling_lock();
+        return WEAR_LEVELING_FAILED;
+    }
+
+    wear_leveling_status_t status = wear_leveling_consolidate_step();
+
+    if (lock_status == STATUS_SUCCESS) {
+        if (wear_leveling_lock() == STATUS_FAILURE) {
+            status = WEAR_LEVELING_FAILED;
+        }
+    }
+
+    return status;
+#else
+    return WEAR_LEVELING_SUCCESS;
+#endif // WEAR_LEVELING_BACKGROUND_CONSOLIDATION
+}
+
 /**
  * Weak implementation of bulk read, drivers can implement more optimised implementations.
  */
@@ -52,3 +52,13 @@ wear_leveling_status_t wear_leveling_write(uint32_t address, const void* value,
  * @return Status of the request
  */
 wear_leveling_status_t wear_leveling_read(uint32_t address, void* value, size_t length);
+
+/**
+ * Performs a single step of any pending background consolidation.
+ *
+ * Only does any work when WEAR_LEVELING_BACKGROUND_CONSOLIDATION is enabled, and is intended to be invoked periodically
+ * from the main loop. Each invocation performs at most one partial erase, or a bounded number of backing store writes.
+ *
+ * @return Status of the request -- WEAR_LEVELING_CONSOLIDATED once a background consolidation has completed
+ */
+wear_leveling_status_t wear_leveling_task(void);
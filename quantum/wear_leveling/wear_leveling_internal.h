@@ -66,6 +66,58 @@ _Static_assert(WEAR_LEVELING_BACKING_SIZE >= (WEAR_LEVELING_LOGICAL_SIZE * 2), "
 _Static_assert(WEAR_LEVELING_LOGICAL_SIZE % BACKING_STORE_WRITE_SIZE == 0, "Logical size must be a multiple of write size");
 _Static_assert(WEAR_LEVELING_BACKING_SIZE % WEAR_LEVELING_LOGICAL_SIZE == 0, "Backing size must be a multiple of logical size");
 
+#ifdef WEAR_LEVELING_BACKGROUND_CONSOLIDATION
+// Background consolidation splits the backing store into two banks, each with its own consolidated data and write log
+#    define WEAR_LEVELING_BANK_SIZE ((WEAR_LEVELING_BACKING_SIZE) / 2)
+// +16 is due to the FNV1a_64 of the consolidated area, as well as the bank's generation counter
+#    define WEAR_LEVELING_LOG_START ((WEAR_LEVELING_LOGICAL_SIZE) + 16)
+
+// Number of write log bytes used in the active bank before background consolidation is started
+#    ifndef WEAR_LEVELING_CONSOLIDATION_THRESHOLD
+#        define WEAR_LEVELING_CONSOLIDATION_THRESHOLD (((WEAR_LEVELING_BANK_SIZE) - (WEAR_LEVELING_LOG_START)) / 2)
+#    endif
+
+// Maximum number of bytes copied to the inactive bank per consolidation step
+#    ifndef WEAR_LEVELING_CONSOLIDATION_STEP_SIZE
+#        define WEAR_LEVELING_CONSOLIDATION_STEP_SIZE 64
+#    endif
+
+// Number of bytes erased per consolidation step, defaulting to the backing store's erase size so that each step erases a single sector
+#    ifndef WEAR_LEVELING_ERASE_STEP_SIZE
+#        ifdef BACKING_STORE_ERASE_SIZE
+#            define WEAR_LEVELING_ERASE_STEP_SIZE (BACKING_STORE_ERASE_SIZE)
+#        else
+#            define WEAR_LEVELING_ERASE_STEP_SIZE (WEAR_LEVELING_BANK_SIZE)
+#        endif
+#    endif
+
+_Static_assert(WEAR_LEVELING_BACKING_SIZE >= (WEAR_LEVELING_LOGICAL_SIZE * 4), "Total backing size must be at least four times the size of the logical size when using background consolidation");
+_Static_assert(WEAR_LEVELING_BANK_SIZE % WEAR_LEVELING_ERASE_STEP_SIZE == 0, "Bank size must be a multiple of the erase step size");
+_Static_assert(WEAR_LEVELING_ERASE_STEP_SIZE % BACKING_STORE_WRITE_SIZE == 0, "Erase step size must be a multiple of write size");
+_Static_assert(WEAR_LEVELING_CONSOLIDATION_STEP_SIZE % BACKING_STORE_WRITE_SIZE == 0, "Consolidation step size must be a multiple of write size");
+_Static_assert(WEAR_LEVELING_CONSOLIDATION_THRESHOLD % BACKING_STORE_WRITE_SIZE == 0, "Consolidation threshold must be a multiple of write size");
+_Static_assert(WEAR_LEVELING_CONSOLIDATION_THRESHOLD + 8 <= WEAR_LEVELING_BANK_SIZE - WEAR_LEVELING_LOG_START, "Consolidation threshold must leave space in the write log");
+#else
+#    define WEAR_LEVELING_BANK_SIZE (WEAR_LEVELING_BACKING_SIZE)
+// +8 is due to the FNV1a_64 of the consolidated area
+#    define WEAR_LEVELING_LOG_START ((WEAR_LEVELING_LOGICAL_SIZE) + 8)
+#endif // WEAR_LEVELING_BACKGROUND_CONSOLIDATION
+
+#ifdef WEAR_LEVELING_LOG_COMPRESSION
+// Minimum number of bytes covered by an extended write log entry -- shorter spans are cheaper using the regular encodings
+#    ifndef WEAR_LEVELING_LOG_COMPRESSION_MIN_LENGTH
+#        define WEAR_LEVELING_LOG_COMPRESSION_MIN_LENGTH 8
+#    endif
+
+// Maximum number of modified spans logged separately for a single write, any further changes are merged into the last span
+#    ifndef WEAR_LEVELING_LOG_COMPRESSION_MAX_SPANS
+#        define WEAR_LEVELING_LOG_COMPRESSION_MAX_SPANS 8
+#    endif
+
+_Static_assert(WEAR_LEVELING_LOG_COMPRESSION_MIN_LENGTH >= 4, "Extended write log entries must cover at least 4 bytes");
+_Static_assert(WEAR_LEVELING_LOG_COMPRESSION_MAX_SPANS >= 1, "At least one span is required per write");
+#endif // WEAR_LEVELING_LOG_COMPRESSION
+
 // Backing Store API, to be implemented elsewhere by flash driver etc.
 bool backing_store_init(void);
 bool backing_store_unlock(void);
@@ -75,6 +127,7 @@ bool backing_store_write_bulk(uint32_t address, backing_store_int_t* values, siz
 bool backing_store_lock(void);
 bool backing_store_read(uint32_t address, backing_store_int_t* value);
 bool backing_store_read_bulk(uint32_t address, backing_store_int_t* values, size_t item_count); // weak implementation already provided, optimized implementation can be implemented by driver
+bool backing_store_erase_range(uint32_t address, size_t length);                                 // only required when WEAR_LEVELING_BACKGROUND_CONSOLIDATION is enabled
 
 /**
  * Helper type used to contain a write log entry.
@@ -101,6 +154,9 @@ enum {
     // 0x02 -- 2-byte backing store write optimization: word-encoded 0/1 values
     LOG_ENTRY_TYPE_WORD_01,
 
+    // 0x03 -- Extended entry covering a range of bytes, see LOG_ENTRY_EXTENDED_*
+    LOG_ENTRY_TYPE_EXTENDED,
+
     LOG_ENTRY_TYPES
 };
 
@@ -149,3 +205,40 @@ _Static_assert(LOG_ENTRY_TYPES <= (1 << 2), "Too many log entry types to fit int
             [1] = (uint8_t)((address) >> 1), /* address */                                            \
         }                                                                                             \
     }
+
+/**
+ * Extended log entry subtype discriminator.
+ */
+enum {
+    // 0x00 -- Literal bytes, the first 3 in the header and the remainder in the following backing store writes
+    LOG_ENTRY_EXTENDED_RANGE,
+
+    // 0x01 -- Repeated 2-byte pattern
+    LOG_ENTRY_EXTENDED_FILL,
+
+    // 0x02 -- Zero XOR delta against the consolidated data, i.e. the bytes are restored from the consolidated area
+    LOG_ENTRY_EXTENDED_RESTORE,
+
+    LOG_ENTRY_EXTENDED_SUBTYPES
+};
+
+_Static_assert(LOG_ENTRY_EXTENDED_SUBTYPES <= (1 << 3), "Too many extended log entry subtypes to fit into 3 bits of storage");
+
+#define LOG_ENTRY_EXTENDED_MAX_LENGTH 0xFFFF
+#define LOG_ENTRY_EXTENDED_HEADER_BYTES 3
+#define LOG_ENTRY_EXTENDED_GET_SUBTYPE(entry) ((uint8_t)(((entry).raw8[0] >> 3) & BITMASK_FOR_BITCOUNT(3)))
+#define LOG_ENTRY_EXTENDED_GET_ADDRESS(entry) (((((uint32_t)((entry).raw8[0])) & BITMASK_FOR_BITCOUNT(3)) << 16) | (((uint32_t)((entry).raw8[1])) << 8) | (entry).raw8[2])
+#define LOG_ENTRY_EXTENDED_GET_LENGTH(entry) ((((uint32_t)((entry).raw8[3])) << 8) | (entry).raw8[4])
+#define LOG_ENTRY_MAKE_EXTENDED(subtype, address, length)                                              \
+    (write_log_entry_t) {                                                                              \
+        .raw8 = {                                                                                      \
+            [0] = (((((uint8_t)LOG_ENTRY_TYPE_EXTENDED) & BITMASK_FOR_BITCOUNT(2)) << 6) /* type */    \
+                   | ((((uint8_t)(subtype)) & BITMASK_FOR_BITCOUNT(3)) << 3)             /* subtype */ \
+                   | ((((uint8_t)((address) >> 16))) & BITMASK_FOR_BITCOUNT(3))          /* address */ \
+                   ),                                                                                  \
+            [1] = (((uint8_t)((address) >> 8)) & BITMASK_FOR_BITCOUNT(8)), /* address */               \
+            [2] = (((uint8_t)(address)) & BITMASK_FOR_BITCOUNT(8)),        /* address */               \
+            [3] = (((uint8_t)((length) >> 8)) & BITMASK_FOR_BITCOUNT(8)),  /* length */                \
+            [4] = (((uint8_t)(length)) & BITMASK_FOR_BITCOUNT(8)),         /* length */                \
+        }                                                                                              \
+    }
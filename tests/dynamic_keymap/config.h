@@ -0,0 +1,13 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+#define BACKING_STORE_WRITE_SIZE 2
+#define WEAR_LEVELING_BACKING_SIZE 4096
+#define WEAR_LEVELING_LOGICAL_SIZE 1024
+#define WEAR_LEVELING_LOG_COMPRESSION
+#define DYNAMIC_KEYMAP_HASH_ENABLE
+#define SEND_STRING_ASYNC_BUFFER_SIZE 16
@@ -0,0 +1,11 @@
+# --------------------------------------------------------------------------------
+# Keep this file, even if it is empty, as a marker that this folder contains tests
+# --------------------------------------------------------------------------------
+
+DYNAMIC_KEYMAP_ENABLE = yes
+EEPROM_DRIVER = wear_leveling
+WEAR_LEVELING_DRIVER = custom
+SEND_STRING_ASYNC_ENABLE = yes
+
+COMMON_VPATH += $(QUANTUM_PATH)/wear_leveling/tests
+SRC += $(QUANTUM_PATH)/wear_leveling/tests/backing_mocks.cpp
@@ -0,0 +1,110 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <vector>
+#include "keyboard_report_util.hpp"
+#include "test_common.hpp"
+#include "backing_mocks.hpp"
+
+extern "C" {
+#include "dynamic_keymap.h"
+#include "eeprom_driver.h"
+}
+
+using testing::_;
+using testing::Invoke;
+
+class DynamicKeymap : public TestFixture {
+   protected:
+    void SetUp() override {
+        MockBackingStore::Instance().reset_instance();
+        eeprom_driver_init();
+        dynamic_keymap_reset();
+    }
+
+    // VIA sends the keymap in chunks, each of which is written using dynamic_keymap_set_buffer()
+    static void upload(std::vector<uint8_t>& keymap) {
+        constexpr uint16_t via_chunk_size = 28;
+        for (uint16_t offset = 0; offset < keymap.size(); offset += via_chunk_size) {
+            uint16_t length = std::min<uint16_t>(via_chunk_size, keymap.size() - offset);
+            dynamic_keymap_set_buffer(offset, length, &keymap[offset]);
+        }
+    }
+};
+
+static std::vector<uint8_t> make_keymap(void) {
+    // A populated base layer, a layer of modified keys, and transparent layers
+    constexpr size_t     layer_keys = MATRIX_ROWS * MATRIX_COLS;
+    std::vector<uint8_t> keymap(DYNAMIC_KEYMAP_LAYER_COUNT * layer_keys * 2);
+    for (size_t i = 0; i < DYNAMIC_KEYMAP_LAYER_COUNT * layer_keys; ++i) {
+        uint16_t keycode;
+        if (i < layer_keys) {
+            keycode = KC_A + i;
+        } else if (i < 2 * layer_keys) {
+            keycode = LCTL(KC_A + (i % 26));
+        } else {
+            keycode = KC_TRANSPARENT;
+        }
+        keymap[i * 2 + 0] = keycode >> 8;
+        keymap[i * 2 + 1] = keycode & 0xFF;
+    }
+    return keymap;
+}
+
+TEST_F(DynamicKeymap, UploadIsWrittenToEeprom) {
+    auto keymap = make_keymap();
+    upload(keymap);
+
+    std::vector<uint8_t> readback(keymap.size());
+    dynamic_keymap_get_buffer(0, readback.size(), readback.data());
+    EXPECT_EQ(readback, keymap);
+    EXPECT_EQ(dynamic_keymap_get_keycode(0, 0, 1), KC_B);
+    EXPECT_EQ(dynamic_keymap_get_keycode(1, 0, 2), LCTL(KC_A + (MATRIX_ROWS * MATRIX_COLS + 2) % 26));
+    EXPECT_EQ(dynamic_keymap_get_keycode(3, 3, 9), KC_TRANSPARENT);
+}
+
+TEST_F(DynamicKeymap, UploadIsLoggedAsBlocks) {
+    auto& inst   = MockBackingStore::Instance();
+    auto  keymap = make_keymap();
+
+    auto write_count = inst.write_invoke_count();
+    upload(keymap);
+    EXPECT_LT((inst.write_invoke_count() - write_count) * BACKING_STORE_WRITE_SIZE, keymap.size()) << "Keymap upload should consume less write log than the size of the keymap";
+
+    // Uploading the same keymap again with a single modified key only logs the change
+    write_count               = inst.write_invoke_count();
+    keymap[keymap.size() - 1] = KC_ESCAPE;
+    upload(keymap);
+    EXPECT_LE((inst.write_invoke_count() - write_count) * BACKING_STORE_WRITE_SIZE, 8) << "Re-upload should only log the modified key";
+    EXPECT_EQ(dynamic_keymap_get_keycode(DYNAMIC_KEYMAP_LAYER_COUNT - 1, MATRIX_ROWS - 1, MATRIX_COLS - 1), KC_ESCAPE);
+}
+
+TEST_F(DynamicKeymap, MacroBufferIsWrittenToEeprom) {
+    uint8_t macros[] = "hello\0world";
+    dynamic_keymap_macro_set_buffer(0, sizeof(macros), macros);
+
+    uint8_t readback[sizeof(macros)];
+    dynamic_keymap_macro_get_buffer(0, sizeof(readback), readback);
+    EXPECT_EQ(memcmp(readback, macros, sizeof(macros)), 0);
+}
+
+TEST_F(DynamicKeymap, MacroLargerThanQueueIsSentInOrder) {
+    TestDriver                     driver;
+    std::vector<report_keyboard_t> expected, reports;
+    EXPECT_CALL(driver, send_keyboard_mock(_)).WillRepeatedly(Invoke([&](report_keyboard_t& report) { reports.push_back(report); }));
+    send_string("abthis macro does not fit");
+    expected.swap(reports);
+
+    uint8_t macros[] = "this macro does not fit";
+    dynamic_keymap_macro_set_buffer(0, sizeof(macros), macros);
+    EXPECT_TRUE(send_string_async("ab"));
+    run_one_scan_loop();
+    dynamic_keymap_macro_send(0);
+    while (send_string_async_active()) {
+        run_one_scan_loop();
+    }
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EQ(reports, expected);
+}
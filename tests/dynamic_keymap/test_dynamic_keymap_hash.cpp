@@ -0,0 +1,72 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <vector>
+#include "test_common.hpp"
+#include "backing_mocks.hpp"
+
+extern "C" {
+#include "dynamic_keymap.h"
+#include "eeprom_driver.h"
+}
+
+using testing::_;
+
+// Layer hashes calculated by content_hash() in lib/python/qmk/via_bulk.py, see test_layer_hash_vectors() in its tests
+#define EMPTY_LAYER_HASH 0xC5A56BFB
+#define ALPHAS_LAYER_HASH 0xF967FC70
+
+class DynamicKeymapHash : public TestFixture {
+   protected:
+    void SetUp() override {
+        MockBackingStore::Instance().reset_instance();
+        eeprom_driver_init();
+        dynamic_keymap_reset();
+    }
+};
+
+// KC_A onwards for every key of the layer, big endian as stored in EEPROM
+static std::vector<uint8_t> alphas_layer(void) {
+    std::vector<uint8_t> layer;
+    for (uint16_t i = 0; i < MATRIX_ROWS * MATRIX_COLS; i++) {
+        layer.push_back((KC_A + i) >> 8);
+        layer.push_back((KC_A + i) & 0xFF);
+    }
+    return layer;
+}
+
+TEST_F(DynamicKeymapHash, CalculatedHashMatchesHost) {
+    EXPECT_EQ(dynamic_keymap_get_hash(0), EMPTY_LAYER_HASH);
+
+    auto layer = alphas_layer();
+    dynamic_keymap_reset();
+    dynamic_keymap_set_buffer(layer.size(), layer.size(), layer.data());
+    EXPECT_EQ(dynamic_keymap_get_hash(1), ALPHAS_LAYER_HASH);
+    EXPECT_EQ(dynamic_keymap_get_hash(0), EMPTY_LAYER_HASH);
+}
+
+TEST_F(DynamicKeymapHash, KeycodeWritesUpdateHash) {
+    EXPECT_EQ(dynamic_keymap_get_hash(0), EMPTY_LAYER_HASH);
+
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+            dynamic_keymap_set_keycode(0, row, col, KC_A + row * MATRIX_COLS + col);
+        }
+    }
+    EXPECT_EQ(dynamic_keymap_get_hash(0), ALPHAS_LAYER_HASH);
+
+    dynamic_keymap_set_keycode(0, 0, 0, KC_ESCAPE);
+    EXPECT_NE(dynamic_keymap_get_hash(0), ALPHAS_LAYER_HASH);
+    dynamic_keymap_set_keycode(0, 0, 0, KC_A);
+    EXPECT_EQ(dynamic_keymap_get_hash(0), ALPHAS_LAYER_HASH);
+}
+
+TEST_F(DynamicKeymapHash, BufferWritesUpdateHash) {
+    EXPECT_EQ(dynamic_keymap_get_hash(0), EMPTY_LAYER_HASH);
+    uint32_t next_layer_hash = dynamic_keymap_get_hash(1);
+
+    auto layer = alphas_layer();
+    dynamic_keymap_set_buffer(0, layer.size(), layer.data());
+    EXPECT_EQ(dynamic_keymap_get_hash(0), ALPHAS_LAYER_HASH);
+    EXPECT_EQ(dynamic_keymap_get_hash(1), next_layer_hash);
+}
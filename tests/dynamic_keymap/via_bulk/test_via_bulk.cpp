@@ -0,0 +1,164 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <array>
+#include <vector>
+#include "test_common.hpp"
+
+extern "C" {
+#include "dynamic_keymap.h"
+#include "raw_hid.h"
+#include "via.h"
+}
+
+using testing::_;
+
+typedef std::array<uint8_t, 32> report_t;
+
+static std::vector<report_t> sent_reports;
+
+extern "C" void raw_hid_send(uint8_t *data, uint8_t length) {
+    report_t report = {};
+    memcpy(report.data(), data, length);
+    sent_reports.push_back(report);
+}
+
+class ViaBulk : public TestFixture {
+   protected:
+    void SetUp() override {
+        sent_reports.clear();
+        dynamic_keymap_reset();
+        dynamic_keymap_macro_reset();
+    }
+
+    // Passes a request to the VIA command handler, returning every report sent in response
+    static std::vector<report_t> request(std::vector<uint8_t> bytes) {
+        report_t report = {};
+        std::copy(bytes.begin(), bytes.end(), report.begin());
+        raw_hid_receive(report.data(), report.size());
+        std::vector<report_t> reports;
+        reports.swap(sent_reports);
+        return reports;
+    }
+};
+
+// Decodes the payload of a block report, as documented in quantum/via.h
+static std::vector<uint8_t> decode(const report_t &report) {
+    std::vector<uint8_t> data;
+    const uint8_t       *payload = &report[2 + 6];
+    for (uint8_t i = 0; i < report[2 + 5];) {
+        uint8_t token = payload[i++];
+        uint8_t count = token & 0x7F;
+        if (token & 0x80) {
+            for (uint8_t j = 0; j < count + 2; j++) {
+                data.push_back(payload[i]);
+                data.push_back(payload[i + 1]);
+            }
+            i += 2;
+        } else {
+            data.insert(data.end(), &payload[i], &payload[i + count + 1]);
+            i += count + 1;
+        }
+    }
+    return data;
+}
+
+TEST_F(ViaBulk, GetInfo) {
+    auto reports = request({id_dynamic_keymap_bulk, id_bulk_get_info});
+
+    ASSERT_EQ(reports.size(), 1);
+    uint16_t keymap_size = DYNAMIC_KEYMAP_LAYER_COUNT * MATRIX_ROWS * MATRIX_COLS * 2;
+    uint16_t macro_size  = dynamic_keymap_macro_get_buffer_size();
+    EXPECT_EQ(reports[0][0], id_dynamic_keymap_bulk);
+    EXPECT_EQ(reports[0][2], VIA_BULK_VERSION);
+    EXPECT_EQ(reports[0][3], id_bulk_region_count);
+    EXPECT_EQ((reports[0][4] << 8) | reports[0][5], keymap_size);
+    EXPECT_EQ((reports[0][6] << 8) | reports[0][7], macro_size);
+    EXPECT_EQ(reports[0][8], VIA_BULK_MAX_WINDOW);
+}
+
+TEST_F(ViaBulk, GetCrcMatchesZlib) {
+    uint8_t check[] = "123456789";
+    dynamic_keymap_macro_set_buffer(0, 9, check);
+
+    auto reports = request({id_dynamic_keymap_bulk, id_bulk_get_crc, id_bulk_region_macro, 0, 0, 0, 9});
+
+    ASSERT_EQ(reports.size(), 1);
+    EXPECT_EQ((reports[0][5] << 8) | reports[0][6], 9);
+    uint32_t crc = ((uint32_t)reports[0][7] << 24) | ((uint32_t)reports[0][8] << 16) | ((uint32_t)reports[0][9] << 8) | reports[0][10];
+    EXPECT_EQ(crc, 0xCBF43926);
+}
+
+TEST_F(ViaBulk, GetCrcInvalidRegion) {
+    auto reports = request({id_dynamic_keymap_bulk, id_bulk_get_crc, id_bulk_region_count, 0, 0, 0, 9});
+
+    ASSERT_EQ(reports.size(), 1);
+    EXPECT_EQ(reports[0][0], id_unhandled);
+}
+
+TEST_F(ViaBulk, WriteDecodesTokens) {
+    // KC_A, KC_B as literal bytes, then KC_TRANSPARENT repeated 10 times
+    auto reports = request({id_dynamic_keymap_bulk, id_bulk_write, id_bulk_region_keymap, 0, 0, VIA_BULK_SEQUENCE_LAST, 24, 8, 0x03, 0x00, 0x04, 0x00, 0x05, 0x88, 0x00, 0x01});
+
+    ASSERT_EQ(reports.size(), 1);
+    EXPECT_EQ(reports[0][2 + 4], 24) << "Write should have been accepted";
+    EXPECT_EQ(dynamic_keymap_get_keycode(0, 0, 0), KC_A);
+    EXPECT_EQ(dynamic_keymap_get_keycode(0, 0, 1), KC_B);
+    EXPECT_EQ(dynamic_keymap_get_keycode(0, 0, 2), KC_TRANSPARENT);
+    EXPECT_EQ(dynamic_keymap_get_keycode(0, 1, 1), KC_TRANSPARENT);
+    EXPECT_EQ(dynamic_keymap_get_keycode(0, 1, 2), KC_NO);
+}
+
+TEST_F(ViaBulk, WriteRejectsMismatchedLength) {
+    auto reports = request({id_dynamic_keymap_bulk, id_bulk_write, id_bulk_region_keymap, 0, 0, VIA_BULK_SEQUENCE_LAST, 20, 8, 0x03, 0x00, 0x04, 0x00, 0x05, 0x88, 0x00, 0x01});
+
+    ASSERT_EQ(reports.size(), 1);
+    EXPECT_EQ(reports[0][2 + 4], 0) << "Write should have been rejected";
+    EXPECT_EQ(dynamic_keymap_get_keycode(0, 0, 0), KC_NO);
+}
+
+TEST_F(ViaBulk, WriteRejectsOutOfRegion) {
+    uint16_t keymap_size = DYNAMIC_KEYMAP_LAYER_COUNT * MATRIX_ROWS * MATRIX_COLS * 2;
+    auto     reports     = request({id_dynamic_keymap_bulk, id_bulk_write, id_bulk_region_keymap, (uint8_t)((keymap_size - 2) >> 8), (uint8_t)((keymap_size - 2) & 0xFF), VIA_BULK_SEQUENCE_LAST, 4, 3, 0x80, 0x00, 0x01});
+
+    ASSERT_EQ(reports.size(), 1);
+    EXPECT_EQ(reports[0][2 + 4], 0) << "Write should have been rejected";
+}
+
+TEST_F(ViaBulk, ReadStreamsWindows) {
+    uint16_t keymap_size = DYNAMIC_KEYMAP_LAYER_COUNT * MATRIX_ROWS * MATRIX_COLS * 2;
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+            dynamic_keymap_set_keycode(0, row, col, KC_A + row * MATRIX_COLS + col);
+            dynamic_keymap_set_keycode(1, row, col, KC_TRANSPARENT);
+        }
+    }
+    std::vector<uint8_t> expected(keymap_size);
+    dynamic_keymap_get_buffer(0, keymap_size, expected.data());
+
+    // The host acknowledges each window by requesting the next offset
+    std::vector<uint8_t> data;
+    size_t               round_trips = 0;
+    while (data.size() < keymap_size) {
+        uint16_t offset    = data.size();
+        uint16_t remaining = keymap_size - offset;
+        auto     reports   = request({id_dynamic_keymap_bulk, id_bulk_read, id_bulk_region_keymap, (uint8_t)(offset >> 8), (uint8_t)(offset & 0xFF), (uint8_t)(remaining >> 8), (uint8_t)(remaining & 0xFF), VIA_BULK_MAX_WINDOW});
+        ASSERT_GE(reports.size(), 1);
+        ASSERT_LE(reports.size(), VIA_BULK_MAX_WINDOW);
+        for (size_t i = 0; i < reports.size(); i++) {
+            const auto &report = reports[i];
+            EXPECT_EQ(report[0], id_dynamic_keymap_bulk);
+            EXPECT_EQ(report[2], id_bulk_region_keymap);
+            EXPECT_EQ((report[3] << 8) | report[4], data.size()) << "Reports should be contiguous";
+            EXPECT_EQ(report[5], i | (i + 1 == reports.size() ? VIA_BULK_SEQUENCE_LAST : 0));
+            auto block = decode(report);
+            EXPECT_EQ(block.size(), report[2 + 4]);
+            data.insert(data.end(), block.begin(), block.end());
+        }
+        round_trips++;
+    }
+
+    EXPECT_EQ(data, expected);
+    // 28 bytes per round trip using id_dynamic_keymap_get_buffer
+    EXPECT_LT(round_trips, keymap_size / 28);
+}
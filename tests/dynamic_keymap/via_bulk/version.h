@@ -0,0 +1,7 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// Stand-in for the version.h generated by keyboard builds, which via.c uses for its EEPROM magic
+#pragma once
+
+#define QMK_BUILDDATE "2025-01-01-00:00:00"
@@ -0,0 +1,11 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+#define MATRIX_ADAPTIVE_SCAN_TIMEOUT 100
+#define MATRIX_ADAPTIVE_SCAN_INTERVAL 10
+#define MATRIX_IDLE_TIMEOUT 1000
+#define MATRIX_IDLE_SLEEP_TIMEOUT 20
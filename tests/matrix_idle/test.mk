@@ -0,0 +1,9 @@
+# Copyright 2025 QMK
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+# --------------------------------------------------------------------------------
+# Keep this file, even if it is empty, as a marker that this folder contains tests
+# --------------------------------------------------------------------------------
+
+MATRIX_IDLE_ENABLE = yes
+DEFERRED_EXEC_ENABLE = yes
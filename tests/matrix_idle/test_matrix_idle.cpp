@@ -0,0 +1,166 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keyboard_report_util.hpp"
+#include "test_common.hpp"
+
+extern "C" {
+#include "matrix_idle.h"
+#include "deferred_exec.h"
+}
+
+using testing::_;
+using testing::InSequence;
+
+static unsigned arm_count    = 0;
+static unsigned disarm_count = 0;
+
+// The test matrix has no pins, so stands in for the standard matrix arming its inputs
+extern "C" bool matrix_idle_arm(void) {
+    arm_count++;
+    return true;
+}
+
+extern "C" void matrix_idle_disarm(void) {
+    disarm_count++;
+}
+
+extern "C" bool matrix_idle_inputs_active(void) {
+    return false;
+}
+
+class MatrixIdle : public TestFixture {
+   public:
+    void SetUp() override {
+        TestFixture::SetUp();
+        arm_count    = 0;
+        disarm_count = 0;
+    }
+
+    // Runs the main loop until a report is sent, returning the number of loops taken
+    unsigned loops_until_report(TestDriver& driver, unsigned limit = 100) {
+        bool sent = false;
+        EXPECT_CALL(driver, send_keyboard_mock(_)).WillOnce([&sent](report_keyboard_t&) { sent = true; });
+        unsigned loops = 0;
+        while (!sent && loops < limit) {
+            run_one_scan_loop();
+            loops++;
+        }
+        VERIFY_AND_CLEAR(driver);
+        return loops;
+    }
+};
+
+TEST_F(MatrixIdle, FullRateWhileActive) {
+    TestDriver driver;
+    auto       key = KeymapKey(0, 0, 0, KC_A);
+
+    set_keymap({key});
+
+    key.press();
+    loops_until_report(driver);
+    key.release();
+    EXPECT_EQ(loops_until_report(driver), 1);
+
+    key.press();
+    EXPECT_EQ(loops_until_report(driver), 1);
+    key.release();
+    EXPECT_EQ(loops_until_report(driver), 1);
+    EXPECT_EQ(arm_count, 0);
+}
+
+TEST_F(MatrixIdle, ReducedRateAfterTimeout) {
+    TestDriver driver;
+    auto       key = KeymapKey(0, 0, 0, KC_A);
+
+    set_keymap({key});
+
+    key.press();
+    loops_until_report(driver);
+    key.release();
+    loops_until_report(driver);
+
+    idle_for(MATRIX_ADAPTIVE_SCAN_TIMEOUT + 5 * MATRIX_ADAPTIVE_SCAN_INTERVAL + 3);
+
+    key.press();
+    unsigned loops = loops_until_report(driver);
+    EXPECT_GT(loops, 1);
+    EXPECT_LE(loops, MATRIX_ADAPTIVE_SCAN_INTERVAL);
+
+    // Back to scanning every loop
+    key.release();
+    EXPECT_EQ(loops_until_report(driver), 1);
+    EXPECT_EQ(arm_count, 0);
+}
+
+TEST_F(MatrixIdle, SleepsAfterIdleTimeout) {
+    TestDriver driver;
+    auto       key = KeymapKey(0, 0, 0, KC_A);
+
+    set_keymap({key});
+
+    key.press();
+    loops_until_report(driver);
+    key.release();
+    loops_until_report(driver);
+
+    idle_for(MATRIX_IDLE_TIMEOUT - 1);
+    EXPECT_EQ(arm_count, 0);
+
+    // Each loop sleeps until it times out, as no key is pressed
+    idle_for(10);
+    EXPECT_EQ(arm_count, 10);
+    EXPECT_EQ(disarm_count, arm_count);
+
+    key.press();
+    EXPECT_LE(loops_until_report(driver), MATRIX_ADAPTIVE_SCAN_INTERVAL);
+    EXPECT_EQ(arm_count, 10);
+
+    key.release();
+    EXPECT_EQ(loops_until_report(driver), 1);
+}
+
+TEST_F(MatrixIdle, HeldKeyIsNotSlept) {
+    TestDriver driver;
+    auto       key = KeymapKey(0, 0, 0, KC_A);
+
+    set_keymap({key});
+
+    key.press();
+    loops_until_report(driver);
+
+    // The release still has to be scanned for
+    idle_for(MATRIX_IDLE_TIMEOUT * 2);
+    EXPECT_EQ(arm_count, 0);
+
+    key.release();
+    EXPECT_LE(loops_until_report(driver), MATRIX_ADAPTIVE_SCAN_INTERVAL);
+}
+
+static uint32_t deferred_noop(uint32_t trigger_time, void *cb_arg) {
+    return 0;
+}
+
+TEST_F(MatrixIdle, PendingDeferredExecIsNotSlept) {
+    TestDriver driver;
+    auto       key = KeymapKey(0, 0, 0, KC_A);
+
+    set_keymap({key});
+
+    key.press();
+    loops_until_report(driver);
+    key.release();
+    loops_until_report(driver);
+
+    deferred_token token = defer_exec(MATRIX_IDLE_TIMEOUT * 2, deferred_noop, NULL);
+    EXPECT_NE(token, INVALID_DEFERRED_TOKEN);
+
+    // Sleeping would hold up the executor
+    idle_for(MATRIX_IDLE_TIMEOUT + 10);
+    EXPECT_EQ(arm_count, 0);
+
+    EXPECT_TRUE(cancel_deferred_exec(token));
+    idle_for(10);
+    EXPECT_EQ(arm_count, 10);
+    EXPECT_EQ(disarm_count, arm_count);
+}
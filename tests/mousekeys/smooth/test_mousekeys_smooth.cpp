@@ -0,0 +1,260 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <cstdlib>
+#include <vector>
+#include "gtest/gtest.h"
+#include "mouse_report_util.hpp"
+#include "test_common.hpp"
+
+extern "C" {
+#include "timer.h"
+}
+
+using testing::_;
+using testing::Invoke;
+
+/* Distance the accelerated mode moves the cursor by, in steps at each interval, the given time after the key is pressed. */
+static int32_t accelerated_distance(uint32_t elapsed) {
+    int32_t distance = MOUSEKEY_MOVE_DELTA;
+    for (uint32_t repeat = 1; MOUSEKEY_DELAY + (repeat - 1) * MOUSEKEY_INTERVAL <= elapsed; repeat++) {
+        uint32_t unit = MOUSEKEY_MOVE_DELTA * MOUSEKEY_MAX_SPEED * std::min<uint32_t>(repeat, MOUSEKEY_TIME_TO_MAX) / MOUSEKEY_TIME_TO_MAX;
+        distance += std::min<uint32_t>(std::max<uint32_t>(unit, 1), MOUSEKEY_MOVE_MAX);
+    }
+    return distance;
+}
+
+struct TimedReport {
+    uint16_t       time;
+    report_mouse_t report;
+};
+
+class MousekeySmooth : public TestFixture {
+   public:
+    void SetUp() override {
+        TestFixture::SetUp();
+        start = timer_read();
+    }
+
+    /* Records every mouse report with the time it was sent, to follow the path of the cursor. */
+    void record_reports(TestDriver& driver) {
+        EXPECT_CALL(driver, send_mouse_mock(_)).WillRepeatedly(Invoke([this](report_mouse_t& report) { reports.push_back({timer_elapsed(start), report}); }));
+    }
+
+    /* Cursor position along x, the given time after the test started. */
+    int32_t x_at(uint16_t time) {
+        int32_t x = 0;
+        for (const auto& timed : reports) {
+            if (timed.time <= time) {
+                x += timed.report.x;
+            }
+        }
+        return x;
+    }
+
+    int32_t sent_x(void) {
+        return x_at(UINT16_MAX);
+    }
+
+    int32_t sent_y(void) {
+        int32_t y = 0;
+        for (const auto& timed : reports) {
+            y += timed.report.y;
+        }
+        return y;
+    }
+
+    int32_t sent_v(void) {
+        int32_t v = 0;
+        for (const auto& timed : reports) {
+            v += timed.report.v;
+        }
+        return v;
+    }
+
+    uint16_t                 start;
+    std::vector<TimedReport> reports;
+};
+
+TEST_F(MousekeySmooth, TapMovesOneStep) {
+    TestDriver driver;
+    KeymapKey  mouse_key = KeymapKey{0, 0, 0, QK_MOUSE_CURSOR_RIGHT};
+    set_keymap({mouse_key});
+
+    EXPECT_MOUSE_REPORT(driver, (MOUSEKEY_MOVE_DELTA, 0, 0, 0, 0));
+    mouse_key.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_MOUSE_REPORT(driver);
+    mouse_key.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_NO_MOUSE_REPORT(driver);
+    idle_for(MOUSEKEY_INTERVAL);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(MousekeySmooth, HeldKeyFollowsAcceleratedPath) {
+    TestDriver driver;
+    KeymapKey  mouse_key = KeymapKey{0, 0, 0, QK_MOUSE_CURSOR_RIGHT};
+    set_keymap({mouse_key});
+    record_reports(driver);
+
+    mouse_key.press();
+    idle_for(1000);
+    mouse_key.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    // Never more than a step from where the accelerated mode would be, through the ramp and at full speed
+    for (uint16_t time = 0; time < 1000; time++) {
+        EXPECT_NEAR(x_at(time), accelerated_distance(time), MOUSEKEY_MOVE_DELTA * MOUSEKEY_MAX_SPEED) << "at " << time << "ms";
+    }
+}
+
+TEST_F(MousekeySmooth, MotionIsSpreadOverFrames) {
+    TestDriver driver;
+    KeymapKey  mouse_key = KeymapKey{0, 0, 0, QK_MOUSE_CURSOR_DOWN};
+    set_keymap({mouse_key});
+    record_reports(driver);
+
+    mouse_key.press();
+    idle_for(MOUSEKEY_INTERVAL * MOUSEKEY_TIME_TO_MAX + 100);
+    reports.clear();
+    idle_for(100);
+    mouse_key.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    // At full speed, each frame moves by its share of a step rather than a whole step each interval
+    const int32_t speed = MOUSEKEY_MOVE_DELTA * MOUSEKEY_MAX_SPEED / MOUSEKEY_INTERVAL;
+    EXPECT_EQ(sent_y(), 100 * speed);
+    for (const auto& timed : reports) {
+        EXPECT_LE(std::abs(timed.report.y), speed);
+    }
+}
+
+TEST_F(MousekeySmooth, FullSpeedIsKeptPastTimerWrap) {
+    TestDriver driver;
+    KeymapKey  mouse_key = KeymapKey{0, 0, 0, QK_MOUSE_CURSOR_DOWN};
+    set_keymap({mouse_key});
+    record_reports(driver);
+
+    // Held for longer than a 16-bit millisecond timer takes to wrap
+    mouse_key.press();
+    idle_for(UINT16_MAX + 1 + MOUSEKEY_DELAY);
+    reports.clear();
+    idle_for(100);
+    mouse_key.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    const int32_t speed = MOUSEKEY_MOVE_DELTA * MOUSEKEY_MAX_SPEED / MOUSEKEY_INTERVAL;
+    EXPECT_EQ(sent_y(), 100 * speed) << "Speed should not ramp up again";
+}
+
+TEST_F(MousekeySmooth, FramesWithoutWholeCountsAreNotSent) {
+    TestDriver driver;
+    KeymapKey  mouse_key = KeymapKey{0, 0, 0, QK_MOUSE_CURSOR_LEFT};
+    set_keymap({mouse_key});
+    record_reports(driver);
+
+    mouse_key.press();
+    run_one_scan_loop();
+    reports.clear();
+    idle_for(5 * MOUSEKEY_INTERVAL);
+
+    // While slow, the cursor moves less than a count per frame
+    EXPECT_LT(reports.size(), 5 * MOUSEKEY_INTERVAL / 2);
+    for (const auto& timed : reports) {
+        EXPECT_NE(timed.report.x, 0);
+    }
+
+    mouse_key.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(MousekeySmooth, FractionsOfACountAreCarried) {
+    TestDriver driver;
+    KeymapKey  accel_key = KeymapKey{0, 0, 0, QK_MOUSE_ACCELERATION_2};
+    KeymapKey  right_key = KeymapKey{0, 1, 0, QK_MOUSE_CURSOR_RIGHT};
+    KeymapKey  down_key  = KeymapKey{0, 2, 0, QK_MOUSE_CURSOR_DOWN};
+    set_keymap({accel_key, right_key, down_key});
+    record_reports(driver);
+
+    accel_key.press();
+    run_one_scan_loop();
+    right_key.press();
+    down_key.press();
+    idle_for(100);
+    reports.clear();
+    idle_for(1000);
+    right_key.release();
+    down_key.release();
+    run_one_scan_loop();
+    accel_key.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    // Diagonally at full speed, 2.83 counts a frame on each axis
+    const double expected = 1000.0 * MOUSEKEY_MOVE_DELTA * MOUSEKEY_MAX_SPEED * 181 / 256 / MOUSEKEY_INTERVAL;
+    EXPECT_NEAR(sent_x(), expected, 1);
+    EXPECT_NEAR(sent_y(), expected, 1);
+}
+
+TEST_F(MousekeySmooth, WheelScrollsWholeDetentsAtItsSpeed) {
+    TestDriver driver;
+    KeymapKey  accel_key = KeymapKey{0, 0, 0, QK_MOUSE_ACCELERATION_2};
+    KeymapKey  wheel_key = KeymapKey{0, 1, 0, QK_MOUSE_WHEEL_UP};
+    set_keymap({accel_key, wheel_key});
+    record_reports(driver);
+
+    accel_key.press();
+    run_one_scan_loop();
+    wheel_key.press();
+    run_one_scan_loop();
+    reports.clear();
+    idle_for(MOUSEKEY_WHEEL_DELAY + 1000);
+    wheel_key.release();
+    run_one_scan_loop();
+    accel_key.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_NEAR(sent_v(), 1000 * MOUSEKEY_WHEEL_DELTA * MOUSEKEY_WHEEL_MAX_SPEED / MOUSEKEY_WHEEL_INTERVAL, 1);
+    for (const auto& timed : reports) {
+        EXPECT_LE(timed.report.v, 1);
+    }
+}
+
+TEST_F(MousekeySmooth, ChangingKeysDoesNotRepeatTheStep) {
+    TestDriver driver;
+    KeymapKey  right_key = KeymapKey{0, 0, 0, QK_MOUSE_CURSOR_RIGHT};
+    KeymapKey  down_key  = KeymapKey{0, 1, 0, QK_MOUSE_CURSOR_DOWN};
+    set_keymap({right_key, down_key});
+    record_reports(driver);
+
+    right_key.press();
+    idle_for(MOUSEKEY_INTERVAL * MOUSEKEY_TIME_TO_MAX);
+    reports.clear();
+    down_key.press();
+    idle_for(100);
+    right_key.release();
+    idle_for(100);
+    down_key.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    // Only the key pressed steps, the one still held carries on at its speed
+    const int32_t speed = MOUSEKEY_MOVE_DELTA * MOUSEKEY_MAX_SPEED / MOUSEKEY_INTERVAL;
+    EXPECT_EQ(reports.front().report.x, 0);
+    EXPECT_EQ(reports.front().report.y, MOUSEKEY_MOVE_DELTA);
+    for (size_t i = 1; i < reports.size(); i++) {
+        EXPECT_LE(std::abs(reports[i].report.x), speed);
+        EXPECT_LE(std::abs(reports[i].report.y), speed);
+    }
+}
@@ -0,0 +1,247 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <vector>
+
+#include "keyboard_report_util.hpp"
+#include "test_common.hpp"
+
+extern "C" {
+#include "usb_device_state.h"
+}
+
+using testing::_;
+using testing::AnyNumber;
+using testing::Invoke;
+
+// The keys held in an NKRO report, lowest keycode first
+static std::vector<uint8_t> nkro_keys(const report_nkro_t& report) {
+    std::vector<uint8_t> keys;
+    for (uint16_t key = 0; key < NKRO_REPORT_BITS * 8; key++) {
+        if (report.bits[key / 8] & (1 << (key % 8))) {
+            keys.push_back(key);
+        }
+    }
+    return keys;
+}
+
+class Nkro : public TestFixture {
+   public:
+    void SetUp() override {
+        TestFixture::SetUp();
+        keymap_config.nkro = true;
+        usb_device_state_set_protocol(USB_PROTOCOL_REPORT);
+    }
+
+    // Records every NKRO report sent while running `action`
+    std::vector<std::vector<uint8_t>> record(TestDriver& driver, std::function<void()> action) {
+        std::vector<std::vector<uint8_t>> reports;
+        EXPECT_CALL(driver, send_nkro_mock(_)).WillRepeatedly(Invoke([&reports](report_nkro_t& report) { reports.push_back(nkro_keys(report)); }));
+        EXPECT_CALL(driver, send_keyboard_mock(_)).Times(0);
+        action();
+        VERIFY_AND_CLEAR(driver);
+        return reports;
+    }
+};
+
+TEST_F(Nkro, HoldsMoreThanSixKeys) {
+    TestDriver            driver;
+    std::vector<KeymapKey> keys;
+    for (uint8_t col = 0; col < 10; col++) {
+        keys.push_back(KeymapKey(0, col, 0, KC_A + col));
+    }
+    set_keymap({keys[0], keys[1], keys[2], keys[3], keys[4], keys[5], keys[6], keys[7], keys[8], keys[9]});
+
+    auto reports = record(driver, [&]() {
+        for (auto& key : keys) {
+            key.press();
+            run_one_scan_loop();
+        }
+    });
+
+    ASSERT_EQ(reports.size(), 10);
+    EXPECT_EQ(reports.back().size(), 10);
+    EXPECT_EQ(get_first_key(), KC_A);
+    EXPECT_EQ(has_anykey(), 10);
+
+    reports = record(driver, [&]() {
+        for (auto& key : keys) {
+            key.release();
+            run_one_scan_loop();
+        }
+    });
+    ASSERT_EQ(reports.size(), 10);
+    EXPECT_TRUE(reports.back().empty());
+    EXPECT_EQ(get_first_key(), KC_NO);
+    EXPECT_EQ(has_anykey(), 0);
+}
+
+TEST_F(Nkro, FirstKeyIsLowestKeycode) {
+    TestDriver driver;
+    auto       key_high = KeymapKey(0, 0, 0, KC_F24);
+    auto       key_low  = KeymapKey(0, 1, 0, KC_B);
+
+    set_keymap({key_high, key_low});
+
+    record(driver, [&]() {
+        key_high.press();
+        run_one_scan_loop();
+    });
+    EXPECT_EQ(get_first_key(), KC_F24);
+
+    record(driver, [&]() {
+        key_low.press();
+        run_one_scan_loop();
+    });
+    EXPECT_EQ(get_first_key(), KC_B);
+    EXPECT_TRUE(is_key_pressed(KC_F24));
+
+    record(driver, [&]() {
+        key_high.release();
+        key_low.release();
+        run_one_scan_loop();
+    });
+}
+
+TEST_F(Nkro, UnchangedReportIsNotResent) {
+    TestDriver driver;
+    auto       key = KeymapKey(0, 0, 0, KC_A);
+
+    set_keymap({key});
+
+    auto reports = record(driver, [&]() {
+        key.press();
+        run_one_scan_loop();
+        send_keyboard_report();
+        send_keyboard_report();
+    });
+    EXPECT_EQ(reports.size(), 1);
+
+    reports = record(driver, [&]() {
+        key.release();
+        run_one_scan_loop();
+        send_keyboard_report();
+    });
+    EXPECT_EQ(reports.size(), 1);
+}
+
+TEST_F(Nkro, BootProtocolUsesSixKeyReport) {
+    TestDriver driver;
+    auto       key = KeymapKey(0, 0, 0, KC_A);
+
+    set_keymap({key});
+    usb_device_state_set_protocol(USB_PROTOCOL_BOOT);
+
+    EXPECT_CALL(driver, send_nkro_mock(_)).Times(0);
+    EXPECT_REPORT(driver, (KC_A));
+    key.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_CALL(driver, send_nkro_mock(_)).Times(0);
+    EXPECT_EMPTY_REPORT(driver);
+    key.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    usb_device_state_set_protocol(USB_PROTOCOL_REPORT);
+    auto reports = record(driver, [&]() { send_keyboard_report(); });
+    ASSERT_EQ(reports.size(), 1);
+    EXPECT_TRUE(reports[0].empty());
+}
+
+TEST_F(Nkro, HeldKeysFollowSwitchToBootProtocol) {
+    TestDriver driver;
+    auto       key_a = KeymapKey(0, 0, 0, KC_A);
+    auto       key_b = KeymapKey(0, 1, 0, KC_B);
+
+    set_keymap({key_a, key_b});
+
+    record(driver, [&]() {
+        key_a.press();
+        run_one_scan_loop();
+    });
+
+    // The host switches to boot protocol while A is held, A is then released
+    usb_device_state_set_protocol(USB_PROTOCOL_BOOT);
+
+    EXPECT_CALL(driver, send_nkro_mock(_)).Times(0);
+    EXPECT_REPORT(driver, (KC_A, KC_B));
+    key_b.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_CALL(driver, send_nkro_mock(_)).Times(0);
+    EXPECT_REPORT(driver, (KC_B));
+    key_a.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    // Back in report protocol, B is still held and A isn't stuck
+    usb_device_state_set_protocol(USB_PROTOCOL_REPORT);
+    auto reports = record(driver, [&]() { send_keyboard_report(); });
+    ASSERT_EQ(reports.size(), 1);
+    EXPECT_EQ(reports[0], std::vector<uint8_t>({KC_B}));
+
+    reports = record(driver, [&]() {
+        key_b.release();
+        run_one_scan_loop();
+    });
+    ASSERT_EQ(reports.size(), 1);
+    EXPECT_TRUE(reports[0].empty());
+}
+
+TEST_F(Nkro, RepeatedStateIsResentAfterSwitch) {
+    TestDriver driver;
+    auto       key = KeymapKey(0, 0, 0, KC_A);
+
+    set_keymap({key});
+
+    record(driver, [&]() {
+        key.press();
+        run_one_scan_loop();
+    });
+
+    // The host hasn't seen an NKRO report since switching back, so the same state is sent again
+    usb_device_state_set_protocol(USB_PROTOCOL_BOOT);
+    EXPECT_CALL(driver, send_nkro_mock(_)).Times(0);
+    EXPECT_REPORT(driver, (KC_A));
+    send_keyboard_report();
+    VERIFY_AND_CLEAR(driver);
+
+    usb_device_state_set_protocol(USB_PROTOCOL_REPORT);
+    auto reports = record(driver, [&]() { send_keyboard_report(); });
+    ASSERT_EQ(reports.size(), 1);
+    EXPECT_EQ(reports[0], std::vector<uint8_t>({KC_A}));
+
+    record(driver, [&]() {
+        key.release();
+        run_one_scan_loop();
+    });
+}
+
+TEST_F(Nkro, TogglingNkroMovesHeldKeys) {
+    TestDriver driver;
+    auto       key = KeymapKey(0, 0, 0, KC_A);
+
+    set_keymap({key});
+    keymap_config.nkro = false;
+
+    EXPECT_REPORT(driver, (KC_A));
+    key.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    keymap_config.nkro = true;
+    auto reports       = record(driver, [&]() { send_keyboard_report(); });
+    ASSERT_EQ(reports.size(), 1);
+    EXPECT_EQ(reports[0], std::vector<uint8_t>({KC_A}));
+
+    reports = record(driver, [&]() {
+        key.release();
+        run_one_scan_loop();
+    });
+    ASSERT_EQ(reports.size(), 1);
+    EXPECT_TRUE(reports[0].empty());
+}
@@ -0,0 +1,231 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include "gtest/gtest.h"
+#include "mouse_report_util.hpp"
+#include "test_common.hpp"
+#include "test_pointing_device_driver.h"
+
+extern "C" {
+#include "eeconfig.h"
+}
+
+using testing::_;
+
+static const pointing_device_accel_curve_t curves[] = {
+    POINTING_DEVICE_ACCEL_CURVE_LINEAR,
+    POINTING_DEVICE_ACCEL_CURVE_SIGMOID,
+    POINTING_DEVICE_ACCEL_CURVE_POWER,
+};
+
+/* The curves computed in floating point, the way keymaps accelerate the pointer without the tables. */
+static double reference_gain(pointing_device_accel_curve_t curve, uint8_t level, double speed) {
+    double span = POINTING_DEVICE_ACCEL_LUT_SIZE - 1 - POINTING_DEVICE_ACCEL_OFFSET;
+    double t    = (speed * (POINTING_DEVICE_ACCEL_LUT_SIZE - 1) / POINTING_DEVICE_ACCEL_SPEED_MAX - POINTING_DEVICE_ACCEL_OFFSET) / span;
+    t           = std::fmin(std::fmax(t, 0.0), 1.0);
+
+    double shape = t;
+    switch (curve) {
+        case POINTING_DEVICE_ACCEL_CURVE_SIGMOID:
+            shape = t * t * (3 - 2 * t);
+            break;
+        case POINTING_DEVICE_ACCEL_CURVE_POWER:
+            shape = t * t;
+            break;
+        default:
+            break;
+    }
+    // The tables run to 255, so the gain tops out 255/256 of the way to the level
+    return 1 + level * POINTING_DEVICE_ACCEL_LEVEL_GAIN / 256.0 * shape * 255 / 256;
+}
+
+/* Accelerates a report with the floating point curves, carrying the fractions like the firmware does. */
+__attribute__((noinline)) static report_mouse_t reference_apply(pointing_device_accel_curve_t curve, uint8_t level, report_mouse_t mouse_report) {
+    static double remainder_x = 0, remainder_y = 0;
+
+    double gain = reference_gain(curve, level, std::hypot(mouse_report.x, mouse_report.y));
+    remainder_x += mouse_report.x * gain;
+    remainder_y += mouse_report.y * gain;
+    mouse_report.x = (mouse_xy_report_t)remainder_x;
+    mouse_report.y = (mouse_xy_report_t)remainder_y;
+    remainder_x -= mouse_report.x;
+    remainder_y -= mouse_report.y;
+    return mouse_report;
+}
+
+class PointingAccel : public TestFixture {
+   public:
+    void SetUp() override {
+        TestFixture::SetUp();
+        eeconfig_update_pointing_device(0);
+        pointing_device_accel_init();
+        pd_clear_movement();
+    }
+};
+
+TEST_F(PointingAccel, GainIsMonotonic) {
+    for (auto curve : curves) {
+        pointing_device_accel_set_curve(curve);
+        for (uint8_t level = 0; level <= POINTING_DEVICE_ACCEL_LEVEL_MAX; level++) {
+            pointing_device_accel_set_level(level);
+            uint16_t last_gain = 0;
+            for (uint16_t speed = 0; speed < 4 * POINTING_DEVICE_ACCEL_SPEED_MAX; speed++) {
+                uint16_t gain = pointing_device_accel_gain(speed);
+                EXPECT_GE(gain, last_gain) << "curve " << curve << " level " << +level << " speed " << speed;
+                EXPECT_GE(gain, 256);
+                last_gain = gain;
+            }
+        }
+    }
+}
+
+TEST_F(PointingAccel, GainIncreasesWithLevel) {
+    for (auto curve : curves) {
+        pointing_device_accel_set_curve(curve);
+        for (uint16_t speed = 0; speed < 2 * POINTING_DEVICE_ACCEL_SPEED_MAX; speed++) {
+            uint16_t last_gain = 0;
+            for (uint8_t level = 0; level <= POINTING_DEVICE_ACCEL_LEVEL_MAX; level++) {
+                pointing_device_accel_set_level(level);
+                uint16_t gain = pointing_device_accel_gain(speed);
+                EXPECT_GE(gain, last_gain) << "curve " << curve << " level " << +level << " speed " << speed;
+                last_gain = gain;
+            }
+        }
+    }
+}
+
+TEST_F(PointingAccel, GainMatchesFloatReference) {
+    for (auto curve : curves) {
+        pointing_device_accel_set_curve(curve);
+        for (uint8_t level = 0; level <= POINTING_DEVICE_ACCEL_LEVEL_MAX; level++) {
+            pointing_device_accel_set_level(level);
+            // Within a step of the table and a step of the gain
+            double tolerance = (level * POINTING_DEVICE_ACCEL_LEVEL_GAIN / 255.0 + 1) / 256;
+            for (uint16_t speed = 0; speed <= POINTING_DEVICE_ACCEL_SPEED_MAX; speed++) {
+                EXPECT_NEAR(pointing_device_accel_gain(speed) / 256.0, reference_gain(curve, level, speed), tolerance) << "curve " << curve << " level " << +level << " speed " << speed;
+            }
+        }
+    }
+}
+
+TEST_F(PointingAccel, SlowMotionIsNotAccelerated) {
+    TestDriver driver;
+
+    pd_set_x(POINTING_DEVICE_ACCEL_OFFSET);
+    EXPECT_MOUSE_REPORT(driver, (POINTING_DEVICE_ACCEL_OFFSET, 0, 0, 0, 0));
+    run_one_scan_loop();
+    pd_clear_movement();
+    run_one_scan_loop();
+
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(PointingAccel, FastMotionIsAccelerated) {
+    TestDriver driver;
+
+    pointing_device_accel_set_curve(POINTING_DEVICE_ACCEL_CURVE_LINEAR);
+    pointing_device_accel_set_level(4);
+    // Full speed, 1 + 4 * 48 / 256 times
+    pd_set_x(-63);
+    EXPECT_MOUSE_REPORT(driver, (-110, 0, 0, 0, 0));
+    run_one_scan_loop();
+    pd_clear_movement();
+    run_one_scan_loop();
+
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(PointingAccel, LevelZeroLeavesMotionAlone) {
+    TestDriver driver;
+
+    pointing_device_accel_set_level(0);
+    pd_set_x(100);
+    pd_set_y(-50);
+    EXPECT_MOUSE_REPORT(driver, (100, -50, 0, 0, 0));
+    run_one_scan_loop();
+    pd_clear_movement();
+    run_one_scan_loop();
+
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(PointingAccel, KeycodesAdjustAndPersistSettings) {
+    TestDriver driver;
+    KeymapKey  curve_key = KeymapKey(0, 0, 0, PD_ACRV);
+    KeymapKey  up_key    = KeymapKey(0, 1, 0, PD_ACUP);
+    KeymapKey  down_key  = KeymapKey(0, 2, 0, PD_ACDN);
+    set_keymap({curve_key, up_key, down_key});
+    EXPECT_NO_REPORT(driver);
+
+    EXPECT_EQ(pointing_device_accel_get_curve(), POINTING_DEVICE_ACCEL_DEFAULT_CURVE);
+    EXPECT_EQ(pointing_device_accel_get_level(), POINTING_DEVICE_ACCEL_DEFAULT_LEVEL);
+
+    tap_key(curve_key);
+    tap_key(up_key);
+    tap_key(up_key);
+    tap_key(down_key);
+    VERIFY_AND_CLEAR(driver);
+
+    const uint8_t curve = (POINTING_DEVICE_ACCEL_DEFAULT_CURVE + 1) % POINTING_DEVICE_ACCEL_CURVE_COUNT;
+    EXPECT_EQ(pointing_device_accel_get_curve(), curve);
+    EXPECT_EQ(pointing_device_accel_get_level(), POINTING_DEVICE_ACCEL_DEFAULT_LEVEL + 1);
+
+    // The settings survive a restart
+    pointing_device_accel_set_level(0);
+    eeconfig_update_pointing_device((pointing_device_accel_config_t){.level = POINTING_DEVICE_ACCEL_DEFAULT_LEVEL + 1, .curve = curve, .is_valid = true}.raw);
+    pointing_device_accel_init();
+    EXPECT_EQ(pointing_device_accel_get_curve(), curve);
+    EXPECT_EQ(pointing_device_accel_get_level(), POINTING_DEVICE_ACCEL_DEFAULT_LEVEL + 1);
+}
+
+TEST_F(PointingAccel, LevelStaysInRange) {
+    TestDriver driver;
+    KeymapKey  up_key   = KeymapKey(0, 0, 0, PD_ACUP);
+    KeymapKey  down_key = KeymapKey(0, 1, 0, PD_ACDN);
+    set_keymap({up_key, down_key});
+    EXPECT_NO_REPORT(driver);
+
+    for (int i = 0; i <= POINTING_DEVICE_ACCEL_LEVEL_MAX; i++) {
+        tap_key(up_key);
+    }
+    EXPECT_EQ(pointing_device_accel_get_level(), POINTING_DEVICE_ACCEL_LEVEL_MAX);
+    for (int i = 0; i <= POINTING_DEVICE_ACCEL_LEVEL_MAX; i++) {
+        tap_key(down_key);
+    }
+    EXPECT_EQ(pointing_device_accel_get_level(), 0);
+    VERIFY_AND_CLEAR(driver);
+}
+
+/*
+ * Times the tables against the same curves in floating point. The host has
+ * an FPU, so this understates the gap on boards that emulate floats such as
+ * Cortex-M0, but shows the cost of each path relative to the other.
+ */
+TEST_F(PointingAccel, Benchmark) {
+    const int reports = 1000000;
+    pointing_device_accel_set_curve(POINTING_DEVICE_ACCEL_CURVE_SIGMOID);
+    pointing_device_accel_set_level(8);
+
+    volatile int32_t sink  = 0;
+    auto             start = std::chrono::steady_clock::now();
+    for (int i = 0; i < reports; i++) {
+        report_mouse_t report = {.x = (mouse_xy_report_t)(i % 97 - 48), .y = (mouse_xy_report_t)(i % 31 - 15)};
+        report                = pointing_device_accel_apply(report);
+        sink                  = sink + report.x + report.y;
+    }
+    auto lut_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < reports; i++) {
+        report_mouse_t report = {.x = (mouse_xy_report_t)(i % 97 - 48), .y = (mouse_xy_report_t)(i % 31 - 15)};
+        report                = reference_apply(POINTING_DEVICE_ACCEL_CURVE_SIGMOID, 8, report);
+        sink                  = sink + report.x + report.y;
+    }
+    auto float_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << "lookup tables: " << (double)lut_ns / reports << " ns per report" << std::endl;
+    std::cout << "floating point: " << (double)float_ns / reports << " ns per report" << std::endl;
+}
@@ -0,0 +1,11 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+#define POINTING_DEVICE_AUTO_MOUSE_ENABLE
+#define AUTO_MOUSE_HOLD_THRESHOLD 2
+#define AUTO_MOUSE_THRESHOLD_TIME 50
+#define AUTO_MOUSE_KEY_LAYERS 2
@@ -0,0 +1,219 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+#include "keyboard_report_util.hpp"
+#include "test_common.hpp"
+#include "test_pointing_device_driver.h"
+
+using testing::_;
+using testing::AnyNumber;
+
+/* The auto mouse layer reads mouse key positions from the keymap, which is the test's keymap here. */
+extern "C" uint16_t keycode_at_keymap_location(uint8_t layer_num, uint8_t row, uint8_t column) {
+    const KeymapKey* key = TestFixture::m_this->find_key(layer_num, {.col = column, .row = row});
+    return key ? key->code : KC_NO;
+}
+
+extern "C" uint8_t keymap_layer_count(void) {
+    return 4;
+}
+
+extern "C" bool is_mouse_record_user(uint16_t keycode, keyrecord_t* record) {
+    return keycode == KC_ENT;
+}
+
+class AutoMouse : public TestFixture {
+   public:
+    void SetUp() override {
+        TestFixture::SetUp();
+        set_auto_mouse_enable(false);
+        set_auto_mouse_enable(true);
+        pd_clear_movement();
+
+        // Past the lockout after a key press, which starts at power on
+        TestDriver driver;
+        idle_for(TAPPING_TERM + 1);
+    }
+
+    void set_mouse_keymap(std::initializer_list<KeymapKey> keys) {
+        set_keymap(keys);
+        auto_mouse_keymap_changed();
+    }
+
+    void move(mouse_xy_report_t x) {
+        pd_set_x(x);
+        run_one_scan_loop();
+        pd_clear_movement();
+    }
+};
+
+TEST_F(AutoMouse, MotionPastThresholdTurnsLayerOn) {
+    TestDriver driver;
+    EXPECT_NO_REPORT(driver);
+    EXPECT_ANY_MOUSE_REPORT(driver).Times(AnyNumber());
+
+    move(AUTO_MOUSE_THRESHOLD);
+    EXPECT_FALSE(layer_state_is(AUTO_MOUSE_DEFAULT_LAYER));
+    move(1);
+    EXPECT_TRUE(layer_state_is(AUTO_MOUSE_DEFAULT_LAYER));
+
+    idle_for(AUTO_MOUSE_TIME - AUTO_MOUSE_DEBOUNCE);
+    EXPECT_TRUE(layer_state_is(AUTO_MOUSE_DEFAULT_LAYER));
+    idle_for(2 * AUTO_MOUSE_DEBOUNCE);
+    EXPECT_FALSE(layer_state_is(AUTO_MOUSE_DEFAULT_LAYER));
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(AutoMouse, LessMotionKeepsLayerOn) {
+    TestDriver driver;
+    EXPECT_NO_REPORT(driver);
+    EXPECT_ANY_MOUSE_REPORT(driver).Times(AnyNumber());
+
+    move(AUTO_MOUSE_THRESHOLD + 1);
+    EXPECT_TRUE(layer_state_is(AUTO_MOUSE_DEFAULT_LAYER));
+
+    // Too little to turn the layer on, but enough to keep it on
+    for (int time = 0; time < 2 * AUTO_MOUSE_TIME; time += AUTO_MOUSE_DEBOUNCE + 1) {
+        idle_for(AUTO_MOUSE_DEBOUNCE);
+        move(AUTO_MOUSE_HOLD_THRESHOLD + 1);
+    }
+    EXPECT_TRUE(layer_state_is(AUTO_MOUSE_DEFAULT_LAYER));
+
+    idle_for(AUTO_MOUSE_TIME + AUTO_MOUSE_DEBOUNCE);
+    EXPECT_FALSE(layer_state_is(AUTO_MOUSE_DEFAULT_LAYER));
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(AutoMouse, SlowDriftDoesNotTurnLayerOn) {
+    TestDriver driver;
+    EXPECT_NO_REPORT(driver);
+    EXPECT_ANY_MOUSE_REPORT(driver).Times(AnyNumber());
+
+    // Many times the threshold in all, but never within the time to reach it
+    for (int i = 0; i < 50; i++) {
+        idle_for(AUTO_MOUSE_THRESHOLD_TIME / 2);
+        move(AUTO_MOUSE_HOLD_THRESHOLD + 1);
+        EXPECT_FALSE(layer_state_is(AUTO_MOUSE_DEFAULT_LAYER));
+    }
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(AutoMouse, MouseKeyHoldsLayer) {
+    TestDriver driver;
+    KeymapKey  regular_key = KeymapKey(0, 0, 0, KC_A);
+    KeymapKey  mouse_key   = KeymapKey(AUTO_MOUSE_DEFAULT_LAYER, 0, 0, MS_UP);
+    set_mouse_keymap({regular_key, mouse_key});
+    EXPECT_NO_REPORT(driver);
+    EXPECT_ANY_MOUSE_REPORT(driver).Times(AnyNumber());
+
+    move(AUTO_MOUSE_THRESHOLD + 1);
+    mouse_key.press();
+    run_one_scan_loop();
+    EXPECT_EQ(get_auto_mouse_key_tracker(), 1);
+
+    idle_for(2 * AUTO_MOUSE_TIME);
+    EXPECT_TRUE(layer_state_is(AUTO_MOUSE_DEFAULT_LAYER));
+
+    mouse_key.release();
+    run_one_scan_loop();
+    EXPECT_EQ(get_auto_mouse_key_tracker(), 0);
+    idle_for(AUTO_MOUSE_TIME + AUTO_MOUSE_DEBOUNCE);
+    EXPECT_FALSE(layer_state_is(AUTO_MOUSE_DEFAULT_LAYER));
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(AutoMouse, OtherKeyTurnsLayerOff) {
+    TestDriver driver;
+    KeymapKey  regular_key = KeymapKey(0, 1, 0, KC_A);
+    set_mouse_keymap({regular_key, KeymapKey(AUTO_MOUSE_DEFAULT_LAYER, 1, 0, KC_TRNS)});
+    EXPECT_ANY_MOUSE_REPORT(driver).Times(AnyNumber());
+
+    move(AUTO_MOUSE_THRESHOLD + 1);
+    idle_for(AUTO_MOUSE_DEBOUNCE + 1);
+    EXPECT_TRUE(layer_state_is(AUTO_MOUSE_DEFAULT_LAYER));
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(regular_key);
+    EXPECT_FALSE(layer_state_is(AUTO_MOUSE_DEFAULT_LAYER));
+    EXPECT_EQ(get_auto_mouse_key_tracker(), 0);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(AutoMouse, ChangedKeymapIsPickedUp) {
+    TestDriver driver;
+    KeymapKey  regular_key = KeymapKey(0, 2, 1, KC_A);
+    set_mouse_keymap({regular_key});
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    regular_key.press();
+    run_one_scan_loop();
+    EXPECT_EQ(get_auto_mouse_key_tracker(), 0);
+    regular_key.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    KeymapKey mouse_key = KeymapKey(0, 2, 1, MS_UP);
+    set_mouse_keymap({mouse_key});
+    EXPECT_NO_REPORT(driver);
+    mouse_key.press();
+    run_one_scan_loop();
+    EXPECT_EQ(get_auto_mouse_key_tracker(), 1);
+    mouse_key.release();
+    run_one_scan_loop();
+    EXPECT_EQ(get_auto_mouse_key_tracker(), 0);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(AutoMouse, KeyReleasedAfterKeymapChangeIsStillMouseKey) {
+    TestDriver driver;
+    KeymapKey  mouse_key = KeymapKey(0, 3, 2, MS_UP);
+    set_mouse_keymap({mouse_key});
+    EXPECT_NO_REPORT(driver);
+
+    mouse_key.press();
+    run_one_scan_loop();
+    EXPECT_EQ(get_auto_mouse_key_tracker(), 1);
+
+    // Released as a regular key, it is counted the way it was pressed so the layer is not held forever
+    set_mouse_keymap({KeymapKey(0, 3, 2, KC_NO)});
+    mouse_key.release();
+    run_one_scan_loop();
+    EXPECT_EQ(get_auto_mouse_key_tracker(), 0);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(AutoMouse, CallbackKeysAreMouseKeys) {
+    TestDriver driver;
+    KeymapKey  enter_key = KeymapKey(0, 4, 0, KC_ENT);
+    set_mouse_keymap({enter_key});
+
+    EXPECT_REPORT(driver, (KC_ENT));
+    enter_key.press();
+    run_one_scan_loop();
+    EXPECT_EQ(get_auto_mouse_key_tracker(), 1);
+
+    EXPECT_EMPTY_REPORT(driver);
+    enter_key.release();
+    run_one_scan_loop();
+    EXPECT_EQ(get_auto_mouse_key_tracker(), 0);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(AutoMouse, KeysOnLayersPastTheMapAreCheckedByKeycode) {
+    TestDriver driver;
+    KeymapKey  mouse_key = KeymapKey(AUTO_MOUSE_KEY_LAYERS, 5, 0, MS_UP);
+    set_mouse_keymap({mouse_key});
+    EXPECT_NO_REPORT(driver);
+
+    layer_on(AUTO_MOUSE_KEY_LAYERS);
+    mouse_key.press();
+    run_one_scan_loop();
+    EXPECT_EQ(get_auto_mouse_key_tracker(), 1);
+    mouse_key.release();
+    run_one_scan_loop();
+    EXPECT_EQ(get_auto_mouse_key_tracker(), 0);
+    VERIFY_AND_CLEAR(driver);
+}
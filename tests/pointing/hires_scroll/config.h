@@ -0,0 +1,9 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+#define WHEEL_EXTENDED_REPORT
+#define POINTING_DEVICE_HIRES_SCROLL_ENABLE
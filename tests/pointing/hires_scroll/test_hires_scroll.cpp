@@ -0,0 +1,197 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <vector>
+#include "gtest/gtest.h"
+#include "mouse_report_util.hpp"
+#include "test_common.hpp"
+#include "test_pointing_device_driver.h"
+
+extern "C" {
+#include "usb_device_state.h"
+}
+
+using testing::_;
+using testing::Invoke;
+
+// Resolution multiplier feature report, vertical wheel in bits 0-1 and horizontal in bits 2-3
+#define RESOLUTION_MULTIPLIER_V 0x01
+#define RESOLUTION_MULTIPLIER_H 0x04
+
+static uint8_t numerator   = 1;
+static uint8_t denominator = 1;
+static bool    drag_scroll = false;
+
+static pointing_device_scale_remainder_t scale_remainder;
+
+extern "C" report_mouse_t pointing_device_task_user(report_mouse_t mouse_report) {
+    if (drag_scroll) {
+        mouse_report.h = mouse_report.x;
+        mouse_report.v = mouse_report.y;
+        mouse_report.x = 0;
+        mouse_report.y = 0;
+    }
+    return pointing_device_scale_report(mouse_report, numerator, denominator, &scale_remainder);
+}
+
+class HiresScroll : public TestFixture {
+   public:
+    void SetUp() override {
+        TestFixture::SetUp();
+        usb_device_state_set_resolution_multiplier(0);
+        numerator       = 1;
+        denominator     = 1;
+        drag_scroll     = false;
+        scale_remainder = {};
+        pd_clear_movement();
+    }
+
+    /* Records every mouse report, to check the motion sent in total rather than each report. */
+    void record_reports(TestDriver& driver) {
+        EXPECT_CALL(driver, send_mouse_mock(_)).WillRepeatedly(Invoke([this](report_mouse_t& report) { reports.push_back(report); }));
+    }
+
+    void scan_with_motion(int16_t x, int16_t y) {
+        pd_set_x(x);
+        pd_set_y(y);
+        run_one_scan_loop();
+        pd_clear_movement();
+    }
+
+    int32_t sent_x(void) {
+        int32_t x = 0;
+        for (const auto& report : reports) {
+            x += report.x;
+        }
+        return x;
+    }
+
+    int32_t sent_v(void) {
+        int32_t v = 0;
+        for (const auto& report : reports) {
+            v += report.v;
+        }
+        return v;
+    }
+
+    std::vector<report_mouse_t> reports;
+};
+
+TEST_F(HiresScroll, WholeDetentsWithoutResolutionMultiplier) {
+    TestDriver driver;
+
+    pd_set_v(2);
+    EXPECT_MOUSE_REPORT(driver, (0, 0, 0, 2, 0));
+    run_one_scan_loop();
+    pd_clear_movement();
+    run_one_scan_loop();
+
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(HiresScroll, WholeDetentsAreMultipliedForTheHost) {
+    TestDriver driver;
+
+    usb_device_state_set_resolution_multiplier(RESOLUTION_MULTIPLIER_V);
+    pd_set_v(2);
+    pd_set_h(1);
+    // Only the vertical wheel has its resolution multiplier enabled
+    EXPECT_MOUSE_REPORT(driver, (0, 0, 1, 2 * POINTING_DEVICE_HIRES_SCROLL_MULTIPLIER, 0));
+    run_one_scan_loop();
+    pd_clear_movement();
+    run_one_scan_loop();
+
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(HiresScroll, SlowDragScrollIsNotLost) {
+    TestDriver driver;
+    record_reports(driver);
+
+    drag_scroll = true;
+    denominator = 8;
+    for (int i = 0; i < 16; i++) {
+        scan_with_motion(0, 3);
+    }
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    // Every count reaches the host, a detent per eight
+    EXPECT_EQ(sent_v(), 6);
+}
+
+TEST_F(HiresScroll, DragScrollIsSentInFractionsOfADetent) {
+    TestDriver driver;
+
+    usb_device_state_set_resolution_multiplier(RESOLUTION_MULTIPLIER_V | RESOLUTION_MULTIPLIER_H);
+    drag_scroll = true;
+    denominator = 8;
+
+    // Each count scrolls an eighth of a detent straight away
+    EXPECT_MOUSE_REPORT(driver, (0, 0, 0, POINTING_DEVICE_HIRES_SCROLL_MULTIPLIER / 8, 0));
+    scan_with_motion(0, 1);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_MOUSE_REPORT(driver, (0, 0, -POINTING_DEVICE_HIRES_SCROLL_MULTIPLIER / 4, 0, 0));
+    scan_with_motion(-2, 0);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(HiresScroll, ScrollBeyondReportRangeIsCarried) {
+    TestDriver driver;
+    record_reports(driver);
+
+    usb_device_state_set_resolution_multiplier(RESOLUTION_MULTIPLIER_V);
+    pd_set_v(400);
+    run_one_scan_loop();
+    pd_clear_movement();
+    run_one_scan_loop();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EQ(sent_v(), 400 * POINTING_DEVICE_HIRES_SCROLL_MULTIPLIER);
+    for (const auto& report : reports) {
+        EXPECT_LE(report.v, HV_REPORT_MAX);
+    }
+}
+
+TEST_F(HiresScroll, SlowMotionIsCarried) {
+    TestDriver driver;
+    record_reports(driver);
+
+    // A quarter speed precision mode
+    denominator = 4;
+    for (int i = 0; i < 10; i++) {
+        scan_with_motion(1, 0);
+    }
+    scan_with_motion(2, 0);
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EQ(sent_x(), 3);
+}
+
+TEST_F(HiresScroll, RemaindersAreKeptPerCaller) {
+    pointing_device_scale_remainder_t thirds = {}, quarters = {};
+    int32_t                           x_thirds = 0, x_quarters = 0;
+
+    // Alternating denominators, as two modes scaling in the same report would
+    for (int i = 0; i < 12; i++) {
+        report_mouse_t report = {.x = 1};
+        x_thirds += pointing_device_scale_report(report, 1, 3, &thirds).x;
+        x_quarters += pointing_device_scale_report(report, 1, 4, &quarters).x;
+    }
+
+    EXPECT_EQ(x_thirds, 4);
+    EXPECT_EQ(x_quarters, 3);
+}
+
+TEST_F(HiresScroll, RemainderIsKeptAcrossDenominators) {
+    pointing_device_scale_remainder_t remainder = {};
+    report_mouse_t                    report    = {.x = 3};
+
+    // Three quarters of a count, then half a count make a whole one
+    EXPECT_EQ(pointing_device_scale_report(report, 1, 4, &remainder).x, 0);
+    report.x = 1;
+    EXPECT_EQ(pointing_device_scale_report(report, 1, 2, &remainder).x, 1);
+}
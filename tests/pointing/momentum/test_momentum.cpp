@@ -0,0 +1,268 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <cstdlib>
+#include <vector>
+#include "gtest/gtest.h"
+#include "mouse_report_util.hpp"
+#include "test_common.hpp"
+#include "test_pointing_device_driver.h"
+
+extern "C" {
+#include "timer.h"
+void advance_time(uint32_t ms);
+}
+
+using testing::_;
+using testing::Invoke;
+
+// Each test restarts the timer, which the glide's executor would see as time going backwards
+static uint32_t test_time = 0;
+// The fixture idles for this long in its clean-up, after TearDown()
+static const uint32_t clean_up_time = 2 * TAPPING_TERM * 10;
+
+struct TimedReport {
+    uint32_t       time;
+    report_mouse_t report;
+};
+
+class Momentum : public TestFixture {
+   public:
+    void SetUp() override {
+        TestFixture::SetUp();
+        advance_time(test_time);
+        pd_clear_movement();
+        pointing_device_momentum_stop();
+    }
+
+    void TearDown() override {
+        test_time = timer_read32() + clean_up_time + 1;
+        TestFixture::TearDown();
+    }
+
+    /* Records every mouse report with the time it was sent, to follow the path of the cursor. */
+    void record_reports(TestDriver& driver) {
+        EXPECT_CALL(driver, send_mouse_mock(_)).WillRepeatedly(Invoke([this](report_mouse_t& report) { reports.push_back({timer_read32(), report}); }));
+    }
+
+    /* Moves at speed counts per millisecond for duration milliseconds, with the sensor read every interval. */
+    void flick(int16_t speed, uint16_t duration, uint16_t interval) {
+        for (uint16_t time = interval; time <= duration; time += interval) {
+            idle_for(interval - 1);
+            pd_set_x(speed * interval);
+            run_one_scan_loop();
+            pd_clear_movement();
+        }
+    }
+
+    /* Cursor position along x at the given time. */
+    int32_t x_at(uint32_t time) {
+        int32_t x = 0;
+        for (const auto& timed : reports) {
+            if (timed.time <= time) {
+                x += timed.report.x;
+            }
+        }
+        return x;
+    }
+
+    int32_t sent_x(void) {
+        return x_at(UINT32_MAX);
+    }
+
+    std::vector<TimedReport> reports;
+};
+
+TEST_F(Momentum, FlickGlidesAfterRelease) {
+    TestDriver driver;
+    record_reports(driver);
+
+    flick(4, 64, 1);
+    int32_t  moved = sent_x();
+    uint32_t end   = timer_read32();
+    idle_for(1000);
+    VERIFY_AND_CLEAR(driver);
+
+    // Carries on for the speed times the time friction takes to slow it down, slowing down as it goes
+    EXPECT_EQ(moved, 4 * 64);
+    EXPECT_NEAR(sent_x() - moved, 4 * POINTING_DEVICE_MOMENTUM_DECAY_MS, 4 * POINTING_DEVICE_MOMENTUM_DECAY_MS / 20);
+    EXPECT_GT(x_at(end + 100) - x_at(end), x_at(end + 200) - x_at(end + 100));
+    EXPECT_EQ(x_at(end + 900), sent_x());
+}
+
+TEST_F(Momentum, SlowMotionDoesNotGlide) {
+    TestDriver driver;
+    record_reports(driver);
+
+    // A count every 8ms, below the trigger speed
+    for (int i = 0; i < 8; i++) {
+        idle_for(7);
+        pd_set_x(1);
+        run_one_scan_loop();
+        pd_clear_movement();
+    }
+    EXPECT_EQ(sent_x(), 8);
+    idle_for(500);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EQ(sent_x(), 8);
+}
+
+TEST_F(Momentum, MotionTakesOverFromGlide) {
+    TestDriver driver;
+    record_reports(driver);
+
+    flick(4, 64, 1);
+    idle_for(POINTING_DEVICE_MOMENTUM_RELEASE_MS + 50);
+    int32_t glided = sent_x();
+
+    // A single count, too little to measure a speed from, stops the glide
+    pd_set_x(-1);
+    run_one_scan_loop();
+    pd_clear_movement();
+    idle_for(500);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_GT(glided, 4 * 64);
+    EXPECT_EQ(sent_x(), glided - 1);
+}
+
+TEST_F(Momentum, ClickStopsGlide) {
+    TestDriver driver;
+    record_reports(driver);
+
+    flick(4, 64, 1);
+    idle_for(POINTING_DEVICE_MOMENTUM_RELEASE_MS + 50);
+    int32_t glided = sent_x();
+
+    pd_press_button(POINTING_DEVICE_BUTTON1);
+    run_one_scan_loop();
+    pd_release_button(POINTING_DEVICE_BUTTON1);
+    run_one_scan_loop();
+    idle_for(500);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_GT(glided, 4 * 64);
+    EXPECT_EQ(sent_x(), glided);
+}
+
+TEST_F(Momentum, GlideIsIndependentOfSensorRate) {
+    TestDriver driver;
+    record_reports(driver);
+
+    // The same flick, read every millisecond and then less often
+    std::vector<int32_t> reference;
+    for (uint16_t interval : {1, 2, 4, 8}) {
+        pointing_device_momentum_stop();
+        reports.clear();
+        uint32_t start = timer_read32();
+        flick(4, 64, interval);
+        idle_for(1000);
+
+        std::vector<int32_t> path;
+        for (uint32_t time = 0; time <= 64 + 1000; time += 10) {
+            path.push_back(x_at(start + time));
+        }
+        if (reference.empty()) {
+            reference = path;
+        }
+        for (size_t i = 0; i < path.size(); i++) {
+            // Within a report of the flick at its speed
+            EXPECT_NEAR(path[i], reference[i], 4 * interval) << "read every " << interval << "ms, at " << i * 10 << "ms";
+        }
+    }
+    VERIFY_AND_CLEAR(driver);
+}
+
+class MomentumEngine : public TestFixture {
+   public:
+    void SetUp() override {
+        TestFixture::SetUp();
+        context = {.config = {
+                       .friction = MOMENTUM_FRICTION_VISCOUS,
+                       .coef     = 65536 * 2 / 100,
+                       .trigger  = 256,
+                       .release  = 20,
+                       .step     = 2,
+                   }};
+    }
+
+    /* Starts gliding at speed counts per step along x. */
+    void glide(int32_t speed) {
+        context.status = {.state = MOMENTUM_GLIDING, .sampled = true, .vx = speed * 256};
+    }
+
+    /* Steps the glide every step milliseconds, taking it every interval, until it has stopped. */
+    std::vector<int32_t> run(uint16_t interval) {
+        std::vector<int32_t> path;
+        int32_t              x       = 0;
+        bool                 running = true;
+        for (uint32_t time = 1; running || time % interval != 0; time++) {
+            if (running && time % context.config.step == 0) {
+                running = momentum_step(&context);
+            }
+            if (time % interval == 0) {
+                x += momentum_take(&context, INT8_MAX).dx;
+            }
+            path.push_back(x);
+        }
+        return path;
+    }
+
+    momentum_context_t context;
+};
+
+TEST_F(MomentumEngine, ViscousFrictionSlowsExponentially) {
+    glide(8);
+    std::vector<int32_t> path = run(1);
+
+    // Speed over the share lost each step
+    EXPECT_NEAR(path.back(), 8 * 50, 8);
+    // A third of the speed left after the time constant of 100ms
+    EXPECT_NEAR(path[200] - path[100], (path[100] - path[0]) / 2.718, 4);
+}
+
+TEST_F(MomentumEngine, KineticFrictionStopsAtPredictedDistance) {
+    context.config.friction = MOMENTUM_FRICTION_KINETIC;
+    context.config.coef     = 8;
+    glide(4);
+    std::vector<int32_t> path = run(1);
+
+    // v^2 / 2a, stopping after v / a steps
+    EXPECT_NEAR(path.back(), 4 * 256 * 4 / (2 * 8), 4);
+    EXPECT_NEAR(path.size(), 2 * 4 * 256 / 8, 8);
+}
+
+TEST_F(MomentumEngine, GlideIsIndependentOfPollRate) {
+    glide(8);
+    std::vector<int32_t> reference = run(1);
+
+    for (uint16_t interval : {3, 8, 10}) {
+        glide(8);
+        std::vector<int32_t> path = run(interval);
+        // The same at every report, with nothing lost at the end
+        for (size_t time = interval - 1; time < reference.size(); time += interval) {
+            EXPECT_EQ(path[time], reference[time]) << "taken every " << interval << "ms, at " << time << "ms";
+        }
+        EXPECT_EQ(path.back(), reference.back());
+    }
+}
+
+TEST_F(MomentumEngine, DiagonalGlideKeepsItsDirection) {
+    context.config.friction = MOMENTUM_FRICTION_KINETIC;
+    context.config.coef     = 8;
+    context.status          = {.state = MOMENTUM_GLIDING, .sampled = true, .vx = 4 * 256, .vy = -2 * 256};
+
+    int32_t x = 0, y = 0;
+    while (momentum_step(&context)) {
+        momentum_t glide = momentum_take(&context, INT8_MAX);
+        x += glide.dx;
+        y += glide.dy;
+    }
+    momentum_t glide = momentum_take(&context, INT8_MAX);
+    x += glide.dx;
+    y += glide.dy;
+
+    EXPECT_GT(x, 0);
+    EXPECT_NEAR(y, -x / 2, 2);
+}
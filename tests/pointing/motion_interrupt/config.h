@@ -0,0 +1,22 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+#define POINTING_DEVICE_MOTION_INTERRUPT
+#define POINTING_DEVICE_MOTION_PIN 0
+#define POINTING_DEVICE_TASK_THROTTLE_MS 8
+
+// The test platform has no GPIO, so the tests drive the motion pin
+#define gpio_set_pin_input(pin)
+#define gpio_read_pin(pin) pd_motion_pin
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+extern unsigned char pd_motion_pin;
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,139 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <vector>
+#include "gtest/gtest.h"
+#include "mouse_report_util.hpp"
+#include "test_common.hpp"
+#include "test_pointing_device_driver.h"
+
+using testing::_;
+using testing::Invoke;
+
+unsigned char pd_motion_pin = 0;
+
+static bool motion_triggered = false;
+static bool host_ready       = true;
+
+// Stand in for the pin interrupt and the USB endpoint of the platform
+extern "C" bool pointing_device_motion_interrupt_triggered(void) {
+    bool triggered   = motion_triggered;
+    motion_triggered = false;
+    return triggered;
+}
+
+extern "C" bool pointing_device_host_ready(void) {
+    return host_ready;
+}
+
+class MotionInterrupt : public TestFixture {
+   public:
+    void SetUp() override {
+        TestFixture::SetUp();
+        pd_motion_pin    = 0;
+        motion_triggered = false;
+        host_ready       = true;
+        pd_clear_movement();
+    }
+
+    /* Records every mouse report, to check the motion sent in total rather than each report. */
+    void record_reports(TestDriver& driver) {
+        EXPECT_CALL(driver, send_mouse_mock(_)).WillRepeatedly(Invoke([this](report_mouse_t& report) { reports.push_back(report); }));
+    }
+
+    /* Runs a scan with the sensor signalling motion on its pin, which is cleared by reading it. */
+    void scan_with_motion(int16_t x, int16_t y) {
+        pd_set_x(x);
+        pd_set_y(y);
+        pd_motion_pin = 1;
+        run_one_scan_loop();
+        pd_clear_movement();
+        pd_motion_pin = 0;
+    }
+
+    int32_t sent_x(void) {
+        int32_t x = 0;
+        for (const auto& report : reports) {
+            x += report.x;
+        }
+        return x;
+    }
+
+    std::vector<report_mouse_t> reports;
+};
+
+TEST_F(MotionInterrupt, SendMouseIsNotCalledWithoutMotion) {
+    TestDriver driver;
+    EXPECT_NO_MOUSE_REPORT(driver);
+
+    // The sensor isn't read until it signals motion
+    pd_set_x(10);
+    idle_for(2 * POINTING_DEVICE_TASK_THROTTLE_MS);
+    pd_clear_movement();
+
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(MotionInterrupt, MotionBetweenReportsIsAccumulated) {
+    TestDriver driver;
+    record_reports(driver);
+
+    for (int i = 0; i < 2 * POINTING_DEVICE_TASK_THROTTLE_MS; i++) {
+        scan_with_motion(10, 0);
+    }
+    idle_for(2 * POINTING_DEVICE_TASK_THROTTLE_MS);
+    VERIFY_AND_CLEAR(driver);
+
+    // Every read reaches the host, in one report per throttle period
+    EXPECT_EQ(sent_x(), 20 * POINTING_DEVICE_TASK_THROTTLE_MS);
+    EXPECT_LE(reports.size(), 3);
+}
+
+TEST_F(MotionInterrupt, MotionBeyondReportRangeIsCarried) {
+    TestDriver driver;
+    record_reports(driver);
+
+    for (int i = 0; i < 4; i++) {
+        scan_with_motion(100, 0);
+    }
+    idle_for(6 * POINTING_DEVICE_TASK_THROTTLE_MS);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EQ(sent_x(), 400);
+    for (const auto& report : reports) {
+        EXPECT_LE(report.x, XY_REPORT_MAX);
+    }
+}
+
+TEST_F(MotionInterrupt, InterruptCatchesMotionAfterPinClears) {
+    TestDriver driver;
+    record_reports(driver);
+
+    // The pin was pulsed between two scans
+    motion_triggered = true;
+    pd_set_x(7);
+    run_one_scan_loop();
+    pd_clear_movement();
+    idle_for(2 * POINTING_DEVICE_TASK_THROTTLE_MS);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EQ(sent_x(), 7);
+}
+
+TEST_F(MotionInterrupt, ReportWaitsForHostToTakeLastOne) {
+    TestDriver driver;
+    EXPECT_NO_MOUSE_REPORT(driver);
+
+    host_ready = false;
+    for (int i = 0; i < 5; i++) {
+        scan_with_motion(10, -3);
+    }
+    idle_for(2 * POINTING_DEVICE_TASK_THROTTLE_MS);
+    VERIFY_AND_CLEAR(driver);
+
+    // Everything read while the host was busy goes in the next report
+    EXPECT_MOUSE_REPORT(driver, (50, -15, 0, 0, 0));
+    host_ready = true;
+    idle_for(2 * POINTING_DEVICE_TASK_THROTTLE_MS);
+    VERIFY_AND_CLEAR(driver);
+}
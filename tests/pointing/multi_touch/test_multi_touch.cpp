@@ -0,0 +1,169 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <cstdlib>
+#include "gtest/gtest.h"
+#include "test_common.hpp"
+
+extern "C" {
+#include "pointing_device_gestures.h"
+}
+
+using testing::_;
+
+class MultiTouch : public TestFixture {
+   public:
+    void SetUp() override {
+        TestFixture::SetUp();
+        context = {.config   = {
+                       .scroll_trigger_px = 50,
+                       .pinch_trigger_px  = 50,
+                       .scroll_px         = 64,
+                       .pinch_px          = 25,
+                   },
+                   .momentum = {.config = {
+                                    .friction = MOMENTUM_FRICTION_VISCOUS,
+                                    .coef     = (256 - 240) * 256,
+                                    .trigger  = 2 * 256,
+                                    .release  = 20,
+                                    .step     = 10,
+                                }}};
+        h = v = zoom = 0;
+    }
+
+    /* Reports two fingers, adding up the gesture they make. */
+    multi_touch_t touch(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1) {
+        multi_touch_point_t points[2] = {{x0, y0}, {x1, y1}};
+        return add(multi_touch_update(&context, points, 2));
+    }
+
+    multi_touch_t lift(void) {
+        return add(multi_touch_update(&context, nullptr, 0));
+    }
+
+    multi_touch_t add(multi_touch_t gesture) {
+        h += gesture.h;
+        v += gesture.v;
+        zoom += gesture.zoom;
+        return gesture;
+    }
+
+    multi_touch_context_t context;
+    int32_t               h, v, zoom;
+};
+
+TEST_F(MultiTouch, FingersMovingTogetherScroll) {
+    for (uint16_t i = 0; i <= 40; i++) {
+        touch(1000, 1000 + 8 * i, 1200, 1000 + 8 * i);
+    }
+
+    // The first 56 pixels decide the gesture, the rest scroll a detent per 64
+    EXPECT_EQ(v, (320 - 56) / 64);
+    EXPECT_EQ(h, 0);
+    EXPECT_EQ(zoom, 0);
+}
+
+TEST_F(MultiTouch, FingersSpreadingApartZoomIn) {
+    for (uint16_t i = 0; i <= 40; i++) {
+        touch(1000 - 2 * i, 1000, 1200 + 2 * i, 1000);
+    }
+
+    // The first 52 pixels decide the gesture, the rest zoom a step per 25
+    EXPECT_EQ(zoom, (160 - 52) / 25);
+    EXPECT_EQ(h, 0);
+    EXPECT_EQ(v, 0);
+}
+
+TEST_F(MultiTouch, FingersClosingZoomOut) {
+    for (uint16_t i = 0; i <= 40; i++) {
+        touch(1000 + 2 * i, 1000, 1400 - 2 * i, 1000);
+    }
+
+    EXPECT_EQ(zoom, -(160 - 52) / 25);
+    EXPECT_EQ(v, 0);
+}
+
+TEST_F(MultiTouch, SmallMovementsAreIgnored) {
+    for (uint16_t i = 0; i < 100; i++) {
+        int16_t jitter = (i % 2) ? 2 : -2;
+        EXPECT_FALSE(touch(1000 + jitter, 1000, 1200, 1000 - jitter).valid);
+    }
+
+    EXPECT_EQ(h, 0);
+    EXPECT_EQ(v, 0);
+    EXPECT_EQ(zoom, 0);
+}
+
+TEST_F(MultiTouch, ScrollCarriesOnAfterLifting) {
+    TestDriver driver;
+    EXPECT_NO_REPORT(driver);
+
+    for (uint16_t i = 0; i <= 20; i++) {
+        touch(1000 + 32 * i, 1000, 1200 + 32 * i, 1000);
+        idle_for(context.momentum.config.step);
+    }
+    int32_t scrolled = h;
+    EXPECT_TRUE(lift().valid);
+
+    // Slowing down every interval until it stops
+    int32_t last    = INT32_MAX;
+    int     reports = 0;
+    while (context.status.state == MULTI_TOUCH_MOMENTUM && reports < 1000) {
+        idle_for(context.momentum.config.step);
+        add(multi_touch_check(&context));
+        EXPECT_LE(context.momentum.status.vx, last);
+        last = context.momentum.status.vx;
+        reports++;
+    }
+    EXPECT_EQ(context.status.state, MULTI_TOUCH_IDLE);
+    EXPECT_GT(h, scrolled);
+    // No further than the speed at lift off times 256 / (256 - 240)
+    EXPECT_LE(h - scrolled, 32 * 256 / (256 - 240) / 64 + 1);
+    EXPECT_EQ(v, 0);
+}
+
+TEST_F(MultiTouch, TouchingStopsMomentum) {
+    TestDriver driver;
+    EXPECT_NO_REPORT(driver);
+
+    for (uint16_t i = 0; i <= 20; i++) {
+        touch(1000, 1000 + 32 * i, 1200, 1000 + 32 * i);
+        idle_for(context.momentum.config.step);
+    }
+    lift();
+    idle_for(context.momentum.config.step);
+    EXPECT_TRUE(add(multi_touch_check(&context)).valid);
+
+    multi_touch_point_t point = {1000, 1000};
+    EXPECT_FALSE(add(multi_touch_update(&context, &point, 1)).valid);
+    int32_t scrolled = v;
+    idle_for(context.momentum.config.step);
+    EXPECT_FALSE(add(multi_touch_check(&context)).valid);
+    EXPECT_EQ(v, scrolled);
+}
+
+TEST_F(MultiTouch, RestingBeforeLiftingDoesNotCarryOn) {
+    TestDriver driver;
+    EXPECT_NO_REPORT(driver);
+
+    for (uint16_t i = 0; i <= 20; i++) {
+        touch(1000, 1000 + 32 * i, 1200, 1000 + 32 * i);
+        idle_for(context.momentum.config.step);
+    }
+    idle_for(context.momentum.config.release);
+    EXPECT_FALSE(lift().valid);
+    idle_for(context.momentum.config.step);
+    EXPECT_FALSE(multi_touch_check(&context).valid);
+}
+
+TEST_F(MultiTouch, PinchDoesNotCarryOn) {
+    TestDriver driver;
+    EXPECT_NO_REPORT(driver);
+
+    for (uint16_t i = 0; i <= 40; i++) {
+        touch(1000 - 4 * i, 1000, 1200 + 4 * i, 1000);
+    }
+    EXPECT_FALSE(lift().valid);
+    idle_for(context.momentum.config.step);
+    EXPECT_FALSE(multi_touch_check(&context).valid);
+}
@@ -0,0 +1,25 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+#include "test_common.h"
+
+#define POINTING_DEVICE_MOTION_INTERRUPT
+#define POINTING_DEVICE_MOTION_PIN 0
+#define POINTING_DEVICE_TASK_THROTTLE_MS 8
+#define PMW33XX_CS_PIN 0
+
+// The test platform has no GPIO, so the simulated sensor drives its active low motion pin, and its chip select is just a number
+#define gpio_set_pin_input_high(pin)
+#define gpio_read_pin(pin) sensor_motion_pin
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+typedef uint8_t pin_t;
+extern unsigned char sensor_motion_pin;
+#ifdef __cplusplus
+}
+#endif
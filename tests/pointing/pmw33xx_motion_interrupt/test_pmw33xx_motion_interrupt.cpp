@@ -0,0 +1,164 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+#include "gtest/gtest.h"
+#include "mouse_report_util.hpp"
+#include "test_common.hpp"
+
+extern "C" {
+#include "spi_master.h"
+#include "sensors/pmw3360.h"
+
+extern const uint8_t pmw33xx_firmware_signature[2];
+}
+
+using testing::_;
+using testing::Invoke;
+
+unsigned char sensor_motion_pin = 1;
+
+// A PMW3360 on the other end of the SPI bus, holding the counts moved since its last burst read
+static int32_t sensor_x     = 0;
+static int32_t sensor_y     = 0;
+static uint8_t sensor_reg   = 0;
+static bool    sensor_start = false;
+
+static void sensor_move(int32_t x, int32_t y) {
+    sensor_x += x;
+    sensor_y += y;
+
+    sensor_motion_pin = 0;
+}
+
+extern "C" {
+void spi_init(void) {}
+
+bool spi_start(pin_t slavePin, bool lsbFirst, uint8_t mode, uint16_t divisor) {
+    sensor_start = true;
+    return true;
+}
+
+spi_status_t spi_write(uint8_t data) {
+    if (sensor_start) {
+        sensor_reg   = data;
+        sensor_start = false;
+    }
+    return SPI_STATUS_SUCCESS;
+}
+
+spi_status_t spi_read(void) {
+    switch (sensor_reg) {
+        case REG_Product_ID:
+            return pgm_read_byte(&pmw33xx_firmware_signature[0]);
+        case REG_Inverse_Product_ID:
+            return pgm_read_byte(&pmw33xx_firmware_signature[1]);
+        default:
+            return 0;
+    }
+}
+
+spi_status_t spi_transmit(const uint8_t *data, uint16_t length) {
+    return SPI_STATUS_SUCCESS;
+}
+
+spi_status_t spi_receive(uint8_t *data, uint16_t length) {
+    if (sensor_reg != REG_Motion_Burst) {
+        return SPI_STATUS_ERROR;
+    }
+
+    // Motion, Observation, then the 16 bit deltas, little endian. Reading them clears the counts and the motion pin
+    int16_t x        = std::min<int32_t>(std::max<int32_t>(sensor_x, INT16_MIN), INT16_MAX);
+    int16_t y        = std::min<int32_t>(std::max<int32_t>(sensor_y, INT16_MIN), INT16_MAX);
+    uint8_t burst[6] = {(uint8_t)(x || y ? 0x80 : 0x00), 0, (uint8_t)x, (uint8_t)(x >> 8), (uint8_t)y, (uint8_t)(y >> 8)};
+
+    sensor_x          = 0;
+    sensor_y          = 0;
+    sensor_motion_pin = 1;
+
+    memcpy(data, burst, std::min<size_t>(length, sizeof(burst)));
+    return SPI_STATUS_SUCCESS;
+}
+
+void spi_stop(void) {}
+}
+
+class Pmw33xxMotionInterrupt : public TestFixture {
+   public:
+    void SetUp() override {
+        TestFixture::SetUp();
+        sensor_x          = 0;
+        sensor_y          = 0;
+        sensor_motion_pin = 1;
+    }
+
+    /* Records every mouse report, to check the motion sent in total rather than each report. */
+    void record_reports(TestDriver &driver) {
+        EXPECT_CALL(driver, send_mouse_mock(_)).WillRepeatedly(Invoke([this](report_mouse_t &report) { reports.push_back(report); }));
+    }
+
+    int32_t sent_x(void) {
+        int32_t x = 0;
+        for (const auto &report : reports) {
+            x += report.x;
+        }
+        return x;
+    }
+
+    int32_t sent_y(void) {
+        int32_t y = 0;
+        for (const auto &report : reports) {
+            y += report.y;
+        }
+        return y;
+    }
+
+    std::vector<report_mouse_t> reports;
+};
+
+TEST_F(Pmw33xxMotionInterrupt, SendsMotionReadInBursts) {
+    TestDriver driver;
+    record_reports(driver);
+
+    for (int i = 0; i < 4; i++) {
+        sensor_move(20, -5);
+        run_one_scan_loop();
+    }
+    idle_for(2 * POINTING_DEVICE_TASK_THROTTLE_MS);
+    VERIFY_AND_CLEAR(driver);
+
+    // The driver turns the sensor's axes around
+    EXPECT_EQ(sent_x(), -80);
+    EXPECT_EQ(sent_y(), 20);
+}
+
+TEST_F(Pmw33xxMotionInterrupt, CountsBeyondReportRangeAreNotLeftInTheDriver) {
+    TestDriver driver;
+    record_reports(driver);
+
+    // More than fits in a report, read in a single burst that also clears the motion pin
+    sensor_move(-1000, 300);
+    run_one_scan_loop();
+    EXPECT_EQ(sensor_motion_pin, 1);
+
+    // The sensor doesn't move again, so nothing else would signal the rest
+    idle_for(20 * POINTING_DEVICE_TASK_THROTTLE_MS);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EQ(sent_x(), 1000);
+    EXPECT_EQ(sent_y(), -300);
+    for (const auto &report : reports) {
+        EXPECT_LE(report.x, XY_REPORT_MAX);
+        EXPECT_GE(report.y, XY_REPORT_MIN);
+    }
+}
+
+TEST_F(Pmw33xxMotionInterrupt, SendMouseIsNotCalledWithoutMotion) {
+    TestDriver driver;
+    EXPECT_NO_MOUSE_REPORT(driver);
+
+    idle_for(2 * POINTING_DEVICE_TASK_THROTTLE_MS);
+    VERIFY_AND_CLEAR(driver);
+}
@@ -0,0 +1,169 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <functional>
+#include <vector>
+
+#include "keyboard_report_util.hpp"
+#include "test_common.hpp"
+
+using testing::_;
+using testing::Invoke;
+
+class SendString : public TestFixture {
+   public:
+    void TearDown() override {
+        send_string_async_cancel();
+        TestFixture::TearDown();
+    }
+
+    // Records every keyboard report sent while running `action`
+    std::vector<report_keyboard_t> record(TestDriver& driver, std::function<void()> action) {
+        std::vector<report_keyboard_t> reports;
+        EXPECT_CALL(driver, send_keyboard_mock(_)).WillRepeatedly(Invoke([&reports](report_keyboard_t& report) { reports.push_back(report); }));
+        action();
+        VERIFY_AND_CLEAR(driver);
+        return reports;
+    }
+
+    // Runs the main loop until the queued strings have been typed out, returning the number of scan loops taken
+    unsigned run_until_idle(unsigned limit = 10000) {
+        unsigned loops = 0;
+        while (send_string_async_active() && loops < limit) {
+            run_one_scan_loop();
+            loops++;
+        }
+        EXPECT_FALSE(send_string_async_active());
+        return loops;
+    }
+
+    void expect_same_reports(const char* string, uint8_t interval) {
+        TestDriver driver;
+
+        auto blocking = record(driver, [&]() { send_string_with_delay(string, interval); });
+        auto async    = record(driver, [&]() {
+            EXPECT_TRUE(send_string_async_with_delay(string, interval));
+            run_until_idle();
+        });
+
+        EXPECT_FALSE(blocking.empty());
+        EXPECT_EQ(blocking, async);
+    }
+};
+
+TEST_F(SendString, AsyncMatchesBlockingText) {
+    expect_same_reports("Hello, World!\n", 0);
+}
+
+TEST_F(SendString, AsyncMatchesBlockingWithInterval) {
+    expect_same_reports("~qmk_firmware~", 5);
+}
+
+TEST_F(SendString, AsyncMatchesBlockingKeycodes) {
+    expect_same_reports(SS_DOWN(X_LCTL) "c" SS_UP(X_LCTL) SS_TAP(X_CAPS) "ab" SS_DELAY(20) SS_TAP(X_CAPS) "z", 0);
+}
+
+TEST_F(SendString, AsyncMatchesBlockingTrailingDelay) {
+    expect_same_reports("a" SS_DELAY(10), 2);
+}
+
+TEST_F(SendString, AsyncMatchesBlockingQueuedStrings) {
+    TestDriver driver;
+
+    auto blocking = record(driver, [&]() {
+        send_string("one ");
+        send_string_with_delay("Two ", 3);
+        send_string(SS_TAP(X_ENT));
+    });
+    auto async = record(driver, [&]() {
+        EXPECT_TRUE(send_string_async("one "));
+        EXPECT_TRUE(send_string_async_with_delay("Two ", 3));
+        EXPECT_TRUE(send_string_async(SS_TAP(X_ENT)));
+        run_until_idle();
+    });
+
+    EXPECT_EQ(blocking, async);
+}
+
+TEST_F(SendString, AsyncSendsOneReportPerScan) {
+    TestDriver driver;
+    unsigned   loops   = 0;
+    auto       reports = record(driver, [&]() {
+        EXPECT_TRUE(send_string_async("abcdef"));
+        loops = run_until_idle();
+    });
+
+    EXPECT_EQ(reports.size(), 12);
+    EXPECT_GE(loops, reports.size());
+}
+
+TEST_F(SendString, AsyncHonoursDelay) {
+    TestDriver driver;
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_TRUE(send_string_async("a" SS_DELAY(50) "b"));
+    idle_for(10);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_NO_REPORT(driver);
+    idle_for(30);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_B));
+    EXPECT_EMPTY_REPORT(driver);
+    run_until_idle();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(SendString, AsyncBackPressure) {
+    TestDriver driver;
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(testing::AnyNumber());
+
+    EXPECT_EQ(send_string_async_free(), SEND_STRING_ASYNC_BUFFER_SIZE);
+
+    // Each string takes its length, the interval and the terminator
+    EXPECT_TRUE(send_string_async("0123456789012345678901234567890"));
+    EXPECT_EQ(send_string_async_free(), SEND_STRING_ASYNC_BUFFER_SIZE - 33);
+    EXPECT_FALSE(send_string_async("012345678901234567890123456789"));
+    EXPECT_EQ(send_string_async_free(), SEND_STRING_ASYNC_BUFFER_SIZE - 33);
+    EXPECT_TRUE(send_string_async("01234567890123456789012345678"));
+    EXPECT_EQ(send_string_async_free(), 0);
+
+    run_until_idle();
+    EXPECT_EQ(send_string_async_free(), SEND_STRING_ASYNC_BUFFER_SIZE);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(SendString, AsyncCancelReleasesKeys) {
+    TestDriver driver;
+
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT));
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT, KC_A));
+    EXPECT_TRUE(send_string_async(SS_DOWN(X_LSFT) "aaaa" SS_UP(X_LSFT)));
+    run_one_scan_loop();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT));
+    EXPECT_EMPTY_REPORT(driver);
+    send_string_async_cancel();
+    EXPECT_FALSE(send_string_async_active());
+    idle_for(100);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(SendString, AsyncFlushKeepsOrder) {
+    TestDriver driver;
+
+    auto blocking = record(driver, [&]() { send_string("queued, then immediate"); });
+    auto flushed  = record(driver, [&]() {
+        EXPECT_TRUE(send_string_async("queued, "));
+        run_one_scan_loop();
+        send_string_async_flush();
+        EXPECT_FALSE(send_string_async_active());
+        send_string("then immediate");
+    });
+
+    EXPECT_EQ(blocking, flushed);
+}
@@ -0,0 +1,287 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "simulator.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <iomanip>
+#include <sstream>
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "action.h"
+#include "action_layer.h"
+#include "action_util.h"
+#include "host.h"
+#include "keyboard.h"
+#include "test_matrix.h"
+#include "timer.h"
+
+void set_time(uint32_t t);
+void advance_time(uint32_t ms);
+}
+
+extern std::map<uint16_t, std::string> KEYCODE_ID_TABLE;
+
+Simulator* Simulator::m_this = nullptr;
+
+using steady_clock = std::chrono::steady_clock;
+
+static uint64_t elapsed_ns(steady_clock::time_point start, steady_clock::time_point end) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+}
+
+/* Times the call of a wrapped stage, see test.mk. The real functions are weak so that stages can be left out of a build. */
+#define SIMULATOR_STAGE(ret, name, params, args)                     \
+    extern "C" ret __real_##name params __attribute__((weak));       \
+    extern "C" ret __wrap_##name params {                            \
+        if (Simulator::m_this == nullptr) return __real_##name args; \
+        Simulator::m_this->enter_stage(#name);                       \
+        struct leave_on_return {                                     \
+            ~leave_on_return() { Simulator::m_this->leave_stage(); } \
+        } leave;                                                     \
+        return __real_##name args;                                   \
+    }
+
+SIMULATOR_STAGE(uint8_t, matrix_scan, (void), ())
+SIMULATOR_STAGE(void, action_exec, (keyevent_t event), (event))
+SIMULATOR_STAGE(bool, pre_process_record_quantum, (keyrecord_t * record), (record))
+SIMULATOR_STAGE(void, action_tapping_process, (keyrecord_t record), (record))
+SIMULATOR_STAGE(action_t, store_or_get_action, (bool pressed, keypos_t key), (pressed, key))
+SIMULATOR_STAGE(void, send_keyboard_report, (void), ())
+SIMULATOR_STAGE(void, host_keyboard_send, (report_keyboard_t * report), (report))
+SIMULATOR_STAGE(void, host_nkro_send, (report_nkro_t * report), (report))
+SIMULATOR_STAGE(void, host_mouse_send, (report_mouse_t * report), (report))
+SIMULATOR_STAGE(void, host_system_send, (uint16_t usage), (usage))
+SIMULATOR_STAGE(void, host_consumer_send, (uint16_t usage), (usage))
+
+/* process_record() is where a key event leaves the tapping and waiting buffers, so also measures how long it was held back */
+extern "C" void __real_process_record(keyrecord_t* record) __attribute__((weak));
+extern "C" void __wrap_process_record(keyrecord_t* record) {
+    if (Simulator::m_this == nullptr) {
+        __real_process_record(record);
+        return;
+    }
+    if (IS_EVENT(record->event)) {
+        Simulator::m_this->record_event_delay(TIMER_DIFF_16(timer_read(), record->event.time));
+    }
+    Simulator::m_this->enter_stage("process_record");
+    __real_process_record(record);
+    Simulator::m_this->leave_stage();
+}
+
+Simulator::Simulator() : m_driver{&Simulator::keyboard_leds, &Simulator::send_keyboard, &Simulator::send_nkro, &Simulator::send_mouse, &Simulator::send_extra} {
+    m_this = this;
+}
+
+Simulator::~Simulator() {
+    m_this = nullptr;
+}
+
+void Simulator::load_keymap(std::istream& stream) {
+    std::map<std::string, uint16_t> keycodes;
+    for (const auto& entry : KEYCODE_ID_TABLE) {
+        keycodes.emplace(entry.second, entry.first);
+    }
+
+    std::string line;
+    for (unsigned number = 1; std::getline(stream, line); number++) {
+        std::istringstream fields(line);
+        unsigned           layer, col, row;
+        std::string        name;
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+        if (!(fields >> layer >> col >> row >> name) || col >= MATRIX_COLS || row >= MATRIX_ROWS) {
+            ADD_FAILURE() << "keymap line " << number << " isn't a valid key: " << line;
+            continue;
+        }
+
+        auto  keycode = keycodes.find(name);
+        char* end;
+        long  value = strtol(name.c_str(), &end, 0);
+        if (keycode != keycodes.end()) {
+            add_key(KeymapKey(layer, col, row, keycode->second));
+        } else if (*end == '\0' && value >= 0 && value <= UINT16_MAX) {
+            add_key(KeymapKey(layer, col, row, value));
+        } else {
+            ADD_FAILURE() << "keymap line " << number << " has an unknown keycode: " << name;
+        }
+    }
+}
+
+std::vector<TraceEvent> Simulator::load_trace(std::istream& stream) {
+    std::vector<TraceEvent> trace;
+    std::string             line;
+    for (unsigned number = 1; std::getline(stream, line); number++) {
+        std::istringstream fields(line);
+        uint32_t           time;
+        unsigned           col, row, pressed;
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+        if (!(fields >> time >> col >> row >> pressed) || col >= MATRIX_COLS || row >= MATRIX_ROWS || pressed > 1) {
+            ADD_FAILURE() << "trace line " << number << " isn't a valid event: " << line;
+            continue;
+        }
+        if (!trace.empty() && time < trace.back().time) {
+            ADD_FAILURE() << "trace line " << number << " goes back in time";
+            continue;
+        }
+        trace.push_back({time, (uint8_t)col, (uint8_t)row, pressed == 1});
+    }
+    return trace;
+}
+
+void Simulator::replay(const std::vector<TraceEvent>& trace) {
+    host_set_driver(&m_driver);
+    m_time = 0;
+    set_time(0);
+
+    for (const auto& event : trace) {
+        idle_until(event.time);
+        if (event.pressed) {
+            press_key(event.col, event.row);
+        } else {
+            release_key(event.col, event.row);
+        }
+    }
+    // Let anything still held back by the tapping term or a timer finish
+    idle_until(m_time + max_idle_ms);
+}
+
+void Simulator::idle_until(uint32_t time) {
+    while (m_time < time) {
+        if (time - m_time > max_idle_ms) {
+            // Nothing has happened for long enough that further scans can't change anything
+            for (uint32_t i = 0; i < max_idle_ms; i++) {
+                scan();
+            }
+            advance_time(time - m_time);
+            m_time = time;
+            return;
+        }
+        scan();
+    }
+}
+
+void Simulator::scan() {
+    m_reports_in_scan = 0;
+
+    auto start = steady_clock::now();
+    enter_stage("keyboard_task");
+    keyboard_task();
+    leave_stage();
+    enter_stage("housekeeping_task");
+    housekeeping_task();
+    leave_stage();
+    uint64_t ns = elapsed_ns(start, steady_clock::now());
+
+    scans++;
+    if (ns > scan_budget_ns) {
+        scans_over_budget++;
+    }
+    if (ns > worst_scan_ns) {
+        worst_scan_ns   = ns;
+        worst_scan_time = m_time;
+    }
+    max_reports_per_scan = std::max(max_reports_per_scan, m_reports_in_scan);
+
+    advance_time(1);
+    m_time++;
+}
+
+void Simulator::enter_stage(const char* stage) {
+    bool outermost = std::none_of(m_stack.begin(), m_stack.end(), [&](const Frame& frame) { return frame.stage == stage; });
+
+    m_stack.push_back({stage, steady_clock::now(), 0, m_path.size(), outermost});
+    if (!m_path.empty()) {
+        m_path += ';';
+    }
+    m_path += stage;
+}
+
+void Simulator::leave_stage() {
+    Frame    frame = m_stack.back();
+    uint64_t ns    = elapsed_ns(frame.start, steady_clock::now());
+    m_stack.pop_back();
+
+    StageStats& stats = stages[frame.stage];
+    stats.calls++;
+    stats.self_ns += ns - frame.children_ns;
+    stats.max_ns = std::max(stats.max_ns, ns);
+    // Recursive calls are already part of the outer call
+    if (frame.outermost) {
+        stats.total_ns += ns;
+    }
+    if (!m_stack.empty()) {
+        m_stack.back().children_ns += ns;
+    }
+
+    folded[m_path] += ns - frame.children_ns;
+    m_path.resize(frame.path_length);
+}
+
+void Simulator::record_event_delay(uint16_t delay) {
+    event_delays[delay]++;
+}
+
+void Simulator::print_report(std::ostream& stream) const {
+    stream << std::left << std::setw(28) << "stage" << std::right << std::setw(12) << "calls" << std::setw(14) << "total us" << std::setw(14) << "self us" << std::setw(12) << "mean ns" << std::setw(12) << "max ns" << std::endl;
+    for (const auto& entry : stages) {
+        const StageStats& stats = entry.second;
+        stream << std::left << std::setw(28) << entry.first << std::right << std::setw(12) << stats.calls << std::setw(14) << stats.total_ns / 1000 << std::setw(14) << stats.self_ns / 1000 << std::setw(12) << (stats.calls ? stats.total_ns / stats.calls : 0) << std::setw(12) << stats.max_ns << std::endl;
+    }
+
+    stream << std::endl << scans << " scans, " << scans_over_budget << " over the budget of " << scan_budget_ns << " ns, the slowest took " << worst_scan_ns << " ns at " << worst_scan_time << " ms" << std::endl;
+
+    uint64_t events = 0;
+    for (const auto& entry : event_delays) {
+        events += entry.second;
+    }
+    stream << events << " key events";
+    if (events > 0) {
+        // Percentiles of the delay between a key event and process_record(), in ms
+        for (const auto& percentile : {50, 90, 99, 100}) {
+            auto     entry = event_delays.begin();
+            uint64_t seen  = entry->second;
+            while (seen * 100 < events * percentile) {
+                seen += (++entry)->second;
+            }
+            stream << (percentile == 50 ? ", delayed by " : ", ") << "p" << percentile << " " << entry->first << " ms";
+        }
+    }
+    stream << std::endl << reports << " host reports, at most " << max_reports_per_scan << " in one scan" << std::endl;
+}
+
+void Simulator::write_folded(std::ostream& stream) const {
+    std::vector<std::pair<std::string, uint64_t>> stacks(folded.begin(), folded.end());
+    std::sort(stacks.begin(), stacks.end());
+    for (const auto& stack : stacks) {
+        stream << stack.first << " " << stack.second << std::endl;
+    }
+}
+
+uint8_t Simulator::keyboard_leds(void) {
+    return 0;
+}
+
+void Simulator::send_keyboard(report_keyboard_t* report) {
+    m_this->reports++;
+    m_this->m_reports_in_scan++;
+}
+
+void Simulator::send_nkro(report_nkro_t* report) {
+    m_this->reports++;
+    m_this->m_reports_in_scan++;
+}
+
+void Simulator::send_mouse(report_mouse_t* report) {
+    m_this->reports++;
+    m_this->m_reports_in_scan++;
+}
+
+void Simulator::send_extra(report_extra_t* report) {
+    m_this->reports++;
+    m_this->m_reports_in_scan++;
+}
@@ -0,0 +1,115 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <istream>
+#include <map>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "test_fixture.hpp"
+
+extern "C" {
+#include "host_driver.h"
+}
+
+/*
+ * Virtual keyboard for profiling the firmware on the host.
+ *
+ * Replays a recorded trace of key events through a keymap, one scan per
+ * millisecond of the trace, and times each stage of the path from the matrix
+ * to the host report on the host's clock. The stages are the functions
+ * wrapped with `-Wl,--wrap` in simulator.mk, so calls within a translation
+ * unit aren't seen.
+ *
+ * Keymap files have one key per line, as `layer col row keycode`, where the
+ * keycode is either a name such as KC_A or a number such as 0x4104.
+ *
+ * Trace files have one event per line, as `time col row 1|0`, with the time
+ * in milliseconds since the start of the trace, and 1 for a press.
+ *
+ * Lines starting with # are ignored in both.
+ */
+
+struct TraceEvent {
+    uint32_t time;
+    uint8_t  col;
+    uint8_t  row;
+    bool     pressed;
+};
+
+struct StageStats {
+    uint64_t calls    = 0;
+    uint64_t total_ns = 0;
+    uint64_t self_ns  = 0;
+    uint64_t max_ns   = 0;
+};
+
+class Simulator : public TestFixture {
+   public:
+    static Simulator* m_this;
+
+    Simulator();
+    ~Simulator();
+
+    void                    load_keymap(std::istream& stream);
+    std::vector<TraceEvent> load_trace(std::istream& stream);
+    void                    replay(const std::vector<TraceEvent>& trace);
+
+    /**
+     * @brief Prints the time spent in each stage, the delay between each key event and its processing, and the reports sent.
+     */
+    void print_report(std::ostream& stream) const;
+
+    /**
+     * @brief Writes the self time of every stack of stages, in nanoseconds, as the collapsed stacks read by flamegraph.pl.
+     */
+    void write_folded(std::ostream& stream) const;
+
+    void enter_stage(const char* stage);
+    void leave_stage();
+    void record_event_delay(uint16_t delay);
+
+    /* Scans are cut short after this long without key events, as nothing more can happen */
+    uint32_t max_idle_ms = 1000;
+    /* Scans taking longer than this on the host are counted as over budget */
+    uint64_t scan_budget_ns = 1000000;
+
+    std::map<std::string, StageStats>         stages;
+    std::unordered_map<std::string, uint64_t> folded;
+    std::map<uint16_t, uint64_t>              event_delays;
+    uint64_t                                  scans                = 0;
+    uint64_t                                  scans_over_budget    = 0;
+    uint64_t                                  worst_scan_ns        = 0;
+    uint32_t                                  worst_scan_time      = 0;
+    uint64_t                                  reports              = 0;
+    uint32_t                                  max_reports_per_scan = 0;
+
+   private:
+    struct Frame {
+        const char*                           stage;
+        std::chrono::steady_clock::time_point start;
+        uint64_t                              children_ns;
+        size_t                                path_length;
+        bool                                  outermost;
+    };
+
+    void scan();
+    void idle_until(uint32_t time);
+
+    static uint8_t keyboard_leds(void);
+    static void    send_keyboard(report_keyboard_t* report);
+    static void    send_nkro(report_nkro_t* report);
+    static void    send_mouse(report_mouse_t* report);
+    static void    send_extra(report_extra_t* report);
+
+    host_driver_t      m_driver;
+    std::vector<Frame> m_stack;
+    std::string        m_path;
+    uint32_t           m_time            = 0;
+    uint32_t           m_reports_in_scan = 0;
+};
@@ -0,0 +1,21 @@
+# Copyright 2025 QMK
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+# Include from the test.mk of tests replaying traces through the simulator.
+# The stages timed by the simulator, see simulator.hpp. Only calls between
+# translation units go through the wrappers.
+SIMULATOR_STAGES := \
+	matrix_scan \
+	action_exec \
+	pre_process_record_quantum \
+	action_tapping_process \
+	process_record \
+	store_or_get_action \
+	send_keyboard_report \
+	host_keyboard_send \
+	host_nkro_send \
+	host_mouse_send \
+	host_system_send \
+	host_consumer_send
+
+LDFLAGS += $(foreach stage,$(SIMULATOR_STAGES),-Wl,--wrap=$(stage))
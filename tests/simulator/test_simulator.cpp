@@ -0,0 +1,105 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include "simulator.hpp"
+#include "test_common.hpp"
+
+using testing::HasSubstr;
+
+TEST_F(Simulator, LoadsKeymapByNameAndNumber) {
+    std::istringstream keymap("# layer col row keycode\n0 0 0 KC_A\n0 1 0 0x4104\n1 0 0 KC_TRANSPARENT\n");
+    load_keymap(keymap);
+
+    EXPECT_EQ(find_key(0, {0, 0})->code, KC_A);
+    EXPECT_EQ(find_key(0, {1, 0})->code, LT(1, KC_A));
+    EXPECT_EQ(find_key(1, {0, 0})->code, KC_TRANSPARENT);
+}
+
+TEST_F(Simulator, ReplaysTrace) {
+    std::istringstream keymap("0 0 0 KC_A\n0 1 0 KC_B\n");
+    std::istringstream trace("0 0 0 1\n20 0 0 0\n35 1 0 1\n36 0 0 1\n50 1 0 0\n60 0 0 0\n");
+    load_keymap(keymap);
+    replay(load_trace(trace));
+
+    EXPECT_EQ(reports, 6);
+    EXPECT_EQ(max_reports_per_scan, 1);
+    ASSERT_EQ(event_delays.size(), 1);
+    EXPECT_EQ(event_delays.at(0), 6);
+
+    EXPECT_EQ(stages.at("process_record").calls, 6);
+    EXPECT_EQ(stages.at("host_keyboard_send").calls, 6);
+    EXPECT_EQ(stages.at("keyboard_task").calls, scans);
+    EXPECT_EQ(scans, 60 + max_idle_ms);
+}
+
+TEST_F(Simulator, MeasuresTapHoldDelay) {
+    std::istringstream keymap("0 0 0 0x4104\n0 1 0 KC_B\n");
+    std::istringstream trace("0 0 0 1\n80 0 0 0\n500 1 0 1\n510 1 0 0\n");
+    load_keymap(keymap);
+    replay(load_trace(trace));
+
+    // The press of the tap-hold key is held back until it is released as a tap
+    EXPECT_EQ(event_delays.at(80), 1);
+    EXPECT_EQ(event_delays.at(0), 3);
+}
+
+TEST_F(Simulator, CutsIdleScansShort) {
+    std::istringstream keymap("0 0 0 KC_A\n");
+    std::istringstream trace("0 0 0 1\n10 0 0 0\n3600000 0 0 1\n3600010 0 0 0\n");
+    load_keymap(keymap);
+    replay(load_trace(trace));
+
+    EXPECT_EQ(reports, 4);
+    EXPECT_EQ(scans, 10 + max_idle_ms + 10 + max_idle_ms);
+}
+
+TEST_F(Simulator, FoldsStacksOfStages) {
+    std::istringstream keymap("0 0 0 KC_A\n");
+    std::istringstream trace("0 0 0 1\n10 0 0 0\n");
+    load_keymap(keymap);
+    replay(load_trace(trace));
+
+    std::stringstream folded;
+    write_folded(folded);
+    EXPECT_THAT(folded.str(), HasSubstr("keyboard_task;matrix_scan "));
+    EXPECT_THAT(folded.str(), HasSubstr("keyboard_task;action_exec;pre_process_record_quantum "));
+    EXPECT_THAT(folded.str(), HasSubstr("keyboard_task;action_exec;action_tapping_process;process_record;store_or_get_action "));
+    EXPECT_THAT(folded.str(), HasSubstr(";process_record;send_keyboard_report;host_keyboard_send "));
+
+    std::stringstream report;
+    print_report(report);
+    EXPECT_THAT(report.str(), HasSubstr("2 key events, delayed by p50 0 ms"));
+    EXPECT_THAT(report.str(), HasSubstr("2 host reports"));
+}
+
+/*
+ * Profiles a recorded trace, e.g.
+ *
+ *   SIMULATOR_KEYMAP=keymap.txt SIMULATOR_TRACE=trace.txt SIMULATOR_FOLDED=out.folded .build/test/simulator.elf --gtest_filter=Simulator.Profile
+ */
+TEST_F(Simulator, Profile) {
+    const char* keymap_path = std::getenv("SIMULATOR_KEYMAP");
+    const char* trace_path  = std::getenv("SIMULATOR_TRACE");
+    if (keymap_path == nullptr || trace_path == nullptr) {
+        GTEST_SKIP() << "SIMULATOR_KEYMAP and SIMULATOR_TRACE aren't set";
+    }
+    if (const char* budget = std::getenv("SIMULATOR_BUDGET_NS")) {
+        scan_budget_ns = std::strtoull(budget, nullptr, 0);
+    }
+
+    std::ifstream keymap(keymap_path);
+    std::ifstream trace(trace_path);
+    ASSERT_TRUE(keymap.is_open()) << "can't open " << keymap_path;
+    ASSERT_TRUE(trace.is_open()) << "can't open " << trace_path;
+    load_keymap(keymap);
+    replay(load_trace(trace));
+
+    print_report(std::cout);
+    if (const char* folded_path = std::getenv("SIMULATOR_FOLDED")) {
+        std::ofstream folded(folded_path);
+        write_folded(folded);
+    }
+}
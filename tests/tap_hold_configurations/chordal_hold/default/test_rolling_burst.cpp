@@ -0,0 +1,83 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <vector>
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+#include "action_tapping.h"
+#include "test_fixture.hpp"
+#include "test_keymap_key.hpp"
+
+using testing::_;
+using testing::Invoke;
+
+class RollingBurst : public TestFixture {
+   protected:
+    /* Records every keyboard report, to check the keys typed rather than each intermediate report. */
+    void record_reports(TestDriver& driver) {
+        EXPECT_CALL(driver, send_keyboard_mock(_)).WillRepeatedly(Invoke([this](report_keyboard_t& report) { reports.push_back(report); }));
+    }
+
+    /* Rolls over `keys`, pressing each before releasing the previous one. */
+    void roll(std::vector<KeymapKey>& keys) {
+        for (size_t i = 0; i < keys.size(); i++) {
+            keys[i].press();
+            run_one_scan_loop();
+            if (i > 0) {
+                keys[i - 1].release();
+                run_one_scan_loop();
+            }
+        }
+        keys.back().release();
+        run_one_scan_loop();
+    }
+
+    /* The keys in the order the host saw them pressed, failing if a modifier is sent or a key is left pressed. */
+    std::vector<uint8_t> typed(void) {
+        std::vector<uint8_t> order;
+        report_keyboard_t    previous = {};
+        for (const auto& report : reports) {
+            EXPECT_EQ(report.mods, 0);
+            for (uint8_t key : report.keys) {
+                if (key != KC_NO && std::find(std::begin(previous.keys), std::end(previous.keys), key) == std::end(previous.keys)) {
+                    order.push_back(key);
+                }
+            }
+            previous = report;
+        }
+        EXPECT_TRUE(previous == report_keyboard_t{}) << "keys left pressed";
+        return order;
+    }
+
+    std::vector<report_keyboard_t> reports;
+};
+
+TEST_F(RollingBurst, home_row_mods_rolled_across_hands_settle_as_taps) {
+    TestDriver             driver;
+    std::vector<KeymapKey> left  = {KeymapKey(0, 1, 1, LSFT_T(KC_A)), KeymapKey(0, 2, 1, LCTL_T(KC_S)), KeymapKey(0, 3, 1, LALT_T(KC_D)), KeymapKey(0, 4, 1, LGUI_T(KC_F))};
+    std::vector<KeymapKey> right = {KeymapKey(0, 5, 1, RGUI_T(KC_J)), KeymapKey(0, 6, 1, RALT_T(KC_K)), KeymapKey(0, 7, 1, RCTL_T(KC_L)), KeymapKey(0, 8, 1, RSFT_T(KC_SCLN))};
+    std::vector<KeymapKey> keys;
+    std::vector<uint8_t>   expected;
+    for (size_t i = 0; i < left.size(); i++) {
+        keys.push_back(left[i]);
+        keys.push_back(right[i]);
+        expected.push_back(QK_MOD_TAP_GET_TAP_KEYCODE(left[i].code));
+        expected.push_back(QK_MOD_TAP_GET_TAP_KEYCODE(right[i].code));
+    }
+
+    set_keymap({});
+    for (auto& key : keys) {
+        add_key(key);
+    }
+    record_reports(driver);
+
+    for (int burst = 0; burst < 10; burst++) {
+        reports.clear();
+        roll(keys);
+        idle_for(TAPPING_TERM);
+        EXPECT_EQ(typed(), expected) << "burst " << burst;
+    }
+    VERIFY_AND_CLEAR(driver);
+}
@@ -0,0 +1,114 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <vector>
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+#include "action_tapping.h"
+#include "test_fixture.hpp"
+#include "test_keymap_key.hpp"
+
+using testing::_;
+using testing::Invoke;
+
+class RollingBurst : public TestFixture {
+   protected:
+    /* Records every keyboard report, to check the keys typed rather than each intermediate report. */
+    void record_reports(TestDriver& driver) {
+        EXPECT_CALL(driver, send_keyboard_mock(_)).WillRepeatedly(Invoke([this](report_keyboard_t& report) { reports.push_back(report); }));
+    }
+
+    /* Rolls over `keys`, pressing each before releasing the previous one. */
+    void roll(std::vector<KeymapKey>& keys) {
+        for (size_t i = 0; i < keys.size(); i++) {
+            keys[i].press();
+            run_one_scan_loop();
+            if (i > 0) {
+                keys[i - 1].release();
+                run_one_scan_loop();
+            }
+        }
+        keys.back().release();
+        run_one_scan_loop();
+    }
+
+    /* The keys in the order the host saw them pressed, failing if a modifier is sent or a key is left pressed. */
+    std::vector<uint8_t> typed(void) {
+        std::vector<uint8_t> order;
+        report_keyboard_t    previous = {};
+        for (const auto& report : reports) {
+            EXPECT_EQ(report.mods, 0);
+            for (uint8_t key : report.keys) {
+                if (key != KC_NO && std::find(std::begin(previous.keys), std::end(previous.keys), key) == std::end(previous.keys)) {
+                    order.push_back(key);
+                }
+            }
+            previous = report;
+        }
+        EXPECT_TRUE(previous == report_keyboard_t{}) << "keys left pressed";
+        return order;
+    }
+
+    std::vector<report_keyboard_t> reports;
+};
+
+TEST_F(RollingBurst, roll_fills_waiting_buffer_while_mod_tap_key_is_held) {
+    TestDriver driver;
+    auto       mod_tap_key = KeymapKey(0, 0, 0, SFT_T(KC_A));
+    // As many keys as the waiting buffer can hold both events of
+    std::vector<KeymapKey> keys;
+    std::vector<uint8_t>   expected = {KC_A};
+    for (uint8_t i = 0; i < (WAITING_BUFFER_SIZE - 1) / 2; i++) {
+        keys.push_back(KeymapKey(0, (i + 1) % MATRIX_COLS, (i + 1) / MATRIX_COLS, KC_B + i));
+        expected.push_back(KC_B + i);
+    }
+
+    set_keymap({mod_tap_key});
+    for (auto& key : keys) {
+        add_key(key);
+    }
+    record_reports(driver);
+
+    mod_tap_key.press();
+    run_one_scan_loop();
+    roll(keys);
+    mod_tap_key.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EQ(typed(), expected);
+}
+
+TEST_F(RollingBurst, repeated_rolls_while_mod_tap_key_is_held) {
+    TestDriver driver;
+    auto       mod_tap_key = KeymapKey(0, 0, 0, SFT_T(KC_A));
+    auto       key_b       = KeymapKey(0, 1, 0, KC_B);
+    auto       key_c       = KeymapKey(0, 2, 0, KC_C);
+
+    set_keymap({mod_tap_key, key_b, key_c});
+    record_reports(driver);
+
+    // Typing the same keys again while their earlier events are still queued
+    for (int burst = 0; burst < 20; burst++) {
+        std::vector<KeymapKey> keys = {key_b, key_c};
+        reports.clear();
+        mod_tap_key.press();
+        run_one_scan_loop();
+        roll(keys);
+        if (burst % 2) {
+            roll(keys);
+        }
+        mod_tap_key.release();
+        run_one_scan_loop();
+        idle_for(TAPPING_TERM);
+
+        std::vector<uint8_t> expected = {KC_A, KC_B, KC_C};
+        if (burst % 2) {
+            expected.insert(expected.end(), {KC_B, KC_C});
+        }
+        EXPECT_EQ(typed(), expected) << "burst " << burst;
+    }
+    VERIFY_AND_CLEAR(driver);
+}
@@ -0,0 +1,11 @@
+# Copyright 2025 QMK
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+# --------------------------------------------------------------------------------
+# Keep this file, even if it is empty, as a marker that this folder contains tests
+# --------------------------------------------------------------------------------
+
+# Typing is replayed through the simulator
+include $(TEST_PATH)/../../simulator/simulator.mk
+SRC += tests/simulator/simulator.cpp
+VPATH += $(TOP_DIR)/tests/simulator
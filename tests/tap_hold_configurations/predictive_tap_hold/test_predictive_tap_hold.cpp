@@ -0,0 +1,262 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include "keyboard_report_util.hpp"
+#include "simulator.hpp"
+#include "test_common.hpp"
+
+using testing::_;
+using testing::AnyNumber;
+using testing::InSequence;
+
+static bool predict = true;
+
+bool get_predictive_tap_hold(uint16_t keycode, keyrecord_t* record) {
+    return predict;
+}
+
+class PredictiveTapHold : public Simulator {
+   protected:
+    /* A qwerty layout with home row mods on row 1 */
+    void load_home_row_mods(void) {
+        // clang-format off
+        const uint16_t keycodes[3][MATRIX_COLS] = {
+            {KC_Q,         KC_W,         KC_E,         KC_R,         KC_T, KC_Y, KC_U,         KC_I,         KC_O,         KC_P},
+            {LGUI_T(KC_A), LALT_T(KC_S), LCTL_T(KC_D), LSFT_T(KC_F), KC_G, KC_H, RSFT_T(KC_J), RCTL_T(KC_K), LALT_T(KC_L), RGUI_T(KC_SCLN)},
+            {KC_Z,         KC_X,         KC_C,         KC_V,         KC_B, KC_N, KC_M,         KC_COMM,      KC_DOT,       KC_SLSH},
+        };
+        // clang-format on
+        for (uint8_t row = 0; row < 3; row++) {
+            for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+                add_key(KeymapKey(0, col, row, keycodes[row][col]));
+            }
+        }
+    }
+
+    /* Deterministic pseudo random number in [low, high] */
+    uint32_t random(uint32_t low, uint32_t high) {
+        m_seed = m_seed * 1103515245 + 12345;
+        return low + (m_seed >> 16) % (high - low + 1);
+    }
+
+    void add_event(std::vector<TraceEvent>& trace, uint32_t time, uint8_t col, uint8_t row, bool pressed) {
+        trace.push_back({time, col, row, pressed});
+    }
+
+    /*
+     * Words of rolled keys, with a press every 50 to 130 ms, each key released
+     * before the next one is, and a pause between words. One word in twenty
+     * is a shortcut instead: a home row mod held over another key, pressed
+     * well after the mod.
+     */
+    std::vector<TraceEvent> generate_typing(uint16_t words) {
+        std::vector<TraceEvent> trace;
+        uint32_t                time = 0;
+        for (uint16_t word = 0; word < words; word++) {
+            time += random(200, 500);
+            if (random(0, 19) == 0) {
+                uint8_t mod_col = random(0, 1) ? random(0, 3) : random(6, 9);
+                uint8_t col     = mod_col < 5 ? random(5, 9) : random(0, 4);
+                uint8_t row     = random(0, 1) ? 0 : 2;
+                add_event(trace, time, mod_col, 1, true);
+                uint32_t press = time + random(120, 260);
+                add_event(trace, press, col, row, true);
+                add_event(trace, press + random(60, 100), col, row, false);
+                time = press + random(160, 250);
+                add_event(trace, time, mod_col, 1, false);
+                continue;
+            }
+
+            uint8_t  length = random(3, 7);
+            uint8_t  col = MATRIX_COLS, row = 0;
+            uint32_t release = 0;
+            for (uint8_t i = 0; i < length; i++) {
+                uint8_t next_col, next_row;
+                do {
+                    next_col = random(0, MATRIX_COLS - 1);
+                    next_row = random(0, 2);
+                } while (next_col == col && next_row == row);
+                if (i > 0) {
+                    time += random(50, 130);
+                    add_event(trace, release, col, row, false);
+                }
+                add_event(trace, time, next_col, next_row, true);
+                col     = next_col;
+                row     = next_row;
+                release = time + random(60, 100);
+            }
+            add_event(trace, release, col, row, false);
+            time = release;
+        }
+        std::stable_sort(trace.begin(), trace.end(), [](const TraceEvent& a, const TraceEvent& b) { return a.time < b.time; });
+        return trace;
+    }
+
+    /* Replays the trace from scratch and gives the mean delay of the key events, in ms */
+    double replay_mean_delay(const std::vector<TraceEvent>& trace) {
+        predictive_tap_hold_reset();
+        event_delays.clear();
+        replay(trace);
+
+        uint64_t events = 0, total = 0;
+        for (const auto& entry : event_delays) {
+            events += entry.second;
+            total += (uint64_t)entry.first * entry.second;
+        }
+        return events ? (double)total / events : 0;
+    }
+
+    uint32_t m_seed = 1;
+};
+
+TEST_F(PredictiveTapHold, home_row_mods_rolled_while_typing_are_settled_early) {
+    load_home_row_mods();
+    std::vector<TraceEvent> trace = generate_typing(2000);
+
+    predict                = false;
+    double baseline_delay  = replay_mean_delay(trace);
+    predict                = true;
+    double predicted_delay = replay_mean_delay(trace);
+
+    const predictive_tap_hold_stats_t* stats = predictive_tap_hold_get_stats();
+    EXPECT_GT(stats->predictions, 1000);
+    EXPECT_LE(stats->misfires * 100, stats->predictions) << stats->misfires << " misfires";
+    EXPECT_LT(predicted_delay, baseline_delay / 2) << "mean delay " << baseline_delay << " ms, predicted " << predicted_delay << " ms";
+}
+
+TEST_F(PredictiveTapHold, held_mods_are_not_predicted) {
+    load_home_row_mods();
+    std::vector<TraceEvent> trace;
+    // Shortcuts only, so the key is never seen rolled
+    for (uint32_t i = 0, time = 0; i < 50; i++, time += 1000) {
+        add_event(trace, time, 3, 1, true);
+        add_event(trace, time + 150, 6, 0, true);
+        add_event(trace, time + 220, 6, 0, false);
+        add_event(trace, time + 400, 3, 1, false);
+    }
+    replay_mean_delay(trace);
+
+    EXPECT_EQ(predictive_tap_hold_get_stats()->predictions, 0);
+}
+
+class PredictiveTapHoldReports : public TestFixture {
+   protected:
+    void SetUp() override {
+        predict = true;
+        predictive_tap_hold_reset();
+    }
+
+    /* Rolls from a regular key onto the mod-tap key, tapping both, until the mod-tap key is predicted while typing */
+    void train(TestDriver& driver, KeymapKey& regular_key, KeymapKey& mod_tap_key) {
+        EXPECT_CALL(driver, send_keyboard_mock(_)).Times(AnyNumber());
+        for (uint8_t i = 0; i < PREDICTIVE_TAP_HOLD_MIN_SAMPLES; i++) {
+            tap_key(regular_key);
+            idle_for(40);
+            tap_key(mod_tap_key, 30);
+            idle_for(500);
+        }
+        VERIFY_AND_CLEAR(driver);
+    }
+};
+
+TEST_F(PredictiveTapHoldReports, predicted_tap_sends_the_tap_keycode_on_press) {
+    TestDriver driver;
+    InSequence s;
+    auto       regular_key = KeymapKey(0, 6, 1, KC_J);
+    auto       mod_tap_key = KeymapKey(0, 3, 1, LSFT_T(KC_F));
+
+    set_keymap({regular_key, mod_tap_key});
+    train(driver, regular_key, mod_tap_key);
+
+    EXPECT_REPORT(driver, (KC_J));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(regular_key);
+    idle_for(40);
+    VERIFY_AND_CLEAR(driver);
+
+    // Settled as tapped without waiting for the release or the tapping term
+    EXPECT_REPORT(driver, (KC_F));
+    mod_tap_key.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    mod_tap_key.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EQ(predictive_tap_hold_get_stats()->predictions, 1);
+    EXPECT_EQ(predictive_tap_hold_get_stats()->misfires, 0);
+}
+
+TEST_F(PredictiveTapHoldReports, mispredicted_hold_stays_tapped) {
+    TestDriver driver;
+    InSequence s;
+    auto       regular_key = KeymapKey(0, 6, 1, KC_J);
+    auto       other_key   = KeymapKey(0, 7, 0, KC_I);
+    auto       mod_tap_key = KeymapKey(0, 3, 1, LSFT_T(KC_F));
+
+    set_keymap({regular_key, other_key, mod_tap_key});
+    train(driver, regular_key, mod_tap_key);
+
+    EXPECT_REPORT(driver, (KC_J));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(regular_key);
+    idle_for(40);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_F));
+    mod_tap_key.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    // Held past the tapping term and over another key, which is sent without the modifier
+    EXPECT_NO_REPORT(driver);
+    idle_for(TAPPING_TERM);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_F, KC_I));
+    EXPECT_REPORT(driver, (KC_F));
+    tap_key(other_key);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    mod_tap_key.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EQ(predictive_tap_hold_get_stats()->predictions, 1);
+    EXPECT_EQ(predictive_tap_hold_get_stats()->misfires, 1);
+}
+
+/*
+ * Compares the delays of a recorded trace with and without prediction, e.g.
+ *
+ *   SIMULATOR_KEYMAP=keymap.txt SIMULATOR_TRACE=trace.txt .build/test/tap_hold_configurations_predictive_tap_hold.elf --gtest_filter=PredictiveTapHold.Profile
+ */
+TEST_F(PredictiveTapHold, Profile) {
+    const char* keymap_path = std::getenv("SIMULATOR_KEYMAP");
+    const char* trace_path  = std::getenv("SIMULATOR_TRACE");
+    if (keymap_path == nullptr || trace_path == nullptr) {
+        GTEST_SKIP() << "SIMULATOR_KEYMAP and SIMULATOR_TRACE aren't set";
+    }
+
+    std::ifstream keymap(keymap_path);
+    std::ifstream trace_file(trace_path);
+    ASSERT_TRUE(keymap.is_open()) << "can't open " << keymap_path;
+    ASSERT_TRUE(trace_file.is_open()) << "can't open " << trace_path;
+    load_keymap(keymap);
+    std::vector<TraceEvent> trace = load_trace(trace_file);
+
+    predict = false;
+    std::cout << "mean delay " << replay_mean_delay(trace) << " ms" << std::endl;
+    predict = true;
+    std::cout << "mean delay with prediction " << replay_mean_delay(trace) << " ms" << std::endl;
+    const predictive_tap_hold_stats_t* stats = predictive_tap_hold_get_stats();
+    std::cout << stats->predictions << " predictions, " << stats->misfires << " misfires" << std::endl;
+    print_report(std::cout);
+}
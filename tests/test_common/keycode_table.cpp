@@ -700,6 +700,9 @@ std::map<uint16_t, std::string> KEYCODE_ID_TABLE = {
     {QK_REPEAT_KEY, "QK_REPEAT_KEY"},
     {QK_ALT_REPEAT_KEY, "QK_ALT_REPEAT_KEY"},
     {QK_LAYER_LOCK, "QK_LAYER_LOCK"},
+    {QK_POINTING_ACCEL_CURVE_NEXT, "QK_POINTING_ACCEL_CURVE_NEXT"},
+    {QK_POINTING_ACCEL_UP, "QK_POINTING_ACCEL_UP"},
+    {QK_POINTING_ACCEL_DOWN, "QK_POINTING_ACCEL_DOWN"},
     {QK_KB_0, "QK_KB_0"},
     {QK_KB_1, "QK_KB_1"},
     {QK_KB_2, "QK_KB_2"},
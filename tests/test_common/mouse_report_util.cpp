@@ -36,7 +36,7 @@ std::ostream& operator<<(std::ostream& os, const report_mouse_t& report) {
     return os << std::endl;
 }
 
-MouseReportMatcher::MouseReportMatcher(int16_t x, int16_t y, int8_t h, int8_t v, uint8_t button_mask) {
+MouseReportMatcher::MouseReportMatcher(int16_t x, int16_t y, int16_t h, int16_t v, uint8_t button_mask) {
     memset(&m_report, 0, sizeof(report_mouse_t));
     m_report.x       = x;
     m_report.y       = y;
@@ -43,6 +43,9 @@
 #ifdef SLEEP_LED_ENABLE
 #    include "sleep_led.h"
 #endif
+#ifdef USB_SOF_SYNC_ENABLE
+#    include "usb_sof_sync.h"
+#endif
 #ifdef MIDI_ENABLE
 #    include "qmk_midi.h"
 #endif
@@ -174,6 +177,9 @@ void protocol_post_init(void) {
 }
 
 void protocol_pre_task(void) {
+#ifdef USB_SOF_SYNC_ENABLE
+    usb_sof_sync_wait();
+#endif
     usb_event_queue_task();
 
 #if !defined(NO_USB_STARTUP_CHECK)
@@ -206,4 +212,7 @@ void protocol_post_task(void) {
     virtser_task();
 #endif
     usb_idle_task();
+#ifdef USB_SOF_SYNC_ENABLE
+    usb_sof_sync_done();
+#endif
 }
@@ -8,9 +8,22 @@ SRC += usb_descriptor.c
 SRC += $(CHIBIOS_DIR)/usb_driver.c
 SRC += $(CHIBIOS_DIR)/usb_endpoints.c
 SRC += $(CHIBIOS_DIR)/usb_report_handling.c
+SRC += $(CHIBIOS_DIR)/usb_report_mailbox.c
 SRC += $(CHIBIOS_DIR)/usb_util.c
 SRC += $(LIBSRC)
 
+ifeq ($(strip $(USB_SOF_SYNC_ENABLE)), yes)
+    SRC += $(CHIBIOS_DIR)/usb_sof_sync.c
+    OPT_DEFS += -DUSB_SOF_SYNC_ENABLE
+endif
+
+ifeq ($(strip $(CONSOLE_ENABLE)), yes)
+    ifeq ($(strip $(CONSOLE_RING_BUFFER_ENABLE)), yes)
+        SRC += console_ring.c
+        OPT_DEFS += -DCONSOLE_RING_BUFFER_ENABLE
+    endif
+endif
+
 VPATH += $(TMK_PATH)/$(PROTOCOL_DIR)
 VPATH += $(TMK_PATH)/$(CHIBIOS_DIR)
 VPATH += $(TMK_PATH)/$(CHIBIOS_DIR)/lufa_utils
@@ -74,6 +74,80 @@ static void obnotify(io_buffers_queue_t *bqp) {
     }
 }
 
+/**
+ * @brief   Moves a report held in the endpoint's mailbox into the output
+ *          buffers queue, if there is room for it.
+ *
+ * @param[in] endpoint  the IN endpoint.
+ */
+static void usb_endpoint_in_post_held_report_I(usb_endpoint_in_t *endpoint) {
+    output_buffers_queue_t *obqp    = &endpoint->obqueue;
+    usb_report_mailbox_t   *mailbox = endpoint->report_mailbox;
+
+    /* Nothing held, no room or a write in progress, which the held report
+       must not be interleaved with.*/
+    if (mailbox == NULL || !mailbox->has_pending || obqIsFullI(obqp) || obqp->ptr != NULL) {
+        return;
+    }
+
+    /* Equivalent of obqGetEmptyBufferTimeoutS() followed by
+       obqPostFullBufferS(), which can't be used from an ISR.*/
+    *((size_t *)obqp->bwrptr) = usb_report_mailbox_take(mailbox, obqp->bwrptr + sizeof(size_t));
+    obqp->bcounter--;
+    obqp->bwrptr += obqp->bsize;
+    if (obqp->bwrptr >= obqp->btop) {
+        obqp->bwrptr = obqp->buffers;
+    }
+}
+
+/**
+ * @brief   Offers a report to the endpoint's mailbox, which holds it rather
+ *          than blocking while the output buffers queue is full.
+ *
+ * @param[in] endpoint  the IN endpoint.
+ * @param[in] data      the report.
+ * @param[in] size      the size of the report.
+ * @param[in] timeout   how long to wait for room if a held report has to be
+ *                      queued first.
+ * @return              true if the report is held, false if it should be
+ *                      written to the queue as usual.
+ */
+static bool usb_endpoint_in_post_to_mailbox(usb_endpoint_in_t *endpoint, const uint8_t *data, size_t size, sysinterval_t timeout) {
+    output_buffers_queue_t *obqp    = &endpoint->obqueue;
+    usb_report_mailbox_t   *mailbox = endpoint->report_mailbox;
+
+    osalSysLock();
+    while (true) {
+        usb_report_mailbox_result_t result = usb_report_mailbox_post(mailbox, data, size, !obqIsFullI(obqp));
+        if (result != USB_REPORT_MAILBOX_BLOCKED) {
+            osalSysUnlock();
+            return result == USB_REPORT_MAILBOX_HELD;
+        }
+
+        /* The held report conflicts with this one and has to reach the host
+           first, so wait for room in the queue.*/
+        if (obqGetEmptyBufferTimeoutS(obqp, timeout) != MSG_OK) {
+            /* Same as a timed out write, drop everything that's queued.*/
+            endpoint->timed_out = true;
+            usb_report_mailbox_reset(mailbox);
+            bqSuspendI(obqp);
+            obqResetI(obqp);
+            bqResumeX(obqp);
+            osalOsRescheduleS();
+            continue;
+        }
+
+        size_t held = usb_report_mailbox_take(mailbox, obqp->ptr);
+        if (held > 0) {
+            obqPostFullBufferS(obqp, held);
+        } else {
+            /* The IN complete callback queued it while waiting.*/
+            obqp->ptr = NULL;
+            obqp->top = NULL;
+        }
+    }
+}
+
 /*===========================================================================*/
 /* Driver exported functions.                                                */
 /*===========================================================================*/
@@ -127,6 +201,9 @@ void usb_endpoint_in_stop(usb_endpoint_in_t *endpoint) {
     if (endpoint->report_storage != NULL) {
         endpoint->report_storage->reset_report(endpoint->report_storage->reports);
     }
+    if (endpoint->report_mailbox != NULL) {
+        usb_report_mailbox_reset(endpoint->report_mailbox);
+    }
     osalOsRescheduleS();
     osalSysUnlock();
 }
@@ -150,6 +227,10 @@ void usb_endpoint_in_suspend_cb(usb_endpoint_in_t *endpoint) {
     if (endpoint->report_storage != NULL) {
         endpoint->report_storage->reset_report(endpoint->report_storage->reports);
     }
+
+    if (endpoint->report_mailbox != NULL) {
+        usb_report_mailbox_reset(endpoint->report_mailbox);
+    }
 }
 
 void usb_endpoint_out_suspend_cb(usb_endpoint_out_t *endpoint) {
@@ -168,6 +249,9 @@ void usb_endpoint_out_wakeup_cb(usb_endpoint_out_t *endpoint) {
 void usb_endpoint_in_configure_cb(usb_endpoint_in_t *endpoint) {
     usbInitEndpointI(endpoint->config.usbp, endpoint->config.ep, &endpoint->ep_config);
     obqResetI(&endpoint->obqueue);
+    if (endpoint->report_mailbox != NULL) {
+        usb_report_mailbox_reset(endpoint->report_mailbox);
+    }
     bqResumeX(&endpoint->obqueue);
 }
 
@@ -208,6 +292,9 @@ void usb_endpoint_in_tx_complete_cb(USBDriver *usbp, usbep_t ep) {
         obqReleaseEmptyBufferI(&endpoint->obqueue);
     }
 
+    /* A buffer may have been freed up for a report held in the mailbox.*/
+    usb_endpoint_in_post_held_report_I(endpoint);
+
     /* Checking if there is a buffer ready for transmission.*/
     buffer = obqGetFullBufferI(&endpoint->obqueue, &n);
 
@@ -269,6 +356,10 @@ bool usb_endpoint_in_send(usb_endpoint_in_t *endpoint, const uint8_t *data, size
     }
     osalSysUnlock();
 
+    if (endpoint->report_mailbox != NULL && !buffered && usb_endpoint_in_post_to_mailbox(endpoint, data, size, timeout)) {
+        return true;
+    }
+
     while (true) {
         size_t sent = obqWriteTimeout(&endpoint->obqueue, data, size, timeout);
 
@@ -310,6 +401,33 @@ void usb_endpoint_in_flush(usb_endpoint_in_t *endpoint, bool padded) {
     obqFlush(obqp);
 }
 
+bool usb_endpoint_in_try_send(usb_endpoint_in_t *endpoint, const uint8_t *data, size_t size, bool padded) {
+    osalDbgCheck((endpoint != NULL) && (data != NULL) && (size > 0U) && (size <= endpoint->config.buffer_size));
+
+    output_buffers_queue_t *obqp = &endpoint->obqueue;
+
+    osalSysLock();
+    /* Not configured or no room.*/
+    if (usbGetDriverStateI(endpoint->config.usbp) != USB_ACTIVE || obqIsFullI(obqp)) {
+        osalSysUnlock();
+        return false;
+    }
+    osalSysUnlock();
+
+    /* There is an empty buffer and only this thread fills it, so none of these writes wait.*/
+    (void)obqWriteTimeout(obqp, data, size, TIME_IMMEDIATE);
+    if (padded) {
+        for (size_t i = size; i < endpoint->config.buffer_size; i++) {
+            (void)obqPutTimeout(obqp, 0, TIME_IMMEDIATE);
+        }
+    }
+    /* Posts a short packet, a full buffer was already posted by the writes.*/
+    obqFlush(obqp);
+    endpoint->timed_out = false;
+
+    return true;
+}
+
 bool usb_endpoint_in_is_inactive(usb_endpoint_in_t *endpoint) {
     osalDbgCheck(endpoint != NULL);
 
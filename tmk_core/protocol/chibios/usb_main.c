@@ -26,11 +26,18 @@
 #    include "led.h"
 #endif
 #include "wait.h"
+#ifdef USB_SOF_SYNC_ENABLE
+#    include "usb_sof_sync.h"
+#endif
 #include "usb_endpoints.h"
 #include "usb_device_state.h"
 #include "usb_descriptor.h"
 #include "usb_driver.h"
 #include "usb_types.h"
+#ifdef CONSOLE_RING_BUFFER_ENABLE
+#    include "console_ring.h"
+#    include "print.h"
+#endif
 
 #ifdef NKRO_ENABLE
 #    include "keycode_config.h"
@@ -254,6 +261,47 @@ static void set_led_transfer_cb(USBDriver *usbp) {
     }
 }
 
+#ifdef POINTING_DEVICE_HIRES_SCROLL_ENABLE
+#    define HID_REPORT_TYPE_FEATURE 0x03
+
+#    ifdef MOUSE_SHARED_EP
+#        define MOUSE_FEATURE_INTERFACE SHARED_INTERFACE
+#        define MOUSE_FEATURE_REPORT_ID REPORT_ID_MOUSE
+#    else
+#        define MOUSE_FEATURE_INTERFACE MOUSE_INTERFACE
+#        define MOUSE_FEATURE_REPORT_ID 0
+#    endif
+
+// Report ID, when the mouse shares its endpoint, followed by the resolution multipliers
+static uint8_t _Alignas(4) resolution_multiplier_buf[2];
+
+static bool is_resolution_multiplier_request(usb_control_request_t *setup) {
+    return setup->wIndex == MOUSE_FEATURE_INTERFACE && setup->wValue.hbyte == HID_REPORT_TYPE_FEATURE && setup->wValue.lbyte == MOUSE_FEATURE_REPORT_ID;
+}
+
+static bool usb_get_resolution_multiplier_cb(USBDriver *usbp) {
+#    ifdef MOUSE_SHARED_EP
+    resolution_multiplier_buf[0] = REPORT_ID_MOUSE;
+    resolution_multiplier_buf[1] = usb_device_state_get_resolution_multiplier();
+    usbSetupTransfer(usbp, resolution_multiplier_buf, 2, NULL);
+#    else
+    resolution_multiplier_buf[0] = usb_device_state_get_resolution_multiplier();
+    usbSetupTransfer(usbp, resolution_multiplier_buf, 1, NULL);
+#    endif
+    return true;
+}
+
+static void set_resolution_multiplier_transfer_cb(USBDriver *usbp) {
+    usb_control_request_t *setup = (usb_control_request_t *)usbp->setup;
+
+    if (setup->wLength == 2) {
+        usb_device_state_set_resolution_multiplier(resolution_multiplier_buf[1]);
+    } else {
+        usb_device_state_set_resolution_multiplier(resolution_multiplier_buf[0]);
+    }
+}
+#endif
+
 static bool usb_requests_hook_cb(USBDriver *usbp) {
     usb_control_request_t *setup = (usb_control_request_t *)usbp->setup;
 
@@ -263,6 +311,11 @@ static bool usb_requests_hook_cb(USBDriver *usbp) {
             case USB_RTYPE_DIR_DEV2HOST:
                 switch (setup->bRequest) {
                     case HID_REQ_GetReport:
+#ifdef POINTING_DEVICE_HIRES_SCROLL_ENABLE
+                        if (is_resolution_multiplier_request(setup)) {
+                            return usb_get_resolution_multiplier_cb(usbp);
+                        }
+#endif
                         return usb_get_report_cb(usbp);
                     case HID_REQ_GetProtocol:
                         if (setup->wIndex == KEYBOARD_INTERFACE) {
@@ -280,6 +333,12 @@ static bool usb_requests_hook_cb(USBDriver *usbp) {
             case USB_RTYPE_DIR_HOST2DEV:
                 switch (setup->bRequest) {
                     case HID_REQ_SetReport:
+#ifdef POINTING_DEVICE_HIRES_SCROLL_ENABLE
+                        if (is_resolution_multiplier_request(setup)) {
+                            usbSetupTransfer(usbp, resolution_multiplier_buf, sizeof(resolution_multiplier_buf), set_resolution_multiplier_transfer_cb);
+                            return true;
+                        }
+#endif
                         switch (setup->wIndex) {
                             case KEYBOARD_INTERFACE:
 #if defined(SHARED_EP_ENABLE) && !defined(KEYBOARD_SHARED_EP)
@@ -329,6 +388,9 @@ static const USBConfig usbcfg = {
     usb_event_cb,          /* USB events callback */
     usb_get_descriptor_cb, /* Device GET_DESCRIPTOR request callback */
     usb_requests_hook_cb,  /* Requests hook callback */
+#ifdef USB_SOF_SYNC_ENABLE
+    usb_sof_sync_sof_cb, /* Start Of Frame callback */
+#endif
 };
 
 void init_usb_driver(USBDriver *usbp) {
@@ -503,6 +565,43 @@ void send_digitizer(report_digitizer_t *report) {
  */
 
 #ifdef CONSOLE_ENABLE
+#    ifdef CONSOLE_RING_BUFFER_ENABLE
+
+int8_t sendchar(uint8_t c) {
+    return (int8_t)console_ring_write(c);
+}
+
+void console_task(void) {
+    static size_t last_used = 0;
+
+    while (true) {
+        size_t used = console_ring_used();
+
+        // A partial packet is only sent once nothing more was printed since the last task
+        if (used == 0 || (used < CONSOLE_EPSIZE && used != last_used)) {
+            break;
+        }
+
+        // Packets are assembled across the end of the ring, so only the last one is ever zero-padded
+        uint8_t packet[CONSOLE_EPSIZE];
+        size_t  size = console_ring_copy(packet, sizeof(packet));
+        if (!usb_endpoint_in_try_send(&usb_endpoints_in[USB_ENDPOINT_IN_CONSOLE], packet, size, true)) {
+            break;
+        }
+        console_ring_consume(size);
+    }
+    last_used = console_ring_used();
+
+    // Reports lost output once there is room for the notice, until then the count carries over
+    if (console_ring_free() >= CONSOLE_EPSIZE) {
+        uint32_t dropped = console_ring_take_dropped();
+        if (dropped > 0) {
+            xprintf("[console: %lu bytes dropped]\n", (unsigned long)dropped);
+        }
+    }
+}
+
+#    else
 
 int8_t sendchar(uint8_t c) {
     return (int8_t)send_report_buffered(USB_ENDPOINT_IN_CONSOLE, &c, sizeof(uint8_t));
@@ -512,6 +611,7 @@ void console_task(void) {
     flush_report_buffered(USB_ENDPOINT_IN_CONSOLE, true);
 }
 
+#    endif
 #endif /* CONSOLE_ENABLE */
 
 #ifdef RAW_ENABLE
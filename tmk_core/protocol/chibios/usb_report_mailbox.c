@@ -0,0 +1,188 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string.h>
+
+#include "usb_report_mailbox.h"
+#include "report.h"
+
+#ifdef MOUSE_EXTENDED_REPORT
+#    define MAILBOX_XY_MIN INT16_MIN
+#    define MAILBOX_XY_MAX INT16_MAX
+#else
+#    define MAILBOX_XY_MIN INT8_MIN
+#    define MAILBOX_XY_MAX INT8_MAX
+#endif
+
+#ifdef WHEEL_EXTENDED_REPORT
+#    define MAILBOX_HV_MIN INT16_MIN
+#    define MAILBOX_HV_MAX INT16_MAX
+#else
+#    define MAILBOX_HV_MIN INT8_MIN
+#    define MAILBOX_HV_MAX INT8_MAX
+#endif
+
+void usb_report_mailbox_reset(usb_report_mailbox_t *mailbox) {
+    mailbox->has_pending   = false;
+    mailbox->pending_size  = 0;
+    mailbox->previous_size = 0;
+}
+
+usb_report_mailbox_result_t usb_report_mailbox_post(usb_report_mailbox_t *mailbox, const uint8_t *report, size_t size, bool queue_has_room) {
+    if (size > mailbox->capacity) {
+        // Too large to hold, so it can only be sent in order, after anything already held
+        if (mailbox->has_pending) {
+            return USB_REPORT_MAILBOX_BLOCKED;
+        }
+        mailbox->previous_size = 0;
+        return USB_REPORT_MAILBOX_SEND;
+    }
+
+    if (!mailbox->has_pending) {
+        if (queue_has_room) {
+            memcpy(mailbox->previous, report, size);
+            mailbox->previous_size = size;
+            return USB_REPORT_MAILBOX_SEND;
+        }
+        memcpy(mailbox->pending, report, size);
+        mailbox->pending_size = size;
+        mailbox->has_pending  = true;
+        return USB_REPORT_MAILBOX_HELD;
+    }
+
+    if (mailbox->pending_size == size) {
+        // Unless it's the same kind of report, what the host saw before the held report isn't known
+        const uint8_t *previous = mailbox->previous_size == size ? mailbox->previous : NULL;
+        // Only the merge knows whether a repeated report is a new event, e.g. mouse movement
+        if (mailbox->merge != NULL ? mailbox->merge(mailbox->pending, previous, report, size) : memcmp(mailbox->pending, report, size) == 0) {
+            return USB_REPORT_MAILBOX_HELD;
+        }
+    }
+    return USB_REPORT_MAILBOX_BLOCKED;
+}
+
+size_t usb_report_mailbox_take(usb_report_mailbox_t *mailbox, uint8_t *buffer) {
+    if (!mailbox->has_pending) {
+        return 0;
+    }
+
+    size_t size = mailbox->pending_size;
+    memcpy(buffer, mailbox->pending, size);
+    memcpy(mailbox->previous, mailbox->pending, size);
+    mailbox->previous_size = size;
+    mailbox->has_pending   = false;
+    return size;
+}
+
+/* Whether every bit that changed from `previous` to `pending` is unchanged in `report`. */
+static bool bits_preserved(const uint8_t *pending, const uint8_t *previous, const uint8_t *report, size_t size) {
+    for (size_t i = 0; i < size; i++) {
+        if ((pending[i] ^ previous[i]) & (report[i] ^ pending[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool contains_key(const uint8_t *keys, uint8_t key) {
+    for (uint8_t i = 0; i < KEYBOARD_REPORT_KEYS; i++) {
+        if (keys[i] == key) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/* Merges 6KRO reports laid out as mods, reserved and keys from `offset`. */
+static bool merge_keyboard_at(uint8_t *pending, const uint8_t *previous, const uint8_t *report, size_t offset) {
+    if (previous == NULL || !bits_preserved(&pending[offset], &previous[offset], &report[offset], 1)) {
+        return false;
+    }
+
+    const uint8_t *pending_keys  = &pending[offset + 2];
+    const uint8_t *previous_keys = &previous[offset + 2];
+    const uint8_t *report_keys   = &report[offset + 2];
+    for (uint8_t i = 0; i < KEYBOARD_REPORT_KEYS; i++) {
+        // A key pressed by the held report must stay pressed...
+        if (pending_keys[i] && !contains_key(previous_keys, pending_keys[i]) && !contains_key(report_keys, pending_keys[i])) {
+            return false;
+        }
+        // ...and a key it released must stay released
+        if (previous_keys[i] && !contains_key(pending_keys, previous_keys[i]) && contains_key(report_keys, previous_keys[i])) {
+            return false;
+        }
+    }
+
+    memcpy(pending, report, offset + 2 + KEYBOARD_REPORT_KEYS);
+    return true;
+}
+
+bool usb_report_merge_keyboard(uint8_t *pending, const uint8_t *previous, const uint8_t *report, size_t size) {
+    // Boot protocol reports leave out the report ID
+    if (size == 2 + KEYBOARD_REPORT_KEYS) {
+        return merge_keyboard_at(pending, previous, report, 0);
+    }
+    return false;
+}
+
+bool usb_report_merge_mouse(uint8_t *pending, const uint8_t *previous, const uint8_t *report, size_t size) {
+    if (size != sizeof(report_mouse_t)) {
+        return false;
+    }
+
+    report_mouse_t held, next;
+    memcpy(&held, pending, sizeof(report_mouse_t));
+    memcpy(&next, report, sizeof(report_mouse_t));
+
+    // Button changes must be seen by the host in order, but movement can be accumulated
+    if (held.buttons != next.buttons) {
+        return false;
+    }
+
+    int32_t x = (int32_t)held.x + next.x;
+    int32_t y = (int32_t)held.y + next.y;
+    int32_t v = (int32_t)held.v + next.v;
+    int32_t h = (int32_t)held.h + next.h;
+    if (x < MAILBOX_XY_MIN || x > MAILBOX_XY_MAX || y < MAILBOX_XY_MIN || y > MAILBOX_XY_MAX || v < MAILBOX_HV_MIN || v > MAILBOX_HV_MAX || h < MAILBOX_HV_MIN || h > MAILBOX_HV_MAX) {
+        return false;
+    }
+
+    held.x = x;
+    held.y = y;
+    held.v = v;
+    held.h = h;
+#ifdef MOUSE_EXTENDED_REPORT
+    held.boot_x = (x > 127) ? 127 : ((x < -127) ? -127 : x);
+    held.boot_y = (y > 127) ? 127 : ((y < -127) ? -127 : y);
+#endif
+    memcpy(pending, &held, sizeof(report_mouse_t));
+    return true;
+}
+
+bool usb_report_merge_shared(uint8_t *pending, const uint8_t *previous, const uint8_t *report, size_t size) {
+    if (pending[0] != report[0]) {
+        return false;
+    }
+
+    switch (report[0]) {
+#if defined(KEYBOARD_SHARED_EP)
+        case REPORT_ID_KEYBOARD:
+            return size == sizeof(report_keyboard_t) && previous != NULL && previous[0] == REPORT_ID_KEYBOARD && merge_keyboard_at(pending, previous, report, 1);
+#endif
+#if defined(MOUSE_SHARED_EP)
+        case REPORT_ID_MOUSE:
+            return usb_report_merge_mouse(pending, previous, report, size);
+#endif
+#if defined(NKRO_ENABLE)
+        case REPORT_ID_NKRO:
+            if (size != sizeof(report_nkro_t) || previous == NULL || previous[0] != REPORT_ID_NKRO || !bits_preserved(&pending[1], &previous[1], &report[1], size - 1)) {
+                return false;
+            }
+            memcpy(pending, report, size);
+            return true;
+#endif
+        default:
+            // System, consumer and other reports only ever hold a single usage, so can only be repeated
+            return memcmp(pending, report, size) == 0;
+    }
+}
@@ -0,0 +1,67 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * A single "latest state" slot in front of an IN endpoint's output queue.
+ *
+ * While the queue has room reports are sent as normal. Once it is full, the
+ * next report is held in the mailbox instead of blocking, and following
+ * reports are merged into it where that can't lose anything the host needs
+ * to see -- e.g. mouse movement is accumulated, and a keyboard report is only
+ * replaced if it keeps every key change the held report made. The held
+ * report is moved into the queue as soon as the host takes a report out of
+ * it, from the IN transfer complete callback.
+ *
+ * This file doesn't depend on ChibiOS, so that it can be tested on the host.
+ */
+
+/**
+ * @brief Merge `report` into the held `pending` report, if that can be done without losing a state change.
+ *
+ * @param pending the held report, updated in place if the merge succeeds
+ * @param previous the report queued before the held one, i.e. what the host will have seen beforehand
+ * @param report the new report
+ * @param size the size of all three reports
+ * @return true if `report` has been merged into `pending`
+ *
+ * Without a merge function, only a repeat of the held report is absorbed.
+ */
+typedef bool (*usb_report_merge_t)(uint8_t *pending, const uint8_t *previous, const uint8_t *report, size_t size);
+
+typedef struct {
+    usb_report_merge_t merge;
+    uint8_t           *pending;
+    uint8_t           *previous;
+    size_t             capacity;
+    size_t             pending_size;
+    size_t             previous_size;
+    bool               has_pending;
+} usb_report_mailbox_t;
+
+typedef enum {
+    USB_REPORT_MAILBOX_SEND,    // Nothing held and the queue has room, the report should be queued now
+    USB_REPORT_MAILBOX_HELD,    // The report is held in the mailbox, possibly merged with an earlier one
+    USB_REPORT_MAILBOX_BLOCKED, // The held report can't be merged with this one, it has to be queued first
+} usb_report_mailbox_result_t;
+
+#define USB_REPORT_MAILBOX(_merge, _capacity)                  \
+    &((usb_report_mailbox_t){                                  \
+        .merge    = _merge,                                    \
+        .pending  = (_Alignas(4) uint8_t[_capacity]){0},       \
+        .previous = (_Alignas(4) uint8_t[_capacity]){0},       \
+        .capacity = _capacity,                                 \
+    })
+
+void                        usb_report_mailbox_reset(usb_report_mailbox_t *mailbox);
+usb_report_mailbox_result_t usb_report_mailbox_post(usb_report_mailbox_t *mailbox, const uint8_t *report, size_t size, bool queue_has_room);
+size_t                      usb_report_mailbox_take(usb_report_mailbox_t *mailbox, uint8_t *buffer);
+
+bool usb_report_merge_keyboard(uint8_t *pending, const uint8_t *previous, const uint8_t *report, size_t size);
+bool usb_report_merge_mouse(uint8_t *pending, const uint8_t *previous, const uint8_t *report, size_t size);
+bool usb_report_merge_shared(uint8_t *pending, const uint8_t *previous, const uint8_t *report, size_t size);
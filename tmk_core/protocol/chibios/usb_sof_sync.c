@@ -0,0 +1,136 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <ch.h>
+#include <hal.h>
+
+#include "usb_sof_sync.h"
+#include "usb_main.h"
+#include "timer.h"
+#include "util.h"
+#include "debug.h"
+
+#ifndef USB_SOF_SYNC_FRAME_US
+#    ifdef USB_HIGH_SPEED
+#        define USB_SOF_SYNC_FRAME_US 125
+#    else
+#        define USB_SOF_SYNC_FRAME_US 1000
+#    endif
+#endif
+
+#ifndef USB_SOF_SYNC_LEAD_US
+#    define USB_SOF_SYNC_LEAD_US (USB_SOF_SYNC_FRAME_US / 4)
+#endif
+
+// How long to wait for a frame before giving up and scanning anyway
+#ifndef USB_SOF_SYNC_TIMEOUT_US
+#    define USB_SOF_SYNC_TIMEOUT_US (USB_SOF_SYNC_FRAME_US * 2)
+#endif
+
+_Static_assert(USB_SOF_SYNC_LEAD_US < USB_SOF_SYNC_FRAME_US, "USB_SOF_SYNC_LEAD_US must be shorter than a frame");
+
+static BSEMAPHORE_DECL(scan_sem, true);
+static virtual_timer_t scan_timer;
+static bool            scan_timer_init = false;
+
+// Shared with the SOF interrupt
+static systime_t scan_start;
+static bool      scan_started  = false;
+static bool      scanning      = false;
+static uint32_t  latency_sum   = 0;
+static uint16_t  latency_min   = UINT16_MAX;
+static uint16_t  latency_max   = 0;
+static uint32_t  latency_count = 0;
+static uint32_t  overrun_count = 0;
+
+static uint32_t stats_timer   = 0;
+static uint16_t last_latency  = 0;
+static uint16_t last_jitter   = 0;
+static uint32_t last_overruns = 0;
+
+static void scan_timer_cb(virtual_timer_t *vtp, void *arg) {
+    (void)vtp;
+    (void)arg;
+    osalSysLockFromISR();
+    chBSemSignalI(&scan_sem);
+    osalSysUnlockFromISR();
+}
+
+void usb_sof_sync_sof_cb(USBDriver *usbp) {
+    (void)usbp;
+
+    osalSysLockFromISR();
+    if (scan_started) {
+        // Time the report had to make it into the queue for this frame
+        uint16_t latency = TIME_I2US(chTimeDiffX(scan_start, chVTGetSystemTimeX()));
+        latency_sum += latency;
+        latency_min = MIN(latency_min, latency);
+        latency_max = MAX(latency_max, latency);
+        latency_count++;
+        scan_started = false;
+    }
+    if (scanning) {
+        overrun_count++;
+    }
+
+    if (scan_timer_init) {
+        chVTSetI(&scan_timer, TIME_US2I(USB_SOF_SYNC_FRAME_US - USB_SOF_SYNC_LEAD_US), scan_timer_cb, NULL);
+    }
+    osalSysUnlockFromISR();
+}
+
+void usb_sof_sync_wait(void) {
+    if (!scan_timer_init) {
+        chVTObjectInit(&scan_timer);
+        scan_timer_init = true;
+    }
+
+    if (USB_DRIVER.state == USB_ACTIVE) {
+        chBSemWaitTimeout(&scan_sem, TIME_US2I(USB_SOF_SYNC_TIMEOUT_US));
+    }
+
+    osalSysLock();
+    scan_start   = chVTGetSystemTimeX();
+    scan_started = true;
+    scanning     = true;
+    osalSysUnlock();
+}
+
+void usb_sof_sync_done(void) {
+    osalSysLock();
+    scanning = false;
+    osalSysUnlock();
+
+    uint32_t timer_now = timer_read32();
+    if (TIMER_DIFF_32(timer_now, stats_timer) < 1000) {
+        return;
+    }
+    stats_timer = timer_now;
+
+    osalSysLock();
+    last_latency  = latency_count ? latency_sum / latency_count : 0;
+    last_jitter   = latency_count ? latency_max - latency_min : 0;
+    last_overruns = overrun_count;
+    latency_sum   = 0;
+    latency_min   = UINT16_MAX;
+    latency_max   = 0;
+    latency_count = 0;
+    overrun_count = 0;
+    osalSysUnlock();
+
+#if defined(DEBUG_MATRIX_SCAN_RATE) && defined(CONSOLE_ENABLE)
+    dprintf("sof sync latency: %u us, jitter: %u us, overruns: %lu\n", last_latency, last_jitter, last_overruns);
+#endif
+}
+
+uint16_t get_usb_sof_sync_latency(void) {
+    return last_latency;
+}
+
+uint16_t get_usb_sof_sync_jitter(void) {
+    return last_jitter;
+}
+
+uint32_t get_usb_sof_sync_overruns(void) {
+    return last_overruns;
+}
@@ -0,0 +1,30 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+#include <hal.h>
+
+/*
+ * Paces the main loop to the host's USB frames: each start-of-frame (SOF)
+ * arms a timer that wakes the main loop USB_SOF_SYNC_LEAD_US before the next
+ * one, so that the matrix is scanned and any report queued just in time for
+ * it, and the MCU can idle in between.
+ *
+ * Without frames, e.g. while suspended or not yet configured, the main loop
+ * runs freely as usual.
+ */
+
+/* Start-of-frame callback, installed in the USB driver's configuration */
+void usb_sof_sync_sof_cb(USBDriver *usbp);
+
+/* Blocks until it's time for the next scan, called at the top of the main loop */
+void usb_sof_sync_wait(void);
+
+/* Marks the end of the scan and report, called at the end of the main loop */
+void usb_sof_sync_done(void);
+
+uint16_t get_usb_sof_sync_latency(void);  // Average time from the start of a scan to the following SOF over the last second, in microseconds
+uint16_t get_usb_sof_sync_jitter(void);   // Spread of that time over the last second, in microseconds
+uint32_t get_usb_sof_sync_overruns(void); // Number of SOFs that arrived before the scan finished over the last second
@@ -44,6 +44,17 @@ static host_driver_t *driver;
 static uint16_t       last_system_usage   = 0;
 static uint16_t       last_consumer_usage = 0;
 
+#ifdef DEBUG_USB_REPORT_RATE
+static uint32_t report_count = 0;
+
+uint32_t host_report_count(void) {
+    return report_count;
+}
+#    define report_sent() report_count++
+#else
+#    define report_sent()
+#endif
+
 void host_set_driver(host_driver_t *d) {
     driver = d;
 }
@@ -85,6 +96,7 @@ void host_keyboard_send(report_keyboard_t *report) {
     report->report_id = REPORT_ID_KEYBOARD;
 #endif
     (*driver->send_keyboard)(report);
+    report_sent();
 
     if (debug_keyboard) {
         dprintf("keyboard_report: %02X | ", report->mods);
@@ -99,6 +111,7 @@ void host_nkro_send(report_nkro_t *report) {
     if (!driver) return;
     report->report_id = REPORT_ID_NKRO;
     (*driver->send_nkro)(report);
+    report_sent();
 
     if (debug_keyboard) {
         dprintf("nkro_report: %02X | ", report->mods);
@@ -127,6 +140,7 @@ void host_mouse_send(report_mouse_t *report) {
     report->boot_y = (report->y > 127) ? 127 : ((report->y < -127) ? -127 : report->y);
 #endif
     (*driver->send_mouse)(report);
+    report_sent();
 }
 
 void host_system_send(uint16_t usage) {
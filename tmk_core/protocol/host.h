@@ -44,6 +44,9 @@ void    host_programmable_button_send(uint32_t data);
 uint16_t host_last_system_usage(void);
 uint16_t host_last_consumer_usage(void);
 
+/* number of keyboard, NKRO and mouse reports sent, for DEBUG_USB_REPORT_RATE */
+uint32_t host_report_count(void);
+
 #ifdef __cplusplus
 }
 #endif
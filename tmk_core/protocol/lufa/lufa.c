@@ -388,6 +388,25 @@ void EVENT_USB_Device_ConfigurationChanged(void) {
     usb_device_state_set_configuration(USB_DeviceState == DEVICE_STATE_Configured, USB_Device_ConfigurationNumber);
 }
 
+#ifdef POINTING_DEVICE_HIRES_SCROLL_ENABLE
+#    define HID_REPORT_TYPE_FEATURE 0x03
+
+#    ifdef MOUSE_SHARED_EP
+#        define MOUSE_FEATURE_INTERFACE SHARED_INTERFACE
+#        define MOUSE_FEATURE_REPORT_ID REPORT_ID_MOUSE
+#    else
+#        define MOUSE_FEATURE_INTERFACE MOUSE_INTERFACE
+#        define MOUSE_FEATURE_REPORT_ID 0
+#    endif
+
+// Report ID, when the mouse shares its endpoint, followed by the resolution multipliers
+static uint8_t resolution_multiplier_buf[2];
+
+static bool is_resolution_multiplier_request(void) {
+    return USB_ControlRequest.wIndex == MOUSE_FEATURE_INTERFACE && (USB_ControlRequest.wValue >> 8) == HID_REPORT_TYPE_FEATURE && (USB_ControlRequest.wValue & 0xFF) == MOUSE_FEATURE_REPORT_ID;
+}
+#endif
+
 /* FIXME: Expose this table in the docs somehow
 Appendix G: HID Request Support Requirements
 
@@ -423,6 +442,19 @@ void EVENT_USB_Device_ControlRequest(void) {
                         ReportSize = sizeof(keyboard_report_sent);
                         break;
                 }
+#ifdef POINTING_DEVICE_HIRES_SCROLL_ENABLE
+                if (is_resolution_multiplier_request()) {
+#    ifdef MOUSE_SHARED_EP
+                    resolution_multiplier_buf[0] = REPORT_ID_MOUSE;
+                    resolution_multiplier_buf[1] = usb_device_state_get_resolution_multiplier();
+                    ReportSize                   = 2;
+#    else
+                    resolution_multiplier_buf[0] = usb_device_state_get_resolution_multiplier();
+                    ReportSize                   = 1;
+#    endif
+                    ReportData = resolution_multiplier_buf;
+                }
+#endif
 
                 /* Write the report data to the control endpoint */
                 Endpoint_Write_Control_Stream_LE(ReportData, ReportSize);
@@ -432,6 +464,24 @@ void EVENT_USB_Device_ControlRequest(void) {
             break;
         case HID_REQ_SetReport:
             if (USB_ControlRequest.bmRequestType == (REQDIR_HOSTTODEVICE | REQTYPE_CLASS | REQREC_INTERFACE)) {
+#ifdef POINTING_DEVICE_HIRES_SCROLL_ENABLE
+                if (is_resolution_multiplier_request()) {
+                    Endpoint_ClearSETUP();
+
+                    while (!(Endpoint_IsOUTReceived())) {
+                        if (USB_DeviceState == DEVICE_STATE_Unattached) return;
+                    }
+
+                    if (Endpoint_BytesInEndpoint() == 2) {
+                        Endpoint_Read_8(); // Report ID
+                    }
+                    usb_device_state_set_resolution_multiplier(Endpoint_Read_8());
+
+                    Endpoint_ClearOUT();
+                    Endpoint_ClearStatusStage();
+                    break;
+                }
+#endif
                 // Interface
                 switch (USB_ControlRequest.wIndex) {
                     case KEYBOARD_INTERFACE:
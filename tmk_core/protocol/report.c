@@ -21,6 +21,7 @@
 #include "debug.h"
 #include "usb_device_state.h"
 #include "util.h"
+#include <stddef.h>
 #include <string.h>
 
 /** \brief has_anykey
@@ -33,8 +34,7 @@ uint8_t has_anykey(void) {
     uint8_t  lp  = sizeof(keyboard_report->keys);
 #ifdef NKRO_ENABLE
     if (usb_device_state_get_protocol() == USB_PROTOCOL_REPORT && keymap_config.nkro) {
-        p  = nkro_report->bits;
-        lp = sizeof(nkro_report->bits);
+        return nkro_bitmap_count_keys(nkro_bitmap);
     }
 #endif
     while (lp--) {
@@ -45,15 +45,12 @@ uint8_t has_anykey(void) {
 
 /** \brief get_first_key
  *
- * FIXME: Needs doc
+ * Returns the first key in the 6KRO report, or the lowest keycode held in the NKRO report, or KC_NO if there are none.
  */
 uint8_t get_first_key(void) {
 #ifdef NKRO_ENABLE
     if (usb_device_state_get_protocol() == USB_PROTOCOL_REPORT && keymap_config.nkro) {
-        uint8_t i = 0;
-        for (; i < NKRO_REPORT_BITS && !nkro_report->bits[i]; i++)
-            ;
-        return i << 3 | biton(nkro_report->bits[i]);
+        return nkro_bitmap_first_key(nkro_bitmap);
     }
 #endif
     return keyboard_report->keys[0];
@@ -143,6 +140,63 @@ void del_key_bit(report_nkro_t* nkro_report, uint8_t code) {
         dprintf("del_key_bit: can't del: %02X\n", code);
     }
 }
+
+_Static_assert(offsetof(report_nkro_bitmap_t, report.bits) == sizeof(uint32_t), "NKRO bitmap must start on a word boundary");
+
+/** \brief Counts the keys held in an NKRO bitmap
+ */
+uint8_t nkro_bitmap_count_keys(const report_nkro_bitmap_t* bitmap) {
+    uint8_t cnt = 0;
+    for (uint8_t i = 1; i <= NKRO_REPORT_WORDS; i++) {
+        if (bitmap->words[i]) {
+            cnt += bitpop32(bitmap->words[i]);
+        }
+    }
+    return cnt;
+}
+
+/** \brief Returns the lowest keycode held in an NKRO bitmap, or KC_NO if there are none
+ */
+uint8_t nkro_bitmap_first_key(const report_nkro_bitmap_t* bitmap) {
+    for (uint8_t i = 1; i <= NKRO_REPORT_WORDS; i++) {
+        if (bitmap->words[i]) {
+            return (i - 1) * 32 + __builtin_ctzl(bitmap->words[i]);
+        }
+    }
+    return KC_NO;
+}
+
+/** \brief Whether an NKRO report differs from the one last sent, compared a word at a time
+ */
+bool nkro_bitmap_changed(const report_nkro_bitmap_t* bitmap, const report_nkro_bitmap_t* last_bitmap) {
+    uint32_t diff = 0;
+    for (uint8_t i = 0; i <= NKRO_REPORT_WORDS; i++) {
+        diff |= bitmap->words[i] ^ last_bitmap->words[i];
+    }
+    return diff != 0;
+}
+
+/** \brief Moves the keys held in an NKRO bitmap into a 6KRO report, as many as fit, lowest keycode first
+ */
+void nkro_bitmap_to_keys(report_nkro_bitmap_t* bitmap, report_keyboard_t* keyboard_report) {
+    for (uint8_t i = 1; i <= NKRO_REPORT_WORDS; i++) {
+        for (uint32_t word = bitmap->words[i]; word; word &= word - 1) {
+            add_key_byte(keyboard_report, (i - 1) * 32 + __builtin_ctzl(word));
+        }
+        bitmap->words[i] = 0;
+    }
+}
+
+/** \brief Moves the keys held in a 6KRO report into an NKRO bitmap
+ */
+void nkro_bitmap_from_keys(report_nkro_bitmap_t* bitmap, report_keyboard_t* keyboard_report) {
+    for (uint8_t i = 0; i < KEYBOARD_REPORT_KEYS; i++) {
+        if (keyboard_report->keys[i]) {
+            add_key_bit(&bitmap->report, keyboard_report->keys[i]);
+            keyboard_report->keys[i] = 0;
+        }
+    }
+}
 #endif
 
 /** \brief add key to report
@@ -165,10 +219,8 @@ void add_key_to_report(uint8_t key) {
  */
 void del_key_from_report(uint8_t key) {
 #ifdef NKRO_ENABLE
-    if (usb_device_state_get_protocol() == USB_PROTOCOL_REPORT && keymap_config.nkro) {
-        del_key_bit(nkro_report, key);
-        return;
-    }
+    // Released from both reports, in case the key was pressed before switching between them
+    del_key_bit(nkro_report, key);
 #endif
     del_key_byte(keyboard_report, key);
 }
@@ -180,10 +232,7 @@ void del_key_from_report(uint8_t key) {
 void clear_keys_from_report(void) {
     // not clear mods
 #ifdef NKRO_ENABLE
-    if (usb_device_state_get_protocol() == USB_PROTOCOL_REPORT && keymap_config.nkro) {
-        memset(nkro_report->bits, 0, sizeof(nkro_report->bits));
-        return;
-    }
+    memset(nkro_report->bits, 0, sizeof(nkro_report->bits));
 #endif
     memset(keyboard_report->keys, 0, sizeof(keyboard_report->keys));
 }
@@ -207,4 +256,19 @@ __attribute__((weak)) bool has_mouse_report_changed(report_mouse_t* new_report,
                     (new_report->x != 0 && new_report->x != old_report->x) || (new_report->y != 0 && new_report->y != old_report->y) || (new_report->h != 0 && new_report->h != old_report->h) || (new_report->v != 0 && new_report->v != old_report->v));
     return changed;
 }
+
+#    ifdef POINTING_DEVICE_HIRES_SCROLL_ENABLE
+/**
+ * @brief Number of steps the host divides each wheel detent into
+ *
+ * The host enables the resolution multiplier of each wheel through the mouse feature report, until then it counts whole detents.
+ *
+ * @param[in] horizontal bool, true for the horizontal wheel
+ * @return uint16_t steps per detent
+ */
+uint16_t mouse_wheel_resolution(bool horizontal) {
+    uint8_t multiplier = usb_device_state_get_resolution_multiplier() >> (horizontal ? 2 : 0);
+    return (multiplier & 0x03) ? POINTING_DEVICE_HIRES_SCROLL_MULTIPLIER : 1;
+}
+#    endif
 #endif
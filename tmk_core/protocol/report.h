@@ -135,6 +135,7 @@ enum desktop_usages {
 // clang-format on
 
 #define NKRO_REPORT_BITS 30
+#define NKRO_REPORT_WORDS ((NKRO_REPORT_BITS + 3) / 4)
 
 #ifdef KEYBOARD_SHARED_EP
 #    define KEYBOARD_REPORT_SIZE 9
@@ -183,6 +184,20 @@ typedef struct {
     uint8_t bits[NKRO_REPORT_BITS];
 } PACKED report_nkro_t;
 
+/*
+ * Storage for an NKRO report, placed so that its bitmap starts on a word
+ * boundary and is padded to a whole number of words. words[0] holds the report
+ * ID and mods, words[1] onwards the bitmap.
+ */
+typedef union {
+    struct {
+        uint8_t       padding[2];
+        report_nkro_t report;
+        uint8_t       tail[NKRO_REPORT_WORDS * 4 - NKRO_REPORT_BITS];
+    } PACKED;
+    uint32_t words[1 + NKRO_REPORT_WORDS];
+} report_nkro_bitmap_t;
+
 typedef struct {
     uint8_t  report_id;
     uint16_t usage;
@@ -205,6 +220,15 @@ typedef int16_t mouse_hv_report_t;
 typedef int8_t mouse_hv_report_t;
 #endif
 
+#ifdef POINTING_DEVICE_HIRES_SCROLL_ENABLE
+#    ifndef WHEEL_EXTENDED_REPORT
+#        error "POINTING_DEVICE_HIRES_SCROLL_ENABLE requires WHEEL_EXTENDED_REPORT"
+#    endif
+#    ifndef POINTING_DEVICE_HIRES_SCROLL_MULTIPLIER
+#        define POINTING_DEVICE_HIRES_SCROLL_MULTIPLIER 120
+#    endif
+#endif
+
 typedef struct {
 #ifdef MOUSE_SHARED_EP
     uint8_t report_id;
@@ -341,6 +365,12 @@ void del_key_byte(report_keyboard_t* keyboard_report, uint8_t code);
 #ifdef NKRO_ENABLE
 void add_key_bit(report_nkro_t* nkro_report, uint8_t code);
 void del_key_bit(report_nkro_t* nkro_report, uint8_t code);
+
+uint8_t nkro_bitmap_count_keys(const report_nkro_bitmap_t* bitmap);
+uint8_t nkro_bitmap_first_key(const report_nkro_bitmap_t* bitmap);
+bool    nkro_bitmap_changed(const report_nkro_bitmap_t* bitmap, const report_nkro_bitmap_t* last_bitmap);
+void    nkro_bitmap_to_keys(report_nkro_bitmap_t* bitmap, report_keyboard_t* keyboard_report);
+void    nkro_bitmap_from_keys(report_nkro_bitmap_t* bitmap, report_keyboard_t* keyboard_report);
 #endif
 
 void add_key_to_report(uint8_t key);
@@ -349,6 +379,9 @@ void clear_keys_from_report(void);
 
 #ifdef MOUSE_ENABLE
 bool has_mouse_report_changed(report_mouse_t* new_report, report_mouse_t* old_report);
+#    ifdef POINTING_DEVICE_HIRES_SCROLL_ENABLE
+uint16_t mouse_wheel_resolution(bool horizontal);
+#    endif
 #endif
 
 #ifdef __cplusplus
@@ -41,6 +41,10 @@
 #include "usb_descriptor.h"
 #include "usb_descriptor_common.h"
 
+#if defined(USB_HIGH_SPEED) && defined(USB_POLLING_INTERVAL_MS) && (USB_POLLING_INTERVAL_US == USB_POLLING_INTERVAL_MS * 1000UL)
+#    pragma message "USB_POLLING_INTERVAL_MS limits USB_HIGH_SPEED polling to whole milliseconds, set USB_POLLING_INTERVAL_US to poll faster"
+#endif
+
 #ifdef JOYSTICK_ENABLE
 #    include "joystick.h"
 #endif
@@ -165,35 +169,87 @@ const USB_Descriptor_HIDReport_Datatype_t PROGMEM SharedReport[] = {
 #    endif
             HID_RI_INPUT(8, HID_IOF_DATA | HID_IOF_VARIABLE | HID_IOF_RELATIVE),
 
+#    ifndef POINTING_DEVICE_HIRES_SCROLL_ENABLE
             // Vertical wheel (1 or 2 bytes)
             HID_RI_USAGE(8, 0x38),     // Wheel
-#    ifndef WHEEL_EXTENDED_REPORT
+#        ifndef WHEEL_EXTENDED_REPORT
             HID_RI_LOGICAL_MINIMUM(8, -127),
             HID_RI_LOGICAL_MAXIMUM(8, 127),
             HID_RI_REPORT_COUNT(8, 0x01),
             HID_RI_REPORT_SIZE(8, 0x08),
-#    else
+#        else
             HID_RI_LOGICAL_MINIMUM(16, -32767),
             HID_RI_LOGICAL_MAXIMUM(16,  32767),
             HID_RI_REPORT_COUNT(8, 0x01),
             HID_RI_REPORT_SIZE(8, 0x10),
-#    endif
+#        endif
             HID_RI_INPUT(8, HID_IOF_DATA | HID_IOF_VARIABLE | HID_IOF_RELATIVE),
             // Horizontal wheel (1 or 2 bytes)
             HID_RI_USAGE_PAGE(8, 0x0C),// Consumer
             HID_RI_USAGE(16, 0x0238),  // AC Pan
-#    ifndef WHEEL_EXTENDED_REPORT
+#        ifndef WHEEL_EXTENDED_REPORT
             HID_RI_LOGICAL_MINIMUM(8, -127),
             HID_RI_LOGICAL_MAXIMUM(8, 127),
             HID_RI_REPORT_COUNT(8, 0x01),
             HID_RI_REPORT_SIZE(8, 0x08),
-#    else
+#        else
             HID_RI_LOGICAL_MINIMUM(16, -32767),
             HID_RI_LOGICAL_MAXIMUM(16,  32767),
             HID_RI_REPORT_COUNT(8, 0x01),
             HID_RI_REPORT_SIZE(8, 0x10),
-#    endif
+#        endif
             HID_RI_INPUT(8, HID_IOF_DATA | HID_IOF_VARIABLE | HID_IOF_RELATIVE),
+#    else
+            // Each wheel shares a logical collection with its resolution
+            // multiplier, which the host enables through the feature report
+            HID_RI_COLLECTION(8, 0x02),        // Logical
+                // Resolution multiplier (2 bits)
+                HID_RI_USAGE_PAGE(8, 0x01),    // Generic Desktop
+                HID_RI_USAGE(8, 0x48),         // Resolution Multiplier
+                HID_RI_LOGICAL_MINIMUM(8, 0x00),
+                HID_RI_LOGICAL_MAXIMUM(8, 0x01),
+                HID_RI_PHYSICAL_MINIMUM(8, 0x01),
+                HID_RI_PHYSICAL_MAXIMUM(16, POINTING_DEVICE_HIRES_SCROLL_MULTIPLIER),
+                HID_RI_REPORT_COUNT(8, 0x01),
+                HID_RI_REPORT_SIZE(8, 0x02),
+                HID_RI_FEATURE(8, HID_IOF_DATA | HID_IOF_VARIABLE | HID_IOF_ABSOLUTE),
+                HID_RI_PHYSICAL_MINIMUM(8, 0x00),
+                HID_RI_PHYSICAL_MAXIMUM(8, 0x00),
+                // Vertical wheel (2 bytes)
+                HID_RI_USAGE(8, 0x38),         // Wheel
+                HID_RI_LOGICAL_MINIMUM(16, -32767),
+                HID_RI_LOGICAL_MAXIMUM(16,  32767),
+                HID_RI_REPORT_COUNT(8, 0x01),
+                HID_RI_REPORT_SIZE(8, 0x10),
+                HID_RI_INPUT(8, HID_IOF_DATA | HID_IOF_VARIABLE | HID_IOF_RELATIVE),
+            HID_RI_END_COLLECTION(0),
+            HID_RI_COLLECTION(8, 0x02),        // Logical
+                // Resolution multiplier (2 bits)
+                HID_RI_USAGE_PAGE(8, 0x01),    // Generic Desktop
+                HID_RI_USAGE(8, 0x48),         // Resolution Multiplier
+                HID_RI_LOGICAL_MINIMUM(8, 0x00),
+                HID_RI_LOGICAL_MAXIMUM(8, 0x01),
+                HID_RI_PHYSICAL_MINIMUM(8, 0x01),
+                HID_RI_PHYSICAL_MAXIMUM(16, POINTING_DEVICE_HIRES_SCROLL_MULTIPLIER),
+                HID_RI_REPORT_COUNT(8, 0x01),
+                HID_RI_REPORT_SIZE(8, 0x02),
+                HID_RI_FEATURE(8, HID_IOF_DATA | HID_IOF_VARIABLE | HID_IOF_ABSOLUTE),
+                HID_RI_PHYSICAL_MINIMUM(8, 0x00),
+                HID_RI_PHYSICAL_MAXIMUM(8, 0x00),
+                // Horizontal wheel (2 bytes)
+                HID_RI_USAGE_PAGE(8, 0x0C),    // Consumer
+                HID_RI_USAGE(16, 0x0238),      // AC Pan
+                HID_RI_LOGICAL_MINIMUM(16, -32767),
+                HID_RI_LOGICAL_MAXIMUM(16,  32767),
+                HID_RI_REPORT_COUNT(8, 0x01),
+                HID_RI_REPORT_SIZE(8, 0x10),
+                HID_RI_INPUT(8, HID_IOF_DATA | HID_IOF_VARIABLE | HID_IOF_RELATIVE),
+            HID_RI_END_COLLECTION(0),
+            // Feature report padding (4 bits)
+            HID_RI_REPORT_COUNT(8, 0x01),
+            HID_RI_REPORT_SIZE(8, 0x04),
+            HID_RI_FEATURE(8, HID_IOF_CONSTANT),
+#    endif
         HID_RI_END_COLLECTION(0),
     HID_RI_END_COLLECTION(0),
 #    ifndef MOUSE_SHARED_EP
@@ -504,10 +560,6 @@ const USB_Descriptor_Device_t PROGMEM DeviceDescriptor = {
 #    define USB_MAX_POWER_CONSUMPTION 500
 #endif
 
-#ifndef USB_POLLING_INTERVAL_MS
-#    define USB_POLLING_INTERVAL_MS 1
-#endif
-
 /*
  * Configuration descriptors
  */
@@ -560,7 +612,7 @@ const USB_Descriptor_Configuration_t PROGMEM ConfigurationDescriptor = {
         .EndpointAddress        = (ENDPOINT_DIR_IN | KEYBOARD_IN_EPNUM),
         .Attributes             = (EP_TYPE_INTERRUPT | ENDPOINT_ATTR_NO_SYNC | ENDPOINT_USAGE_DATA),
         .EndpointSize           = KEYBOARD_EPSIZE,
-        .PollingIntervalMS      = USB_POLLING_INTERVAL_MS
+        .PollingIntervalMS      = USB_INTERVAL_US(KEYBOARD_POLLING_INTERVAL_US)
     },
 #endif
 
@@ -600,7 +652,7 @@ const USB_Descriptor_Configuration_t PROGMEM ConfigurationDescriptor = {
         .EndpointAddress        = (ENDPOINT_DIR_IN | RAW_IN_EPNUM),
         .Attributes             = (EP_TYPE_INTERRUPT | ENDPOINT_ATTR_NO_SYNC | ENDPOINT_USAGE_DATA),
         .EndpointSize           = RAW_EPSIZE,
-        .PollingIntervalMS      = 0x01
+        .PollingIntervalMS      = USB_INTERVAL_MS(1)
     },
     .Raw_OUTEndpoint = {
         .Header = {
@@ -610,7 +662,7 @@ const USB_Descriptor_Configuration_t PROGMEM ConfigurationDescriptor = {
         .EndpointAddress        = (ENDPOINT_DIR_OUT | RAW_OUT_EPNUM),
         .Attributes             = (EP_TYPE_INTERRUPT | ENDPOINT_ATTR_NO_SYNC | ENDPOINT_USAGE_DATA),
         .EndpointSize           = RAW_EPSIZE,
-        .PollingIntervalMS      = 0x01
+        .PollingIntervalMS      = USB_INTERVAL_MS(1)
     },
 #endif
 
@@ -650,7 +702,7 @@ const USB_Descriptor_Configuration_t PROGMEM ConfigurationDescriptor = {
         .EndpointAddress        = (ENDPOINT_DIR_IN | MOUSE_IN_EPNUM),
         .Attributes             = (EP_TYPE_INTERRUPT | ENDPOINT_ATTR_NO_SYNC | ENDPOINT_USAGE_DATA),
         .EndpointSize           = MOUSE_EPSIZE,
-        .PollingIntervalMS      = USB_POLLING_INTERVAL_MS
+        .PollingIntervalMS      = USB_INTERVAL_US(MOUSE_POLLING_INTERVAL_US)
     },
 #endif
 
@@ -695,7 +747,7 @@ const USB_Descriptor_Configuration_t PROGMEM ConfigurationDescriptor = {
         .EndpointAddress        = (ENDPOINT_DIR_IN | SHARED_IN_EPNUM),
         .Attributes             = (EP_TYPE_INTERRUPT | ENDPOINT_ATTR_NO_SYNC | ENDPOINT_USAGE_DATA),
         .EndpointSize           = SHARED_EPSIZE,
-        .PollingIntervalMS      = USB_POLLING_INTERVAL_MS
+        .PollingIntervalMS      = USB_INTERVAL_US(SHARED_POLLING_INTERVAL_US)
     },
 #endif
 
@@ -735,7 +787,7 @@ const USB_Descriptor_Configuration_t PROGMEM ConfigurationDescriptor = {
         .EndpointAddress        = (ENDPOINT_DIR_IN | CONSOLE_IN_EPNUM),
         .Attributes             = (EP_TYPE_INTERRUPT | ENDPOINT_ATTR_NO_SYNC | ENDPOINT_USAGE_DATA),
         .EndpointSize           = CONSOLE_EPSIZE,
-        .PollingIntervalMS      = 0x01
+        .PollingIntervalMS      = USB_INTERVAL_MS(1)
     },
 #endif
 
@@ -957,7 +1009,7 @@ const USB_Descriptor_Configuration_t PROGMEM ConfigurationDescriptor = {
         .EndpointAddress        = (ENDPOINT_DIR_IN | CDC_NOTIFICATION_EPNUM),
         .Attributes             = (EP_TYPE_INTERRUPT | ENDPOINT_ATTR_NO_SYNC | ENDPOINT_USAGE_DATA),
         .EndpointSize           = CDC_NOTIFICATION_EPSIZE,
-        .PollingIntervalMS      = 0xFF
+        .PollingIntervalMS      = USB_INTERVAL_MS(255)
     },
     .CDC_DCI_Interface = {
         .Header = {
@@ -1030,7 +1082,7 @@ const USB_Descriptor_Configuration_t PROGMEM ConfigurationDescriptor = {
         .EndpointAddress        = (ENDPOINT_DIR_IN | JOYSTICK_IN_EPNUM),
         .Attributes             = (EP_TYPE_INTERRUPT | ENDPOINT_ATTR_NO_SYNC | ENDPOINT_USAGE_DATA),
         .EndpointSize           = JOYSTICK_EPSIZE,
-        .PollingIntervalMS      = USB_POLLING_INTERVAL_MS
+        .PollingIntervalMS      = USB_INTERVAL_US(USB_POLLING_INTERVAL_US)
     },
 #endif
 
@@ -1070,7 +1122,7 @@ const USB_Descriptor_Configuration_t PROGMEM ConfigurationDescriptor = {
         .EndpointAddress        = (ENDPOINT_DIR_IN | DIGITIZER_IN_EPNUM),
         .Attributes             = (EP_TYPE_INTERRUPT | ENDPOINT_ATTR_NO_SYNC | ENDPOINT_USAGE_DATA),
         .EndpointSize           = DIGITIZER_EPSIZE,
-        .PollingIntervalMS      = USB_POLLING_INTERVAL_MS
+        .PollingIntervalMS      = USB_INTERVAL_US(USB_POLLING_INTERVAL_US)
     },
 #endif
 };
@@ -1164,6 +1216,59 @@ void set_serial_number_descriptor(void) {
 
 #endif // defined(SERIAL_NUMBER)
 
+#ifdef USB_HIGH_SPEED
+/*
+ * Device qualifier and other speed configuration descriptors, required of high-speed capable devices
+ */
+// clang-format off
+const USB_Descriptor_DeviceQualifier_t PROGMEM DeviceQualifierDescriptor = {
+    .Header = {
+        .Size                   = sizeof(USB_Descriptor_DeviceQualifier_t),
+        .Type                   = DTYPE_DeviceQualifier
+    },
+    .USBSpecification           = VERSION_BCD(2, 0, 0),
+
+#    if VIRTSER_ENABLE
+    .Class                      = USB_CSCP_IADDeviceClass,
+    .SubClass                   = USB_CSCP_IADDeviceSubclass,
+    .Protocol                   = USB_CSCP_IADDeviceProtocol,
+#    else
+    .Class                      = USB_CSCP_NoDeviceClass,
+    .SubClass                   = USB_CSCP_NoDeviceSubclass,
+    .Protocol                   = USB_CSCP_NoDeviceProtocol,
+#    endif
+
+    .Endpoint0Size              = FIXED_CONTROL_ENDPOINT_SIZE,
+    .NumberOfConfigurations     = FIXED_NUM_CONFIGURATIONS,
+    .Reserved                   = 0
+};
+// clang-format on
+
+static USB_Descriptor_Configuration_t OtherSpeedConfigurationDescriptor;
+
+// The configuration as it is at full speed, with the interrupt endpoints polling at the same rate, rounded up to whole frames
+static void set_other_speed_configuration_descriptor(void) {
+    static bool is_set = false;
+    if (is_set) {
+        return;
+    }
+    is_set = true;
+
+    OtherSpeedConfigurationDescriptor                    = ConfigurationDescriptor;
+    OtherSpeedConfigurationDescriptor.Config.Header.Type = DTYPE_Other;
+
+    uint8_t* p   = (uint8_t*)&OtherSpeedConfigurationDescriptor;
+    uint8_t* end = p + sizeof(USB_Descriptor_Configuration_t);
+    while (p < end && ((USB_Descriptor_Header_t*)p)->Size > 0) {
+        USB_Descriptor_Endpoint_t* endpoint = (USB_Descriptor_Endpoint_t*)p;
+        if (endpoint->Header.Type == DTYPE_Endpoint && (endpoint->Attributes & EP_TYPE_MASK) == EP_TYPE_INTERRUPT) {
+            endpoint->PollingIntervalMS = USB_INTERVAL_FULL_SPEED(endpoint->PollingIntervalMS);
+        }
+        p += ((USB_Descriptor_Header_t*)p)->Size;
+    }
+}
+#endif // USB_HIGH_SPEED
+
 /**
  * This function is called by the library when in device mode, and must be overridden (see library "USB Descriptors"
  * documentation) by the application code so that the address and size of a requested descriptor can be given
@@ -1188,6 +1293,19 @@ uint16_t get_usb_descriptor(const uint16_t wValue, const uint16_t wIndex, const
             Size    = sizeof(USB_Descriptor_Configuration_t);
 
             break;
+#ifdef USB_HIGH_SPEED
+        case DTYPE_DeviceQualifier:
+            Address = &DeviceQualifierDescriptor;
+            Size    = sizeof(USB_Descriptor_DeviceQualifier_t);
+
+            break;
+        case DTYPE_Other:
+            set_other_speed_configuration_descriptor();
+            Address = &OtherSpeedConfigurationDescriptor;
+            Size    = sizeof(USB_Descriptor_Configuration_t);
+
+            break;
+#endif
         case DTYPE_String:
             switch (DescriptorIndex) {
                 case 0x00:
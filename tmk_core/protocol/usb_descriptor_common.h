@@ -32,3 +32,45 @@
 #ifndef RAW_USAGE_ID
 #    define RAW_USAGE_ID 0x61
 #endif
+
+/////////////////////
+// Interrupt endpoint polling intervals
+//
+// Full-speed bInterval is in frames (1ms). High-speed bInterval is an
+// exponent, polling every 2^(bInterval - 1) microframes of 125us -- so
+// requested periods are rounded down to the nearest power of two.
+
+#ifdef USB_HIGH_SPEED
+#    define USB_INTERVAL_US(us) \
+        ((us) < 250 ? 1 : (us) < 500 ? 2 : (us) < 1000 ? 3 : (us) < 2000 ? 4 : (us) < 4000 ? 5 : (us) < 8000 ? 6 : (us) < 16000 ? 7 : (us) < 32000 ? 8 : (us) < 64000 ? 9 : (us) < 128000 ? 10 : (us) < 256000 ? 11 : 12)
+#else
+#    define USB_INTERVAL_US(us) ((us) < 1000 ? 1 : (us) > 255000 ? 255 : (us) / 1000)
+#endif
+#define USB_INTERVAL_MS(ms) USB_INTERVAL_US((ms)*1000UL)
+
+#ifdef USB_HIGH_SPEED
+// Full-speed bInterval polling at the same rate as a high-speed bInterval, for the other speed configuration
+#    define USB_INTERVAL_FULL_SPEED(interval) ((interval) <= 4 ? 1 : (interval) >= 12 ? 255 : 1 << ((interval)-4))
+#endif
+
+#ifndef USB_POLLING_INTERVAL_US
+#    ifdef USB_POLLING_INTERVAL_MS
+#        define USB_POLLING_INTERVAL_US (USB_POLLING_INTERVAL_MS * 1000UL)
+#    elif defined(USB_HIGH_SPEED)
+#        define USB_POLLING_INTERVAL_US 125
+#    else
+#        define USB_POLLING_INTERVAL_US 1000
+#    endif
+#endif
+
+#ifndef KEYBOARD_POLLING_INTERVAL_US
+#    define KEYBOARD_POLLING_INTERVAL_US USB_POLLING_INTERVAL_US
+#endif
+
+#ifndef MOUSE_POLLING_INTERVAL_US
+#    define MOUSE_POLLING_INTERVAL_US USB_POLLING_INTERVAL_US
+#endif
+
+#ifndef SHARED_POLLING_INTERVAL_US
+#    define SHARED_POLLING_INTERVAL_US USB_POLLING_INTERVAL_US
+#endif
@@ -24,7 +24,7 @@
 #    include "os_detection.h"
 #endif
 
-static struct usb_device_state usb_device_state = {.idle_rate = 0, .leds = 0, .protocol = USB_PROTOCOL_REPORT, .configure_state = USB_DEVICE_STATE_NO_INIT};
+static struct usb_device_state usb_device_state = {.idle_rate = 0, .leds = 0, .resolution_multiplier = 0, .protocol = USB_PROTOCOL_REPORT, .configure_state = USB_DEVICE_STATE_NO_INIT};
 
 __attribute__((weak)) void notify_usb_device_state_change_kb(struct usb_device_state usb_device_state) {
     notify_usb_device_state_change_user(usb_device_state);
@@ -61,6 +61,8 @@ void usb_device_state_set_resume(bool is_configured, uint8_t configuration_numbe
 
 void usb_device_state_set_reset(void) {
     usb_device_state.configure_state = USB_DEVICE_STATE_INIT;
+    // The host sets the resolution multiplier again when it enumerates the device
+    usb_device_state.resolution_multiplier = 0;
     notify_usb_device_state_change(usb_device_state);
 }
 
@@ -99,3 +101,12 @@ void usb_device_state_set_idle_rate(uint8_t idle_rate) {
 inline uint8_t usb_device_state_get_idle_rate(void) {
     return usb_device_state.idle_rate;
 }
+
+void usb_device_state_set_resolution_multiplier(uint8_t resolution_multiplier) {
+    usb_device_state.resolution_multiplier = resolution_multiplier;
+    notify_usb_device_state_change(usb_device_state);
+}
+
+inline uint8_t usb_device_state_get_resolution_multiplier(void) {
+    return usb_device_state.resolution_multiplier;
+}
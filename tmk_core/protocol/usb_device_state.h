@@ -38,6 +38,7 @@ typedef enum {
 struct usb_device_state {
     uint8_t               idle_rate;
     uint8_t               leds;
+    uint8_t               resolution_multiplier;
     usb_hid_protocol_t    protocol;
     usb_configure_state_t configure_state;
 };
@@ -54,6 +55,8 @@ void                  usb_device_state_set_leds(uint8_t leds);
 uint8_t               usb_device_state_get_leds(void);
 void                  usb_device_state_set_idle_rate(uint8_t idle_rate);
 uint8_t               usb_device_state_get_idle_rate(void);
+void                  usb_device_state_set_resolution_multiplier(uint8_t resolution_multiplier);
+uint8_t               usb_device_state_get_resolution_multiplier(void);
 void                  usb_device_state_reset_hid_state(void);
 
 void notify_usb_device_state_change_kb(struct usb_device_state usb_device_state);